@@ -1,8 +1,9 @@
-
-
 #ifndef GPIO_H_
 #define GPIO_H_
 
+#include <stdint.h>
+#include "lpc21xx.h"
+
 /************* Type def section ************/
 
 /* Port data type */
@@ -49,6 +50,31 @@ typedef enum
 
 }pinState_t;
 
+/* A set of pins of one port, one bit per pin as in the IOxxx registers */
+typedef uint32_t pinMask_t;
+
+/* Pins next to each other on one port, driven and read as one value - a bank
+   of LEDs, or the segments of a display. Bit 0 of the value is the first pin */
+typedef struct
+{
+	portX_t Port;
+	pinMask_t Mask;
+	uint8_t Shift;
+
+}pinGroup_t;
+
+
+/************* Macro section ************/
+
+/* The mask of a single pin */
+#define GPIO_PIN_MASK(pinNum)					((pinMask_t)1 << (pinNum))
+
+/* Initialiser of a pinGroup_t of pinCount pins from firstPin up */
+#define GPIO_GROUP(portName, firstPin, pinCount)	{ (portName), ((((pinMask_t)1 << (pinCount)) - 1U) << (firstPin)), (uint8_t)(firstPin) }
+
+/* Both compilers take __inline in C90 as well as C99 */
+#define GPIO_INLINE								static __inline
+
 
 /************ Function declaration section ***********/
 
@@ -57,5 +83,111 @@ extern pinState_t GPIO_read(portX_t PortName, pinX_t pinNum);
 extern void GPIO_write(portX_t PortName, pinX_t PinNum, pinState_t pinState);
 
 
+/************ Inline function section ***********/
+
+/*
+ * Drive the pins of setMask high and those of clrMask low, leaving the others
+ * alone. IOSET and IOCLR only act on the bits written as 1, so no read is
+ * needed: with a constant port this is one store, or two if both masks are
+ * non zero. The LPC2129 has no masked write of IOPIN to do both at once.
+ */
+GPIO_INLINE void GPIO_writeMask(portX_t portName, pinMask_t setMask, pinMask_t clrMask)
+{
+	if(PORT_0 == portName)
+	{
+		if(0U != setMask)
+		{
+			IOSET0 = setMask;
+		}
+		if(0U != clrMask)
+		{
+			IOCLR0 = clrMask;
+		}
+	}
+	else
+	{
+		if(0U != setMask)
+		{
+			IOSET1 = setMask;
+		}
+		if(0U != clrMask)
+		{
+			IOCLR1 = clrMask;
+		}
+	}
+}
+
+/*
+ * The level of every pin of the port, in one load.
+ */
+GPIO_INLINE pinMask_t GPIO_readPort(portX_t portName)
+{
+	return (PORT_0 == portName) ? (pinMask_t)IOPIN0 : (pinMask_t)IOPIN1;
+}
+
+/*
+ * Drive the pins of a group to value. Bits of value beyond the group are
+ * ignored.
+ */
+GPIO_INLINE void GPIO_writeGroup(const pinGroup_t *group, uint32_t value)
+{
+	pinMask_t bits = ((pinMask_t)value << group->Shift) & group->Mask;
+	
+	GPIO_writeMask(group->Port, bits, group->Mask & ~bits);
+}
+
+/*
+ * The levels of the pins of a group, the first pin in bit 0.
+ */
+GPIO_INLINE uint32_t GPIO_readGroup(const pinGroup_t *group)
+{
+	return (uint32_t)((GPIO_readPort(group->Port) & group->Mask) >> group->Shift);
+}
+
+
+
+/************ Pin table section ***********/
+
+#include "GPIO_cfg.h"
+
+/* The pins of each port in the table, and those of them that are outputs */
+#define GPIO_CFG_P0_PIN(Name, Port, Pin, Direction)		| ((PORT_0 == (Port)) ? GPIO_PIN_MASK(Pin) : 0U)
+#define GPIO_CFG_P1_PIN(Name, Port, Pin, Direction)		| ((PORT_1 == (Port)) ? GPIO_PIN_MASK(Pin) : 0U)
+#define GPIO_CFG_P0_OUTPUT(Name, Port, Pin, Direction)	| (((PORT_0 == (Port)) && (OUTPUT == (Direction))) ? GPIO_PIN_MASK(Pin) : 0U)
+#define GPIO_CFG_P1_OUTPUT(Name, Port, Pin, Direction)	| (((PORT_1 == (Port)) && (OUTPUT == (Direction))) ? GPIO_PIN_MASK(Pin) : 0U)
+
+#define GPIO_PORT0_PINS							((pinMask_t)0U GPIO_PIN_TABLE(GPIO_CFG_P0_PIN))
+#define GPIO_PORT1_PINS							((pinMask_t)0U GPIO_PIN_TABLE(GPIO_CFG_P1_PIN))
+#define GPIO_PORT0_OUTPUTS						((pinMask_t)0U GPIO_PIN_TABLE(GPIO_CFG_P0_OUTPUT))
+#define GPIO_PORT1_OUTPUTS						((pinMask_t)0U GPIO_PIN_TABLE(GPIO_CFG_P1_OUTPUT))
+
+/* The accessors of each pin in the table. The port and pin are constants, so
+   a read is one IOPIN load and a write one IOSET or IOCLR store. Inputs get no
+   GPIO_write_<Name>(), so writing one fails the build */
+#define GPIO_CFG_ACCESSORS(Name, Port, Pin, Direction)	GPIO_CFG_ACCESSORS_##Direction(Name, Port, Pin)
+
+#define GPIO_CFG_ACCESSORS_INPUT(Name, Port, Pin) \
+	GPIO_INLINE pinState_t GPIO_read_##Name(void) \
+	{ \
+		return (pinState_t)((GPIO_readPort(Port) >> (Pin)) & 1U); \
+	}
+
+#define GPIO_CFG_ACCESSORS_OUTPUT(Name, Port, Pin) \
+	GPIO_CFG_ACCESSORS_INPUT(Name, Port, Pin) \
+	GPIO_INLINE void GPIO_write_##Name(pinState_t pinState) \
+	{ \
+		if(PIN_IS_LOW == pinState) \
+		{ \
+			GPIO_writeMask(Port, 0U, GPIO_PIN_MASK(Pin)); \
+		} \
+		else \
+		{ \
+			GPIO_writeMask(Port, GPIO_PIN_MASK(Pin), 0U); \
+		} \
+	}
+
+GPIO_PIN_TABLE(GPIO_CFG_ACCESSORS)
+
+
 
 #endif /* DIO_MCAL_INC_DIO_H_ */
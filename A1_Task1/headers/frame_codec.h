@@ -0,0 +1,154 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	FRAME CODEC.
+
+	The encoding of the frames sent by frame.c, shared by the target and the
+	host side library, so it depends on nothing but the C library.
+
+	Before encoding a frame is:
+
+		type		1 byte		chosen by the sender
+		sequence	2 bytes		counts the frames sent on the port
+		payload		0 to frameMAX_PAYLOAD bytes
+		CRC			2 or 4 bytes
+
+	All fields are little endian.  The CRC covers the type, sequence and
+	payload.  It is either CRC-16/CCITT-FALSE (polynomial 0x1021, initial value
+	0xffff) or CRC-32 as used by Ethernet and zlib, both table driven.
+
+	The frame is then COBS encoded, which replaces every zero byte, and
+	followed by a single zero byte.  A receiver finds the end of a frame at the
+	next zero whatever state it is in, so it can join a stream part way
+	through, and one bad frame never costs more than itself.  The encoding adds
+	one byte for every 254, plus the delimiter, however many zeros the payload
+	holds.
+
+	A receiver that sees the sequence number jump knows how many frames it
+	missed, even when they were lost whole.
+*/
+
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The largest payload a decoder accepts.  Frames of this size or smaller can
+always be encoded.  Can be set on the compiler command line, the same on both
+sides. */
+#ifndef frameMAX_PAYLOAD
+	#define frameMAX_PAYLOAD		( 128U )
+#endif
+
+#define frameHEADER_BYTES			( 3U )
+#define frameCRC16_BYTES			( 2U )
+#define frameCRC32_BYTES			( 4U )
+
+#define frameCRC16_INIT				( ( uint16_t ) 0xffffU )
+#define frameCRC32_INIT				( ( uint32_t ) 0xffffffffUL )
+
+/* The frame delimiter, which the encoded frame never contains. */
+#define frameDELIMITER				( ( uint8_t ) 0x00 )
+
+/* The most bytes a payload of xLength bytes can take once encoded, including
+the delimiter. */
+#define frameENCODED_MAX( xLength, xCrcBytes )																\
+	( ( frameHEADER_BYTES + ( xLength ) + ( xCrcBytes ) ) + ( ( frameHEADER_BYTES + ( xLength ) + ( xCrcBytes ) ) / 254U ) + 2U )
+
+/* Where an encoded frame is written: xFirstLength bytes at pucFirst, then
+xSecondLength at pucSecond - the room either side of the end of a ring buffer,
+for example.  Set pucSecond to NULL and xSecondLength to 0 for a flat buffer. */
+typedef struct FRAME_OUTPUT
+{
+	uint8_t *pucFirst;
+	size_t xFirstLength;
+	uint8_t *pucSecond;
+	size_t xSecondLength;
+} FrameOutput_t;
+
+typedef enum
+{
+	eFrameIncomplete = 0,	/* Nothing to report yet. */
+	eFrameReceived,			/* A good frame is in the decoder. */
+	eFrameError				/* A frame was thrown away - its CRC was wrong, it was too long, or badly encoded. */
+} FrameResult_t;
+
+/* Decodes a stream a byte at a time.  The fields from ucType on describe the
+last frame received, until the next byte is pushed.  The counters are never
+reset. */
+typedef struct FRAME_DECODER
+{
+	uint8_t ucBuffer[ frameHEADER_BYTES + frameMAX_PAYLOAD + frameCRC32_BYTES ];
+	size_t xLength;				/* Decoded bytes in ucBuffer. */
+	size_t xCrcBytes;
+	uint8_t ucBlockLeft;		/* Bytes left in the current COBS block. */
+	uint8_t ucBlockCode;		/* The code byte that started it, 0 before the first. */
+	uint8_t ucDiscarding;		/* Set once the frame is known to be bad. */
+	uint8_t ucHaveSequence;		/* Set once a frame has been received. */
+	uint16_t usNextSequence;
+
+	uint8_t ucType;
+	uint16_t usSequence;
+	const uint8_t *pucPayload;
+	size_t xPayloadLength;
+
+	uint32_t ulFrames;			/* Good frames received. */
+	uint32_t ulCrcErrors;		/* Frames thrown away for their CRC. */
+	uint32_t ulFramingErrors;	/* Frames thrown away as too long or badly encoded. */
+	uint32_t ulLostFrames;		/* Frames missing from the sequence numbers. */
+} FrameDecoder_t;
+
+/*
+ * Continue a CRC over xLength bytes.  Start with frameCRC16_INIT or
+ * frameCRC32_INIT.  A CRC-32 is complete once it has been inverted.
+ */
+uint16_t usFrameCrc16( uint16_t usCrc, const uint8_t *pucData, size_t xLength );
+uint32_t ulFrameCrc32( uint32_t ulCrc, const uint8_t *pucData, size_t xLength );
+
+/*
+ * Encode a frame of the given type, sequence number and payload, with a CRC of
+ * xCrcBytes (frameCRC16_BYTES or frameCRC32_BYTES), into *pxOutput.  Returns
+ * the bytes written, including the delimiter, or 0 if they did not fit -
+ * frameENCODED_MAX() always does.  The payload is read once, straight into
+ * the output.
+ */
+size_t xFrameEncode( const FrameOutput_t *pxOutput, uint8_t ucType, uint16_t usSequence, const uint8_t *pucPayload, size_t xLength, size_t xCrcBytes );
+
+/*
+ * Prepare a decoder for frames with a CRC of xCrcBytes.  If it joins a stream
+ * part way through a frame, that frame is counted as an error.
+ */
+void vFrameDecoderInit( FrameDecoder_t *pxDecoder, size_t xCrcBytes );
+
+/*
+ * Give the decoder the next byte of the stream.
+ */
+FrameResult_t eFrameDecoderPush( FrameDecoder_t *pxDecoder, uint8_t ucByte );
+
+#endif /* FRAME_CODEC_H */
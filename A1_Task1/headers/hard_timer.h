@@ -0,0 +1,159 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	HARD TIMERS.
+
+	The callbacks of the software timers in timers.c run in the timer task, so
+	how late they run depends on the priority of that task and on whatever else
+	is ready.  A hard timer calls its callback straight from an interrupt
+	instead, so it is only ever late by the time interrupts are disabled for -
+	the longest critical section, or another interrupt being handled.  They
+	are meant for short, time critical work such as a software PWM or the
+	sampling of a button.
+
+	Set configUSE_HARD_TIMERS to 1 in FreeRTOSConfig.h and choose where the
+	callbacks run with configHARD_TIMER_SOURCE:
+
+	 - hardtimerSOURCE_TICK (0): from the tick interrupt, through the tick
+	   hook.  Times are in ticks.  FreeRTOSConfig.h turns the tick hook on, and
+	   hard_timer.c provides vApplicationTickHook().
+
+	 - hardtimerSOURCE_TIMER1 (1): from the match 1 interrupt of Timer1, which
+	   is reprogrammed for the next timer due.  Times are in Timer1 counts, so
+	   a timer can be shorter than, and is not aligned to, the tick.  Timer1
+	   keeps free running for the run time stats - it must not be reset or
+	   have its prescaler changed while timers are active.
+
+	Use hardtimerUS_TO_COUNTS() to give times in microseconds for either.
+
+	A callback runs with interrupts disabled, so it must be short, and may only
+	use the FromISR API.  With the tick source a task it wakes runs as soon as
+	the tick interrupt returns.  The Timer1 interrupt does not switch context
+	when it returns, so a task woken from there runs at the next tick at the
+	latest.  The timers themselves are held in a table of hardtimerMAX_TIMERS
+	entries, so nothing is allocated.
+*/
+
+#ifndef HARD_TIMER_H
+#define HARD_TIMER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include hard_timer.h"
+#endif
+
+/*-----------------------------------------------------------
+ * Hard timer configuration.  Each can be set in FreeRTOSConfig.h.
+ *----------------------------------------------------------*/
+
+#define hardtimerSOURCE_TICK		0
+#define hardtimerSOURCE_TIMER1		1
+
+/* The number of hard timers that can be created. */
+#ifndef hardtimerMAX_TIMERS
+	#define hardtimerMAX_TIMERS			( 4 )
+#endif
+
+/* The rate Timer1 counts at.  The applications set its prescaler for 1MHz in
+configTimer1(). */
+#ifndef hardtimerTIMER1_HZ
+	#define hardtimerTIMER1_HZ			( 1000000UL )
+#endif
+
+/* The least number of Timer1 counts between programming the match register
+and the match.  A match Timer1 has reached by the time it is written is moved
+on, twice as far each time. */
+#ifndef hardtimerTIMER1_MIN_LEAD
+	#define hardtimerTIMER1_MIN_LEAD	( 2UL )
+#endif
+
+/* Set to 0 to define vApplicationTickHook() in the application instead, which
+must then call vHardTimerTick(). */
+#ifndef hardtimerDEFINE_TICK_HOOK
+	#define hardtimerDEFINE_TICK_HOOK	1
+#endif
+
+#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TIMER1 )
+	#define hardtimerUS_TO_COUNTS( ulUs )	( ( uint32_t ) ( ( ( uint64_t ) ( ulUs ) * hardtimerTIMER1_HZ ) / 1000000ULL ) )
+#else
+	#define hardtimerUS_TO_COUNTS( ulUs )	( ( uint32_t ) ( ( ( uint64_t ) ( ulUs ) * configTICK_RATE_HZ ) / 1000000ULL ) )
+#endif
+
+/*-----------------------------------------------------------
+ * API.
+ *----------------------------------------------------------*/
+
+struct HARD_TIMER;
+typedef struct HARD_TIMER * HardTimerHandle_t;
+
+/*
+ * Called from the interrupt when the timer expires.  Set
+ * *pxHigherPriorityTaskWoken as the FromISR API does.
+ */
+typedef void ( *HardTimerCallback_t )( HardTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+/*
+ * Take a timer from the table.  It is created stopped.  Returns NULL if the
+ * table is full.  Must be called from a task, or before the scheduler is
+ * started.
+ */
+HardTimerHandle_t xHardTimerCreate( HardTimerCallback_t pxCallback, void *pvTimerID );
+
+/*
+ * Start, or restart, a timer so it first expires ulFirst counts from now, then
+ * every ulPeriod counts - or only once if ulPeriod is 0.  A periodic timer is
+ * rescheduled from when it was due, not from when its callback ran, so it
+ * does not drift.  Periods missed altogether are counted, not made up.
+ *
+ * Returns pdFAIL if ulFirst is 0.
+ */
+BaseType_t xHardTimerStart( HardTimerHandle_t xTimer, uint32_t ulFirst, uint32_t ulPeriod );
+BaseType_t xHardTimerStartFromISR( HardTimerHandle_t xTimer, uint32_t ulFirst, uint32_t ulPeriod );
+
+/*
+ * Stop a timer.  Its callback is not called again until it is restarted.
+ */
+void vHardTimerStop( HardTimerHandle_t xTimer );
+void vHardTimerStopFromISR( HardTimerHandle_t xTimer );
+
+/*
+ * The ID the timer was created with.
+ */
+void *pvHardTimerGetTimerID( HardTimerHandle_t xTimer );
+
+/*
+ * The number of whole periods the timer has missed since it was created.
+ */
+uint32_t ulHardTimerGetOverruns( HardTimerHandle_t xTimer );
+
+/*
+ * With hardtimerSOURCE_TICK, runs the timers that are due.  Called from the
+ * tick hook.
+ */
+void vHardTimerTick( void );
+
+#endif /* HARD_TIMER_H */
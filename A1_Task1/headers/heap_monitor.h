@@ -0,0 +1,141 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	HEAP MONITOR.
+
+	Include this file at the end of FreeRTOSConfig.h to define the traceMALLOC()
+	and traceFREE() hooks.  Every block pvPortMalloc() hands out is recorded with
+	the task that asked for it, the address it was called from and its size,
+	until it is freed.  From those records the monitor keeps:
+
+	 - the bytes each task has allocated and not yet freed, and the most it
+	   ever had at once;
+
+	 - a histogram of the sizes asked for, in powers of two;
+
+	 - the number of requests that failed, and the least free heap there has
+	   ever been.
+
+	vHeapMonitorPrint() writes all of that over UART1, with the largest free
+	block, a fragmentation index and every block still allocated.  The run time
+	stats task calls it each period.
+
+	The fragmentation index is the share of the free heap that cannot be handed
+	out as one block: 0% when the free heap is one block, approaching 100% as
+	it is broken into ever smaller pieces.  The largest free block comes from
+	vPortGetHeapStats(), so the heap must provide it - heap_2.c, heap_4.c,
+	heap_5.c, heap_pool.c and heap_tlsf.c do.
+
+	A request made by the kernel on a task's behalf, such as the stack and TCB
+	allocated by xTaskCreate(), is recorded against the calling task, with the
+	call site inside the kernel.  Blocks allocated before the scheduler starts
+	are recorded against "(init)".  A freed block is taken off the task that
+	allocated it, whichever task frees it.
+
+	The hooks are called by the heap with the scheduler suspended, so the
+	records need no further protection as long as the heap is not used from
+	interrupts.
+*/
+
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+/*-----------------------------------------------------------
+ * Monitor configuration.  Each can be set in FreeRTOSConfig.h before this
+ * file is included.
+ *----------------------------------------------------------*/
+
+/* The number of blocks that can be recorded at once.  Blocks allocated while
+the table is full are counted, but not attributed. */
+#ifndef heapmonitorMAX_RECORDS
+	#define heapmonitorMAX_RECORDS			( 32 )
+#endif
+
+/* The number of tasks, including "(init)", that allocations are attributed
+to.  A task with nothing allocated gives up its place when it is needed. */
+#ifndef heapmonitorMAX_OWNERS
+	#define heapmonitorMAX_OWNERS			( 8 )
+#endif
+
+/* The size histogram has a bucket for each power of two from 16 bytes or less
+up to this many bytes, and one for everything larger. */
+#ifndef heapmonitorHISTOGRAM_MAX_SIZE_LOG2
+	#define heapmonitorHISTOGRAM_MAX_SIZE_LOG2	( 10 )
+#endif
+
+/* Set to 0 to leave the list of blocks still allocated out of the output. */
+#ifndef heapmonitorPRINT_BLOCKS
+	#define heapmonitorPRINT_BLOCKS			1
+#endif
+
+/* The monitor finds the task that made each request with these. */
+#ifndef INCLUDE_xTaskGetCurrentTaskHandle
+	#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#endif
+
+#ifndef INCLUDE_xTaskGetSchedulerState
+	#define INCLUDE_xTaskGetSchedulerState		1
+#endif
+
+/* The return address of the function the hook is expanded in, which is the
+call site of pvPortMalloc(). */
+#if defined( __CC_ARM )
+	#define heapmonitorCALL_SITE()			( ( void * ) __return_address() )
+#elif defined( __GNUC__ )
+	#define heapmonitorCALL_SITE()			__builtin_return_address( 0 )
+#else
+	#define heapmonitorCALL_SITE()			( ( void * ) 0 )
+#endif
+
+/*-----------------------------------------------------------
+ * API.
+ *----------------------------------------------------------*/
+
+/*
+ * Write the heap totals, the fragmentation index, each task's live and peak
+ * bytes, the size histogram and the blocks still allocated to UART1.  Must be
+ * called from one task only, as it waits for the driver to accept each line
+ * and formats them in static buffers.
+ */
+void vHeapMonitorPrint( void );
+
+/*
+ * Used by the hooks below.  pvAddress is NULL for a request that failed.
+ */
+void vHeapMonitorRecordMalloc( void *pvAddress, size_t xSize, void *pvCallSite );
+void vHeapMonitorRecordFree( void *pvAddress );
+
+/*-----------------------------------------------------------
+ * Heap trace hooks.
+ *----------------------------------------------------------*/
+
+#define traceMALLOC( pvAddress, uiSize )	vHeapMonitorRecordMalloc( ( pvAddress ), ( size_t ) ( uiSize ), heapmonitorCALL_SITE() )
+#define traceFREE( pvAddress, uiSize )		vHeapMonitorRecordFree( pvAddress )
+
+#endif /* HEAP_MONITOR_H */
+
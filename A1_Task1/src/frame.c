@@ -0,0 +1,128 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	FRAMES - see frame.h.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_FRAMES == 1 )
+
+#include "serial.h"
+#include "frame.h"
+
+/*-----------------------------------------------------------*/
+
+void vFrameChannelInit( FrameChannel_t *pxChannel, xComPortHandle xPort )
+{
+	memset( pxChannel, 0, sizeof( FrameChannel_t ) );
+	pxChannel->xPort = xPort;
+	vFrameDecoderInit( &( pxChannel->xDecoder ), frameCRC_BYTES );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFrameSend( FrameChannel_t *pxChannel, uint8_t ucType, const void *pvPayload, size_t xLength, TickType_t xBlockTime )
+{
+SerialSpace_t xSpace;
+FrameOutput_t xOutput;
+size_t xWritten;
+
+	if( xLength > frameMAX_PAYLOAD )
+	{
+		return pdFALSE;
+	}
+
+	/* Room for the longest the frame can be.  What is not used is given back
+	by the commit. */
+	if( xSerialPortReserve( pxChannel->xPort, ( unsigned short ) frameENCODED_MAX( xLength, frameCRC_BYTES ), &xSpace, xBlockTime ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	xOutput.pucFirst = xSpace.pucFirst;
+	xOutput.xFirstLength = xSpace.usFirst;
+	xOutput.pucSecond = xSpace.pucSecond;
+	xOutput.xSecondLength = xSpace.usSecond;
+
+	/* Other senders wait until the commit, so the sequence number can be
+	taken without a critical section. */
+	xWritten = xFrameEncode( &xOutput, ucType, pxChannel->usNextSequence, ( const uint8_t * ) pvPayload, xLength, frameCRC_BYTES );
+	pxChannel->usNextSequence++;
+
+	vSerialPortCommit( pxChannel->xPort, ( unsigned short ) xWritten );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xFrameReceive( FrameChannel_t *pxChannel, TickType_t xBlockTime )
+{
+TimeOut_t xTimeOut;
+unsigned short usRead;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		/* Decode what is left of the last chunk first. */
+		while( pxChannel->usRxNext < pxChannel->usRxCount )
+		{
+			pxChannel->usRxNext++;
+
+			if( eFrameDecoderPush( &( pxChannel->xDecoder ), pxChannel->ucRxChunk[ pxChannel->usRxNext - 1U ] ) == eFrameReceived )
+			{
+				return pdTRUE;
+			}
+		}
+
+		/* Take whatever has arrived, or failing that wait for one more
+		character. */
+		usRead = xSerialPortRead( pxChannel->xPort, ( signed char * ) pxChannel->ucRxChunk, frameRX_CHUNK, 0 );
+
+		if( usRead == 0 )
+		{
+			if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+			{
+				return pdFALSE;
+			}
+
+			usRead = xSerialPortRead( pxChannel->xPort, ( signed char * ) pxChannel->ucRxChunk, 1, xBlockTime );
+		}
+
+		pxChannel->usRxNext = 0;
+		pxChannel->usRxCount = usRead;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_FRAMES */
@@ -0,0 +1,448 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	FRAME CODEC - see frame_codec.h.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+#include "frame_codec.h"
+
+/*-----------------------------------------------------------*/
+
+/* A COBS block holds at most 254 bytes after its code byte. */
+#define frameMAX_BLOCK_CODE			( ( uint8_t ) 0xff )
+
+/* The state of a frame being encoded. */
+typedef struct FRAME_ENCODER
+{
+	const FrameOutput_t *pxOutput;
+	size_t xWritten;				/* Bytes written, or reserved for the code byte. */
+	size_t xCodeIndex;				/* Where the code byte of the current block goes. */
+	uint32_t ulCrc;					/* The CRC so far, of either width. */
+	size_t xCrcBytes;
+	uint8_t ucCode;					/* One more than the bytes in the current block. */
+	uint8_t ucOverflow;				/* Set if the output was too small. */
+} FrameEncoder_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write ucByte at xIndex of the output, if it fits.
+ */
+static void prvPut( FrameEncoder_t *pxEncoder, size_t xIndex, uint8_t ucByte );
+
+/*
+ * COBS encode the next byte of a frame.
+ */
+static void prvEncodeByte( FrameEncoder_t *pxEncoder, uint8_t ucByte );
+
+/*
+ * Add the next byte of the header or payload to the CRC, then COBS encode it.
+ */
+static void prvEncodeCheckedByte( FrameEncoder_t *pxEncoder, uint8_t ucByte );
+
+/*
+ * Called at a delimiter.  Checks the frame decoded so far and makes ready for
+ * the next.
+ */
+static FrameResult_t prvDecodeEnd( FrameDecoder_t *pxDecoder );
+
+/*-----------------------------------------------------------*/
+
+static const uint16_t usCrc16Table[ 256 ] =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+	0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+	0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+	0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+	0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+	0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+	0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+	0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+	0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+	0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+	0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+	0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+	0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+	0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+	0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+	0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+	0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+	0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+	0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+	0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+	0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+	0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+	0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+	0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+	0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+	0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+	0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+	0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+	0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+	0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+	0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+	0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+};
+
+static const uint32_t ulCrc32Table[ 256 ] =
+{
+	0x00000000UL, 0x77073096UL, 0xee0e612cUL, 0x990951baUL, 0x076dc419UL, 0x706af48fUL,
+	0xe963a535UL, 0x9e6495a3UL, 0x0edb8832UL, 0x79dcb8a4UL, 0xe0d5e91eUL, 0x97d2d988UL,
+	0x09b64c2bUL, 0x7eb17cbdUL, 0xe7b82d07UL, 0x90bf1d91UL, 0x1db71064UL, 0x6ab020f2UL,
+	0xf3b97148UL, 0x84be41deUL, 0x1adad47dUL, 0x6ddde4ebUL, 0xf4d4b551UL, 0x83d385c7UL,
+	0x136c9856UL, 0x646ba8c0UL, 0xfd62f97aUL, 0x8a65c9ecUL, 0x14015c4fUL, 0x63066cd9UL,
+	0xfa0f3d63UL, 0x8d080df5UL, 0x3b6e20c8UL, 0x4c69105eUL, 0xd56041e4UL, 0xa2677172UL,
+	0x3c03e4d1UL, 0x4b04d447UL, 0xd20d85fdUL, 0xa50ab56bUL, 0x35b5a8faUL, 0x42b2986cUL,
+	0xdbbbc9d6UL, 0xacbcf940UL, 0x32d86ce3UL, 0x45df5c75UL, 0xdcd60dcfUL, 0xabd13d59UL,
+	0x26d930acUL, 0x51de003aUL, 0xc8d75180UL, 0xbfd06116UL, 0x21b4f4b5UL, 0x56b3c423UL,
+	0xcfba9599UL, 0xb8bda50fUL, 0x2802b89eUL, 0x5f058808UL, 0xc60cd9b2UL, 0xb10be924UL,
+	0x2f6f7c87UL, 0x58684c11UL, 0xc1611dabUL, 0xb6662d3dUL, 0x76dc4190UL, 0x01db7106UL,
+	0x98d220bcUL, 0xefd5102aUL, 0x71b18589UL, 0x06b6b51fUL, 0x9fbfe4a5UL, 0xe8b8d433UL,
+	0x7807c9a2UL, 0x0f00f934UL, 0x9609a88eUL, 0xe10e9818UL, 0x7f6a0dbbUL, 0x086d3d2dUL,
+	0x91646c97UL, 0xe6635c01UL, 0x6b6b51f4UL, 0x1c6c6162UL, 0x856530d8UL, 0xf262004eUL,
+	0x6c0695edUL, 0x1b01a57bUL, 0x8208f4c1UL, 0xf50fc457UL, 0x65b0d9c6UL, 0x12b7e950UL,
+	0x8bbeb8eaUL, 0xfcb9887cUL, 0x62dd1ddfUL, 0x15da2d49UL, 0x8cd37cf3UL, 0xfbd44c65UL,
+	0x4db26158UL, 0x3ab551ceUL, 0xa3bc0074UL, 0xd4bb30e2UL, 0x4adfa541UL, 0x3dd895d7UL,
+	0xa4d1c46dUL, 0xd3d6f4fbUL, 0x4369e96aUL, 0x346ed9fcUL, 0xad678846UL, 0xda60b8d0UL,
+	0x44042d73UL, 0x33031de5UL, 0xaa0a4c5fUL, 0xdd0d7cc9UL, 0x5005713cUL, 0x270241aaUL,
+	0xbe0b1010UL, 0xc90c2086UL, 0x5768b525UL, 0x206f85b3UL, 0xb966d409UL, 0xce61e49fUL,
+	0x5edef90eUL, 0x29d9c998UL, 0xb0d09822UL, 0xc7d7a8b4UL, 0x59b33d17UL, 0x2eb40d81UL,
+	0xb7bd5c3bUL, 0xc0ba6cadUL, 0xedb88320UL, 0x9abfb3b6UL, 0x03b6e20cUL, 0x74b1d29aUL,
+	0xead54739UL, 0x9dd277afUL, 0x04db2615UL, 0x73dc1683UL, 0xe3630b12UL, 0x94643b84UL,
+	0x0d6d6a3eUL, 0x7a6a5aa8UL, 0xe40ecf0bUL, 0x9309ff9dUL, 0x0a00ae27UL, 0x7d079eb1UL,
+	0xf00f9344UL, 0x8708a3d2UL, 0x1e01f268UL, 0x6906c2feUL, 0xf762575dUL, 0x806567cbUL,
+	0x196c3671UL, 0x6e6b06e7UL, 0xfed41b76UL, 0x89d32be0UL, 0x10da7a5aUL, 0x67dd4accUL,
+	0xf9b9df6fUL, 0x8ebeeff9UL, 0x17b7be43UL, 0x60b08ed5UL, 0xd6d6a3e8UL, 0xa1d1937eUL,
+	0x38d8c2c4UL, 0x4fdff252UL, 0xd1bb67f1UL, 0xa6bc5767UL, 0x3fb506ddUL, 0x48b2364bUL,
+	0xd80d2bdaUL, 0xaf0a1b4cUL, 0x36034af6UL, 0x41047a60UL, 0xdf60efc3UL, 0xa867df55UL,
+	0x316e8eefUL, 0x4669be79UL, 0xcb61b38cUL, 0xbc66831aUL, 0x256fd2a0UL, 0x5268e236UL,
+	0xcc0c7795UL, 0xbb0b4703UL, 0x220216b9UL, 0x5505262fUL, 0xc5ba3bbeUL, 0xb2bd0b28UL,
+	0x2bb45a92UL, 0x5cb36a04UL, 0xc2d7ffa7UL, 0xb5d0cf31UL, 0x2cd99e8bUL, 0x5bdeae1dUL,
+	0x9b64c2b0UL, 0xec63f226UL, 0x756aa39cUL, 0x026d930aUL, 0x9c0906a9UL, 0xeb0e363fUL,
+	0x72076785UL, 0x05005713UL, 0x95bf4a82UL, 0xe2b87a14UL, 0x7bb12baeUL, 0x0cb61b38UL,
+	0x92d28e9bUL, 0xe5d5be0dUL, 0x7cdcefb7UL, 0x0bdbdf21UL, 0x86d3d2d4UL, 0xf1d4e242UL,
+	0x68ddb3f8UL, 0x1fda836eUL, 0x81be16cdUL, 0xf6b9265bUL, 0x6fb077e1UL, 0x18b74777UL,
+	0x88085ae6UL, 0xff0f6a70UL, 0x66063bcaUL, 0x11010b5cUL, 0x8f659effUL, 0xf862ae69UL,
+	0x616bffd3UL, 0x166ccf45UL, 0xa00ae278UL, 0xd70dd2eeUL, 0x4e048354UL, 0x3903b3c2UL,
+	0xa7672661UL, 0xd06016f7UL, 0x4969474dUL, 0x3e6e77dbUL, 0xaed16a4aUL, 0xd9d65adcUL,
+	0x40df0b66UL, 0x37d83bf0UL, 0xa9bcae53UL, 0xdebb9ec5UL, 0x47b2cf7fUL, 0x30b5ffe9UL,
+	0xbdbdf21cUL, 0xcabac28aUL, 0x53b39330UL, 0x24b4a3a6UL, 0xbad03605UL, 0xcdd70693UL,
+	0x54de5729UL, 0x23d967bfUL, 0xb3667a2eUL, 0xc4614ab8UL, 0x5d681b02UL, 0x2a6f2b94UL,
+	0xb40bbe37UL, 0xc30c8ea1UL, 0x5a05df1bUL, 0x2d02ef8dUL
+};
+
+/*-----------------------------------------------------------*/
+
+uint16_t usFrameCrc16( uint16_t usCrc, const uint8_t *pucData, size_t xLength )
+{
+	while( xLength > 0 )
+	{
+		usCrc = ( uint16_t ) ( ( usCrc << 8 ) ^ usCrc16Table[ ( uint8_t ) ( ( usCrc >> 8 ) ^ *pucData ) ] );
+		pucData++;
+		xLength--;
+	}
+
+	return usCrc;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulFrameCrc32( uint32_t ulCrc, const uint8_t *pucData, size_t xLength )
+{
+	while( xLength > 0 )
+	{
+		ulCrc = ( ulCrc >> 8 ) ^ ulCrc32Table[ ( uint8_t ) ( ulCrc ^ *pucData ) ];
+		pucData++;
+		xLength--;
+	}
+
+	return ulCrc;
+}
+/*-----------------------------------------------------------*/
+
+size_t xFrameEncode( const FrameOutput_t *pxOutput, uint8_t ucType, uint16_t usSequence, const uint8_t *pucPayload, size_t xLength, size_t xCrcBytes )
+{
+FrameEncoder_t xEncoder;
+uint8_t ucHeader[ frameHEADER_BYTES ], ucCrc[ frameCRC32_BYTES ];
+uint32_t ulCrc;
+size_t x;
+
+	if( ( xLength > frameMAX_PAYLOAD ) || ( ( xCrcBytes != frameCRC16_BYTES ) && ( xCrcBytes != frameCRC32_BYTES ) ) )
+	{
+		return 0;
+	}
+
+	ucHeader[ 0 ] = ucType;
+	ucHeader[ 1 ] = ( uint8_t ) usSequence;
+	ucHeader[ 2 ] = ( uint8_t ) ( usSequence >> 8 );
+
+	xEncoder.pxOutput = pxOutput;
+	xEncoder.xCodeIndex = 0;
+	xEncoder.xWritten = 1;
+	xEncoder.ulCrc = ( xCrcBytes == frameCRC16_BYTES ) ? frameCRC16_INIT : frameCRC32_INIT;
+	xEncoder.xCrcBytes = xCrcBytes;
+	xEncoder.ucCode = 1;
+	xEncoder.ucOverflow = 0;
+
+	/* One pass over the payload both encodes it and adds it to the CRC. */
+	for( x = 0; x < frameHEADER_BYTES; x++ )
+	{
+		prvEncodeCheckedByte( &xEncoder, ucHeader[ x ] );
+	}
+
+	for( x = 0; x < xLength; x++ )
+	{
+		prvEncodeCheckedByte( &xEncoder, pucPayload[ x ] );
+	}
+
+	if( xCrcBytes == frameCRC16_BYTES )
+	{
+		ulCrc = xEncoder.ulCrc;
+		ucCrc[ 0 ] = ( uint8_t ) ulCrc;
+		ucCrc[ 1 ] = ( uint8_t ) ( ulCrc >> 8 );
+	}
+	else
+	{
+		ulCrc = ~xEncoder.ulCrc;
+		ucCrc[ 0 ] = ( uint8_t ) ulCrc;
+		ucCrc[ 1 ] = ( uint8_t ) ( ulCrc >> 8 );
+		ucCrc[ 2 ] = ( uint8_t ) ( ulCrc >> 16 );
+		ucCrc[ 3 ] = ( uint8_t ) ( ulCrc >> 24 );
+	}
+
+	for( x = 0; x < xCrcBytes; x++ )
+	{
+		prvEncodeByte( &xEncoder, ucCrc[ x ] );
+	}
+
+	/* Close the last block, and the frame. */
+	prvPut( &xEncoder, xEncoder.xCodeIndex, xEncoder.ucCode );
+	prvPut( &xEncoder, xEncoder.xWritten, frameDELIMITER );
+	xEncoder.xWritten++;
+
+	return ( xEncoder.ucOverflow == 0 ) ? xEncoder.xWritten : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEncodeCheckedByte( FrameEncoder_t *pxEncoder, uint8_t ucByte )
+{
+uint32_t ulCrc = pxEncoder->ulCrc;
+
+	/* The same steps as usFrameCrc16() and ulFrameCrc32(), one byte at a
+	time. */
+	if( pxEncoder->xCrcBytes == frameCRC16_BYTES )
+	{
+		ulCrc = ( uint16_t ) ( ( ulCrc << 8 ) ^ usCrc16Table[ ( uint8_t ) ( ( ulCrc >> 8 ) ^ ucByte ) ] );
+	}
+	else
+	{
+		ulCrc = ( ulCrc >> 8 ) ^ ulCrc32Table[ ( uint8_t ) ( ulCrc ^ ucByte ) ];
+	}
+
+	pxEncoder->ulCrc = ulCrc;
+	prvEncodeByte( pxEncoder, ucByte );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEncodeByte( FrameEncoder_t *pxEncoder, uint8_t ucByte )
+{
+	if( ucByte == 0 )
+	{
+		/* The zero ends the block, and is implied by its code. */
+		prvPut( pxEncoder, pxEncoder->xCodeIndex, pxEncoder->ucCode );
+		pxEncoder->xCodeIndex = pxEncoder->xWritten;
+		pxEncoder->xWritten++;
+		pxEncoder->ucCode = 1;
+	}
+	else
+	{
+		prvPut( pxEncoder, pxEncoder->xWritten, ucByte );
+		pxEncoder->xWritten++;
+		pxEncoder->ucCode++;
+
+		if( pxEncoder->ucCode == frameMAX_BLOCK_CODE )
+		{
+			/* A full block, which implies no zero. */
+			prvPut( pxEncoder, pxEncoder->xCodeIndex, pxEncoder->ucCode );
+			pxEncoder->xCodeIndex = pxEncoder->xWritten;
+			pxEncoder->xWritten++;
+			pxEncoder->ucCode = 1;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPut( FrameEncoder_t *pxEncoder, size_t xIndex, uint8_t ucByte )
+{
+const FrameOutput_t *pxOutput = pxEncoder->pxOutput;
+
+	if( xIndex < pxOutput->xFirstLength )
+	{
+		pxOutput->pucFirst[ xIndex ] = ucByte;
+	}
+	else if( ( xIndex - pxOutput->xFirstLength ) < pxOutput->xSecondLength )
+	{
+		pxOutput->pucSecond[ xIndex - pxOutput->xFirstLength ] = ucByte;
+	}
+	else
+	{
+		pxEncoder->ucOverflow = 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vFrameDecoderInit( FrameDecoder_t *pxDecoder, size_t xCrcBytes )
+{
+	memset( pxDecoder, 0, sizeof( FrameDecoder_t ) );
+	pxDecoder->xCrcBytes = xCrcBytes;
+}
+/*-----------------------------------------------------------*/
+
+FrameResult_t eFrameDecoderPush( FrameDecoder_t *pxDecoder, uint8_t ucByte )
+{
+FrameResult_t eResult = eFrameIncomplete;
+
+	if( ucByte == frameDELIMITER )
+	{
+		eResult = prvDecodeEnd( pxDecoder );
+	}
+	else if( pxDecoder->ucDiscarding != 0 )
+	{
+		/* Skip to the next delimiter. */
+	}
+	else if( pxDecoder->ucBlockLeft == 0 )
+	{
+		/* A code byte.  The block before it ended with an implied zero,
+		unless it was a full one. */
+		if( ( pxDecoder->ucBlockCode != 0 ) && ( pxDecoder->ucBlockCode != frameMAX_BLOCK_CODE ) )
+		{
+			if( pxDecoder->xLength < sizeof( pxDecoder->ucBuffer ) )
+			{
+				pxDecoder->ucBuffer[ pxDecoder->xLength ] = 0;
+				pxDecoder->xLength++;
+			}
+			else
+			{
+				pxDecoder->ucDiscarding = 1;
+			}
+		}
+
+		pxDecoder->ucBlockCode = ucByte;
+		pxDecoder->ucBlockLeft = ( uint8_t ) ( ucByte - 1U );
+	}
+	else
+	{
+		if( pxDecoder->xLength < sizeof( pxDecoder->ucBuffer ) )
+		{
+			pxDecoder->ucBuffer[ pxDecoder->xLength ] = ucByte;
+			pxDecoder->xLength++;
+		}
+		else
+		{
+			pxDecoder->ucDiscarding = 1;
+		}
+
+		pxDecoder->ucBlockLeft--;
+	}
+
+	return eResult;
+}
+/*-----------------------------------------------------------*/
+
+static FrameResult_t prvDecodeEnd( FrameDecoder_t *pxDecoder )
+{
+FrameResult_t eResult = eFrameError;
+size_t xLength = pxDecoder->xLength, xCrcBytes = pxDecoder->xCrcBytes, xBody;
+const uint8_t *pucCrc;
+uint32_t ulCrc, ulReceived;
+uint16_t usSequence;
+
+	if( ( xLength == 0 ) && ( pxDecoder->ucBlockCode == 0 ) )
+	{
+		/* Delimiters in a row - there is no frame between them. */
+		eResult = eFrameIncomplete;
+	}
+	else if( ( pxDecoder->ucDiscarding != 0 ) || ( pxDecoder->ucBlockLeft != 0 ) || ( xLength < ( frameHEADER_BYTES + xCrcBytes ) ) )
+	{
+		/* Too long, cut short, or too short to be a frame. */
+		pxDecoder->ulFramingErrors++;
+	}
+	else
+	{
+		xBody = xLength - xCrcBytes;
+		pucCrc = &( pxDecoder->ucBuffer[ xBody ] );
+
+		if( xCrcBytes == frameCRC16_BYTES )
+		{
+			ulCrc = usFrameCrc16( frameCRC16_INIT, pxDecoder->ucBuffer, xBody );
+			ulReceived = ( uint32_t ) pucCrc[ 0 ] | ( ( uint32_t ) pucCrc[ 1 ] << 8 );
+		}
+		else
+		{
+			ulCrc = ~ulFrameCrc32( frameCRC32_INIT, pxDecoder->ucBuffer, xBody );
+			ulReceived = ( uint32_t ) pucCrc[ 0 ] | ( ( uint32_t ) pucCrc[ 1 ] << 8 ) |
+						 ( ( uint32_t ) pucCrc[ 2 ] << 16 ) | ( ( uint32_t ) pucCrc[ 3 ] << 24 );
+		}
+
+		if( ulCrc != ulReceived )
+		{
+			pxDecoder->ulCrcErrors++;
+		}
+		else
+		{
+			usSequence = ( uint16_t ) ( pxDecoder->ucBuffer[ 1 ] | ( pxDecoder->ucBuffer[ 2 ] << 8 ) );
+
+			if( pxDecoder->ucHaveSequence != 0 )
+			{
+				pxDecoder->ulLostFrames += ( uint16_t ) ( usSequence - pxDecoder->usNextSequence );
+			}
+
+			pxDecoder->ucHaveSequence = 1;
+			pxDecoder->usNextSequence = ( uint16_t ) ( usSequence + 1U );
+
+			pxDecoder->ucType = pxDecoder->ucBuffer[ 0 ];
+			pxDecoder->usSequence = usSequence;
+			pxDecoder->pucPayload = &( pxDecoder->ucBuffer[ frameHEADER_BYTES ] );
+			pxDecoder->xPayloadLength = xBody - frameHEADER_BYTES;
+			pxDecoder->ulFrames++;
+
+			eResult = eFrameReceived;
+		}
+	}
+
+	/* Ready for the next frame. */
+	pxDecoder->xLength = 0;
+	pxDecoder->ucBlockLeft = 0;
+	pxDecoder->ucBlockCode = 0;
+	pxDecoder->ucDiscarding = 0;
+
+	return eResult;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,388 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	HARD TIMERS - see hard_timer.h.
+*/
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+#include "hard_timer.h"
+
+/* The timers are only built when they are enabled in FreeRTOSConfig.h. */
+#if( configUSE_HARD_TIMERS == 1 )
+
+/*-----------------------------------------------------------*/
+
+/* Timer1 match 1 interrupt, in the VIC slot after the tick and UART1. */
+#define hardtimerMCR_MR1_INTERRUPT	( ( unsigned long ) 0x08 )
+#define hardtimerIR_MR1				( ( unsigned long ) 0x02 )
+#define hardtimerVIC_CHANNEL		( ( unsigned long ) 0x0005 )
+#define hardtimerVIC_CHANNEL_BIT	( ( unsigned long ) 0x0020 )
+#define hardtimerVIC_ENABLE			( ( unsigned long ) 0x0020 )
+#define hardtimerCLEAR_VIC_INTERRUPT	( 0 )
+
+/* A time is due when it is not after now, the difference being taken modulo
+2^32 so the count can wrap. */
+#define hardtimerIS_DUE( ulTime, ulNow )	( ( ( uint32_t ) ( ( ulNow ) - ( ulTime ) ) ) < 0x80000000UL )
+
+/* The Timer1 interrupt entry point does not save the task context, so it is
+a plain interrupt function for the compiler. */
+#if defined( __CC_ARM )
+	#define hardtimerIRQ	__irq
+#else
+	#define hardtimerIRQ
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct HARD_TIMER
+{
+	HardTimerCallback_t pxCallback;	/*<< NULL if the entry is not in use. */
+	void *pvTimerID;				/*<< Given to xHardTimerCreate(). */
+	uint32_t ulExpiry;				/*<< The count the timer is next due at. */
+	uint32_t ulPeriod;				/*<< 0 for a one-shot timer. */
+	uint32_t ulOverruns;			/*<< Whole periods missed. */
+	BaseType_t xActive;				/*<< pdTRUE while the timer is started. */
+} HardTimer_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The count the timers are kept in: the tick count, or Timer1.
+ */
+static uint32_t prvHardTimerNow( void );
+
+/*
+ * Call the callback of every active timer that is due, and reschedule or stop
+ * each.  Called from the interrupt.
+ */
+static void prvHardTimerRun( uint32_t ulNow );
+
+/*
+ * Set the expiry of a timer.  Called with interrupts disabled.
+ */
+static BaseType_t prvHardTimerStart( HardTimer_t *pxTimer, uint32_t ulFirst, uint32_t ulPeriod );
+
+#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TIMER1 )
+
+	/*
+	 * Point Timer1 match 1 at the next timer due, or disable its interrupt if
+	 * none is active.  Called with interrupts disabled.
+	 */
+	static void prvHardTimerProgramMatch( void );
+
+	/*
+	 * The Timer1 interrupt.
+	 */
+	void vHardTimerISR( void ) hardtimerIRQ;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+static HardTimer_t xHardTimers[ hardtimerMAX_TIMERS ];
+
+/*-----------------------------------------------------------*/
+
+HardTimerHandle_t xHardTimerCreate( HardTimerCallback_t pxCallback, void *pvTimerID )
+{
+HardTimer_t *pxTimer = NULL;
+UBaseType_t uxIndex;
+
+	taskENTER_CRITICAL();
+	{
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) hardtimerMAX_TIMERS; uxIndex++ )
+		{
+			if( xHardTimers[ uxIndex ].pxCallback == NULL )
+			{
+				pxTimer = &( xHardTimers[ uxIndex ] );
+				pxTimer->pxCallback = pxCallback;
+				pxTimer->pvTimerID = pvTimerID;
+				pxTimer->ulOverruns = 0;
+				pxTimer->xActive = pdFALSE;
+				break;
+			}
+		}
+
+		#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TIMER1 )
+		{
+			/* Setup the VIC for Timer1.  Its match 1 interrupt is only enabled
+			while a timer is active. */
+			VICIntSelect &= ~( hardtimerVIC_CHANNEL_BIT );
+			VICIntEnable |= hardtimerVIC_CHANNEL_BIT;
+			VICVectAddr2 = ( unsigned long ) vHardTimerISR;
+			VICVectCntl2 = hardtimerVIC_CHANNEL | hardtimerVIC_ENABLE;
+		}
+		#endif
+	}
+	taskEXIT_CRITICAL();
+
+	return pxTimer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHardTimerStart( HardTimerHandle_t xTimer, uint32_t ulFirst, uint32_t ulPeriod )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvHardTimerStart( xTimer, ulFirst, ulPeriod );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHardTimerStartFromISR( HardTimerHandle_t xTimer, uint32_t ulFirst, uint32_t ulPeriod )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xReturn = prvHardTimerStart( xTimer, ulFirst, ulPeriod );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvHardTimerStart( HardTimer_t *pxTimer, uint32_t ulFirst, uint32_t ulPeriod )
+{
+	if( ulFirst == 0 )
+	{
+		return pdFAIL;
+	}
+
+	pxTimer->ulExpiry = prvHardTimerNow() + ulFirst;
+	pxTimer->ulPeriod = ulPeriod;
+	pxTimer->xActive = pdTRUE;
+
+	#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TIMER1 )
+	{
+		prvHardTimerProgramMatch();
+	}
+	#endif
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vHardTimerStop( HardTimerHandle_t xTimer )
+{
+	/* The match is left where it is - the interrupt finds nothing due, and
+	moves it on. */
+	taskENTER_CRITICAL();
+	{
+		xTimer->xActive = pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vHardTimerStopFromISR( HardTimerHandle_t xTimer )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xTimer->xActive = pdFALSE;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void *pvHardTimerGetTimerID( HardTimerHandle_t xTimer )
+{
+	return xTimer->pvTimerID;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulHardTimerGetOverruns( HardTimerHandle_t xTimer )
+{
+	return xTimer->ulOverruns;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHardTimerRun( uint32_t ulNow )
+{
+HardTimer_t *pxTimer;
+UBaseType_t uxIndex;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	for( uxIndex = 0; uxIndex < ( UBaseType_t ) hardtimerMAX_TIMERS; uxIndex++ )
+	{
+		pxTimer = &( xHardTimers[ uxIndex ] );
+
+		if( ( pxTimer->xActive != pdFALSE ) && hardtimerIS_DUE( pxTimer->ulExpiry, ulNow ) )
+		{
+			/* Reschedule before calling the callback, which may restart or
+			stop the timer itself. */
+			if( pxTimer->ulPeriod != 0 )
+			{
+				pxTimer->ulExpiry += pxTimer->ulPeriod;
+
+				while( hardtimerIS_DUE( pxTimer->ulExpiry, ulNow ) )
+				{
+					pxTimer->ulExpiry += pxTimer->ulPeriod;
+					pxTimer->ulOverruns++;
+				}
+			}
+			else
+			{
+				pxTimer->xActive = pdFALSE;
+			}
+
+			pxTimer->pxCallback( pxTimer, &xHigherPriorityTaskWoken );
+		}
+	}
+
+	/* A task woken by a callback is switched to when the tick interrupt
+	returns, as the FromISR API has already set a yield pending.  The Timer1
+	interrupt cannot switch context itself. */
+	( void ) xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TICK )
+
+	static uint32_t prvHardTimerNow( void )
+	{
+		return ( uint32_t ) xTaskGetTickCountFromISR();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vHardTimerTick( void )
+	{
+		prvHardTimerRun( prvHardTimerNow() );
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( hardtimerDEFINE_TICK_HOOK == 1 )
+
+		void vApplicationTickHook( void )
+		{
+			vHardTimerTick();
+		}
+
+	#endif
+
+#else /* configHARD_TIMER_SOURCE */
+
+	static uint32_t prvHardTimerNow( void )
+	{
+		return ( uint32_t ) T1TC;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vHardTimerTick( void )
+	{
+		/* The timers run from Timer1. */
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvHardTimerProgramMatch( void )
+	{
+	HardTimer_t *pxTimer;
+	UBaseType_t uxIndex;
+	uint32_t ulNow, ulUntil, ulSoonest = 0xffffffffUL, ulMatch, ulLead;
+	BaseType_t xAnyActive = pdFALSE;
+
+		ulNow = prvHardTimerNow();
+
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) hardtimerMAX_TIMERS; uxIndex++ )
+		{
+			pxTimer = &( xHardTimers[ uxIndex ] );
+
+			if( pxTimer->xActive != pdFALSE )
+			{
+				/* A timer already due is 0 counts away. */
+				ulUntil = hardtimerIS_DUE( pxTimer->ulExpiry, ulNow ) ? 0UL : ( pxTimer->ulExpiry - ulNow );
+
+				if( ulUntil < ulSoonest )
+				{
+					ulSoonest = ulUntil;
+				}
+
+				xAnyActive = pdTRUE;
+			}
+		}
+
+		if( xAnyActive == pdFALSE )
+		{
+			T1MCR &= ~hardtimerMCR_MR1_INTERRUPT;
+		}
+		else
+		{
+			if( ulSoonest < hardtimerTIMER1_MIN_LEAD )
+			{
+				/* Due now, or too soon to be sure of the match - take the
+				interrupt as soon as possible instead. */
+				ulSoonest = hardtimerTIMER1_MIN_LEAD;
+			}
+
+			ulMatch = ulNow + ulSoonest;
+			T1MR1 = ulMatch;
+			T1MCR |= hardtimerMCR_MR1_INTERRUPT;
+
+			/* Timer1 only matches when it counts onto the match, so one it
+			has already reached by the time it was written would not be seen
+			until the count wraps.  Move it on, further each time, until it is
+			written ahead of the count. */
+			ulLead = hardtimerTIMER1_MIN_LEAD;
+
+			while( hardtimerIS_DUE( ulMatch, prvHardTimerNow() ) )
+			{
+				ulLead <<= 1;
+				ulMatch = prvHardTimerNow() + ulLead;
+				T1MR1 = ulMatch;
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vHardTimerISR( void ) hardtimerIRQ
+	{
+		T1IR = hardtimerIR_MR1;
+
+		prvHardTimerRun( prvHardTimerNow() );
+		prvHardTimerProgramMatch();
+
+		/* Clear the ISR in the VIC. */
+		VICVectAddr = hardtimerCLEAR_VIC_INTERRUPT;
+	}
+
+#endif /* configHARD_TIMER_SOURCE */
+
+#endif /* configUSE_HARD_TIMERS */
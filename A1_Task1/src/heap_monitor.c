@@ -0,0 +1,371 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	HEAP MONITOR - see heap_monitor.h.
+*/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+
+/* The monitor is only built when it is enabled in FreeRTOSConfig.h, which
+then includes heap_monitor.h. */
+#if( configUSE_HEAP_MONITOR == 1 )
+
+/*-----------------------------------------------------------*/
+
+/* The buckets of the size histogram: one for 16 bytes or less, one for each
+power of two up to heapmonitorHISTOGRAM_MAX_SIZE_LOG2, and one for the rest. */
+#define heapmonitorHISTOGRAM_MIN_SIZE_LOG2	( 4 )
+#define heapmonitorHISTOGRAM_BUCKETS		( heapmonitorHISTOGRAM_MAX_SIZE_LOG2 - heapmonitorHISTOGRAM_MIN_SIZE_LOG2 + 2 )
+
+/* Returned when there is no room to attribute a request to its task. */
+#define heapmonitorNO_OWNER					( ( UBaseType_t ) heapmonitorMAX_OWNERS )
+
+#define heapmonitorLINE_LENGTH				( 64 )
+
+/*-----------------------------------------------------------*/
+
+/* A block that has been allocated and not yet freed. */
+typedef struct HEAP_MONITOR_RECORD
+{
+	void *pvAddress;		/*<< The block, or NULL if the record is not in use. */
+	void *pvCallSite;		/*<< Where pvPortMalloc() was called from. */
+	size_t xSize;			/*<< The size the heap reported for the block. */
+	UBaseType_t uxOwner;	/*<< The index of the task that allocated it in xOwners[]. */
+} HeapMonitorRecord_t;
+
+/* A task that allocations are attributed to. */
+typedef struct HEAP_MONITOR_OWNER
+{
+	TaskHandle_t xTask;		/*<< NULL for the blocks allocated before the scheduler started. */
+	size_t xLiveBytes;		/*<< The bytes allocated by the task and not yet freed. */
+	size_t xPeakBytes;		/*<< The most xLiveBytes has been. */
+	size_t xAllocations;	/*<< The number of blocks the task has allocated. */
+	char cName[ configMAX_TASK_NAME_LEN ];	/*<< Empty if the entry is not in use. */
+} HeapMonitorOwner_t;
+
+/*
+ * Find, or make, the entry in xOwners[] for the task making a request.
+ * Returns heapmonitorNO_OWNER if there is no room for it.
+ */
+static UBaseType_t prvFindOwner( void );
+
+/*
+ * Write a string on UART1, waiting for the driver to accept it.
+ */
+static void prvPrint( const char *pcString );
+
+/*-----------------------------------------------------------*/
+
+static HeapMonitorRecord_t xRecords[ heapmonitorMAX_RECORDS ];
+static HeapMonitorOwner_t xOwners[ heapmonitorMAX_OWNERS ];
+
+/* The number of requests for each bucket of sizes, whether or not they could
+be met. */
+static size_t xSizeHistogram[ heapmonitorHISTOGRAM_BUCKETS ];
+
+static size_t xFailedAllocations = 0;
+
+/* The blocks allocated while xRecords[] or xOwners[] was full. */
+static size_t xUntrackedAllocations = 0;
+
+/*-----------------------------------------------------------*/
+
+void vHeapMonitorRecordMalloc( void *pvAddress, size_t xSize, void *pvCallSite )
+{
+UBaseType_t uxBucket, uxRecord, uxOwner;
+size_t xBucketLimit = ( size_t ) 1 << heapmonitorHISTOGRAM_MIN_SIZE_LOG2;
+
+	for( uxBucket = 0; uxBucket < ( heapmonitorHISTOGRAM_BUCKETS - 1 ); uxBucket++ )
+	{
+		if( xSize <= xBucketLimit )
+		{
+			break;
+		}
+
+		xBucketLimit <<= 1;
+	}
+
+	xSizeHistogram[ uxBucket ]++;
+
+	if( pvAddress == NULL )
+	{
+		xFailedAllocations++;
+	}
+	else
+	{
+		for( uxRecord = 0; uxRecord < heapmonitorMAX_RECORDS; uxRecord++ )
+		{
+			if( xRecords[ uxRecord ].pvAddress == NULL )
+			{
+				break;
+			}
+		}
+
+		uxOwner = prvFindOwner();
+
+		if( ( uxRecord < heapmonitorMAX_RECORDS ) && ( uxOwner != heapmonitorNO_OWNER ) )
+		{
+			xRecords[ uxRecord ].pvAddress = pvAddress;
+			xRecords[ uxRecord ].pvCallSite = pvCallSite;
+			xRecords[ uxRecord ].xSize = xSize;
+			xRecords[ uxRecord ].uxOwner = uxOwner;
+
+			xOwners[ uxOwner ].xLiveBytes += xSize;
+			xOwners[ uxOwner ].xAllocations++;
+
+			if( xOwners[ uxOwner ].xLiveBytes > xOwners[ uxOwner ].xPeakBytes )
+			{
+				xOwners[ uxOwner ].xPeakBytes = xOwners[ uxOwner ].xLiveBytes;
+			}
+		}
+		else
+		{
+			xUntrackedAllocations++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vHeapMonitorRecordFree( void *pvAddress )
+{
+UBaseType_t uxRecord;
+
+	/* A block allocated while the tables were full is not found, and there is
+	nothing to undo for it. */
+	for( uxRecord = 0; uxRecord < heapmonitorMAX_RECORDS; uxRecord++ )
+	{
+		if( xRecords[ uxRecord ].pvAddress == pvAddress )
+		{
+			xOwners[ xRecords[ uxRecord ].uxOwner ].xLiveBytes -= xRecords[ uxRecord ].xSize;
+			xRecords[ uxRecord ].pvAddress = NULL;
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindOwner( void )
+{
+TaskHandle_t xTask = NULL;
+const char *pcName = "(init)";
+UBaseType_t x, uxReturn = heapmonitorNO_OWNER, uxUnused = heapmonitorNO_OWNER;
+
+	if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+		pcName = pcTaskGetName( xTask );
+	}
+
+	for( x = 0; x < heapmonitorMAX_OWNERS; x++ )
+	{
+		if( xOwners[ x ].cName[ 0 ] == '\0' )
+		{
+			/* Prefer an entry that has never been used to one that is only
+			idle now. */
+			if( ( uxUnused == heapmonitorNO_OWNER ) || ( xOwners[ uxUnused ].cName[ 0 ] != '\0' ) )
+			{
+				uxUnused = x;
+			}
+		}
+		else if( xOwners[ x ].xTask == xTask )
+		{
+			uxReturn = x;
+			break;
+		}
+		else if( ( xOwners[ x ].xLiveBytes == 0U ) && ( uxUnused == heapmonitorNO_OWNER ) )
+		{
+			uxUnused = x;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( uxReturn == heapmonitorNO_OWNER )
+	{
+		uxReturn = uxUnused;
+
+		if( uxReturn != heapmonitorNO_OWNER )
+		{
+			xOwners[ uxReturn ].xTask = xTask;
+			xOwners[ uxReturn ].xPeakBytes = 0;
+			xOwners[ uxReturn ].xAllocations = 0;
+		}
+	}
+
+	if( ( uxReturn != heapmonitorNO_OWNER ) && ( xOwners[ uxReturn ].xLiveBytes == 0U ) )
+	{
+		/* A deleted task's handle can be given to a new task, so the name is
+		taken again whenever the entry holds nothing. */
+		strncpy( xOwners[ uxReturn ].cName, pcName, configMAX_TASK_NAME_LEN - 1 );
+		xOwners[ uxReturn ].cName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapMonitorPrint( void )
+{
+/* Static, to keep them off the stack of the stats task, which can be of the
+minimal size. */
+static HeapStats_t xHeapStats;
+static HeapMonitorOwner_t xOwner;
+static HeapMonitorRecord_t xRecord;
+static char cLine[ heapmonitorLINE_LENGTH ];
+size_t xCount, xFailed, xUntracked;
+UBaseType_t x;
+unsigned long ulFragmentation = 0;
+
+	vPortGetHeapStats( &xHeapStats );
+
+	vTaskSuspendAll();
+	{
+		xFailed = xFailedAllocations;
+		xUntracked = xUntrackedAllocations;
+	}
+	( void ) xTaskResumeAll();
+
+	if( xHeapStats.xAvailableHeapSpaceInBytes > 0U )
+	{
+		ulFragmentation = 100UL - ( unsigned long ) ( ( xHeapStats.xSizeOfLargestFreeBlockInBytes * 100U ) / xHeapStats.xAvailableHeapSpaceInBytes );
+	}
+
+	snprintf( cLine, sizeof( cLine ), "Heap: %lu free, %lu least, %lu largest, %lu%% frag\r\n",
+			  ( unsigned long ) xHeapStats.xAvailableHeapSpaceInBytes,
+			  ( unsigned long ) xHeapStats.xMinimumEverFreeBytesRemaining,
+			  ( unsigned long ) xHeapStats.xSizeOfLargestFreeBlockInBytes,
+			  ulFragmentation );
+	prvPrint( cLine );
+
+	snprintf( cLine, sizeof( cLine ), "Heap: %lu failed, %lu untracked\r\n", ( unsigned long ) xFailed, ( unsigned long ) xUntracked );
+	prvPrint( cLine );
+
+	/* Each entry is copied out with the scheduler suspended, then printed
+	with it running, as the UART can take several ticks. */
+	prvPrint( "Owner\t\tLive\tPeak\tAllocs\r\n" );
+
+	for( x = 0; x < heapmonitorMAX_OWNERS; x++ )
+	{
+		vTaskSuspendAll();
+		{
+			xOwner = xOwners[ x ];
+		}
+		( void ) xTaskResumeAll();
+
+		if( xOwner.cName[ 0 ] != '\0' )
+		{
+			snprintf( cLine, sizeof( cLine ), "%s\t\t%lu\t%lu\t%lu\r\n",
+					  xOwner.cName,
+					  ( unsigned long ) xOwner.xLiveBytes,
+					  ( unsigned long ) xOwner.xPeakBytes,
+					  ( unsigned long ) xOwner.xAllocations );
+			prvPrint( cLine );
+		}
+	}
+
+	prvPrint( "Size\tRequests\r\n" );
+
+	for( x = 0; x < heapmonitorHISTOGRAM_BUCKETS; x++ )
+	{
+		vTaskSuspendAll();
+		{
+			xCount = xSizeHistogram[ x ];
+		}
+		( void ) xTaskResumeAll();
+
+		if( x < ( heapmonitorHISTOGRAM_BUCKETS - 1 ) )
+		{
+			snprintf( cLine, sizeof( cLine ), "<=%lu\t%lu\r\n", 1UL << ( x + heapmonitorHISTOGRAM_MIN_SIZE_LOG2 ), ( unsigned long ) xCount );
+		}
+		else
+		{
+			snprintf( cLine, sizeof( cLine ), ">%lu\t%lu\r\n", 1UL << heapmonitorHISTOGRAM_MAX_SIZE_LOG2, ( unsigned long ) xCount );
+		}
+
+		prvPrint( cLine );
+	}
+
+	#if( heapmonitorPRINT_BLOCKS == 1 )
+	{
+		prvPrint( "Block\tSize\tOwner\tCall site\r\n" );
+
+		for( x = 0; x < heapmonitorMAX_RECORDS; x++ )
+		{
+			vTaskSuspendAll();
+			{
+				xRecord = xRecords[ x ];
+
+				if( xRecord.pvAddress != NULL )
+				{
+					xOwner = xOwners[ xRecord.uxOwner ];
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( xRecord.pvAddress != NULL )
+			{
+				snprintf( cLine, sizeof( cLine ), "%p\t%lu\t%s\t%p\r\n",
+						  xRecord.pvAddress,
+						  ( unsigned long ) xRecord.xSize,
+						  xOwner.cName,
+						  xRecord.pvCallSite );
+				prvPrint( cLine );
+			}
+		}
+	}
+	#endif /* heapmonitorPRINT_BLOCKS */
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrint( const char *pcString )
+{
+unsigned short usLength = 0;
+
+	while( pcString[ usLength ] != '\0' )
+	{
+		usLength++;
+	}
+
+	/* Wait for room rather than drop the line. */
+	( void ) xSerialWrite( ( const signed char * ) pcString, usLength, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_MONITOR */
+
@@ -0,0 +1,591 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	LOGGER - see logger.h.
+*/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The logger is only built when it is enabled in FreeRTOSConfig.h. */
+#if( configUSE_LOGGER == 1 )
+
+/* Demo application includes. */
+#include "serial.h"
+#include "logger.h"
+
+/*-----------------------------------------------------------*/
+
+#define loggerINDEX_MASK				( loggerBUFFER_RECORDS - 1UL )
+
+/* The producer table entry for interrupts, and for tasks once it is full. */
+#define loggerOTHER_PRODUCER			( 0U )
+
+/* As many records as fit in one message to the serial driver. */
+#define loggerFRAME_RECORDS				( ( serTX_BUFFER_SIZE - loggerFRAME_HEADER_BYTES ) / loggerRECORD_BYTES )
+#define loggerFRAME_BYTES				( loggerFRAME_HEADER_BYTES + ( loggerFRAME_RECORDS * loggerRECORD_BYTES ) )
+
+/* The timestamps are the tick count. */
+#define loggerTIMESTAMP_HZ				( ( uint32_t ) configTICK_RATE_HZ )
+
+/*-----------------------------------------------------------*/
+
+typedef struct LOG_PRODUCER
+{
+	TaskHandle_t xTask;						/*<< NULL if the entry is not in use. */
+	char cName[ configMAX_TASK_NAME_LEN ];	/*<< Copied, so it outlives the task. */
+	uint32_t ulDropped;						/*<< Records dropped in total. */
+	uint32_t ulReported;					/*<< Of those, the number the drain task has reported. */
+	BaseType_t xNameSent;					/*<< pdTRUE once the name has been sent in a binary frame. */
+	BaseType_t xForgotten;					/*<< pdTRUE from vLoggerForgetTask() until the drain task frees the entry. */
+} LogProducer_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that drains the ring buffer over UART1.
+ */
+static void prvLoggerTask( void *pvParameters );
+
+/*
+ * Find, or take, the producer table entry of the calling task.  Called in a
+ * critical section.
+ */
+static uint8_t prvFindProducer( void );
+
+/*
+ * Write a record into the ring buffer, or count it as dropped if it is full.
+ * Called in a critical section.  Returns pdTRUE if the ring buffer was empty,
+ * so the drain task has to be woken.
+ */
+static BaseType_t prvWriteRecord( uint8_t ucLevel, uint16_t usFormat, uint8_t ucProducer, uint32_t ulTimestamp, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, BaseType_t *pxWritten );
+
+/*
+ * Take the oldest record from the ring buffer.  Returns pdFALSE if it is
+ * empty.
+ */
+static BaseType_t prvTakeRecord( LogRecord_t *pxRecord );
+
+/*
+ * Send a record, as a line of text or by adding it to the binary frame.
+ */
+static void prvSendRecord( const LogRecord_t *pxRecord );
+
+/*
+ * Send a record for each producer whose drops have not been reported yet.
+ */
+static void prvReportDrops( uint32_t ulTimestamp );
+
+/*
+ * Free the entries of the tasks given to vLoggerForgetTask(), once none of
+ * their records are left to send.
+ */
+static void prvFreeForgotten( void );
+
+#if( loggerBINARY == 1 )
+
+	/*
+	 * Send the binary frame, if there is anything in it.
+	 */
+	static void prvFlushFrame( void );
+
+	/*
+	 * Append a 16 or 32 bit value to the frame, little endian.
+	 */
+	static unsigned char *prvPut16( unsigned char *pucFrame, uint16_t usValue );
+	static unsigned char *prvPut32( unsigned char *pucFrame, uint32_t ulValue );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( loggerBINARY == 0 )
+
+	/* The format strings, in the order of the names in LogFormat_t.  They stay
+	on the host when the records are sent as binary. */
+	#define loggerFORMAT( xName, pcFormat )	pcFormat,
+
+	static const char * const pcLoggerFormats[ loggerFORMAT_COUNT + 1 ] =
+	{
+		#include loggerFORMATS_HEADER
+		NULL
+	};
+
+	#undef loggerFORMAT
+
+#endif
+
+static LogRecord_t xLoggerBuffer[ loggerBUFFER_RECORDS ];
+
+/* The number of records ever written, and ever taken by the drain task.  Only
+the low bits index the ring buffer. */
+static volatile uint32_t ulLoggerHead = 0;
+static volatile uint32_t ulLoggerTail = 0;
+
+static LogProducer_t xProducers[ loggerMAX_PRODUCERS ] = { { NULL, "other", 0UL, 0UL, pdFALSE, pdFALSE } };
+static volatile uint8_t ucLoggerLevel = loggerLEVEL_DEBUG;
+static TaskHandle_t xLoggerTask = NULL;
+
+#if( loggerBINARY == 1 )
+
+	/* The frame is built here rather than on the stack of the drain task. */
+	static unsigned char ucLoggerFrame[ loggerFRAME_BYTES ];
+	static uint16_t usFrameRecords = 0;
+
+#else
+
+	static char cLoggerLine[ loggerLINE_LENGTH ];
+	static const char cLevels[] = "DIWE";
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vLoggerStart( UBaseType_t uxPriority )
+{
+	xTaskCreate( prvLoggerTask, "Logger", loggerSTACK_SIZE, NULL, uxPriority, &xLoggerTask );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLoggerPrint( uint8_t ucLevel, uint16_t usFormat, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2 )
+{
+BaseType_t xWritten = pdFALSE, xWake = pdFALSE;
+
+	if( ucLevel >= ucLoggerLevel )
+	{
+		taskENTER_CRITICAL();
+		{
+			xWake = prvWriteRecord( ucLevel, usFormat, prvFindProducer(), ( uint32_t ) xTaskGetTickCount(), ulArg0, ulArg1, ulArg2, &xWritten );
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xWake != pdFALSE ) && ( xLoggerTask != NULL ) )
+		{
+			xTaskNotifyGive( xLoggerTask );
+		}
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLoggerPrintFromISR( uint8_t ucLevel, uint16_t usFormat, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xWritten = pdFALSE, xWake = pdFALSE;
+UBaseType_t uxSavedInterruptStatus;
+
+	if( ucLevel >= ucLoggerLevel )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xWake = prvWriteRecord( ucLevel, usFormat, loggerOTHER_PRODUCER, ( uint32_t ) xTaskGetTickCountFromISR(), ulArg0, ulArg1, ulArg2, &xWritten );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xWake != pdFALSE ) && ( xLoggerTask != NULL ) )
+		{
+			vTaskNotifyGiveFromISR( xLoggerTask, pxHigherPriorityTaskWoken );
+		}
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+void vLoggerSetLevel( uint8_t ucLevel )
+{
+	ucLoggerLevel = ucLevel;
+}
+/*-----------------------------------------------------------*/
+
+uint8_t ucLoggerGetLevel( void )
+{
+	return ucLoggerLevel;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulLoggerGetDropped( TaskHandle_t xTask )
+{
+UBaseType_t x;
+
+	if( xTask == NULL )
+	{
+		return xProducers[ loggerOTHER_PRODUCER ].ulDropped;
+	}
+
+	for( x = loggerOTHER_PRODUCER + 1U; x < loggerMAX_PRODUCERS; x++ )
+	{
+		if( ( xProducers[ x ].xTask == xTask ) && ( xProducers[ x ].xForgotten == pdFALSE ) )
+		{
+			return xProducers[ x ].ulDropped;
+		}
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vLoggerForgetTask( TaskHandle_t xTask )
+{
+UBaseType_t x;
+
+	taskENTER_CRITICAL();
+	{
+		for( x = loggerOTHER_PRODUCER + 1U; x < loggerMAX_PRODUCERS; x++ )
+		{
+			if( ( xProducers[ x ].xTask == xTask ) && ( xProducers[ x ].xForgotten == pdFALSE ) )
+			{
+				/* The name is kept for the records still to be sent.  The
+				drain task frees the entry once they have gone. */
+				xProducers[ x ].xForgotten = pdTRUE;
+				break;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xLoggerTask != NULL )
+	{
+		xTaskNotifyGive( xLoggerTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvFindProducer( void )
+{
+TaskHandle_t xTask = xTaskGetCurrentTaskHandle();
+const char *pcName;
+UBaseType_t x, xFree = loggerOTHER_PRODUCER;
+
+	if( xTask == NULL )
+	{
+		/* No task has been created yet. */
+		return loggerOTHER_PRODUCER;
+	}
+
+	for( x = loggerOTHER_PRODUCER + 1U; x < loggerMAX_PRODUCERS; x++ )
+	{
+		if( ( xProducers[ x ].xTask == xTask ) && ( xProducers[ x ].xForgotten == pdFALSE ) )
+		{
+			return ( uint8_t ) x;
+		}
+
+		/* Freed entries leave gaps, so the whole table is searched before
+		the first free entry is taken. */
+		if( ( xProducers[ x ].xTask == NULL ) && ( xFree == loggerOTHER_PRODUCER ) )
+		{
+			xFree = x;
+		}
+	}
+
+	if( xFree != loggerOTHER_PRODUCER )
+	{
+		/* The task has not logged before - take the free entry. */
+		pcName = pcTaskGetName( xTask );
+		strncpy( xProducers[ xFree ].cName, pcName, configMAX_TASK_NAME_LEN );
+		xProducers[ xFree ].xTask = xTask;
+	}
+
+	return ( uint8_t ) xFree;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteRecord( uint8_t ucLevel, uint16_t usFormat, uint8_t ucProducer, uint32_t ulTimestamp, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, BaseType_t *pxWritten )
+{
+LogRecord_t *pxRecord;
+uint32_t ulHead = ulLoggerHead;
+BaseType_t xWasEmpty = ( ulHead == ulLoggerTail ) ? pdTRUE : pdFALSE;
+
+	if( ( ulHead - ulLoggerTail ) >= loggerBUFFER_RECORDS )
+	{
+		xProducers[ ucProducer ].ulDropped++;
+		*pxWritten = pdFALSE;
+	}
+	else
+	{
+		pxRecord = &( xLoggerBuffer[ ulHead & loggerINDEX_MASK ] );
+		pxRecord->ulTimestamp = ulTimestamp;
+		pxRecord->usFormat = usFormat;
+		pxRecord->ucLevel = ucLevel;
+		pxRecord->ucProducer = ucProducer;
+		pxRecord->ulArgs[ 0 ] = ulArg0;
+		pxRecord->ulArgs[ 1 ] = ulArg1;
+		pxRecord->ulArgs[ 2 ] = ulArg2;
+
+		ulLoggerHead = ulHead + 1UL;
+		*pxWritten = pdTRUE;
+	}
+
+	return xWasEmpty;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeRecord( LogRecord_t *pxRecord )
+{
+BaseType_t xTaken = pdFALSE;
+
+	taskENTER_CRITICAL();
+	{
+		if( ulLoggerTail != ulLoggerHead )
+		{
+			*pxRecord = xLoggerBuffer[ ulLoggerTail & loggerINDEX_MASK ];
+			ulLoggerTail++;
+			xTaken = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xTaken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoggerTask( void *pvParameters )
+{
+LogRecord_t xRecord;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Woken by the call that writes into an empty ring buffer. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		while( prvTakeRecord( &xRecord ) != pdFALSE )
+		{
+			prvSendRecord( &xRecord );
+		}
+
+		prvReportDrops( ( uint32_t ) xTaskGetTickCount() );
+		prvFreeForgotten();
+
+		#if( loggerBINARY == 1 )
+		{
+			prvFlushFrame();
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReportDrops( uint32_t ulTimestamp )
+{
+LogRecord_t xRecord;
+uint32_t ulDropped;
+UBaseType_t x;
+
+	for( x = 0; x < loggerMAX_PRODUCERS; x++ )
+	{
+		/* Read once - it is written by the log calls. */
+		ulDropped = xProducers[ x ].ulDropped;
+
+		if( ulDropped != xProducers[ x ].ulReported )
+		{
+			xRecord.ulTimestamp = ulTimestamp;
+			xRecord.usFormat = loggerRECORD_DROPPED;
+			xRecord.ucLevel = loggerLEVEL_WARNING;
+			xRecord.ucProducer = ( uint8_t ) x;
+			xRecord.ulArgs[ 0 ] = ulDropped - xProducers[ x ].ulReported;
+			xRecord.ulArgs[ 1 ] = ulDropped;
+			xRecord.ulArgs[ 2 ] = 0;
+			prvSendRecord( &xRecord );
+
+			xProducers[ x ].ulReported = ulDropped;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeForgotten( void )
+{
+LogProducer_t *pxProducer;
+UBaseType_t x;
+
+	taskENTER_CRITICAL();
+	{
+		/* A forgotten task logs no more, so once the ring buffer is empty
+		and its drops are reported nothing refers to its entry. */
+		if( ulLoggerTail == ulLoggerHead )
+		{
+			for( x = loggerOTHER_PRODUCER + 1U; x < loggerMAX_PRODUCERS; x++ )
+			{
+				pxProducer = &( xProducers[ x ] );
+
+				if( ( pxProducer->xForgotten != pdFALSE ) && ( pxProducer->ulDropped == pxProducer->ulReported ) )
+				{
+					pxProducer->xTask = NULL;
+					pxProducer->ulDropped = 0;
+					pxProducer->ulReported = 0;
+					pxProducer->xNameSent = pdFALSE;
+					pxProducer->xForgotten = pdFALSE;
+				}
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if( loggerBINARY == 0 )
+
+	static void prvSendRecord( const LogRecord_t *pxRecord )
+	{
+	const char *pcName;
+	int iLength;
+	unsigned short usLength;
+
+		pcName = xProducers[ pxRecord->ucProducer ].cName;
+
+		iLength = snprintf( cLoggerLine, sizeof( cLoggerLine ), "%8lu %c %-*.*s ",
+							( unsigned long ) pxRecord->ulTimestamp,
+							cLevels[ pxRecord->ucLevel & 0x03U ],
+							( int ) configMAX_TASK_NAME_LEN, ( int ) configMAX_TASK_NAME_LEN, pcName );
+
+		if( pxRecord->usFormat == loggerRECORD_DROPPED )
+		{
+			iLength += snprintf( &( cLoggerLine[ iLength ] ), sizeof( cLoggerLine ) - ( size_t ) iLength, "dropped %lu records, %lu in total",
+								 ( unsigned long ) pxRecord->ulArgs[ 0 ], ( unsigned long ) pxRecord->ulArgs[ 1 ] );
+		}
+		else if( pxRecord->usFormat < ( uint16_t ) loggerFORMAT_COUNT )
+		{
+			iLength += snprintf( &( cLoggerLine[ iLength ] ), sizeof( cLoggerLine ) - ( size_t ) iLength, pcLoggerFormats[ pxRecord->usFormat ],
+								 ( unsigned long ) pxRecord->ulArgs[ 0 ], ( unsigned long ) pxRecord->ulArgs[ 1 ], ( unsigned long ) pxRecord->ulArgs[ 2 ] );
+		}
+		else
+		{
+			iLength += snprintf( &( cLoggerLine[ iLength ] ), sizeof( cLoggerLine ) - ( size_t ) iLength, "unknown format %u", ( unsigned ) pxRecord->usFormat );
+		}
+
+		/* A message too long for the line is cut short, keeping room for the
+		line ending. */
+		if( iLength > ( int ) ( sizeof( cLoggerLine ) - 3U ) )
+		{
+			iLength = ( int ) ( sizeof( cLoggerLine ) - 3U );
+		}
+
+		cLoggerLine[ iLength++ ] = '\r';
+		cLoggerLine[ iLength++ ] = '\n';
+		usLength = ( unsigned short ) iLength;
+
+		( void ) xSerialWrite( ( const signed char * ) cLoggerLine, usLength, portMAX_DELAY );
+	}
+
+#else /* loggerBINARY */
+
+	static void prvSendRecord( const LogRecord_t *pxRecord )
+	{
+	LogProducer_t *pxProducer = &( xProducers[ pxRecord->ucProducer ] );
+	LogRecord_t xName;
+	char *pcName;
+	unsigned char *pucFrame;
+	UBaseType_t x;
+
+		/* A producer's name goes ahead of its first record. */
+		if( pxProducer->xNameSent == pdFALSE )
+		{
+			pxProducer->xNameSent = pdTRUE;
+
+			memset( &xName, 0, sizeof( xName ) );
+			xName.ulTimestamp = pxRecord->ulTimestamp;
+			xName.usFormat = loggerRECORD_PRODUCER_NAME;
+			xName.ucProducer = pxRecord->ucProducer;
+			/* Names longer than the arguments are cut short. */
+			pcName = ( char * ) xName.ulArgs;
+			strncpy( pcName, pxProducer->cName, ( configMAX_TASK_NAME_LEN < sizeof( xName.ulArgs ) ) ? configMAX_TASK_NAME_LEN : sizeof( xName.ulArgs ) );
+			prvSendRecord( &xName );
+		}
+
+		if( usFrameRecords == loggerFRAME_RECORDS )
+		{
+			prvFlushFrame();
+		}
+
+		pucFrame = &( ucLoggerFrame[ loggerFRAME_HEADER_BYTES + ( usFrameRecords * loggerRECORD_BYTES ) ] );
+		pucFrame = prvPut32( pucFrame, pxRecord->ulTimestamp );
+		pucFrame = prvPut16( pucFrame, pxRecord->usFormat );
+		*pucFrame++ = pxRecord->ucLevel;
+		*pucFrame++ = pxRecord->ucProducer;
+
+		if( pxRecord->usFormat == loggerRECORD_PRODUCER_NAME )
+		{
+			/* The name is sent as it is, not as numbers. */
+			memcpy( pucFrame, pxRecord->ulArgs, sizeof( pxRecord->ulArgs ) );
+		}
+		else
+		{
+			for( x = 0; x < loggerMAX_ARGS; x++ )
+			{
+				pucFrame = prvPut32( pucFrame, pxRecord->ulArgs[ x ] );
+			}
+		}
+
+		usFrameRecords++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvFlushFrame( void )
+	{
+	unsigned char *pucFrame;
+
+		if( usFrameRecords > 0 )
+		{
+			pucFrame = prvPut32( ucLoggerFrame, loggerFRAME_SYNC );
+			pucFrame = prvPut32( pucFrame, loggerTIMESTAMP_HZ );
+			pucFrame = prvPut16( pucFrame, usFrameRecords );
+			( void ) prvPut16( pucFrame, 0 );
+
+			( void ) xSerialWrite( ( const signed char * ) ucLoggerFrame, ( unsigned short ) ( loggerFRAME_HEADER_BYTES + ( usFrameRecords * loggerRECORD_BYTES ) ), portMAX_DELAY );
+			usFrameRecords = 0;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned char *prvPut16( unsigned char *pucFrame, uint16_t usValue )
+	{
+		pucFrame[ 0 ] = ( unsigned char ) ( usValue & 0xffU );
+		pucFrame[ 1 ] = ( unsigned char ) ( usValue >> 8 );
+
+		return pucFrame + 2;
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned char *prvPut32( unsigned char *pucFrame, uint32_t ulValue )
+	{
+		pucFrame = prvPut16( pucFrame, ( uint16_t ) ( ulValue & 0xffffUL ) );
+
+		return prvPut16( pucFrame, ( uint16_t ) ( ulValue >> 16 ) );
+	}
+
+#endif /* loggerBINARY */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_LOGGER */
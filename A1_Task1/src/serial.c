@@ -24,21 +24,48 @@
  *
  * 1 tab == 4 spaces!
  */
-
-
 /* 
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0. 
-
-	Note this driver is used to test the FreeRTOS port.  It is NOT intended to
-	be an example of an efficient implementation!
+	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0 AND UART1. 
+
+	Each UART has a port of its own - its ring buffers, semaphores and
+	interrupt handler - so the two run independently at full rate.  A port is
+	opened with xSerialPortInit(), which returns the xComPortHandle the
+	xSerialPort...() functions take.  UART1 is always available.  UART0 is
+	only when serUSE_UART0 is set to 1, as its buffers cost RAM.  The
+	functions without a handle, and xSerialPortInitMinimal(), use UART1.
+
+	Characters to transmit are copied into a ring buffer of serTX_BUFFER_SIZE
+	bytes.  Each THRE interrupt moves up to serTX_FIFO_DEPTH of them into the
+	UART's transmit FIFO, so a message costs one interrupt per 16 characters
+	rather than one per character.  When the ring runs dry the transmitter goes
+	idle, and the next write primes the FIFO itself.
+
+	A write is copied into the ring in one critical section, so messages from
+	several tasks are never interleaved.  Writers that find the ring full can
+	block until the interrupt has made room - they wait on a binary semaphore
+	that the interrupt gives only while somebody is waiting, and a writer that
+	gets in passes it on to the next.
+
+	Instead of having a message copied in, a task can reserve room in the ring
+	with xSerialPortReserve(), build the message there itself, and commit it.
+	Other writers wait while a reservation is held, so nothing is interleaved
+	with it, but the interrupt keeps sending what was queued before it.
+
+	Received characters collect in the UART's receive FIFO until
+	serRX_TRIGGER_LEVEL of them have arrived, or the line has been quiet for
+	about four character times, then the interrupt moves all of them into a
+	ring buffer of serRX_BUFFER_SIZE bytes.  Readers block on a second
+	semaphore in the same way as the writers.
 */
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "semphr.h"
 #include "task.h"
 
 /* Demo application includes. */
@@ -47,23 +74,28 @@
 /*-----------------------------------------------------------*/
 
 /* Constants to setup I/O */
-#define mainTX_ENABLE		( ( unsigned long ) 0x00010000 )	/* UART1. */
-#define mainRX_ENABLE		( ( unsigned long ) 0x00040000 ) 	/* UART1. */
+#define serU0_PINSEL					( ( unsigned long ) 0x00000005 )	/* TXD0 and RXD0. */
+#define serU1_PINSEL					( ( unsigned long ) 0x00050000 )	/* TXD1 and RXD1. */
 
 /* Constants to setup and access the UART. */
 #define serDLAB							( ( unsigned char ) 0x80 )
 #define serENABLE_INTERRUPTS			( ( unsigned char ) 0x03 )
-#define serNO_PARITY					( ( unsigned char ) 0x00 )
-#define ser1_STOP_BIT					( ( unsigned char ) 0x00 )
-#define ser8_BIT_CHARS					( ( unsigned char ) 0x03 )
+#define serLCR_STOP_BITS_2				( ( unsigned char ) 0x04 )
+#define serLCR_PARITY_ENABLE			( ( unsigned char ) 0x08 )
+#define serLCR_PARITY_SHIFT				( 4 )
 #define serFIFO_ON						( ( unsigned char ) 0x01 )
 #define serCLEAR_FIFO					( ( unsigned char ) 0x06 )
+#define serLSR_RX_DATA_READY			( ( unsigned char ) 0x01 )
 #define serWANTED_CLOCK_SCALING			( ( unsigned long ) 16 )
+#define serMAX_DIVISOR					( ( unsigned long ) 0xffff )
 
-/* Constants to setup and access the VIC. */
+/* Constants to setup and access the VIC.  UART1 uses vectored slot 1 and
+UART0 slot 3 - slot 0 is the tick and slot 2 Timer1. */
+#define serU0VIC_CHANNEL				( ( unsigned long ) 0x0006 )
+#define serU0VIC_CHANNEL_BIT			( ( unsigned long ) 0x0040 )
 #define serU1VIC_CHANNEL				( ( unsigned long ) 0x0007 )
 #define serU1VIC_CHANNEL_BIT			( ( unsigned long ) 0x0080 )
-#define serU1VIC_ENABLE					( ( unsigned long ) 0x0020 )
+#define serVIC_ENABLE					( ( unsigned long ) 0x0020 )
 
 /* Constant to access the VIC. */
 #define serCLEAR_VIC_INTERRUPT			( ( unsigned long ) 0 )
@@ -76,116 +108,776 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* The depth of the UART's transmit FIFO - the most that can be written to THR
+each time it empties. */
+#ifndef serTX_FIFO_DEPTH
+	#define serTX_FIFO_DEPTH			( 16U )
+#endif
+
+/* The FCR bits that select serRX_TRIGGER_LEVEL. */
+#if( serRX_TRIGGER_LEVEL == 1 )
+	#define serRX_TRIGGER_BITS			( ( unsigned char ) 0x00 )
+#elif( serRX_TRIGGER_LEVEL == 4 )
+	#define serRX_TRIGGER_BITS			( ( unsigned char ) 0x40 )
+#elif( serRX_TRIGGER_LEVEL == 8 )
+	#define serRX_TRIGGER_BITS			( ( unsigned char ) 0x80 )
+#elif( serRX_TRIGGER_LEVEL == 14 )
+	#define serRX_TRIGGER_BITS			( ( unsigned char ) 0xc0 )
+#else
+	#error serRX_TRIGGER_LEVEL must be 1, 4, 8 or 14
+#endif
+
+/* A register of the port's UART, such as serREG( pxPort, THR ) for U0THR or
+U1THR.  The register name is only evaluated for the UART selected, so an access
+has the same effect as naming the register directly. */
+#define serREG( pxPort, xReg )	( *( ( ( pxPort )->ucUart == 0U ) ? &( U0##xReg ) : &( U1##xReg ) ) )
+
 /*-----------------------------------------------------------*/
-unsigned char receivedChar;
-unsigned char isNewCharAvailable = 0;
 
-unsigned char txBuffer[200];
-unsigned char txDataSizeToSend;
-unsigned char txDataSizeLeftToSend;
+typedef struct SERIAL_PORT
+{
+	/* 0 for UART0, 1 for UART1. */
+	unsigned char ucUart;
+
+	/* The characters waiting to be transmitted.  Written by tasks at
+	usTxHead, read by the interrupt at usTxTail.  Both only change with
+	interrupts disabled. */
+	unsigned char ucTxBuffer[ serTX_BUFFER_SIZE ];
+	volatile unsigned short usTxHead;
+	volatile unsigned short usTxTail;
+	volatile unsigned short usTxCount;
+
+	/* pdTRUE while the FIFO is being refilled from THRE interrupts.  pdFALSE
+	once a THRE interrupt has found the ring empty, after which the next write
+	has to prime the FIFO. */
+	volatile portBASE_TYPE xTxActive;
+
+	/* The length of the room reserved at usTxHead by xSerialPortReserve(),
+	or 0.  No other write is queued while it is held. */
+	volatile unsigned short usTxReserved;
+
+	/* Given by the interrupt when it has made room in the ring, or finished
+	transmitting, while uxTxWaiters tasks are blocked on it. */
+	SemaphoreHandle_t xTxEvent;
+	volatile UBaseType_t uxTxWaiters;
+
+	/* The characters received and not yet read.  Written by the interrupt at
+	usRxHead, read by tasks at usRxTail. */
+	unsigned char ucRxBuffer[ serRX_BUFFER_SIZE ];
+	volatile unsigned short usRxHead;
+	volatile unsigned short usRxTail;
+	volatile unsigned short usRxCount;
+
+	/* Given by the interrupt when characters have been received while
+	uxRxWaiters tasks are blocked on it. */
+	SemaphoreHandle_t xRxEvent;
+	volatile UBaseType_t uxRxWaiters;
+} SerialPort_t;
+
+static SerialPort_t xUart1Port;
+
+#if( serUSE_UART0 == 1 )
+	static SerialPort_t xUart0Port;
+#endif
+
+/* The rates of eBaud, in order. */
+static const unsigned long ulBaudRates[] =
+{
+	50UL, 75UL, 110UL, 134UL, 150UL, 200UL, 300UL, 600UL, 1200UL, 1800UL,
+	2400UL, 4800UL, 9600UL, 19200UL, 38400UL, 57600UL, 115200UL
+};
+
 /*
- * The asm wrapper for the interrupt service routine.
+ * The asm wrappers for the interrupt service routines.
  */
 extern void vUART_ISREntry( void );
+#if( serUSE_UART0 == 1 )
+	extern void vUART0_ISREntry( void );
+#endif
 
 /* 
- * The C function called from the asm wrapper. 
+ * The C functions called from the asm wrappers - vUART_ISRHandler() for UART1
+ * and vUART0_ISRHandler() for UART0.
  */
 void vUART_ISRHandler( void );
+#if( serUSE_UART0 == 1 )
+	void vUART0_ISRHandler( void );
+#endif
+
+/*
+ * Set up a port's UART for ulWantedBaud and the ucLineControl format, and
+ * enable its interrupts.  Returns NULL if the baud rate cannot be set.
+ */
+static xComPortHandle prvPortInit( SerialPort_t *pxPort, unsigned long ulWantedBaud, unsigned char ucLineControl );
+
+/*
+ * Service every interrupt pending on a port's UART.  Returns whether a task
+ * of a higher priority than the one interrupted was woken.
+ */
+static portBASE_TYPE prvHandleInterrupt( SerialPort_t *pxPort );
+
+/*
+ * Copy usLength characters into the ring, which must have room for them, and
+ * start the transmitter if it is idle.  Called with interrupts disabled.
+ */
+static void prvTxQueue( SerialPort_t *pxPort, const unsigned char *pucData, unsigned short usLength );
+
+/*
+ * Add usLength characters, already in the ring at usTxHead, to those to send,
+ * and start the transmitter if it is idle.  Called with interrupts disabled.
+ */
+static void prvTxCommit( SerialPort_t *pxPort, unsigned short usLength );
+
+/*
+ * Move as many characters from the ring to the FIFO as it can take after
+ * emptying.  Called with interrupts disabled.
+ */
+static void prvTxFill( SerialPort_t *pxPort );
+
+/*
+ * Move everything in the receive FIFO into the ring.  Called from the
+ * interrupt.
+ */
+static void prvRxDrain( SerialPort_t *pxPort );
+
+/*
+ * Copy up to usLength characters out of the ring.  Returns the number copied.
+ * Called with interrupts disabled.
+ */
+static unsigned short prvRxTake( SerialPort_t *pxPort, unsigned char *pucData, unsigned short usLength );
+
+/*
+ * Block on xEvent for up to xBlockTime.  The caller must have incremented
+ * *puxWaiters in the same critical section in which it found it had to wait.
+ */
+static void prvWaitForEvent( SemaphoreHandle_t xEvent, volatile UBaseType_t *puxWaiters, TickType_t xBlockTime );
+
+/*
+ * The interrupt gives xTxEvent once however many tasks are waiting.  Called by
+ * a task that is done to give it to the next, if there is room for it.
+ */
+static void prvTxPassOn( SerialPort_t *pxPort );
 
 /*-----------------------------------------------------------*/
 
-void xSerialPortInitMinimal( unsigned long ulWantedBaud)
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud )
 {
-    unsigned long ulDivisor, ulWantedClock;
-	
-	/* Configure the UART1 pins.  All other pins remain at their default of 0. */
-	PINSEL0 |= mainTX_ENABLE;
-	PINSEL0 |= mainRX_ENABLE;
+	/* UART1, eight data bits, no parity and one stop bit. */
+	return prvPortInit( &xUart1Port, ulWantedBaud, ( unsigned char ) serBITS_8 );
+}
+/*-----------------------------------------------------------*/
+
+xComPortHandle xSerialPortInit( eCOMPort ePort, eBaud eWantedBaud, eParity eWantedParity, eDataBits eWantedDataBits, eStopBits eWantedStopBits )
+{
+SerialPort_t *pxPort;
+unsigned char ucLineControl;
+
+	switch( ePort )
+	{
+		#if( serUSE_UART0 == 1 )
+			case serCOM1 :	pxPort = &xUart0Port;
+							break;
+		#endif
+
+		case serCOM2 :		pxPort = &xUart1Port;
+							break;
+
+		default :			/* There is no such UART, or it is not used. */
+							return NULL;
+	}
+
+	if( ( unsigned long ) eWantedBaud >= ( sizeof( ulBaudRates ) / sizeof( ulBaudRates[ 0 ] ) ) )
+	{
+		return NULL;
+	}
+
+	/* The data bits are the low two bits of LCR in the order of eDataBits.
+	The parity select bits above the enable are in the order of eParity after
+	serNO_PARITY. */
+	ucLineControl = ( unsigned char ) eWantedDataBits;
+
+	if( eWantedStopBits == serSTOP_2 )
+	{
+		ucLineControl |= serLCR_STOP_BITS_2;
+	}
+
+	if( eWantedParity != serNO_PARITY )
+	{
+		ucLineControl |= ( unsigned char ) ( serLCR_PARITY_ENABLE | ( ( eWantedParity - serODD_PARITY ) << serLCR_PARITY_SHIFT ) );
+	}
+
+	return prvPortInit( pxPort, ulBaudRates[ eWantedBaud ], ucLineControl );
+}
+/*-----------------------------------------------------------*/
+
+static xComPortHandle prvPortInit( SerialPort_t *pxPort, unsigned long ulWantedBaud, unsigned char ucLineControl )
+{
+unsigned long ulDivisor, ulWantedClock;
+
+	/* The ports are otherwise zero until opened, which selects UART0. */
+	pxPort->ucUart = ( pxPort == &xUart1Port ) ? 1U : 0U;
 
 	/* Setup the baud rate:  Calculate the divisor value. */
 	ulWantedClock = ulWantedBaud * serWANTED_CLOCK_SCALING;
 	ulDivisor = configCPU_CLOCK_HZ / ulWantedClock;
 
+	if( ( ulDivisor == 0 ) || ( ulDivisor > serMAX_DIVISOR ) )
+	{
+		return NULL;
+	}
+
+	/* Create the semaphores writers wait on when the transmit ring is full,
+	and readers when the receive ring is empty. */
+	if( pxPort->xTxEvent == NULL )
+	{
+		pxPort->xTxEvent = xSemaphoreCreateBinary();
+		pxPort->xRxEvent = xSemaphoreCreateBinary();
+
+		if( ( pxPort->xTxEvent == NULL ) || ( pxPort->xRxEvent == NULL ) )
+		{
+			/* Out of heap, or the heap is not set up yet (heap_5.c needs its
+			regions first).  Leave the port closed, so opening it can be tried
+			again. */
+			if( pxPort->xTxEvent != NULL )
+			{
+				vSemaphoreDelete( pxPort->xTxEvent );
+				pxPort->xTxEvent = NULL;
+			}
+
+			if( pxPort->xRxEvent != NULL )
+			{
+				vSemaphoreDelete( pxPort->xRxEvent );
+				pxPort->xRxEvent = NULL;
+			}
+
+			return NULL;
+		}
+	}
+
+	/* Configure the UART pins.  All other pins remain at their default of 0. */
+	PINSEL0 |= ( pxPort->ucUart == 0U ) ? serU0_PINSEL : serU1_PINSEL;
+
 	/* Set the DLAB bit so we can access the divisor. */
-	U1LCR |= serDLAB;
+	serREG( pxPort, LCR ) |= serDLAB;
 
 	/* Setup the divisor. */
-	U1DLL = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
+	serREG( pxPort, DLL ) = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
 	ulDivisor >>= 8;
-	U1DLM = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
+	serREG( pxPort, DLM ) = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
 
-	/* Turn on the FIFO's and clear the buffers. */
-	U1FCR = ( serFIFO_ON | serCLEAR_FIFO );
+	/* Turn on the FIFO's, clear the buffers and set the receive trigger
+	level. */
+	serREG( pxPort, FCR ) = ( serFIFO_ON | serCLEAR_FIFO | serRX_TRIGGER_BITS );
 
-	/* Setup transmission format. */
-	U1LCR = serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS;
+	/* Setup transmission format, which also clears DLAB. */
+	serREG( pxPort, LCR ) = ucLineControl;
 
 	/* Setup the VIC for the UART. */
-	VICIntSelect &= ~( serU1VIC_CHANNEL_BIT );
-	VICIntEnable |= serU1VIC_CHANNEL_BIT;
-	VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
-	VICVectCntl1 = serU1VIC_CHANNEL | serU1VIC_ENABLE;
+	#if( serUSE_UART0 == 1 )
+	{
+		if( pxPort->ucUart == 0U )
+		{
+			VICIntSelect &= ~( serU0VIC_CHANNEL_BIT );
+			VICIntEnable |= serU0VIC_CHANNEL_BIT;
+			VICVectAddr3 = ( unsigned long ) vUART0_ISREntry;
+			VICVectCntl3 = serU0VIC_CHANNEL | serVIC_ENABLE;
+		}
+	}
+	#endif
 
-	/* Enable UART0 interrupts. */
-	U1IER |= serENABLE_INTERRUPTS;
+	if( pxPort->ucUart == 1U )
+	{
+		VICIntSelect &= ~( serU1VIC_CHANNEL_BIT );
+		VICIntEnable |= serU1VIC_CHANNEL_BIT;
+		VICVectAddr1 = ( unsigned long ) vUART_ISREntry;
+		VICVectCntl1 = serU1VIC_CHANNEL | serVIC_ENABLE;
+	}
+
+	/* Enable the UART interrupts. */
+	serREG( pxPort, IER ) |= serENABLE_INTERRUPTS;
+
+	return ( xComPortHandle ) pxPort;
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
+signed portBASE_TYPE xSerialPortGetChar( xComPortHandle xPort, signed char *pcRxedChar )
 {
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+unsigned short usTaken;
+
 	/* Get the next character from the buffer.  Return false if no characters
-	are available, or arrive before xBlockTime expires. */
-	if(isNewCharAvailable == 1U)
+	are available. */
+	portENTER_CRITICAL();
 	{
-		isNewCharAvailable = 0U;
-		*pcRxedChar = receivedChar;
-		return pdTRUE;
+		usTaken = prvRxTake( pxPort, ( unsigned char * ) pcRxedChar, 1 );
 	}
-	else
+	portEXIT_CRITICAL();
+
+	return ( usTaken == 1 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+unsigned short xSerialPortRead( xComPortHandle xPort, signed char *pcBuffer, unsigned short usLength, TickType_t xBlockTime )
+{
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+unsigned short usRead = 0;
+TimeOut_t xTimeOut;
+portBASE_TYPE xMustWait;
+
+	if( pcBuffer == NULL )
 	{
-		return pdFALSE;
+		return 0;
 	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		portENTER_CRITICAL();
+		{
+			usRead += prvRxTake( pxPort, ( unsigned char * ) &( pcBuffer[ usRead ] ), ( unsigned short ) ( usLength - usRead ) );
+
+			xMustWait = ( usRead < usLength ) ? pdTRUE : pdFALSE;
+			if( xMustWait != pdFALSE )
+			{
+				pxPort->uxRxWaiters++;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xMustWait == pdFALSE )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			portENTER_CRITICAL();
+			{
+				pxPort->uxRxWaiters--;
+			}
+			portEXIT_CRITICAL();
+			break;
+		}
+
+		prvWaitForEvent( pxPort->xRxEvent, &( pxPort->uxRxWaiters ), xBlockTime );
+	}
+
+	/* As for the writers, let the next reader have what is left. */
+	if( ( pxPort->uxRxWaiters > 0 ) && ( pxPort->usRxCount > 0 ) )
+	{
+		( void ) xSemaphoreGive( pxPort->xRxEvent );
+	}
+
+	return usRead;
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+signed portBASE_TYPE xSerialPortPutString( xComPortHandle xPort, const signed char * const pcString, unsigned short usStringLength )
 {
-	int i;
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+signed portBASE_TYPE xReturn = pdFALSE;
 
-	if(txDataSizeLeftToSend == 0 && pcString != NULL)
+	if( ( pcString != NULL ) && ( usStringLength <= serTX_BUFFER_SIZE ) )
 	{
-	  txDataSizeToSend = usStringLength;
-	  txDataSizeLeftToSend = usStringLength;
-	
-	  for(i = 0;i < usStringLength; i++)
-	  {
-		  txBuffer[i] = pcString[i];
-	  }
-	
-	  xSerialPutChar(txBuffer[txDataSizeToSend - txDataSizeLeftToSend--]);
-		
-	  return pdTRUE;
+		portENTER_CRITICAL();
+		{
+			if( ( pxPort->usTxReserved == 0 ) && ( ( serTX_BUFFER_SIZE - pxPort->usTxCount ) >= usStringLength ) )
+			{
+				prvTxQueue( pxPort, ( const unsigned char * ) pcString, usStringLength );
+				xReturn = pdTRUE;
+			}
+		}
+		portEXIT_CRITICAL();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned short xSerialPortWrite( xComPortHandle xPort, const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime )
+{
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+unsigned short usWritten = 0, usSpace, usChunk;
+TimeOut_t xTimeOut;
+portBASE_TYPE xMustWait;
+
+	if( pcString == NULL )
+	{
+		return 0;
 	}
-	else
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		portENTER_CRITICAL();
+		{
+			if( pxPort->usTxReserved == 0 )
+			{
+				usSpace = ( unsigned short ) ( serTX_BUFFER_SIZE - pxPort->usTxCount );
+			}
+			else
+			{
+				/* Wait for the reservation to be committed. */
+				usSpace = 0;
+			}
+
+			usChunk = ( unsigned short ) ( usStringLength - usWritten );
+
+			if( usChunk > serTX_BUFFER_SIZE )
+			{
+				/* Too long to ever fit in one go - send what fits now. */
+				if( usChunk > usSpace )
+				{
+					usChunk = usSpace;
+				}
+			}
+			else if( usChunk > usSpace )
+			{
+				/* Wait until the rest of the message fits as a whole. */
+				usChunk = 0;
+			}
+
+			if( usChunk > 0 )
+			{
+				prvTxQueue( pxPort, ( const unsigned char * ) &( pcString[ usWritten ] ), usChunk );
+				usWritten += usChunk;
+			}
+
+			xMustWait = ( usWritten < usStringLength ) ? pdTRUE : pdFALSE;
+			if( xMustWait != pdFALSE )
+			{
+				/* Registered before interrupts are enabled again, so the
+				interrupt cannot make room without also giving xTxEvent. */
+				pxPort->uxTxWaiters++;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xMustWait == pdFALSE )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			portENTER_CRITICAL();
+			{
+				pxPort->uxTxWaiters--;
+			}
+			portEXIT_CRITICAL();
+			break;
+		}
+
+		prvWaitForEvent( pxPort->xTxEvent, &( pxPort->uxTxWaiters ), xBlockTime );
+	}
+
+	prvTxPassOn( pxPort );
+
+	return usWritten;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPortFlush( xComPortHandle xPort, TickType_t xBlockTime )
+{
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+TimeOut_t xTimeOut;
+portBASE_TYPE xMustWait;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		portENTER_CRITICAL();
+		{
+			xMustWait = pxPort->xTxActive;
+			if( xMustWait != pdFALSE )
+			{
+				pxPort->uxTxWaiters++;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xMustWait == pdFALSE )
+		{
+			prvTxPassOn( pxPort );
+			return pdTRUE;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			portENTER_CRITICAL();
+			{
+				pxPort->uxTxWaiters--;
+			}
+			portEXIT_CRITICAL();
+			return pdFALSE;
+		}
+
+		prvWaitForEvent( pxPort->xTxEvent, &( pxPort->uxTxWaiters ), xBlockTime );
+	}
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPortReserve( xComPortHandle xPort, unsigned short usLength, SerialSpace_t *pxSpace, TickType_t xBlockTime )
+{
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+TimeOut_t xTimeOut;
+portBASE_TYPE xMustWait;
+unsigned short usFirst;
+
+	if( ( pxSpace == NULL ) || ( usLength == 0 ) || ( usLength > serTX_BUFFER_SIZE ) )
 	{
 		return pdFALSE;
 	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		portENTER_CRITICAL();
+		{
+			xMustWait = pdTRUE;
+
+			if( ( pxPort->usTxReserved == 0 ) && ( ( serTX_BUFFER_SIZE - pxPort->usTxCount ) >= usLength ) )
+			{
+				pxPort->usTxReserved = usLength;
+				xMustWait = pdFALSE;
+			}
+			else
+			{
+				pxPort->uxTxWaiters++;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xMustWait == pdFALSE )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+		{
+			portENTER_CRITICAL();
+			{
+				pxPort->uxTxWaiters--;
+			}
+			portEXIT_CRITICAL();
+			return pdFALSE;
+		}
+
+		prvWaitForEvent( pxPort->xTxEvent, &( pxPort->uxTxWaiters ), xBlockTime );
+	}
+
+	/* usTxHead only moves when the reservation is committed, and the
+	interrupt does not read beyond it, so the room can be handed out as is. */
+	usFirst = ( unsigned short ) ( serTX_BUFFER_SIZE - pxPort->usTxHead );
+	if( usFirst > usLength )
+	{
+		usFirst = usLength;
+	}
+
+	pxSpace->pucFirst = &( pxPort->ucTxBuffer[ pxPort->usTxHead ] );
+	pxSpace->usFirst = usFirst;
+	pxSpace->pucSecond = pxPort->ucTxBuffer;
+	pxSpace->usSecond = ( unsigned short ) ( usLength - usFirst );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vSerialPortCommit( xComPortHandle xPort, unsigned short usLength )
+{
+SerialPort_t *pxPort = ( SerialPort_t * ) xPort;
+
+	portENTER_CRITICAL();
+	{
+		if( usLength > pxPort->usTxReserved )
+		{
+			usLength = pxPort->usTxReserved;
+		}
+
+		if( usLength > 0 )
+		{
+			prvTxCommit( pxPort, usLength );
+		}
+
+		pxPort->usTxReserved = 0;
+	}
+	portEXIT_CRITICAL();
+
+	/* Writers may have been waiting for the reservation rather than for
+	room. */
+	if( pxPort->uxTxWaiters > 0 )
+	{
+		( void ) xSemaphoreGive( pxPort->xTxEvent );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vSerialPortPutChar( xComPortHandle xPort, signed char cOutChar )
+{
+	( void ) xSerialPortPutString( xPort, &cOutChar, 1 );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
+{
+	return xSerialPortGetChar( &xUart1Port, pcRxedChar );
+}
+/*-----------------------------------------------------------*/
+
+unsigned short xSerialRead( signed char *pcBuffer, unsigned short usLength, TickType_t xBlockTime )
+{
+	return xSerialPortRead( &xUart1Port, pcBuffer, usLength, xBlockTime );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+{
+	return xSerialPortPutString( &xUart1Port, pcString, usStringLength );
+}
+/*-----------------------------------------------------------*/
+
+unsigned short xSerialWrite( const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime )
+{
+	return xSerialPortWrite( &xUart1Port, pcString, usStringLength, xBlockTime );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialFlush( TickType_t xBlockTime )
+{
+	return xSerialPortFlush( &xUart1Port, xBlockTime );
 }
 /*-----------------------------------------------------------*/
 
 void xSerialPutChar(signed char cOutChar)
 {
-	U1THR = cOutChar;
+	( void ) xSerialPortPutString( &xUart1Port, &cOutChar, 1 );
 }
 /*-----------------------------------------------------------*/
 
-void vUART_ISRHandler( void )
+static void prvTxQueue( SerialPort_t *pxPort, const unsigned char *pucData, unsigned short usLength )
+{
+unsigned short usFirst;
+
+	/* Copy in at most two pieces, either side of the end of the ring. */
+	usFirst = ( unsigned short ) ( serTX_BUFFER_SIZE - pxPort->usTxHead );
+	if( usFirst > usLength )
+	{
+		usFirst = usLength;
+	}
+
+	memcpy( &( pxPort->ucTxBuffer[ pxPort->usTxHead ] ), pucData, usFirst );
+	memcpy( pxPort->ucTxBuffer, &( pucData[ usFirst ] ), usLength - usFirst );
+
+	prvTxCommit( pxPort, usLength );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTxCommit( SerialPort_t *pxPort, unsigned short usLength )
+{
+	pxPort->usTxHead = ( unsigned short ) ( ( pxPort->usTxHead + usLength ) % serTX_BUFFER_SIZE );
+	pxPort->usTxCount += usLength;
+
+	if( pxPort->xTxActive == pdFALSE )
+	{
+		/* The FIFO is empty and no THRE interrupt is coming - fill it from
+		here.  The interrupt takes over when it empties again. */
+		pxPort->xTxActive = pdTRUE;
+		prvTxFill( pxPort );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTxFill( SerialPort_t *pxPort )
+{
+unsigned short usCount = 0;
+
+	while( ( usCount < serTX_FIFO_DEPTH ) && ( pxPort->usTxCount > 0 ) )
+	{
+		serREG( pxPort, THR ) = pxPort->ucTxBuffer[ pxPort->usTxTail ];
+		pxPort->usTxTail = ( unsigned short ) ( ( pxPort->usTxTail + 1U ) % serTX_BUFFER_SIZE );
+		pxPort->usTxCount--;
+		usCount++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRxDrain( SerialPort_t *pxPort )
+{
+unsigned char ucChar;
+
+	while( ( serREG( pxPort, LSR ) & serLSR_RX_DATA_READY ) != 0 )
+	{
+		ucChar = serREG( pxPort, RBR );
+
+		/* If the ring is full the character is lost. */
+		if( pxPort->usRxCount < serRX_BUFFER_SIZE )
+		{
+			pxPort->ucRxBuffer[ pxPort->usRxHead ] = ucChar;
+			pxPort->usRxHead = ( unsigned short ) ( ( pxPort->usRxHead + 1U ) % serRX_BUFFER_SIZE );
+			pxPort->usRxCount++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned short prvRxTake( SerialPort_t *pxPort, unsigned char *pucData, unsigned short usLength )
+{
+unsigned short usFirst;
+
+	if( usLength > pxPort->usRxCount )
+	{
+		usLength = pxPort->usRxCount;
+	}
+
+	/* Copy out in at most two pieces, either side of the end of the ring. */
+	usFirst = ( unsigned short ) ( serRX_BUFFER_SIZE - pxPort->usRxTail );
+	if( usFirst > usLength )
+	{
+		usFirst = usLength;
+	}
+
+	memcpy( pucData, &( pxPort->ucRxBuffer[ pxPort->usRxTail ] ), usFirst );
+	memcpy( &( pucData[ usFirst ] ), pxPort->ucRxBuffer, usLength - usFirst );
+
+	pxPort->usRxTail = ( unsigned short ) ( ( pxPort->usRxTail + usLength ) % serRX_BUFFER_SIZE );
+	pxPort->usRxCount -= usLength;
+
+	return usLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForEvent( SemaphoreHandle_t xEvent, volatile UBaseType_t *puxWaiters, TickType_t xBlockTime )
+{
+	( void ) xSemaphoreTake( xEvent, xBlockTime );
+
+	portENTER_CRITICAL();
+	{
+		( *puxWaiters )--;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTxPassOn( SerialPort_t *pxPort )
+{
+	if( ( pxPort->uxTxWaiters > 0 ) && ( pxPort->usTxCount < serTX_BUFFER_SIZE ) )
+	{
+		( void ) xSemaphoreGive( pxPort->xTxEvent );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvHandleInterrupt( SerialPort_t *pxPort )
 {
 signed char cChar;
 unsigned char ucInterrupt;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-	ucInterrupt = U1IIR;
+	ucInterrupt = serREG( pxPort, IIR );
 
 	/* The interrupt pending bit is active low. */
 	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
@@ -194,41 +886,84 @@ unsigned char ucInterrupt;
 		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
 		{
 			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
-				cChar = U1LSR;
+				cChar = serREG( pxPort, LSR );
 				break;
 	
 			case serSOURCE_THRE	:	/* The THRE is empty */
 				
-				/* Do nothing */
-				if(txDataSizeLeftToSend > 0)
+				/* Refill the whole FIFO, or stop if there is nothing left to
+				send. */
+				if( pxPort->usTxCount > 0 )
+				{
+					prvTxFill( pxPort );
+				}
+				else
 				{
-					U1THR = txBuffer[txDataSizeToSend - txDataSizeLeftToSend--];
+					pxPort->xTxActive = pdFALSE;
+				}
+
+				/* Room was made, or the transmitter went idle. */
+				if( pxPort->uxTxWaiters > 0 )
+				{
+					( void ) xSemaphoreGiveFromISR( pxPort->xTxEvent, &xHigherPriorityTaskWoken );
 				}
 				
 				break;
 	
 			case serSOURCE_RX_TIMEOUT :
-			case serSOURCE_RX	:	/* A character was received */
+			case serSOURCE_RX	:	/* Characters were received */
 			
-				receivedChar = U1RBR;
-				isNewCharAvailable = 1U;			
+				/* Take everything in the FIFO, not just the characters that
+				raised the interrupt. */
+				prvRxDrain( pxPort );
+
+				if( pxPort->uxRxWaiters > 0 )
+				{
+					( void ) xSemaphoreGiveFromISR( pxPort->xRxEvent, &xHigherPriorityTaskWoken );
+				}
 				break;
 	
 			default:	/* There is nothing to do, leave the ISR. */
 				break;
 		}
 
-		ucInterrupt = U1IIR;
+		ucInterrupt = serREG( pxPort, IIR );
 	}
 
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+void vUART_ISRHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken;
+
+	xHigherPriorityTaskWoken = prvHandleInterrupt( &xUart1Port );
+
 	/* Clear the ISR in the VIC. */
 	VICVectAddr = serCLEAR_VIC_INTERRUPT;
+
+	/* Exit the ISR.  If a reader or writer was woken then a context switch
+	will occur. */
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
 /*-----------------------------------------------------------*/
 
+#if( serUSE_UART0 == 1 )
 
+	void vUART0_ISRHandler( void )
+	{
+	portBASE_TYPE xHigherPriorityTaskWoken;
 
+		xHigherPriorityTaskWoken = prvHandleInterrupt( &xUart0Port );
 
+		/* Clear the ISR in the VIC. */
+		VICVectAddr = serCLEAR_VIC_INTERRUPT;
 
+		/* Exit the ISR.  If a reader or writer was woken then a context switch
+		will occur. */
+		portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+	}
 
-	
+#endif /* serUSE_UART0 */
+/*-----------------------------------------------------------*/
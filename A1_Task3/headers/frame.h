@@ -0,0 +1,119 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	FRAMES.
+
+	Structured data - sensor readings, trace records - sent over a serial port
+	as frames with a type, a sequence number and a CRC, COBS encoded so the
+	receiver always finds where a frame ends.  The encoding is described in
+	frame_codec.h, which the host side library shares.
+
+	xFrameSend() does not build the frame in a buffer of its own.  It reserves
+	the most room the frame can take in the transmit ring of the port, encodes
+	the payload straight into it and commits what it used, so the payload is
+	read once, and the frame is never copied.  The sequence number is given
+	while the room is reserved, so the numbers go out in order even when
+	several tasks send on the same channel.
+
+	xFrameReceive() reads the port through a streaming decoder, and returns
+	once a good frame has arrived.  Frames with a bad CRC, or that are cut
+	short, are counted and skipped.
+
+	Set configUSE_FRAMES to 1 in FreeRTOSConfig.h to build it.
+*/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include frame.h"
+#endif
+
+#include "serial.h"
+#include "frame_codec.h"
+
+/*-----------------------------------------------------------
+ * Frame configuration.  Each can be set in FreeRTOSConfig.h.
+ *----------------------------------------------------------*/
+
+/* frameCRC16_BYTES or frameCRC32_BYTES.  The receiver must be told which. */
+#ifndef frameCRC_BYTES
+	#define frameCRC_BYTES			frameCRC16_BYTES
+#endif
+
+/* The characters taken from the port at a time by xFrameReceive(). */
+#ifndef frameRX_CHUNK
+	#define frameRX_CHUNK			( 16U )
+#endif
+
+#if( frameENCODED_MAX( frameMAX_PAYLOAD, frameCRC_BYTES ) > serTX_BUFFER_SIZE )
+	#error The largest frame must fit in the transmit ring - reduce frameMAX_PAYLOAD or increase serTX_BUFFER_SIZE.
+#endif
+
+/*-----------------------------------------------------------
+ * API.
+ *----------------------------------------------------------*/
+
+/* The frames sent and received on one serial port.  Only one channel should
+receive on a port. */
+typedef struct FRAME_CHANNEL
+{
+	xComPortHandle xPort;
+	uint16_t usNextSequence;
+
+	/* The last frame received is in xDecoder - see frame_codec.h. */
+	FrameDecoder_t xDecoder;
+
+	/* Characters read from the port and not yet decoded. */
+	uint8_t ucRxChunk[ frameRX_CHUNK ];
+	uint16_t usRxNext;
+	uint16_t usRxCount;
+} FrameChannel_t;
+
+/*
+ * Set up a channel on a port opened with xSerialPortInit() or
+ * xSerialPortInitMinimal().
+ */
+void vFrameChannelInit( FrameChannel_t *pxChannel, xComPortHandle xPort );
+
+/*
+ * Send xLength bytes of payload as a frame of type ucType, blocking for up to
+ * xBlockTime for room in the transmit ring.  Returns pdFALSE, having sent
+ * nothing, on timeout or if xLength is larger than frameMAX_PAYLOAD.  Only
+ * call from a task.
+ */
+BaseType_t xFrameSend( FrameChannel_t *pxChannel, uint8_t ucType, const void *pvPayload, size_t xLength, TickType_t xBlockTime );
+
+/*
+ * Block for up to xBlockTime for a good frame.  Returns pdTRUE when one has
+ * arrived - its type, sequence number and payload are then in
+ * pxChannel->xDecoder until the next call.  Only call from a task.
+ */
+BaseType_t xFrameReceive( FrameChannel_t *pxChannel, TickType_t xBlockTime );
+
+#endif /* FRAME_H */
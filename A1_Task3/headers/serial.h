@@ -28,8 +28,35 @@
 #ifndef SERIAL_COMMS_H
 #define SERIAL_COMMS_H
 
+/* Set to 1 in FreeRTOSConfig.h to drive UART0 as well as UART1.  Each port has
+buffers of its own, so it is off unless needed. */
+#ifndef serUSE_UART0
+	#define serUSE_UART0			0
+#endif
+
+/* The size of the transmit ring buffer of each port.  Can be set in
+FreeRTOSConfig.h.  vSerialPutString() only accepts messages that fit in it. */
+#ifndef serTX_BUFFER_SIZE
+	#define serTX_BUFFER_SIZE		( 256U )
+#endif
+
+/* The size of the receive ring buffer of each port.  Can be set in
+FreeRTOSConfig.h.  Characters that arrive while it is full are lost. */
+#ifndef serRX_BUFFER_SIZE
+	#define serRX_BUFFER_SIZE		( 128U )
+#endif
+
+/* The number of characters the receive FIFO collects before it
+interrupts: 1, 4, 8 or 14.  Fewer are picked up by the character time-out
+interrupt, about four character times after the last one arrived.  Can be set
+in FreeRTOSConfig.h. */
+#ifndef serRX_TRIGGER_LEVEL
+	#define serRX_TRIGGER_LEVEL		8
+#endif
+
 typedef void * xComPortHandle;
 
+/* serCOM1 is UART0 and serCOM2 is UART1.  There are no others. */
 typedef enum
 { 
 	serCOM1, 
@@ -86,9 +113,103 @@ typedef enum
 	ser115200
 } eBaud;
 
-void xSerialPortInitMinimal( unsigned long ulWantedBaud);
+/* Room in a transmit ring, handed out by xSerialPortReserve().  It wraps
+around the end of the ring after usFirst characters, so usSecond are at
+pucSecond. */
+typedef struct SERIAL_SPACE
+{
+	unsigned char *pucFirst;
+	unsigned short usFirst;
+	unsigned char *pucSecond;
+	unsigned short usSecond;
+} SerialSpace_t;
+
+/*
+ * Open UART1 for ulWantedBaud, eight data bits, no parity and one stop bit.
+ * The functions below that take no handle then use it.  Returns its handle,
+ * or NULL if the rate cannot be set or there is no heap for the port's
+ * semaphores - the port must not be used then.
+ */
+xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud);
+
+/*
+ * Open ePort with the given format.  Returns the handle to pass to the
+ * xSerialPort...() functions, or NULL if the port does not exist (UART0 needs
+ * serUSE_UART0), the rate cannot be set, or there is no heap for its
+ * semaphores.  Opening a port again changes its format, but keeps whatever is
+ * buffered.
+ */
+xComPortHandle xSerialPortInit( eCOMPort ePort, eBaud eWantedBaud, eParity eWantedParity, eDataBits eWantedDataBits, eStopBits eWantedStopBits );
+
+/*
+ * For a port opened with xSerialPortInit().  Each behaves as its UART1
+ * counterpart below - xSerialPortWrite() as xSerialWrite(), and so on.
+ */
+signed portBASE_TYPE xSerialPortPutString( xComPortHandle xPort, const signed char * const pcString, unsigned short usStringLength );
+unsigned short xSerialPortWrite( xComPortHandle xPort, const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime );
+signed portBASE_TYPE xSerialPortFlush( xComPortHandle xPort, TickType_t xBlockTime );
+signed portBASE_TYPE xSerialPortGetChar( xComPortHandle xPort, signed char *pcRxedChar );
+unsigned short xSerialPortRead( xComPortHandle xPort, signed char *pcBuffer, unsigned short usLength, TickType_t xBlockTime );
+void vSerialPortPutChar( xComPortHandle xPort, signed char cOutChar );
+
+/*
+ * Reserve usLength characters of room in the transmit ring of xPort, blocking
+ * for up to xBlockTime for it, so a message can be built in place rather than
+ * copied in.  Returns pdFALSE on timeout, or if usLength is 0 or larger than
+ * serTX_BUFFER_SIZE.  Otherwise *pxSpace describes the room.
+ *
+ * The message must then be committed with vSerialPortCommit(), without
+ * blocking in between - until it is, every other write to the port waits.
+ * Only call from a task.
+ */
+signed portBASE_TYPE xSerialPortReserve( xComPortHandle xPort, unsigned short usLength, SerialSpace_t *pxSpace, TickType_t xBlockTime );
+
+/*
+ * Send the first usLength characters of the room reserved on xPort, which may
+ * be fewer than were reserved, and release the rest.
+ */
+void vSerialPortCommit( xComPortHandle xPort, unsigned short usLength );
+
+/*
+ * Queue a message for transmission without blocking.  Returns pdTRUE if all of
+ * it was queued, or pdFALSE, having queued none of it, if there is not room
+ * in the transmit ring for all of it.  It may be called while a previous
+ * message is still being sent.
+ */
 signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength);
+
+/*
+ * Queue a message for transmission, blocking for up to xBlockTime for room in
+ * the transmit ring.  A message no longer than serTX_BUFFER_SIZE is queued
+ * whole or not at all, so it is never interleaved with another task's.  A
+ * longer one is queued in pieces as room is made.  Returns the number of
+ * characters queued.  Only call with a non zero xBlockTime from a task.
+ */
+unsigned short xSerialWrite( const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime );
+
+/*
+ * Block for up to xBlockTime until everything queued has been moved to the
+ * UART's FIFO and the FIFO has emptied.  Returns pdFALSE on timeout.
+ */
+signed portBASE_TYPE xSerialFlush( TickType_t xBlockTime );
+
+/*
+ * Take the next received character without blocking.  Returns pdFALSE if
+ * there is none.
+ */
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar);
+
+/*
+ * Read usLength received characters into pcBuffer, blocking for up to
+ * xBlockTime for them to arrive.  Returns the number read, which is less than
+ * usLength only if xBlockTime expired.  Only call with a non zero xBlockTime
+ * from a task.
+ */
+unsigned short xSerialRead( signed char *pcBuffer, unsigned short usLength, TickType_t xBlockTime );
+
+/*
+ * Queue a single character.  It is discarded if the transmit ring is full.
+ */
 void xSerialPutChar(signed char cOutChar);
 
 #endif
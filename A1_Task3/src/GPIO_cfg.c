@@ -3,39 +3,21 @@
 #include "GPIO_cfg.h"
 
 
-PinConfig_t PinConfig_array[] = 
-							{
-								{PORT_0, PIN0, INPUT},
-								{PORT_0, PIN1, OUTPUT},
-								{PORT_0, PIN2, OUTPUT},
-								{PORT_0, PIN3, OUTPUT},
-								{PORT_0, PIN4, OUTPUT},
-								{PORT_0, PIN5, OUTPUT},
-								{PORT_0, PIN6, OUTPUT},
-								{PORT_0, PIN7, OUTPUT},
-								{PORT_0, PIN8, OUTPUT},
-								{PORT_0, PIN9, OUTPUT},
-								{PORT_0, PIN10, OUTPUT},
-								{PORT_0, PIN11, OUTPUT},
-								{PORT_0, PIN13, OUTPUT},
-								{PORT_0, PIN14, OUTPUT},
-								{PORT_0, PIN15, OUTPUT},
-								
-								{PORT_1, PIN0, OUTPUT},
-								{PORT_1, PIN1, OUTPUT},
-								{PORT_1, PIN2, OUTPUT},
-								{PORT_1, PIN3, OUTPUT},
-								{PORT_1, PIN4, OUTPUT},
-								{PORT_1, PIN5, OUTPUT},
-								{PORT_1, PIN6, OUTPUT},
-								{PORT_1, PIN7, OUTPUT},
-								{PORT_1, PIN8, OUTPUT},
-								{PORT_1, PIN9, OUTPUT},
-								{PORT_1, PIN10, OUTPUT},
-								{PORT_1, PIN11, OUTPUT},
-								{PORT_1, PIN13, OUTPUT},
-								{PORT_1, PIN14, OUTPUT},
-								{PORT_1, PIN15, OUTPUT},
-							};
+/* The pin table in GPIO_cfg.h is expanded by GPIO.h; nothing of it is kept
+   in RAM. What is wrong with it is caught here, when building */
 
-uint16_t PinConfig_array_size = sizeof(PinConfig_array)/sizeof(PinConfig_t);
+/* A pin listed twice redeclares its enumerator */
+#define GPIO_CFG_UNIQUE(Name, Port, Pin, Direction)		GPIO_CFG_##Port##_##Pin,
+
+enum GPIO_cfgPins
+{
+	GPIO_PIN_TABLE(GPIO_CFG_UNIQUE)
+	GPIO_CFG_PIN_COUNT
+};
+
+/* A pin that is not one of PIN0 to PIN15 of PORT_0 or PORT_1 gets an array
+   of negative size */
+#define GPIO_CFG_VALID(Name, Port, Pin, Direction) \
+	typedef char GPIO_cfg_valid_##Name[(((PORT_0 == (Port)) || (PORT_1 == (Port))) && ((Pin) >= PIN0) && ((Pin) <= PIN15)) ? 1 : -1];
+
+GPIO_PIN_TABLE(GPIO_CFG_VALID)
@@ -64,6 +64,7 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "run_time_stats.h"
 
 
 /*-----------------------------------------------------------*/
@@ -74,6 +75,12 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Timer 1 is the run time stats clock.  Counting at 1MHz it wraps every 71
+minutes, far longer than the period at which the statistics are written. */
+#define mainRUN_TIME_STATS_HZ	( ( unsigned long ) 1000000 )
+#define mainSTATS_PERIOD		( ( TickType_t ) 1000 / portTICK_PERIOD_MS )
+#define mainSTATS_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -104,6 +111,18 @@ int main( void )
 	called.  The demo applications included in the FreeRTOS.org download switch
 	to supervisor mode prior to main being called.  If you are not using one of
 	these demo application projects then ensure Supervisor mode is used here. */
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		/* The trace recorder drains over UART1, so it takes the place of the
+		run time stats task. */
+		vTraceRecorderStart( mainSTATS_PRIORITY );
+	}
+	#else
+	{
+		vStartRunTimeStatsTask( mainSTATS_PRIORITY, mainSTATS_PERIOD );
+	}
+	#endif
+
 	vTaskStartScheduler();
 
 	/* Should never reach here!  If you do then there was not enough heap
@@ -112,17 +131,20 @@ int main( void )
 }
 /*-----------------------------------------------------------*/
 
-/* Function to reset timer 1 */
+/* Function to reset timer 1.  The run time statistics written for the period
+in which this is called will be wrong. */
 void timer1Reset(void)
 {
 	T1TCR |= 0x2;
 	T1TCR &= ~0x2;
 }
 
-/* Function to initialize and start timer 1 */
-static void configTimer1(void)
+/* Function to initialize and start timer 1.  Called by the kernel, through
+portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(), when the scheduler starts - which is
+after prvSetupHardware() has set the peripheral clock to the CPU clock. */
+void configTimer1(void)
 {
-	T1PR = 1000;
+	T1PR = ( configCPU_CLOCK_HZ / mainRUN_TIME_STATS_HZ ) - 1UL;
 	T1TCR |= 0x1;
 }
 
@@ -137,9 +159,6 @@ static void prvSetupHardware( void )
 	/* Configure GPIO */
 	GPIO_init();
 	
-	/* Config trace timer 1 and read T1TC to get current tick */
-	configTimer1();
-
 	/* Setup the peripheral bus to be the same as the PLL output. */
 	VPBDIV = mainBUS_CLK_FULL;
 }
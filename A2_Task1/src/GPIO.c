@@ -9,103 +9,33 @@
 
 void GPIO_init(void)
 {
-	int i;
-	
-	for(i = 0; i < PinConfig_array_size;i++)
-	{
-		switch(PinConfig_array[i].Port)
-		{
-			case PORT_0:
-				if(INPUT == PinConfig_array[i].Direction)
-				{
-					CLR_BIT(IODIR0, PinConfig_array[i].Pin);
-				}
-				else if (OUTPUT == PinConfig_array[i].Direction)
-				{
-					SET_BIT(IODIR0, PinConfig_array[i].Pin);
-				}
-				else
-				{
-					
-				}
-				break;
-	
-			case PORT_1:
-				if(INPUT == PinConfig_array[i].Direction)
-				{
-					CLR_BIT(IODIR1, PinConfig_array[i].Pin);
-				}
-				else if (OUTPUT == PinConfig_array[i].Direction)
-				{
-					SET_BIT(IODIR1, PinConfig_array[i].Pin);
-				}
-				else
-				{
-
-				}
-				break;
-	
-			default:
-				break;
-		}
-	}
+	/* The masks are constants expanded from the pin table, so each IODIR is
+	   written once. Pins that are not in the table keep their direction */
+	IODIR0 = (IODIR0 & ~GPIO_PORT0_PINS) | GPIO_PORT0_OUTPUTS;
+	IODIR1 = (IODIR1 & ~GPIO_PORT1_PINS) | GPIO_PORT1_OUTPUTS;
 }
 
 
 pinState_t GPIO_read(portX_t PortName, pinX_t pinNum)
 {
-	pinState_t state;
-	
-	switch(PortName)
-	{
-		case PORT_0:
-			{
-				state = (pinState_t) GET_BIT(IOPIN0, pinNum);
-				break;
-			}
-
-		case PORT_1:
-			{
-				state = (pinState_t) GET_BIT(IOPIN1, pinNum);
-				break;
-			}
-	}
-	
-	return state;
+	return (pinState_t) GET_BIT(GPIO_readPort(PortName), pinNum);
 }
 
 
 void GPIO_write(portX_t portName, pinX_t pinNum, pinState_t pinState)
 {
-	switch(portName)
+	if(PIN_IS_LOW == pinState)
 	{
-		case PORT_0:
-			if(PIN_IS_LOW == pinState)
-			{
-				SET_BIT(IOCLR0, pinNum);
-			}
-			else if (PIN_IS_HIGH == pinState)
-			{
-				SET_BIT(IOSET0, pinNum);
-			}
-			else
-			{
-				
-			}
-			break;
-
-		case PORT_1:
-			if(PIN_IS_LOW == pinState)
-			{
-				SET_BIT(IOCLR1, pinNum);
-			}
-			else if (PIN_IS_HIGH == pinState)
-			{
-				SET_BIT(IOSET1, pinNum);
-			}
-			else
-			{
-				
-			}
+		GPIO_writeMask(portName, 0U, GPIO_PIN_MASK(pinNum));
+	}
+	else if (PIN_IS_HIGH == pinState)
+	{
+		GPIO_writeMask(portName, GPIO_PIN_MASK(pinNum), 0U);
+	}
+	else
+	{
+		
 	}
 }
+
+
@@ -64,6 +64,7 @@
 /* Peripheral includes. */
 #include "serial.h"
 #include "GPIO.h"
+#include "run_time_stats.h"
 
 /* Lib includes */
 //#include "std.h"
@@ -76,12 +77,15 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
-/* Macros */
-#define LED_PORT    		PORT_0
-#define LED_PIN     		PIN1
+/* Timer 1 is the run time stats clock.  Counting at 1MHz it wraps every 71
+minutes, far longer than the period at which the statistics are written. */
+#define mainRUN_TIME_STATS_HZ	( ( unsigned long ) 1000000 )
+#define mainSTATS_PERIOD		( ( TickType_t ) 1000 / portTICK_PERIOD_MS )
+#define mainSTATS_PRIORITY		( tskIDLE_PRIORITY + 1 )
 
-#define BTN_PORT				PORT_0
-#define BTN_PIN					PIN0
+/* Macros */
+/* The LED and the button are the LED and BTN entries of the pin table in
+   GPIO_cfg.h */
 #define BTN_MS_DEBOUNCE 50
 #define BTN_TICK_POLL 	5
 
@@ -159,6 +163,18 @@ int main( void )
 	called.  The demo applications included in the FreeRTOS.org download switch
 	to supervisor mode prior to main being called.  If you are not using one of
 	these demo application projects then ensure Supervisor mode is used here. */
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		/* The trace recorder drains over UART1, so it takes the place of the
+		run time stats task. */
+		vTraceRecorderStart( mainSTATS_PRIORITY );
+	}
+	#else
+	{
+		vStartRunTimeStatsTask( mainSTATS_PRIORITY, mainSTATS_PERIOD );
+	}
+	#endif
+
 	vTaskStartScheduler();
 
 	/* Should never reach here!  If you do then there was not enough heap
@@ -183,13 +199,13 @@ static void btn_handler_task(void *pvParameters)
     for (;;)
     {
 			// check button state
-			if(PIN_IS_HIGH == GPIO_read(BTN_PORT, BTN_PIN))
+			if(PIN_IS_HIGH == GPIO_read_BTN())
 			{
 				// debounce delay
 				vTaskDelay(BTN_MS_DEBOUNCE);
 				
 				// recheck if button is released
-				while(PIN_IS_HIGH == GPIO_read(BTN_PORT, BTN_PIN)) // wait until btn is released
+				while(PIN_IS_HIGH == GPIO_read_BTN()) // wait until btn is released
 				{
 					vTaskDelay(tickType_l_check_ms_delay);
 				}
@@ -241,7 +257,7 @@ static void led_handler_task(void *pvParameters)
 				if(APP_NOTIF_TOGGLE == uint32_notification)
 				{
 					// Toggle LED
-					GPIO_write(LED_PORT, LED_PIN, bool_l_led_on ? PIN_IS_LOW : PIN_IS_HIGH);
+					GPIO_write_LED(bool_l_led_on ? PIN_IS_LOW : PIN_IS_HIGH);
 					bool_l_led_on = bool_l_led_on ? FALSE : TRUE;
 				}
 				else
@@ -265,17 +281,20 @@ static void notify_led_handler(uint32_t u32_a_notification)
 	);
 }
 
-/* Function to reset timer 1 */
+/* Function to reset timer 1.  The run time statistics written for the period
+in which this is called will be wrong. */
 void timer1Reset(void)
 {
 	T1TCR |= 0x2;
 	T1TCR &= ~0x2;
 }
 
-/* Function to initialize and start timer 1 */
-static void configTimer1(void)
+/* Function to initialize and start timer 1.  Called by the kernel, through
+portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(), when the scheduler starts - which is
+after prvSetupHardware() has set the peripheral clock to the CPU clock. */
+void configTimer1(void)
 {
-	T1PR = 1000;
+	T1PR = ( configCPU_CLOCK_HZ / mainRUN_TIME_STATS_HZ ) - 1UL;
 	T1TCR |= 0x1;
 }
 
@@ -290,9 +309,6 @@ static void prvSetupHardware( void )
 	/* Configure GPIO */
 	GPIO_init();
 	
-	/* Config trace timer 1 and read T1TC to get current tick */
-	configTimer1();
-
 	/* Setup the peripheral bus to be the same as the PLL output. */
 	VPBDIV = mainBUS_CLK_FULL;
 }
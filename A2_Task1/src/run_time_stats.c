@@ -0,0 +1,293 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	RUN TIME STATISTICS STREAMED OVER UART1.
+
+	Every period the task below reads the run time counter and the switch in
+	count of every task, and writes the share of the CPU time each task used
+	and the number of times each task was switched in during the period just
+	ended.  Working from the change over a period, rather than the totals kept
+	by the kernel, means the results stay correct after the run time counter
+	wraps.
+
+	When the application is built with heap_pool.c the task also writes, for
+	each size class of the heap, the blocks in use now, the most ever in use at
+	once and the number of allocations that failed, which is what the block
+	counts and configTOTAL_HEAP_SIZE are sized from.  When the heap monitor is
+	enabled the task writes its report as well - see heap_monitor.h.
+*/
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "run_time_stats.h"
+
+/*-----------------------------------------------------------*/
+
+/* The largest number of tasks, including the idle task, reported on. */
+#ifndef statsMAX_TASKS
+	#define statsMAX_TASKS				( 8 )
+#endif
+
+/* The stack of the stats task, which calls snprintf() and the heap monitor. */
+#ifndef statsSTACK_SIZE
+	#define statsSTACK_SIZE				( configMINIMAL_STACK_SIZE * 3 )
+#endif
+
+/* Long enough for a heap pool line of five ten digit numbers, the longest
+line printed. */
+#define statsLINE_LENGTH				( 64 )
+
+/* The CPU time is reported in tenths of a percent. */
+#define statsPER_MILLE					( ( unsigned long ) 1000 )
+
+/*-----------------------------------------------------------*/
+
+/* The counters read at the end of the last period, for each task. */
+typedef struct STATS_PREVIOUS
+{
+	TaskHandle_t xHandle;
+	uint32_t ulRunTimeCounter;
+	uint32_t ulSwitchInCount;
+} StatsPrevious_t;
+
+/*
+ * The task that streams the statistics.
+ */
+static void vRunTimeStatsTask( void *pvParameters );
+
+/*
+ * Write one line for each of the uxTasks tasks in xStatus[].
+ */
+static void prvPrintPeriod( UBaseType_t uxTasks, uint32_t ulPeriodRunTime );
+
+/*
+ * Write one line for each size class of heap_pool.c.
+ */
+#ifdef configHEAP_POOL_BLOCK_SIZES
+	static void prvPrintHeapPool( void );
+#endif
+
+/*
+ * Find the counters read for xHandle at the end of the last period.  A task
+ * created since then starts from zero.
+ */
+static const StatsPrevious_t *prvFindPrevious( TaskHandle_t xHandle );
+
+/*
+ * Keep the counters of the uxTasks tasks in xStatus[] for the next period,
+ * forgetting any task that has been deleted.
+ */
+static void prvRememberCounters( UBaseType_t uxTasks );
+
+/*
+ * Write a string on UART1, waiting for the driver to accept it.
+ */
+static void prvPrint( const char *pcString );
+
+/*-----------------------------------------------------------*/
+
+static TaskStatus_t xStatus[ statsMAX_TASKS ];
+static StatsPrevious_t xPrevious[ statsMAX_TASKS ];
+
+/* The period, in ticks, at which the statistics are written. */
+static TickType_t xStatsPeriod;
+
+/*-----------------------------------------------------------*/
+
+void vStartRunTimeStatsTask( UBaseType_t uxPriority, TickType_t xPeriod )
+{
+	xStatsPeriod = xPeriod;
+	xTaskCreate( vRunTimeStatsTask, "Stats", statsSTACK_SIZE, NULL, uxPriority, ( TaskHandle_t * ) NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vRunTimeStatsTask( void *pvParameters )
+{
+TickType_t xLastWakeTime;
+UBaseType_t uxTasks;
+uint32_t ulTotalRunTime = 0, ulLastTotalRunTime = 0;
+
+	( void ) pvParameters;
+
+	uxTasks = uxTaskGetSystemState( xStatus, statsMAX_TASKS, &ulLastTotalRunTime );
+	prvRememberCounters( uxTasks );
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xStatsPeriod );
+
+		uxTasks = uxTaskGetSystemState( xStatus, statsMAX_TASKS, &ulTotalRunTime );
+
+		if( uxTasks == 0 )
+		{
+			prvPrint( "Stats: too many tasks\r\n" );
+		}
+		else
+		{
+			/* Unsigned arithmetic gives the right answer across a wrap of the
+			run time counter, provided it does not wrap twice within one
+			period. */
+			prvPrintPeriod( uxTasks, ulTotalRunTime - ulLastTotalRunTime );
+			prvRememberCounters( uxTasks );
+			ulLastTotalRunTime = ulTotalRunTime;
+		}
+
+		#ifdef configHEAP_POOL_BLOCK_SIZES
+		{
+			prvPrintHeapPool();
+		}
+		#endif
+
+		#if( configUSE_HEAP_MONITOR == 1 )
+		{
+			vHeapMonitorPrint();
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintPeriod( UBaseType_t uxTasks, uint32_t ulPeriodRunTime )
+{
+UBaseType_t x;
+const StatsPrevious_t *pxPrevious;
+unsigned long ulPerMille;
+char cLine[ statsLINE_LENGTH ];
+
+	/* Avoid a divide by zero below. */
+	ulPeriodRunTime /= statsPER_MILLE;
+	if( ulPeriodRunTime == 0UL )
+	{
+		ulPeriodRunTime = 1UL;
+	}
+
+	prvPrint( "Task\t\tCPU\tSwitches\r\n" );
+
+	for( x = 0; x < uxTasks; x++ )
+	{
+		pxPrevious = prvFindPrevious( xStatus[ x ].xHandle );
+		ulPerMille = ( unsigned long ) ( ( xStatus[ x ].ulRunTimeCounter - pxPrevious->ulRunTimeCounter ) / ulPeriodRunTime );
+
+		snprintf( cLine, sizeof( cLine ), "%s\t\t%lu.%lu%%\t%lu\r\n",
+				  xStatus[ x ].pcTaskName,
+				  ulPerMille / 10UL,
+				  ulPerMille % 10UL,
+				  ( unsigned long ) ( xStatus[ x ].ulSwitchInCount - pxPrevious->ulSwitchInCount ) );
+		prvPrint( cLine );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#ifdef configHEAP_POOL_BLOCK_SIZES
+
+	static void prvPrintHeapPool( void )
+	{
+	UBaseType_t x;
+	HeapPoolClassStats_t xClassStats;
+	char cLine[ statsLINE_LENGTH ];
+
+		prvPrint( "Block\tUsed\tPeak\tFailed\r\n" );
+
+		for( x = 0; x < uxPortGetHeapPoolClassCount(); x++ )
+		{
+			vPortGetHeapPoolClassStats( x, &xClassStats );
+
+			snprintf( cLine, sizeof( cLine ), "%lu\t%lu/%lu\t%lu\t%lu\r\n",
+					  ( unsigned long ) xClassStats.xBlockSize,
+					  ( unsigned long ) ( xClassStats.xBlockCount - xClassStats.xFreeBlocks ),
+					  ( unsigned long ) xClassStats.xBlockCount,
+					  ( unsigned long ) ( xClassStats.xBlockCount - xClassStats.xMinimumEverFreeBlocks ),
+					  ( unsigned long ) xClassStats.xFailedAllocations );
+			prvPrint( cLine );
+		}
+	}
+
+#endif /* configHEAP_POOL_BLOCK_SIZES */
+/*-----------------------------------------------------------*/
+
+static const StatsPrevious_t *prvFindPrevious( TaskHandle_t xHandle )
+{
+static const StatsPrevious_t xNone = { NULL, 0, 0 };
+const StatsPrevious_t *pxReturn = &xNone;
+UBaseType_t x;
+
+	for( x = 0; x < statsMAX_TASKS; x++ )
+	{
+		if( xPrevious[ x ].xHandle == xHandle )
+		{
+			pxReturn = &( xPrevious[ x ] );
+			break;
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRememberCounters( UBaseType_t uxTasks )
+{
+UBaseType_t x;
+
+	for( x = 0; x < statsMAX_TASKS; x++ )
+	{
+		if( x < uxTasks )
+		{
+			xPrevious[ x ].xHandle = xStatus[ x ].xHandle;
+			xPrevious[ x ].ulRunTimeCounter = xStatus[ x ].ulRunTimeCounter;
+			xPrevious[ x ].ulSwitchInCount = xStatus[ x ].ulSwitchInCount;
+		}
+		else
+		{
+			xPrevious[ x ].xHandle = NULL;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrint( const char *pcString )
+{
+unsigned short usLength = 0;
+
+	while( pcString[ usLength ] != '\0' )
+	{
+		usLength++;
+	}
+
+	/* Wait for room rather than drop the line. */
+	( void ) xSerialWrite( ( const signed char * ) pcString, usLength, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
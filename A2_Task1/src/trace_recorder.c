@@ -0,0 +1,316 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	BINARY TRACE RECORDER - see trace_recorder.h.
+*/
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo application includes. */
+#include "serial.h"
+
+/* The recorder is only built when it is enabled in FreeRTOSConfig.h, which
+then includes trace_recorder.h. */
+#if( configUSE_TRACE_RECORDER == 1 )
+
+/*-----------------------------------------------------------*/
+
+#define traceINDEX_MASK					( traceRECORDER_BUFFER_RECORDS - 1UL )
+
+/* As many records as fit in one write to the serial driver, which accepts no
+more than its transmit buffer of serTX_BUFFER_SIZE characters. */
+#define traceFRAME_RECORDS				( ( serTX_BUFFER_SIZE - traceFRAME_HEADER_BYTES ) / traceRECORD_BYTES )
+#define traceFRAME_BYTES				( traceFRAME_HEADER_BYTES + ( traceFRAME_RECORDS * traceRECORD_BYTES ) )
+
+/* The number of ticks the UART takes to send a full frame, at ten bits a
+character. */
+#define traceFRAME_TICKS				( ( TickType_t ) ( ( ( traceFRAME_BYTES * 10UL * configTICK_RATE_HZ ) / traceRECORDER_BAUD_RATE ) + 1UL ) )
+
+#define traceSTACK_SIZE					configMINIMAL_STACK_SIZE
+#define traceMAX_DROPPED				( 0xffffUL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that drains the ring buffer over UART1.
+ */
+static void vTraceDrainTask( void *pvParameters );
+
+/*
+ * Take up to traceFRAME_RECORDS complete records from the ring buffer and send
+ * them as one frame.  Returns the number of records sent.
+ */
+static unsigned long prvSendFrame( void );
+
+/*
+ * Claim the next record in the ring buffer.
+ */
+static uint32_t prvClaimRecord( void );
+
+/*
+ * Append a 16 or 32 bit value to a frame, little endian.
+ */
+static unsigned char *prvPut16( unsigned char *pucFrame, uint16_t usValue );
+static unsigned char *prvPut32( unsigned char *pucFrame, uint32_t ulValue );
+
+/*-----------------------------------------------------------*/
+
+static volatile TraceRecord_t xTraceBuffer[ traceRECORDER_BUFFER_RECORDS ];
+
+/* The number of records ever claimed, and ever taken by the drain task.  Only
+the low bits index the ring buffer. */
+static volatile uint32_t ulTraceHead = 0;
+static uint32_t ulTraceTail = 0;
+
+/* Records overwritten before they could be sent, not yet reported. */
+static uint32_t ulTraceDropped = 0;
+
+static uint8_t ucTraceQueueNumber = 0;
+
+/* The task last recorded as switched in. */
+static uint8_t ucTraceRunningTask = 0;
+
+/* The frame is built here rather than on the stack of the drain task. */
+static unsigned char ucTraceFrame[ traceFRAME_BYTES ];
+
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( unsigned long ulPriority )
+{
+	xTaskCreate( vTraceDrainTask, "Trace", traceSTACK_SIZE, NULL, ( UBaseType_t ) ulPriority, ( TaskHandle_t * ) NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvClaimRecord( void )
+{
+uint32_t ulClaimed;
+
+	#if defined( __CC_ARM )
+	{
+	int iWasMasked;
+
+		/* The ARM7TDMI has no atomic read-modify-write instruction, so IRQ is
+		masked for the increment.  __disable_irq() returns non zero if it was
+		already masked, as it is when the hook is called from an interrupt or a
+		critical section. */
+		iWasMasked = __disable_irq();
+		ulClaimed = ulTraceHead;
+		ulTraceHead = ulClaimed + 1UL;
+
+		if( iWasMasked == 0 )
+		{
+			__enable_irq();
+		}
+	}
+	#else
+	{
+		/* The simulated interrupts of the Posix port are signals, which can
+		interrupt the task at any instruction. */
+		ulClaimed = __atomic_fetch_add( &ulTraceHead, 1UL, __ATOMIC_RELAXED );
+	}
+	#endif
+
+	return ulClaimed;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecord( uint8_t ucEvent, uint8_t ucObject, uint16_t usParam )
+{
+volatile TraceRecord_t *pxRecord;
+
+	pxRecord = &( xTraceBuffer[ prvClaimRecord() & traceINDEX_MASK ] );
+
+	/* The event code is written last, as the drain task takes a record to be
+	complete once its event code is not traceEVENT_NONE. */
+	pxRecord->ulTimestamp = traceRECORDER_TIMESTAMP();
+	pxRecord->ucObject = ucObject;
+	pxRecord->usParam = usParam;
+	pxRecord->ucEvent = ucEvent;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordTaskSwitchedIn( uint8_t ucTask, uint16_t usPriority )
+{
+	/* The scheduler selects a task on every yield and every tick, but only a
+	change of task is recorded - an idle task that yields would otherwise fill
+	the ring buffer.  Called from the context switch only, with interrupts
+	masked. */
+	if( ucTask != ucTraceRunningTask )
+	{
+		ucTraceRunningTask = ucTask;
+		vTraceRecord( traceEVENT_TASK_SWITCHED_IN, ucTask, usPriority );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordTaskCreate( uint8_t ucTask, uint16_t usPriority, const char *pcName )
+{
+volatile TraceRecord_t *pxRecord;
+uint16_t usOffset = 0, usRecordOffset;
+uint32_t ulCharacters, ulShift;
+
+	vTraceRecord( traceEVENT_TASK_CREATE, ucTask, usPriority );
+
+	/* The name follows, four characters to a record in place of the
+	timestamp, in the order they are sent. */
+	do
+	{
+		ulCharacters = 0;
+		usRecordOffset = usOffset;
+
+		for( ulShift = 0; ulShift < 32UL; ulShift += 8UL )
+		{
+			if( ( usOffset < ( uint16_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ usOffset ] != '\0' ) )
+			{
+				ulCharacters |= ( ( uint32_t ) ( unsigned char ) pcName[ usOffset ] ) << ulShift;
+				usOffset++;
+			}
+		}
+
+		pxRecord = &( xTraceBuffer[ prvClaimRecord() & traceINDEX_MASK ] );
+		pxRecord->ulTimestamp = ulCharacters;
+		pxRecord->ucObject = ucTask;
+		pxRecord->usParam = usRecordOffset;
+		pxRecord->ucEvent = traceEVENT_TASK_NAME;
+
+	} while( ( ulCharacters & 0xff000000UL ) != 0UL );
+}
+/*-----------------------------------------------------------*/
+
+uint8_t ucTraceRecordQueueCreate( uint8_t ucQueueType )
+{
+uint8_t ucQueue;
+
+	/* Queues are created with the scheduler running, so the number is taken
+	in a critical section. */
+	taskENTER_CRITICAL();
+	{
+		ucTraceQueueNumber++;
+		ucQueue = ucTraceQueueNumber;
+	}
+	taskEXIT_CRITICAL();
+
+	vTraceRecord( traceEVENT_QUEUE_CREATE, ucQueue, ucQueueType );
+
+	return ucQueue;
+}
+/*-----------------------------------------------------------*/
+
+static void vTraceDrainTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Send frames until the ring buffer is empty, giving the UART the
+		time it needs to send each one. */
+		while( prvSendFrame() != 0UL )
+		{
+			vTaskDelay( traceFRAME_TICKS );
+		}
+
+		vTaskDelay( traceFRAME_TICKS );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvSendFrame( void )
+{
+uint32_t ulUnread;
+unsigned long ulRecords = 0, ulDropped;
+volatile TraceRecord_t *pxRecord;
+unsigned char *pucFrame = &( ucTraceFrame[ traceFRAME_HEADER_BYTES ] );
+
+	/* Skip anything that has been overwritten. */
+	ulUnread = ulTraceHead - ulTraceTail;
+	if( ulUnread > traceRECORDER_BUFFER_RECORDS )
+	{
+		ulTraceDropped += ulUnread - traceRECORDER_BUFFER_RECORDS;
+		ulTraceTail = ulTraceHead - traceRECORDER_BUFFER_RECORDS;
+	}
+
+	while( ( ulRecords < traceFRAME_RECORDS ) && ( ulTraceTail != ulTraceHead ) )
+	{
+		pxRecord = &( xTraceBuffer[ ulTraceTail & traceINDEX_MASK ] );
+
+		if( pxRecord->ucEvent == traceEVENT_NONE )
+		{
+			/* Claimed but not yet complete. */
+			break;
+		}
+
+		pucFrame = prvPut32( pucFrame, pxRecord->ulTimestamp );
+		*pucFrame++ = pxRecord->ucEvent;
+		*pucFrame++ = pxRecord->ucObject;
+		pucFrame = prvPut16( pucFrame, pxRecord->usParam );
+
+		pxRecord->ucEvent = traceEVENT_NONE;
+		ulTraceTail++;
+		ulRecords++;
+	}
+
+	if( ( ulRecords != 0UL ) || ( ulTraceDropped != 0UL ) )
+	{
+		ulDropped = ( ulTraceDropped > traceMAX_DROPPED ) ? traceMAX_DROPPED : ulTraceDropped;
+		ulTraceDropped -= ulDropped;
+
+		pucFrame = prvPut32( ucTraceFrame, traceFRAME_SYNC );
+		pucFrame = prvPut32( pucFrame, traceRECORDER_TIMESTAMP_HZ );
+		pucFrame = prvPut16( pucFrame, ( uint16_t ) ulRecords );
+		( void ) prvPut16( pucFrame, ( uint16_t ) ulDropped );
+
+		while( vSerialPutString( ( const signed char * ) ucTraceFrame, ( unsigned short ) ( traceFRAME_HEADER_BYTES + ( ulRecords * traceRECORD_BYTES ) ) ) == pdFALSE )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+
+	return ulRecords;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char *prvPut16( unsigned char *pucFrame, uint16_t usValue )
+{
+	pucFrame[ 0 ] = ( unsigned char ) usValue;
+	pucFrame[ 1 ] = ( unsigned char ) ( usValue >> 8 );
+
+	return pucFrame + 2;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char *prvPut32( unsigned char *pucFrame, uint32_t ulValue )
+{
+	pucFrame = prvPut16( pucFrame, ( uint16_t ) ulValue );
+
+	return prvPut16( pucFrame, ( uint16_t ) ( ulValue >> 16 ) );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER */
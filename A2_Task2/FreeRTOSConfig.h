@@ -51,10 +51,30 @@
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
 #define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
 #define configMAX_TASK_NAME_LEN		( 8 )
-#define configUSE_TRACE_FACILITY	0
+#define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 
+/* The size classes of heap_pool.c, smallest block first, and the number of
+blocks of each, carved out of the configTOTAL_HEAP_SIZE heap: task control
+blocks and queues, minimal task stacks, and larger task stacks.  The sizes
+scale with the pointer and stack word so the same classes fit the Linux host
+build.  The run time stats task reports how many blocks of each class have
+been in use at once. */
+#define configHEAP_POOL_BLOCK_SIZES		{ 32 * sizeof( void * ), configMINIMAL_STACK_SIZE * sizeof( StackType_t ), 4 * configMINIMAL_STACK_SIZE * sizeof( StackType_t ) }
+#define configHEAP_POOL_BLOCK_COUNTS	{ 12, 6, 2 }
+
+/* Stop the tick and put the processor in idle mode when no task needs to run
+for at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks. */
+#define configUSE_TICKLESS_IDLE		1
+
+/* Run time stats gathering definitions.  Timer 1 is the run time stats clock -
+see configTimer1() in main.c. */
+extern void configTimer1( void );
+#define configGENERATE_RUN_TIME_STATS				1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	configTimer1()
+#define portGET_RUN_TIME_COUNTER_VALUE()			T1TC
+
 #define configQUEUE_REGISTRY_SIZE 	0
 
 /* Co-routine definitions. */
@@ -72,6 +92,59 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 
+/* Set to 1 to record the kernel trace hooks and drain them over UART1 - see
+trace_recorder.h. */
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER	0
+#endif
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	#include "trace_recorder.h"
+#endif
+
+/* Set to 1 to record the task, call site and size of every heap block and
+write them with the run time stats - see heap_monitor.h. */
+#ifndef configUSE_HEAP_MONITOR
+	#define configUSE_HEAP_MONITOR		0
+#endif
+
+#if( configUSE_HEAP_MONITOR == 1 )
+	#include "heap_monitor.h"
+#endif
+
+/* Set to 1 to run time critical callbacks straight from an interrupt, rather
+than from the timer task - see hard_timer.h.  They run from the tick interrupt
+when configHARD_TIMER_SOURCE is 0, or from a Timer1 match interrupt when it is
+1. */
+#ifndef configUSE_HARD_TIMERS
+	#define configUSE_HARD_TIMERS		0
+#endif
+
+#ifndef configHARD_TIMER_SOURCE
+	#define configHARD_TIMER_SOURCE		0
+#endif
+
+#if( ( configUSE_HARD_TIMERS == 1 ) && ( configHARD_TIMER_SOURCE == 0 ) )
+	#undef configUSE_TICK_HOOK
+	#define configUSE_TICK_HOOK			1
+#endif
+
+/* Set to 1 to log from tasks and interrupts through the logging service, which
+formats the records, or frames them for Tools/log_decode.c, in a task of its own
+- see logger.h. */
+#ifndef configUSE_LOGGER
+	#define configUSE_LOGGER			0
+#endif
+
+#if( configUSE_LOGGER == 1 )
+	#undef INCLUDE_xTaskGetCurrentTaskHandle
+	#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#endif
 
+/* Set to 1 to send and receive frames of binary data, with a CRC and sequence
+numbers, over a serial port - see frame.h. */
+#ifndef configUSE_FRAMES
+	#define configUSE_FRAMES			0
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
@@ -3,19 +3,45 @@
 #ifndef GPIO_CFG_H_
 #define GPIO_CFG_H_
 
-/************* Type def section ************/
-
-typedef struct
-{
-	portX_t Port;
-	pinX_t Pin;
-	pinDir_t Direction;
-	
-}PinConfig_t;
-
-
-extern PinConfig_t PinConfig_array[];
-extern uint16_t PinConfig_array_size;
-
-
-#endif 
+/************* Pin table section ************/
+
+/* Every pin the application uses, one PIN_ENTRY(Name, Port, Pin, Direction)
+   a line. The table is expanded at compile time, so it takes no RAM: GPIO.h
+   makes GPIO_read_<Name>() for each pin, GPIO_write_<Name>() for each output,
+   and the direction masks GPIO_init() writes. A pin listed twice, or not
+   one of PIN0 to PIN15 of PORT_0 or PORT_1, fails the build in GPIO_cfg.c */
+#define GPIO_PIN_TABLE(PIN_ENTRY) \
+	PIN_ENTRY(P0_16, PORT_0, PIN0, INPUT) \
+	PIN_ENTRY(P0_17, PORT_0, PIN1, OUTPUT) \
+	PIN_ENTRY(P0_18, PORT_0, PIN2, OUTPUT) \
+	PIN_ENTRY(P0_19, PORT_0, PIN3, OUTPUT) \
+	PIN_ENTRY(P0_20, PORT_0, PIN4, OUTPUT) \
+	PIN_ENTRY(P0_21, PORT_0, PIN5, OUTPUT) \
+	PIN_ENTRY(P0_22, PORT_0, PIN6, OUTPUT) \
+	PIN_ENTRY(P0_23, PORT_0, PIN7, OUTPUT) \
+	PIN_ENTRY(P0_24, PORT_0, PIN8, OUTPUT) \
+	PIN_ENTRY(P0_25, PORT_0, PIN9, OUTPUT) \
+	PIN_ENTRY(P0_26, PORT_0, PIN10, OUTPUT) \
+	PIN_ENTRY(P0_27, PORT_0, PIN11, OUTPUT) \
+	PIN_ENTRY(P0_29, PORT_0, PIN13, OUTPUT) \
+	PIN_ENTRY(P0_30, PORT_0, PIN14, OUTPUT) \
+	PIN_ENTRY(P0_31, PORT_0, PIN15, OUTPUT) \
+	\
+	PIN_ENTRY(P1_16, PORT_1, PIN0, OUTPUT) \
+	PIN_ENTRY(P1_17, PORT_1, PIN1, OUTPUT) \
+	PIN_ENTRY(P1_18, PORT_1, PIN2, OUTPUT) \
+	PIN_ENTRY(P1_19, PORT_1, PIN3, OUTPUT) \
+	PIN_ENTRY(P1_20, PORT_1, PIN4, OUTPUT) \
+	PIN_ENTRY(P1_21, PORT_1, PIN5, OUTPUT) \
+	PIN_ENTRY(P1_22, PORT_1, PIN6, OUTPUT) \
+	PIN_ENTRY(P1_23, PORT_1, PIN7, OUTPUT) \
+	PIN_ENTRY(P1_24, PORT_1, PIN8, OUTPUT) \
+	PIN_ENTRY(P1_25, PORT_1, PIN9, OUTPUT) \
+	PIN_ENTRY(P1_26, PORT_1, PIN10, OUTPUT) \
+	PIN_ENTRY(P1_27, PORT_1, PIN11, OUTPUT) \
+	PIN_ENTRY(P1_29, PORT_1, PIN13, OUTPUT) \
+	PIN_ENTRY(P1_30, PORT_1, PIN14, OUTPUT) \
+	PIN_ENTRY(P1_31, PORT_1, PIN15, OUTPUT)
+
+
+#endif
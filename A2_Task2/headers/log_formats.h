@@ -0,0 +1,42 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	The formats of the logger - see logger.h.  One loggerFORMAT( <name>,
+	"<format>" ) line per format, whose name is passed to xLoggerPrint().
+	Every conversion must take an unsigned long or a long.
+
+	There is no include guard, as logger.h and logger.c each include this file
+	with their own definition of loggerFORMAT().  Tools/log_decode.c includes it
+	too, so a capture has to be decoded with the same list it was made with.
+*/
+
+loggerFORMAT( logSTARTED,			"started" )
+loggerFORMAT( logVALUE,				"value %lu" )
+loggerFORMAT( logSTACK_LOW,			"stack low, %lu words left" )
+loggerFORMAT( logQUEUE_FULL,		"queue %lu full" )
+loggerFORMAT( logTIMEOUT,			"timeout after %lu ticks" )
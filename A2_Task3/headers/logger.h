@@ -0,0 +1,204 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	LOGGER.
+
+	A log call does not format anything.  It copies a format number and up to
+	loggerMAX_ARGS raw arguments into a record in a RAM ring buffer, and
+	returns, so it is cheap, never blocks, needs no printf() on the stack of the
+	calling task, and can be made from interrupts.  A single low priority
+	drain task, created by vLoggerStart(), takes the records and writes them
+	over UART1 through serial.c, either formatted as text or, with
+	loggerBINARY set to 1, as binary frames that Tools/log_decode.c formats on
+	the host.
+
+	The formats are listed once, in log_formats.h, as
+	loggerFORMAT( <name>, "<format>" ) lines.  The names become the numbers
+	passed to the log calls, and the host decoder includes the same file for
+	the strings.  Every conversion in a format must take an unsigned long or a
+	long (%lu, %ld, %lx, ...), as each argument is passed to printf() as an
+	unsigned long.  Strings cannot be passed.
+
+	When the ring buffer is full the record is dropped, and the drop is counted
+	against the task that made the call.  The drain task reports the drops of
+	each task once it has caught up.  The tasks are told apart in a table of
+	loggerMAX_PRODUCERS entries, filled as they first log.  Records written
+	from interrupts, or by tasks once the table is full, are counted against
+	the first entry, "other".  An entry is found by the task handle, so a task
+	that is deleted has to be passed to vLoggerForgetTask() once it has logged
+	for the last time.  Otherwise its entry is never freed, and a task created
+	later at the same address takes on its name and drops.
+
+	Records below the level set with vLoggerSetLevel() are discarded when the
+	call is made, and not counted as drops.
+
+	Set configUSE_LOGGER to 1 in FreeRTOSConfig.h to build it.
+*/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/*-----------------------------------------------------------
+ * Wire format of the binary frames.  All fields are little endian.
+ *----------------------------------------------------------*/
+
+/* Every frame starts with this header, then usRecords records. */
+#define loggerFRAME_SYNC				( 0x31474f4cUL )	/* "LOG1". */
+#define loggerFRAME_HEADER_BYTES		( 12 )
+#define loggerMAX_ARGS					( 3 )
+#define loggerRECORD_BYTES				( 8 + ( 4 * loggerMAX_ARGS ) )
+
+typedef struct LOG_FRAME_HEADER
+{
+	uint32_t ulSync;			/* loggerFRAME_SYNC. */
+	uint32_t ulTimestampHz;		/* The rate at which the timestamps count. */
+	uint16_t usRecords;			/* The number of records that follow. */
+	uint16_t usReserved;		/* Zero. */
+} LogFrameHeader_t;
+
+typedef struct LOG_RECORD
+{
+	uint32_t ulTimestamp;		/* When the call was made. */
+	uint16_t usFormat;			/* The number of the format in log_formats.h, or one of the loggerRECORD_ values below. */
+	uint8_t ucLevel;			/* One of the loggerLEVEL_ values below. */
+	uint8_t ucProducer;			/* The entry of the task that made the call in the producer table. */
+	uint32_t ulArgs[ loggerMAX_ARGS ];
+} LogRecord_t;
+
+/* The levels, from least to most severe. */
+#define loggerLEVEL_DEBUG				( 0 )
+#define loggerLEVEL_INFO				( 1 )
+#define loggerLEVEL_WARNING				( 2 )
+#define loggerLEVEL_ERROR				( 3 )
+
+/* Records written by the drain task itself.  Sent, in binary, before the
+first record of a producer. */
+#define loggerRECORD_PRODUCER_NAME		( 0xfffe )	/* Args: the name, NUL padded. */
+#define loggerRECORD_DROPPED			( 0xffff )	/* Args: records dropped since the last report, and in total. */
+
+/* The format numbers, from log_formats.h. */
+#ifndef loggerFORMATS_HEADER
+	#define loggerFORMATS_HEADER		"log_formats.h"
+#endif
+
+#define loggerFORMAT( xName, pcFormat )	xName,
+
+typedef enum
+{
+	#include loggerFORMATS_HEADER
+	loggerFORMAT_COUNT
+} LogFormat_t;
+
+#undef loggerFORMAT
+
+#ifndef loggerHOST_DECODER
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include logger.h"
+#endif
+
+#if( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+	#error The logger needs INCLUDE_xTaskGetCurrentTaskHandle to be set to 1 in FreeRTOSConfig.h, to tell the tasks apart.
+#endif
+
+/*-----------------------------------------------------------
+ * Logger configuration.  Each can be set in FreeRTOSConfig.h.
+ *----------------------------------------------------------*/
+
+/* The number of records the ring buffer holds.  Must be a power of two. */
+#ifndef loggerBUFFER_RECORDS
+	#define loggerBUFFER_RECORDS		( 32UL )
+#endif
+
+#if( ( loggerBUFFER_RECORDS & ( loggerBUFFER_RECORDS - 1UL ) ) != 0 )
+	#error loggerBUFFER_RECORDS must be a power of two.
+#endif
+
+/* The number of tasks whose drops are counted separately, including the
+"other" entry. */
+#ifndef loggerMAX_PRODUCERS
+	#define loggerMAX_PRODUCERS			( 8 )
+#endif
+
+/* Set to 1 to send binary frames for Tools/log_decode.c, rather than text. */
+#ifndef loggerBINARY
+	#define loggerBINARY				0
+#endif
+
+/* The longest line the drain task formats, including the timestamp, level
+and task name in front of the message. */
+#ifndef loggerLINE_LENGTH
+	#define loggerLINE_LENGTH			( 96 )
+#endif
+
+/* The stack of the drain task, which calls snprintf() when sending text. */
+#ifndef loggerSTACK_SIZE
+	#define loggerSTACK_SIZE			( configMINIMAL_STACK_SIZE * 3 )
+#endif
+
+/*-----------------------------------------------------------
+ * API.
+ *----------------------------------------------------------*/
+
+/*
+ * Creates the drain task.  Records logged before it is called are kept, up to
+ * the size of the ring buffer.  UART1 can still be written by others, a line
+ * or a frame at a time.
+ */
+void vLoggerStart( UBaseType_t uxPriority );
+
+/*
+ * Log a record.  usFormat is one of the names in log_formats.h.  Returns
+ * pdFALSE if the record was dropped, or discarded by the level filter.
+ */
+BaseType_t xLoggerPrint( uint8_t ucLevel, uint16_t usFormat, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2 );
+BaseType_t xLoggerPrintFromISR( uint8_t ucLevel, uint16_t usFormat, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2, BaseType_t *pxHigherPriorityTaskWoken );
+
+/*
+ * Records below ucLevel are discarded from now on.  The level is
+ * loggerLEVEL_DEBUG to start with, so every record is kept.
+ */
+void vLoggerSetLevel( uint8_t ucLevel );
+uint8_t ucLoggerGetLevel( void );
+
+/*
+ * The number of records a task has had dropped, or NULL for the "other"
+ * entry.  0 for a task that has not logged.
+ */
+uint32_t ulLoggerGetDropped( TaskHandle_t xTask );
+
+/*
+ * Free the producer table entry of a task that will not log again, such as
+ * one about to be deleted.  The drain task frees it once the task's records
+ * and drops have been sent.
+ */
+void vLoggerForgetTask( TaskHandle_t xTask );
+
+#endif /* loggerHOST_DECODER */
+
+#endif /* LOGGER_H */
@@ -27,10 +27,10 @@
 
 	INCLUDE portmacro.inc
 
-	;The UART interrupt entry point is defined within an assembly wrapper
-	;within this file.  This takes care of the task context saving before it
-	;calls the main handler (vUART_ISRHandler()) which is written in C within
-	;serial.c.  The execution of the handler can unblock tasks that were blocked
+	;The UART interrupt entry points are defined within assembly wrappers
+	;within this file.  These take care of the task context saving before they
+	;call the main handler (vUART_ISRHandler() for UART1, vUART0_ISRHandler()
+	;for UART0) which is written in C within serial.c.  The execution of the handler can unblock tasks that were blocked
 	;waiting for UART events.  Once the handler completes the asm wrapper
 	;finishes off by	restoring the context of whichever task is now selected to
 	;enter the RUNNING state (which might now be a different task to that which
@@ -38,6 +38,11 @@
 	IMPORT vUART_ISRHandler
 	EXPORT vUART_ISREntry
 
+	;vUART0_ISRHandler() is only defined when serUSE_UART0 is 1, and
+	;vUART0_ISREntry is only installed in the VIC then.
+	IMPORT vUART0_ISRHandler [WEAK]
+	EXPORT vUART0_ISREntry
+
 	;/* Interrupt entry must always be in ARM mode. */
 	ARM
 	AREA	|.text|, CODE, READONLY
@@ -60,4 +65,17 @@ vUART_ISREntry
 	; interrupted.
 	portRESTORE_CONTEXT
 
+
+vUART0_ISREntry
+
+	PRESERVE8
+
+	portSAVE_CONTEXT
+
+	LDR R0, =vUART0_ISRHandler
+	MOV LR, PC
+	BX R0
+
+	portRESTORE_CONTEXT
+
 	END
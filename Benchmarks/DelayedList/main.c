@@ -0,0 +1,294 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Delayed task list benchmark.
+ *
+ * Measures, in CPU cycles, the cost of adding a task to the delayed tasks as
+ * the number of tasks already delayed grows, with configUSE_DELAYED_TASK_WHEEL
+ * set to 0 (vListInsert() into the delayed list sorted by wake time, as
+ * prvAddCurrentTaskToDelayedList() does by default) or 1 (xListWheelInsert()
+ * into the delayed task wheel).  The list items are inserted directly so the
+ * cost of vTaskDelay() that does not depend on the number of delayed tasks
+ * does not hide the difference.
+ *
+ * A number of tasks then block for pseudo random times, some beyond the reach
+ * of the wheel, and check they are never woken early, before the results are
+ * printed on UART1 and the scheduler is stopped (which ends the process when
+ * running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "list.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The largest number of delayed tasks the insertion cost is measured with, and
+the number of insertions timed for each count. */
+#define mainMAX_DELAYED_ITEMS	( 256UL )
+#define mainINSERTIONS			( 20000UL )
+
+/* Wake times are spread over this many ticks, which is within the reach of a
+two level wheel. */
+#define mainMAX_DELAY			( 1000UL )
+
+/* The tasks that check the wake times block for up to this many ticks, which
+is beyond the reach of a two level wheel, and run for mainCHECK_TICKS. */
+#define mainCHECK_TASKS			( 16UL )
+#define mainCHECK_MAX_DELAY		( 1500UL )
+#define mainCHECK_TICKS			( ( TickType_t ) 4000 )
+
+#define mainBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define mainCHECK_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	#define mainDELAYED_MODE	"wheel"
+#else
+	#define mainDELAYED_MODE	"sorted"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times the insertions, runs the wake time check, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Repeatedly blocks for a pseudo random time and checks when it wakes.
+ */
+static void prvCheckTask( void *pvParameters );
+
+/*
+ * Returns the median cost of inserting into ulItems delayed items.
+ */
+static unsigned long prvTimeInsertions( unsigned long ulItems );
+
+/*
+ * A small linear congruential generator, so every build sees the same
+ * sequence of wake times.
+ */
+static unsigned long prvRandom( unsigned long *pulSeed );
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	static ListWheel_t xDelayed;
+#else
+	static List_t xDelayed;
+#endif
+
+static ListItem_t xItems[ mainMAX_DELAYED_ITEMS + 1UL ];
+
+/* Insertions are counted in a histogram of one cycle buckets, and the median
+is reported as it is not skewed by the occasional insertion that is
+interrupted. */
+static BenchHistogram_t xHistogram;
+
+/* Written by the check tasks. */
+static volatile unsigned long ulWakes = 0, ulEarlyWakes = 0, ulMaxLateness = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, mainBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( unsigned long *pulSeed )
+{
+	*pulSeed = ( *pulSeed * 1103515245UL ) + 12345UL;
+
+	return ( *pulSeed >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvTimeInsertions( unsigned long ulItems )
+{
+unsigned long ulItem, ulRound, ulStart, ulSeed = 1UL;
+ListItem_t *pxItem;
+const TickType_t xNow = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+	#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		vListWheelInitialise( &xDelayed, xNow );
+	}
+	#else
+	{
+		vListInitialise( &xDelayed );
+	}
+	#endif
+
+	/* ulItems + 1 items are cycled through, so every timed insertion is made
+	with ulItems items already delayed. */
+	for( ulItem = 0; ulItem <= ulItems; ulItem++ )
+	{
+		vListInitialiseItem( &( xItems[ ulItem ] ) );
+	}
+
+	for( ulRound = 0; ulRound < ( mainINSERTIONS + ulItems ); ulRound++ )
+	{
+		pxItem = &( xItems[ ulRound % ( ulItems + 1UL ) ] );
+
+		if( listLIST_ITEM_CONTAINER( pxItem ) != NULL )
+		{
+			( void ) uxListRemove( pxItem );
+		}
+
+		listSET_LIST_ITEM_VALUE( pxItem, xNow + ( TickType_t ) 1 + ( TickType_t ) ( prvRandom( &ulSeed ) % mainMAX_DELAY ) );
+
+		/* Only time the insertions made once ulItems are already delayed. */
+		ulStart = benchGET_CYCLE_COUNT();
+
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			( void ) xListWheelInsert( &xDelayed, pxItem, xNow );
+		}
+		#else
+		{
+			vListInsert( &xDelayed, pxItem );
+		}
+		#endif
+
+		if( ulRound >= ulItems )
+		{
+			vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+		}
+	}
+
+	return ulBenchHistogramMedian( &xHistogram );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulItems, ulRound, ulStart, ulOverhead, ulMedian;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	/* The cost of the two cycle counter reads made around each insertion,
+	measured in the same way as the insertions themselves. */
+	for( ulRound = 0; ulRound < mainINSERTIONS; ulRound++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xHistogram );
+
+	for( ulItems = 1UL; ulItems <= mainMAX_DELAYED_ITEMS; ulItems *= 4UL )
+	{
+		ulMedian = prvTimeInsertions( ulItems );
+		ulMedian = ( ulMedian > ulOverhead ) ? ( ulMedian - ulOverhead ) : 0;
+
+		sprintf( cBuffer, "delayed list: %-6s %4lu delayed, %lu insertions, median %lu cycles\r\n",
+				 mainDELAYED_MODE,
+				 ulItems,
+				 mainINSERTIONS,
+				 ulMedian );
+		vBenchPrint( cBuffer );
+	}
+
+	/* Check the kernel wakes delayed tasks on time. */
+	for( ulRound = 0; ulRound < mainCHECK_TASKS; ulRound++ )
+	{
+		xTaskCreate( prvCheckTask, "Check", configMINIMAL_STACK_SIZE, ( void * ) ( ulRound + 1UL ), mainCHECK_PRIORITY, NULL );
+	}
+
+	vTaskDelay( mainCHECK_TICKS );
+
+	sprintf( cBuffer, "delayed list: %-6s %lu wakes, %lu early, at most %lu ticks late\r\n",
+			 mainDELAYED_MODE,
+			 ulWakes,
+			 ulEarlyWakes,
+			 ulMaxLateness );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void *pvParameters )
+{
+unsigned long ulSeed = ( unsigned long ) pvParameters;
+TickType_t xDelay, xStart, xSlept;
+
+	for( ;; )
+	{
+		xDelay = ( TickType_t ) 1 + ( TickType_t ) ( prvRandom( &ulSeed ) % mainCHECK_MAX_DELAY );
+
+		xStart = xTaskGetTickCount();
+		vTaskDelay( xDelay );
+		xSlept = xTaskGetTickCount() - xStart;
+
+		/* The tick count can change between reading it and blocking, so the
+		task can appear to have slept one tick too long, but never too little. */
+		taskENTER_CRITICAL();
+		{
+			ulWakes++;
+
+			if( xSlept < xDelay )
+			{
+				ulEarlyWakes++;
+			}
+			else if( ( unsigned long ) ( xSlept - xDelay ) > ulMaxLateness )
+			{
+				ulMaxLateness = ( unsigned long ) ( xSlept - xDelay );
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
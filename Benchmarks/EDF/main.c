@@ -0,0 +1,359 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Earliest deadline first benchmark.
+ *
+ * Runs a set of periodic tasks whose jobs use the processor for a fixed number
+ * of ticks, and counts the jobs that complete after their deadline, with the
+ * tasks at rate monotonic fixed priorities (benchUSE_EDF 0) or all at one
+ * priority so they are scheduled by earliest deadline first (benchUSE_EDF 1).
+ *
+ * The task set uses 97% of the processor.  It cannot be scheduled by fixed
+ * priorities, where the longer period task misses its deadline whenever its
+ * job is released together with the shorter period task, but can be by EDF,
+ * which meets every deadline up to 100%.
+ *
+ * A second run releases jobs by event rather than by time.  A task with a
+ * short period waits, in each job, for a value sent by a task with a long
+ * period that keeps the processor busy.  The value is sent part way through a
+ * tick, alternately to a queue and as a direct to task notification.  With
+ * EDF both tasks have the same priority, so the task woken must preempt the
+ * sender because its deadline is earlier - not wait for the next tick.  The
+ * time from the send to the woken task running is measured, and the wakes
+ * that were only acted on in a later tick are counted.
+ *
+ * The results are printed on UART1, then the scheduler is stopped (which ends
+ * the process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The task set is run for this many ticks: ten times the least common
+multiple of the periods. */
+#define mainRUN_TICKS			( ( TickType_t ) 3500 )
+
+#define mainNUM_TASKS			( 2 )
+
+/* The event run: the periods of the woken task and of the sender, and the
+longest the sender works, in cycles, before it sends. */
+#define mainEVENT_RUN_TICKS		( ( TickType_t ) 2000 )
+#define mainEVENT_PERIOD		( ( TickType_t ) 10 )
+#define mainLOAD_PERIOD			( ( TickType_t ) 10000 )
+#define mainMAX_SEND_DELAY		( 0x3ffffUL )
+#define mainEDF_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainCONTROL_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+#if( benchUSE_EDF == 1 )
+	#define mainSCHEDULING_MODE	"edf"
+#else
+	#define mainSCHEDULING_MODE	"fixed priority"
+#endif
+
+/*-----------------------------------------------------------*/
+
+typedef struct BENCH_TASK
+{
+	TickType_t xExecutionTicks;		/* The processor time each job uses. */
+	TickType_t xPeriod;				/* The time between the releases of the jobs, which is also the deadline. */
+	UBaseType_t uxFixedPriority;	/* The rate monotonic priority - the shorter the period the higher the priority. */
+} BenchTask_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the jobs of the task described by pvParameters.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*
+ * The task woken by the event run, and the task that sends to it.
+ */
+static void prvEventTask( void *pvParameters );
+static void prvLoadTask( void *pvParameters );
+
+/*
+ * Lets the task set run, then the event run, and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static const BenchTask_t xTasks[ mainNUM_TASKS ] =
+{
+	{ 20, 50, tskIDLE_PRIORITY + 2 },
+	{ 40, 70, tskIDLE_PRIORITY + 1 }
+};
+
+static TaskHandle_t xTaskHandles[ mainNUM_TASKS ];
+
+/* The ticks during which each task was running, counted by the tick hook. */
+static volatile TickType_t xRunningTicks[ mainNUM_TASKS ];
+
+/* The number of jobs each task has completed. */
+static volatile unsigned long ulJobs[ mainNUM_TASKS ];
+
+/* The event run.  xEventWaiting is set while the woken task is blocked for
+its value, which is sent at ulSentAt cycles during tick xSentTick. */
+static TaskHandle_t xEventTask = NULL, xLoadTask = NULL;
+static QueueHandle_t xEventQueue = NULL;
+static volatile BaseType_t xEventWaiting = pdFALSE;
+static volatile unsigned long ulSentAt = 0;
+static volatile TickType_t xSentTick = 0;
+static volatile unsigned long ulEvents = 0, ulLateEvents = 0;
+static volatile unsigned long ulTotalLatency = 0, ulLongestLatency = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+BaseType_t xTask;
+UBaseType_t uxPriority;
+
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+
+	for( xTask = 0; xTask < mainNUM_TASKS; xTask++ )
+	{
+		#if( benchUSE_EDF == 1 )
+		{
+			uxPriority = mainEDF_PRIORITY;
+		}
+		#else
+		{
+			uxPriority = xTasks[ xTask ].uxFixedPriority;
+		}
+		#endif
+
+		xTaskCreate( prvPeriodicTask, "Periodic", configMINIMAL_STACK_SIZE, ( void * ) xTask, uxPriority, &( xTaskHandles[ xTask ] ) );
+	}
+
+	xEventQueue = xQueueCreate( 1, sizeof( unsigned long ) );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 2, NULL, mainCONTROL_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+TaskHandle_t xRunning = xTaskGetCurrentTaskHandle();
+BaseType_t xTask;
+
+	for( xTask = 0; xTask < mainNUM_TASKS; xTask++ )
+	{
+		if( xTaskHandles[ xTask ] == xRunning )
+		{
+			xRunningTicks[ xTask ]++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+const BaseType_t xTask = ( BaseType_t ) pvParameters;
+TickType_t xJobEnd;
+
+	/* The first job is released now, at tick 0, for all the tasks. */
+	vTaskSetDeadline( NULL, 0, xTasks[ xTask ].xPeriod );
+
+	for( ;; )
+	{
+		/* Use the processor for the execution time of the job. */
+		xJobEnd = xRunningTicks[ xTask ] + xTasks[ xTask ].xExecutionTicks;
+
+		while( xRunningTicks[ xTask ] < xJobEnd )
+		{
+		}
+
+		ulJobs[ xTask ]++;
+		vTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventTask( void *pvParameters )
+{
+unsigned long ulValue, ulLatency;
+
+	( void ) pvParameters;
+
+	vTaskSetDeadline( NULL, 0, mainEVENT_PERIOD );
+
+	for( ;; )
+	{
+		/* Wait for the value of this job, by queue and by notification in
+		turn. */
+		xEventWaiting = pdTRUE;
+
+		if( ( ulEvents & 0x01UL ) == 0UL )
+		{
+			( void ) xQueueReceive( xEventQueue, &ulValue, portMAX_DELAY );
+		}
+		else
+		{
+			( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+
+		ulLatency = benchGET_CYCLE_COUNT() - ulSentAt;
+
+		if( xTaskGetTickCount() != xSentTick )
+		{
+			ulLateEvents++;
+		}
+
+		ulTotalLatency += ulLatency;
+
+		if( ulLatency > ulLongestLatency )
+		{
+			ulLongestLatency = ulLatency;
+		}
+
+		ulEvents++;
+		vTaskWaitForNextPeriod();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+unsigned long ulRandom = 0x12345678UL, ulSendAt, ulValue = 0;
+
+	( void ) pvParameters;
+
+	vTaskSetDeadline( NULL, 0, mainLOAD_PERIOD );
+
+	/* One job that keeps the processor busy for the whole run, sending the
+	woken task its value some way into a tick. */
+	for( ;; )
+	{
+		if( xEventWaiting != pdFALSE )
+		{
+			ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+			ulSendAt = benchGET_CYCLE_COUNT() + ( ( ulRandom >> 8 ) & mainMAX_SEND_DELAY );
+
+			while( ( long ) ( benchGET_CYCLE_COUNT() - ulSendAt ) < 0L )
+			{
+			}
+
+			xEventWaiting = pdFALSE;
+			xSentTick = xTaskGetTickCount();
+			ulSentAt = benchGET_CYCLE_COUNT();
+
+			if( ( ulEvents & 0x01UL ) == 0UL )
+			{
+				( void ) xQueueSend( xEventQueue, &ulValue, 0 );
+			}
+			else
+			{
+				( void ) xTaskNotifyGive( xEventTask );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+BaseType_t xTask;
+char cBuffer[ 140 ];
+
+	( void ) pvParameters;
+
+	vTaskDelay( mainRUN_TICKS );
+
+	for( xTask = 0; xTask < mainNUM_TASKS; xTask++ )
+	{
+		vTaskSuspend( xTaskHandles[ xTask ] );
+	}
+
+	for( xTask = 0; xTask < mainNUM_TASKS; xTask++ )
+	{
+		sprintf( cBuffer, "edf: %-14s task C=%lu T=%lu: %lu jobs, %lu deadline misses\r\n",
+				 mainSCHEDULING_MODE,
+				 ( unsigned long ) xTasks[ xTask ].xExecutionTicks,
+				 ( unsigned long ) xTasks[ xTask ].xPeriod,
+				 ulJobs[ xTask ],
+				 ( unsigned long ) ulTaskGetDeadlineMisses( xTaskHandles[ xTask ] ) );
+		vBenchPrint( cBuffer );
+	}
+
+	/* The event run.  With fixed priorities the woken task has the higher,
+	rate monotonic, priority. */
+	#if( benchUSE_EDF == 1 )
+	{
+		xTaskCreate( prvEventTask, "Event", configMINIMAL_STACK_SIZE, NULL, mainEDF_PRIORITY, &xEventTask );
+		xTaskCreate( prvLoadTask, "Load", configMINIMAL_STACK_SIZE, NULL, mainEDF_PRIORITY, &xLoadTask );
+	}
+	#else
+	{
+		xTaskCreate( prvEventTask, "Event", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xEventTask );
+		xTaskCreate( prvLoadTask, "Load", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xLoadTask );
+	}
+	#endif
+
+	vTaskDelay( mainEVENT_RUN_TICKS );
+
+	vTaskSuspend( xLoadTask );
+	vTaskSuspend( xEventTask );
+
+	sprintf( cBuffer, "edf: %-14s event release: %lu wakes, %lu acted on in a later tick, mean %lu, longest %lu cycles\r\n",
+			 mainSCHEDULING_MODE,
+			 ulEvents,
+			 ulLateEvents,
+			 ( ulEvents > 0UL ) ? ( ulTotalLatency / ulEvents ) : 0UL,
+			 ulLongestLatency );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,358 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Event group interrupt latency benchmark.
+ *
+ * The Timer1 match 0 interrupt sets a bit in an event group with
+ * xEventGroupSetBitsFromISR(), and a task waiting for the bit, at the highest
+ * priority, reads Timer1 as soon as it runs.  Timer1 counts microseconds, and
+ * the latency is the time from the interrupt setting the bit to the task
+ * running.  The cycles xEventGroupSetBitsFromISR() itself takes in the
+ * interrupt are counted too.
+ *
+ * The benchmark is built with the bits set through the timer task, and set
+ * directly in the interrupt (configUSE_EVENT_GROUP_DIRECT_ISR_SET).  Each
+ * runs with the CPU idle, then with a load task above the timer task that
+ * spins for a varying part of every millisecond.  The results are printed on
+ * UART1, then the scheduler is stopped (which ends the process when running
+ * on the Linux host).
+ *
+ * The interrupt asks for a context switch with portYIELD_FROM_ISR(), as the
+ * simulated interrupts of the host build can.  On the target it would need an
+ * entry point that saves and restores the task context, as serialISR.s does.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Timer1 match 0 interrupt, in the VIC slot after the tick and UART1. */
+#define mainMCR_MR0_INTERRUPT	( ( unsigned long ) 0x01 )
+#define mainIR_MR0				( ( unsigned long ) 0x01 )
+#define mainVIC_CHANNEL			( ( unsigned long ) 0x0005 )
+#define mainVIC_CHANNEL_BIT		( ( unsigned long ) 0x0020 )
+#define mainVIC_ENABLE			( ( unsigned long ) 0x0020 )
+#define mainCLEAR_VIC_INTERRUPT	( 0 )
+
+/* The interrupt is next due this long after it last ran. */
+#define mainINTERRUPT_US		( 500UL )
+
+/* The bit the interrupt sets. */
+#define mainEVENT_BIT			( ( EventBits_t ) 0x01 )
+
+/* How long each set of samples is taken for. */
+#define mainPHASE_TICKS			( ( TickType_t ) 2000 / portTICK_PERIOD_MS )
+
+/* The load task spins for between mainLOAD_MIN_US and mainLOAD_MAX_US, then
+blocks until the next tick. */
+#define mainLOAD_MIN_US			( 100UL )
+#define mainLOAD_MAX_US			( 900UL )
+
+#define mainLOAD_PRIORITY		( tskIDLE_PRIORITY + 3 )
+#define mainWAITER_PRIORITY		( tskIDLE_PRIORITY + 4 )
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 4 )
+
+#if( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+	#define mainSET_PATH		"direct"
+#else
+	#define mainSET_PATH		"deferred"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The latency of the waiting task, and the cost of setting the bits, over one
+phase.  Latency is counted in a histogram of one microsecond buckets. */
+typedef struct BENCH_LATENCY
+{
+	BenchHistogram_t xWake;
+	unsigned long ulLost;
+	unsigned long ulSetCalls;
+	unsigned long ulSetCycles;
+	unsigned long ulSetLongest;
+} BenchLatency_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the interrupt idle and under load, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Waits for the bit, and records how long after it was set the task ran.
+ */
+static void prvWaiterTask( void *pvParameters );
+
+/*
+ * Spins for a pseudo random time, then blocks for a tick, forever.
+ */
+static void prvLoadTask( void *pvParameters );
+
+/*
+ * The Timer1 match 0 interrupt, which sets the bit.
+ */
+static void prvTimer1ISR( void );
+
+/*
+ * Start and stop the interrupt.
+ */
+static void prvStartInterrupt( void );
+static void prvStopInterrupt( void );
+
+/*
+ * Print the results of a phase.
+ */
+static void prvPrintLatency( const char *pcLoad, const BenchLatency_t *pxLatency );
+
+/*-----------------------------------------------------------*/
+
+static BenchLatency_t xLatency;
+
+static EventGroupHandle_t xEvents = NULL;
+
+/* Timer1 when the interrupt last set the bit. */
+static volatile unsigned long ulSetTime = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_MICROSECONDS );
+
+	xEvents = xEventGroupCreate();
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, NULL );
+	xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE * 2, NULL, mainWAITER_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimer1ISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulStart, ulCycles;
+
+	T1IR = mainIR_MR0;
+
+	if( ( xEventGroupGetBitsFromISR( xEvents ) & mainEVENT_BIT ) != 0 )
+	{
+		/* The waiting task has not yet run since the last interrupt. */
+		xLatency.ulLost++;
+	}
+
+	ulSetTime = T1TC;
+
+	ulStart = benchGET_CYCLE_COUNT();
+	( void ) xEventGroupSetBitsFromISR( xEvents, mainEVENT_BIT, &xHigherPriorityTaskWoken );
+	ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+
+	/* A count taken across a reset of the counter is dropped. */
+	if( ulCycles < 0x80000000UL )
+	{
+		xLatency.ulSetCalls++;
+		xLatency.ulSetCycles += ulCycles;
+
+		if( ulCycles > xLatency.ulSetLongest )
+		{
+			xLatency.ulSetLongest = ulCycles;
+		}
+	}
+
+	T1MR0 = T1TC + mainINTERRUPT_US;
+
+	/* Clear the ISR in the VIC. */
+	VICVectAddr = mainCLEAR_VIC_INTERRUPT;
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartInterrupt( void )
+{
+	taskENTER_CRITICAL();
+	{
+		VICIntSelect &= ~( mainVIC_CHANNEL_BIT );
+		VICIntEnable |= mainVIC_CHANNEL_BIT;
+		VICVectAddr2 = ( unsigned long ) prvTimer1ISR;
+		VICVectCntl2 = mainVIC_CHANNEL | mainVIC_ENABLE;
+
+		T1MR0 = T1TC + mainINTERRUPT_US;
+		T1MCR |= mainMCR_MR0_INTERRUPT;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopInterrupt( void )
+{
+	taskENTER_CRITICAL();
+	{
+		T1MCR &= ~mainMCR_MR0_INTERRUPT;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+unsigned long ulLatency;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xEvents, mainEVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+		ulLatency = T1TC - ulSetTime;
+
+		vBenchHistogramRecord( &( xLatency.xWake ), ulLatency );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+unsigned long ulStart, ulBusy, ulRandom = 0x1234567UL;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+		ulBusy = mainLOAD_MIN_US + ( ( ulRandom >> 16 ) % ( mainLOAD_MAX_US - mainLOAD_MIN_US ) );
+		ulStart = T1TC;
+
+		while( ( T1TC - ulStart ) < ulBusy )
+		{
+			/* Spin. */
+		}
+
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+TaskHandle_t xLoadTask = NULL;
+BaseType_t xLoaded;
+char cBuffer[ 80 ];
+
+	( void ) pvParameters;
+
+	if( xEvents == NULL )
+	{
+		vBenchPrint( "event group isr: could not create the event group\r\n" );
+	}
+	else
+	{
+		sprintf( cBuffer, "event group isr: bits set %s\r\n", mainSET_PATH );
+		vBenchPrint( cBuffer );
+
+		for( xLoaded = pdFALSE; xLoaded <= pdTRUE; xLoaded++ )
+		{
+			if( xLoaded != pdFALSE )
+			{
+				xTaskCreate( prvLoadTask, "Load", configMINIMAL_STACK_SIZE, NULL, mainLOAD_PRIORITY, &xLoadTask );
+			}
+
+			memset( &xLatency, 0x00, sizeof( xLatency ) );
+			vBenchHistogramInit( &( xLatency.xWake ), 1UL );
+
+			prvStartInterrupt();
+			vTaskDelay( mainPHASE_TICKS );
+			prvStopInterrupt();
+
+			if( xLoadTask != NULL )
+			{
+				vTaskDelete( xLoadTask );
+				xLoadTask = NULL;
+			}
+
+			/* Let the last bit set reach the waiting task. */
+			vTaskDelay( 10 );
+
+			prvPrintLatency( ( xLoaded != pdFALSE ) ? "loaded" : "idle", &xLatency );
+		}
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintLatency( const char *pcLoad, const BenchLatency_t *pxLatency )
+{
+char cBuffer[ 120 ];
+unsigned long ulAverageCycles = 0;
+
+	if( pxLatency->ulSetCalls != 0 )
+	{
+		ulAverageCycles = pxLatency->ulSetCycles / pxLatency->ulSetCalls;
+	}
+
+	sprintf( cBuffer, "event group isr: %-8s %-6s %5lu events, %lu lost, wake median %4lu us, 99%% %4lu us, longest %4lu us\r\n",
+			 mainSET_PATH,
+			 pcLoad,
+			 pxLatency->xWake.ulSamples,
+			 pxLatency->ulLost,
+			 ulBenchHistogramPercentile( &( pxLatency->xWake ), 500UL ),
+			 ulBenchHistogramPercentile( &( pxLatency->xWake ), 990UL ),
+			 pxLatency->xWake.ulLongest );
+	vBenchPrint( cBuffer );
+
+	sprintf( cBuffer, "event group isr: %-8s %-6s set from isr average %lu cycles, longest %lu cycles\r\n",
+			 mainSET_PATH,
+			 pcLoad,
+			 ulAverageCycles,
+			 pxLatency->ulSetLongest );
+	vBenchPrint( cBuffer );
+}
+/*-----------------------------------------------------------*/
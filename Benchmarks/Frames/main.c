@@ -0,0 +1,378 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Framed telemetry benchmark.
+ *
+ *  - cost: frames of mainSMALL, mainMEDIUM and frameMAX_PAYLOAD bytes are sent
+ *    with xFrameSend(), which encodes straight into the transmit ring, and by
+ *    encoding into a buffer on the stack and writing that with
+ *    xSerialPortWrite().  The median cycles of each are compared.  The ring is
+ *    flushed between frames, so neither waits for room.
+ *
+ *  - stream: two tasks send mainSTREAM_FRAMES frames of mainMEDIUM bytes
+ *    between them on one channel as fast as UART1 takes them.  The bytes on
+ *    the wire are compared with the payload, and the time with what the baud
+ *    rate allows.
+ *
+ *  - decode: the capture of the stream is decoded on the host with the
+ *    frame_codec library, once to measure the cycles per byte and once to
+ *    check every payload.
+ *
+ *  - receive: the capture is fed back into UART1, and read with
+ *    xFrameReceive().
+ *
+ * UART1 is connected to temporary files for the run.  The results are
+ * printed on UART1 afterwards, then the scheduler is stopped (which ends the
+ * process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+#include "frame.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Constants for the UART. */
+#define mainBITS_PER_CHAR		( 10UL )
+#define mainCLOCK_SCALING		( 16UL )
+#define mainDIVISOR				( configCPU_CLOCK_HZ / ( benchCOM_BAUD_RATE * mainCLOCK_SCALING ) )
+
+#define mainSMALL				( 8U )
+#define mainMEDIUM				( 32U )
+#define mainSIZES				( 3 )
+#define mainCOST_FRAMES			( 32UL )
+
+#define mainSENDERS				( 2UL )
+#define mainSTREAM_FRAMES		( 200UL )
+#define mainFRAME_TYPE			( ( uint8_t ) 0x21 )
+
+#define mainRX_TIMEOUT			( ( TickType_t ) 100 )
+
+#define mainSENDER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainCONTROL_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Sends its share of the stream, numbered from pvParameters.
+ */
+static void prvSenderTask( void *pvParameters );
+
+/*
+ * Runs the phases and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The two ways of sending, for the cost phase.
+ */
+static void prvMeasureCost( size_t xLength, unsigned long *pulZeroCopy, unsigned long *pulCopy );
+
+/*
+ * Fill a payload with data that depends on ulFrame, a fifth of it zeros as
+ * in sensor readings.  The first two bytes are the frame number.
+ */
+static void prvFillPayload( uint8_t *pucPayload, size_t xLength, unsigned long ulFrame );
+
+/*
+ * Read all of pxFile into memory.  Returns the number of bytes.
+ */
+static size_t prvReadAll( FILE *pxFile, uint8_t **ppucData );
+
+/*
+ * The median of ulCount cycle counts, which are sorted.
+ */
+static unsigned long prvMedian( unsigned long *pulCycles, unsigned long ulCount );
+static int prvCompare( const void *pvA, const void *pvB );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xControlTask = NULL;
+static FrameChannel_t xChannel;
+static unsigned long ulCycles[ 2 ][ mainCOST_FRAMES ];
+static unsigned long ulFailedSends = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4, NULL, mainCONTROL_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void *pvParameters )
+{
+unsigned long ulFrame;
+uint8_t ucPayload[ mainMEDIUM ];
+
+	/* The senders take alternate frame numbers. */
+	for( ulFrame = ( unsigned long ) ( uintptr_t ) pvParameters; ulFrame < mainSTREAM_FRAMES; ulFrame += mainSENDERS )
+	{
+		prvFillPayload( ucPayload, sizeof( ucPayload ), ulFrame );
+
+		if( xFrameSend( &xChannel, mainFRAME_TYPE, ucPayload, sizeof( ucPayload ), portMAX_DELAY ) == pdFALSE )
+		{
+			ulFailedSends++;
+		}
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const size_t xSizes[ mainSIZES ] = { mainSMALL, mainMEDIUM, frameMAX_PAYLOAD };
+FILE *pxCapture;
+FrameDecoder_t xDecoder;
+uint8_t *pucStream, ucExpected[ mainMEDIUM ];
+size_t xWireBytes, xByte, xPayloadBytes;
+unsigned long ulSize, ulSender, ulZeroCopy, ulCopy, ulIdealTicks, ulStart, ulDecodeCycles, ulIntact = 0, ulReceived = 0, ulLost;
+TickType_t xStart, xTicks;
+char cBuffer[ 4 ][ 160 ];
+char cCost[ mainSIZES ][ 120 ];
+
+	( void ) pvParameters;
+
+	xControlTask = xTaskGetCurrentTaskHandle();
+	vFrameChannelInit( &xChannel, xSerialPortInitMinimal( benchCOM_BAUD_RATE ) );
+
+	/* Cost. */
+	pxCapture = tmpfile();
+	configASSERT( pxCapture );
+	vSimConnectUart( 1, fileno( pxCapture ), -1 );
+
+	for( ulSize = 0; ulSize < mainSIZES; ulSize++ )
+	{
+		prvMeasureCost( xSizes[ ulSize ], &ulZeroCopy, &ulCopy );
+		sprintf( cCost[ ulSize ], "frames crc%u: cost %3u bytes: %lu cycles encoding into the ring, %lu through a buffer\r\n",
+				 ( unsigned ) ( frameCRC_BYTES * 8U ), ( unsigned ) xSizes[ ulSize ], ulZeroCopy, ulCopy );
+	}
+
+	fclose( pxCapture );
+
+	/* Stream. */
+	pxCapture = tmpfile();
+	configASSERT( pxCapture );
+	vSimConnectUart( 1, fileno( pxCapture ), -1 );
+	xStart = xTaskGetTickCount();
+
+	for( ulSender = 0; ulSender < mainSENDERS; ulSender++ )
+	{
+		xTaskCreate( prvSenderTask, "Sender", configMINIMAL_STACK_SIZE * 4, ( void * ) ( uintptr_t ) ulSender, mainSENDER_PRIORITY, NULL );
+	}
+
+	for( ulSender = 0; ulSender < mainSENDERS; ulSender++ )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+	}
+
+	( void ) xSerialFlush( portMAX_DELAY );
+	xTicks = xTaskGetTickCount() - xStart;
+
+	xWireBytes = prvReadAll( pxCapture, &pucStream );
+	xPayloadBytes = mainSTREAM_FRAMES * mainMEDIUM;
+	ulIdealTicks = ( unsigned long ) ( ( ( unsigned long long ) xWireBytes * mainBITS_PER_CHAR * configTICK_RATE_HZ * mainCLOCK_SCALING * mainDIVISOR ) / configCPU_CLOCK_HZ );
+
+	/* Decode on the host, timing a pass on its own. */
+	vFrameDecoderInit( &xDecoder, frameCRC_BYTES );
+	ulStart = benchGET_CYCLE_COUNT();
+
+	for( xByte = 0; xByte < xWireBytes; xByte++ )
+	{
+		( void ) eFrameDecoderPush( &xDecoder, pucStream[ xByte ] );
+	}
+
+	ulDecodeCycles = benchGET_CYCLE_COUNT() - ulStart;
+
+	/* Then again, checking every payload.  The senders interleave, so each
+	frame is checked against the number its payload says it is. */
+	vFrameDecoderInit( &xDecoder, frameCRC_BYTES );
+
+	for( xByte = 0; xByte < xWireBytes; xByte++ )
+	{
+		if( eFrameDecoderPush( &xDecoder, pucStream[ xByte ] ) == eFrameReceived )
+		{
+			prvFillPayload( ucExpected, sizeof( ucExpected ), xDecoder.pucPayload[ 0 ] | ( ( unsigned long ) xDecoder.pucPayload[ 1 ] << 8 ) );
+
+			if( ( xDecoder.ucType == mainFRAME_TYPE ) && ( xDecoder.xPayloadLength == sizeof( ucExpected ) ) &&
+				( memcmp( xDecoder.pucPayload, ucExpected, sizeof( ucExpected ) ) == 0 ) )
+			{
+				ulIntact++;
+			}
+		}
+	}
+
+	/* Receive, by feeding the capture back in. */
+	( void ) lseek( fileno( pxCapture ), 0, SEEK_SET );
+	vSimConnectUart( 1, -1, fileno( pxCapture ) );
+	vFrameChannelInit( &xChannel, xChannel.xPort );
+
+	while( xFrameReceive( &xChannel, mainRX_TIMEOUT ) != pdFALSE )
+	{
+		ulReceived++;
+	}
+
+	ulLost = xChannel.xDecoder.ulLostFrames;
+	fclose( pxCapture );
+	vSimConnectUart( 1, STDOUT_FILENO, -1 );
+
+	sprintf( cBuffer[ 0 ], "frames crc%u: stream: %lu frames of %u bytes from %lu tasks, %lu failed, %lu bytes on the wire, %lu.%02lu per payload byte\r\n",
+			 ( unsigned ) ( frameCRC_BYTES * 8U ), mainSTREAM_FRAMES, mainMEDIUM, mainSENDERS, ulFailedSends, ( unsigned long ) xWireBytes,
+			 ( unsigned long ) ( xWireBytes / xPayloadBytes ), ( unsigned long ) ( ( ( xWireBytes * 100U ) / xPayloadBytes ) % 100U ) );
+	sprintf( cBuffer[ 1 ], "frames crc%u: stream: %lu ticks (ideal %lu at the line rate)\r\n",
+			 ( unsigned ) ( frameCRC_BYTES * 8U ), ( unsigned long ) xTicks, ulIdealTicks );
+	sprintf( cBuffer[ 2 ], "frames crc%u: decode: %lu of %lu intact, %lu crc errors, %lu framing errors, %lu lost, %lu cycles a byte\r\n",
+			 ( unsigned ) ( frameCRC_BYTES * 8U ), ulIntact, mainSTREAM_FRAMES, ( unsigned long ) xDecoder.ulCrcErrors,
+			 ( unsigned long ) xDecoder.ulFramingErrors, ( unsigned long ) xDecoder.ulLostFrames, ulDecodeCycles / ( unsigned long ) xWireBytes );
+	sprintf( cBuffer[ 3 ], "frames crc%u: receive: %lu of %lu frames, %lu lost\r\n",
+			 ( unsigned ) ( frameCRC_BYTES * 8U ), ulReceived, mainSTREAM_FRAMES, ulLost );
+
+	for( ulSize = 0; ulSize < mainSIZES; ulSize++ )
+	{
+		vBenchPrint( cCost[ ulSize ] );
+	}
+
+	for( ulSize = 0; ulSize < 4; ulSize++ )
+	{
+		vBenchPrint( cBuffer[ ulSize ] );
+	}
+
+	free( pucStream );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureCost( size_t xLength, unsigned long *pulZeroCopy, unsigned long *pulCopy )
+{
+uint8_t ucPayload[ frameMAX_PAYLOAD ], ucFrame[ frameENCODED_MAX( frameMAX_PAYLOAD, frameCRC_BYTES ) ];
+FrameOutput_t xOutput;
+unsigned long ulFrame, ulStart;
+size_t xWritten;
+
+	xOutput.pucFirst = ucFrame;
+	xOutput.xFirstLength = sizeof( ucFrame );
+	xOutput.pucSecond = NULL;
+	xOutput.xSecondLength = 0;
+
+	for( ulFrame = 0; ulFrame < mainCOST_FRAMES; ulFrame++ )
+	{
+		prvFillPayload( ucPayload, xLength, ulFrame );
+
+		ulStart = benchGET_CYCLE_COUNT();
+		( void ) xFrameSend( &xChannel, mainFRAME_TYPE, ucPayload, xLength, portMAX_DELAY );
+		ulCycles[ 0 ][ ulFrame ] = benchGET_CYCLE_COUNT() - ulStart;
+		( void ) xSerialFlush( portMAX_DELAY );
+
+		ulStart = benchGET_CYCLE_COUNT();
+		xWritten = xFrameEncode( &xOutput, mainFRAME_TYPE, xChannel.usNextSequence++, ucPayload, xLength, frameCRC_BYTES );
+		( void ) xSerialPortWrite( xChannel.xPort, ( const signed char * ) ucFrame, ( unsigned short ) xWritten, portMAX_DELAY );
+		ulCycles[ 1 ][ ulFrame ] = benchGET_CYCLE_COUNT() - ulStart;
+		( void ) xSerialFlush( portMAX_DELAY );
+	}
+
+	*pulZeroCopy = prvMedian( ulCycles[ 0 ], mainCOST_FRAMES );
+	*pulCopy = prvMedian( ulCycles[ 1 ], mainCOST_FRAMES );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillPayload( uint8_t *pucPayload, size_t xLength, unsigned long ulFrame )
+{
+size_t x;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		pucPayload[ x ] = ( ( x % 5U ) == 4U ) ? 0U : ( uint8_t ) ( ( ulFrame * 31UL ) + ( x * 13UL ) );
+	}
+
+	if( xLength >= 2U )
+	{
+		pucPayload[ 0 ] = ( uint8_t ) ulFrame;
+		pucPayload[ 1 ] = ( uint8_t ) ( ulFrame >> 8 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadAll( FILE *pxFile, uint8_t **ppucData )
+{
+off_t xSize;
+
+	xSize = lseek( fileno( pxFile ), 0, SEEK_END );
+	*ppucData = malloc( ( size_t ) xSize + 1U );
+	configASSERT( *ppucData );
+
+	( void ) lseek( fileno( pxFile ), 0, SEEK_SET );
+	( void ) read( fileno( pxFile ), *ppucData, ( size_t ) xSize );
+
+	return ( size_t ) xSize;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvMedian( unsigned long *pulCycles, unsigned long ulCount )
+{
+	qsort( pulCycles, ulCount, sizeof( unsigned long ), prvCompare );
+
+	return pulCycles[ ulCount / 2UL ];
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompare( const void *pvA, const void *pvB )
+{
+unsigned long ulA = *( const unsigned long * ) pvA, ulB = *( const unsigned long * ) pvB;
+
+	return ( ulA > ulB ) - ( ulA < ulB );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,257 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * GPIO benchmark.
+ *
+ * A bank of eight LEDs on P1.16 to P1.23 is driven through every value and
+ * read back, three times:
+ *
+ *  - per pin: GPIO_write() and GPIO_read() for each of the eight pins;
+ *
+ *  - through the accessors generated from the pin table: GPIO_write_P1_16()
+ *    and GPIO_read_P1_16() to GPIO_write_P1_23() and GPIO_read_P1_23();
+ *
+ *  - as a group: one GPIO_writeGroup() and one GPIO_readGroup() call.
+ *
+ * The register accesses are counted through wrappers linked in front of the
+ * simulator's IOSET, IOCLR and IOPIN accessors, and the value read back is
+ * checked against the one written.  The directions GPIO_init() leaves in IODIR
+ * are checked against the masks expanded from the pin table.  The results are printed on
+ * UART1, then the scheduler is stopped (which ends the process when running on
+ * the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+#include "GPIO.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The bank, and the times it is taken through all its values. */
+#define mainBANK_PINS			( 8 )
+#define mainBANK_VALUES			( 1UL << mainBANK_PINS )
+#define mainROUNDS				( 50UL )
+#define mainUPDATES				( mainROUNDS * mainBANK_VALUES )
+
+#define mainMODES				( 3 )
+
+#define mainTEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the bank both ways and prints the results.
+ */
+static void prvTestTask( void *pvParameters );
+
+/*
+ * Write value to the bank and read it back, one pin at a time, through the
+ * generated accessors, or as a group.
+ */
+static unsigned long prvUpdatePerPin( unsigned long ulValue );
+static unsigned long prvUpdateAccessors( unsigned long ulValue );
+static unsigned long prvUpdateGroup( unsigned long ulValue );
+
+/*-----------------------------------------------------------*/
+
+/* The accessors of the simulated registers, and the wrappers counting the
+calls to them. */
+extern volatile unsigned long *__real_pulSimGpioSET( unsigned long ulPort );
+extern volatile unsigned long *__real_pulSimGpioCLR( unsigned long ulPort );
+extern volatile unsigned long *__real_pulSimGpioPIN( unsigned long ulPort );
+volatile unsigned long *__wrap_pulSimGpioSET( unsigned long ulPort );
+volatile unsigned long *__wrap_pulSimGpioCLR( unsigned long ulPort );
+volatile unsigned long *__wrap_pulSimGpioPIN( unsigned long ulPort );
+
+static volatile unsigned long ulStores = 0;
+static volatile unsigned long ulLoads = 0;
+
+static const pinGroup_t xBank = GPIO_GROUP( PORT_1, PIN0, mainBANK_PINS );
+
+static unsigned long ( * const pxUpdates[ mainMODES ] )( unsigned long ulValue ) = { prvUpdatePerPin, prvUpdateAccessors, prvUpdateGroup };
+static const char * const pcModes[ mainMODES ] = { "per pin", "accessor", "group" };
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+
+	/* The bank is configured as outputs by the pin table in GPIO_cfg.h. */
+	GPIO_init();
+
+	xTaskCreate( prvTestTask, "Test", configMINIMAL_STACK_SIZE * 4, NULL, mainTEST_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *__wrap_pulSimGpioSET( unsigned long ulPort )
+{
+	ulStores++;
+	return __real_pulSimGpioSET( ulPort );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *__wrap_pulSimGpioCLR( unsigned long ulPort )
+{
+	ulStores++;
+	return __real_pulSimGpioCLR( ulPort );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *__wrap_pulSimGpioPIN( unsigned long ulPort )
+{
+	ulLoads++;
+	return __real_pulSimGpioPIN( ulPort );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvUpdatePerPin( unsigned long ulValue )
+{
+unsigned long ulRead = 0;
+int iPin;
+
+	for( iPin = 0; iPin < mainBANK_PINS; iPin++ )
+	{
+		GPIO_write( PORT_1, ( pinX_t ) ( PIN0 + iPin ), ( ( ulValue >> iPin ) & 0x01UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	}
+
+	for( iPin = 0; iPin < mainBANK_PINS; iPin++ )
+	{
+		ulRead |= ( unsigned long ) GPIO_read( PORT_1, ( pinX_t ) ( PIN0 + iPin ) ) << iPin;
+	}
+
+	return ulRead;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvUpdateAccessors( unsigned long ulValue )
+{
+unsigned long ulRead;
+
+	GPIO_write_P1_16( ( ulValue & 0x01UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_17( ( ulValue & 0x02UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_18( ( ulValue & 0x04UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_19( ( ulValue & 0x08UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_20( ( ulValue & 0x10UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_21( ( ulValue & 0x20UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_22( ( ulValue & 0x40UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+	GPIO_write_P1_23( ( ulValue & 0x80UL ) ? PIN_IS_HIGH : PIN_IS_LOW );
+
+	ulRead = ( unsigned long ) GPIO_read_P1_16();
+	ulRead |= ( unsigned long ) GPIO_read_P1_17() << 1;
+	ulRead |= ( unsigned long ) GPIO_read_P1_18() << 2;
+	ulRead |= ( unsigned long ) GPIO_read_P1_19() << 3;
+	ulRead |= ( unsigned long ) GPIO_read_P1_20() << 4;
+	ulRead |= ( unsigned long ) GPIO_read_P1_21() << 5;
+	ulRead |= ( unsigned long ) GPIO_read_P1_22() << 6;
+	ulRead |= ( unsigned long ) GPIO_read_P1_23() << 7;
+
+	return ulRead;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvUpdateGroup( unsigned long ulValue )
+{
+	GPIO_writeGroup( &xBank, ulValue );
+
+	return GPIO_readGroup( &xBank );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTask( void *pvParameters )
+{
+unsigned long ulUpdate, ulValue, ulStart, ulCycles, ulWrong;
+int iMode;
+char cBuffer[ 160 ];
+
+	( void ) pvParameters;
+
+	/* GPIO_init() ran in main(), from a cleared IODIR. */
+	snprintf( cBuffer, sizeof( cBuffer ), "gpio: init      IODIR0 0x%08lx IODIR1 0x%08lx%s\r\n",
+			  ( unsigned long ) IODIR0,
+			  ( unsigned long ) IODIR1,
+			  ( ( IODIR0 == GPIO_PORT0_OUTPUTS ) && ( IODIR1 == GPIO_PORT1_OUTPUTS ) ) ? "" : " - WRONG DIRECTIONS" );
+	vBenchPrint( cBuffer );
+
+	for( iMode = 0; iMode < mainMODES; iMode++ )
+	{
+		ulWrong = 0;
+		ulStores = 0;
+		ulLoads = 0;
+		ulStart = benchGET_CYCLE_COUNT();
+
+		for( ulUpdate = 0; ulUpdate < mainUPDATES; ulUpdate++ )
+		{
+			ulValue = ulUpdate % mainBANK_VALUES;
+
+			if( pxUpdates[ iMode ]( ulValue ) != ulValue )
+			{
+				ulWrong++;
+			}
+		}
+
+		ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+
+		snprintf( cBuffer, sizeof( cBuffer ), "gpio: %-9s %d pins, %lu.%02lu stores and %lu.%02lu loads per update, %lu cycles%s\r\n",
+				  pcModes[ iMode ],
+				  mainBANK_PINS,
+				  ulStores / mainUPDATES,
+				  ( ( ulStores % mainUPDATES ) * 100UL ) / mainUPDATES,
+				  ulLoads / mainUPDATES,
+				  ( ( ulLoads % mainUPDATES ) * 100UL ) / mainUPDATES,
+				  ulCycles / mainUPDATES,
+				  ( ulWrong == 0 ) ? "" : " - VALUES WRONG" );
+		vBenchPrint( cBuffer );
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
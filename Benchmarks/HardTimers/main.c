@@ -0,0 +1,299 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Hard timer jitter benchmark.
+ *
+ * A hard timer (see hard_timer.h) and a software timer of the timer task are
+ * both set to expire every mainPERIOD_US.  Each callback reads Timer1, which
+ * counts microseconds, and the jitter is how far the time since the callback
+ * last ran is from the period.
+ *
+ * The timers run for a while with the CPU idle, then again with a load task
+ * above the timer task that spins for a varying part of every millisecond, as
+ * a heavy load loop in an application would.  The timer task is held off by
+ * the load for a different time each period, the hard timer is not.  Intervals
+ * of more than two periods, where a whole period went by without a callback,
+ * are counted as skipped.
+ *
+ * On the Linux host Timer1 counts real time, but its match interrupt is only
+ * raised from the simulated tick, so each Timer1 callback runs on the first
+ * tick after its match, up to a tick late, and the Timer1 source shows more
+ * idle jitter there than the tick source.  A host that holds the tick thread
+ * off for more than a period skips periods of every timer; the Timer1 source
+ * also counts them as missed, while the tick count, and so the tick source,
+ * just stops.  The results are printed on UART1, then the
+ * scheduler is stopped (which ends the process when running on the Linux
+ * host).
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+#include "hard_timer.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Both timers expire this often. */
+#define mainPERIOD_US			( 2000UL )
+
+/* How long each set of samples is taken for. */
+#define mainPHASE_TICKS			( ( TickType_t ) 2000 / portTICK_PERIOD_MS )
+
+/* The load task spins for between mainLOAD_MIN_US and mainLOAD_MAX_US, then
+blocks until the next tick. */
+#define mainLOAD_MIN_US			( 100UL )
+#define mainLOAD_MAX_US			( 1900UL )
+
+#define mainLOAD_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 3 )
+
+#if( configHARD_TIMER_SOURCE == hardtimerSOURCE_TIMER1 )
+	#define mainHARD_SOURCE		"timer1"
+#else
+	#define mainHARD_SOURCE		"tick"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The intervals between the callbacks of one timer.  Their jitter is counted in
+a histogram of one microsecond buckets. */
+typedef struct BENCH_JITTER
+{
+	BenchHistogram_t xJitter;
+	unsigned long ulSkipped;
+	unsigned long ulLast;
+	BaseType_t xStarted;
+} BenchJitter_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the timers idle and under load, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Spins for a pseudo random time, then blocks for a tick, forever.
+ */
+static void prvLoadTask( void *pvParameters );
+
+/*
+ * The timer callbacks.
+ */
+static void prvHardTimerCallback( HardTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+static void prvSoftTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * Add the time since the last callback to, or print and clear, the jitter of
+ * a timer.
+ */
+static void prvRecordInterval( BenchJitter_t *pxJitter );
+static void prvPrintJitter( const char *pcTimer, const char *pcLoad, BenchJitter_t *pxJitter );
+
+/*-----------------------------------------------------------*/
+
+static BenchJitter_t xHardJitter;
+static BenchJitter_t xSoftJitter;
+
+static HardTimerHandle_t xHardTimer = NULL;
+static TimerHandle_t xSoftTimer = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_MICROSECONDS );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordInterval( BenchJitter_t *pxJitter )
+{
+unsigned long ulNow, ulInterval, ulJitter;
+
+	ulNow = T1TC;
+
+	if( pxJitter->xStarted != pdFALSE )
+	{
+		ulInterval = ulNow - pxJitter->ulLast;
+		ulJitter = ( ulInterval > mainPERIOD_US ) ? ( ulInterval - mainPERIOD_US ) : ( mainPERIOD_US - ulInterval );
+
+		/* A whole period went by without a callback. */
+		if( ulInterval > ( 2UL * mainPERIOD_US ) )
+		{
+			pxJitter->ulSkipped++;
+		}
+
+		vBenchHistogramRecord( &( pxJitter->xJitter ), ulJitter );
+	}
+
+	pxJitter->ulLast = ulNow;
+	pxJitter->xStarted = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHardTimerCallback( HardTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) xTimer;
+	( void ) pxHigherPriorityTaskWoken;
+
+	prvRecordInterval( &xHardJitter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSoftTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+
+	prvRecordInterval( &xSoftJitter );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTask( void *pvParameters )
+{
+unsigned long ulStart, ulBusy, ulRandom = 0x1234567UL;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		ulRandom = ( ulRandom * 1103515245UL ) + 12345UL;
+		ulBusy = mainLOAD_MIN_US + ( ( ulRandom >> 16 ) % ( mainLOAD_MAX_US - mainLOAD_MIN_US ) );
+		ulStart = T1TC;
+
+		while( ( T1TC - ulStart ) < ulBusy )
+		{
+			/* Spin. */
+		}
+
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+TaskHandle_t xLoadTask = NULL;
+BaseType_t xLoaded;
+char cBuffer[ 80 ];
+
+	( void ) pvParameters;
+
+	xHardTimer = xHardTimerCreate( prvHardTimerCallback, NULL );
+	xSoftTimer = xTimerCreate( "Soft", pdMS_TO_TICKS( mainPERIOD_US / 1000UL ), pdTRUE, NULL, prvSoftTimerCallback );
+
+	if( ( xHardTimer == NULL ) || ( xSoftTimer == NULL ) )
+	{
+		vBenchPrint( "hard timers: could not create the timers\r\n" );
+	}
+	else
+	{
+		sprintf( cBuffer, "hard timers: %s source, %lu us period\r\n", mainHARD_SOURCE, mainPERIOD_US );
+		vBenchPrint( cBuffer );
+
+		for( xLoaded = pdFALSE; xLoaded <= pdTRUE; xLoaded++ )
+		{
+			memset( &xHardJitter, 0x00, sizeof( xHardJitter ) );
+			memset( &xSoftJitter, 0x00, sizeof( xSoftJitter ) );
+			vBenchHistogramInit( &( xHardJitter.xJitter ), 1UL );
+			vBenchHistogramInit( &( xSoftJitter.xJitter ), 1UL );
+
+			if( xLoaded != pdFALSE )
+			{
+				xTaskCreate( prvLoadTask, "Load", configMINIMAL_STACK_SIZE, NULL, mainLOAD_PRIORITY, &xLoadTask );
+			}
+
+			/* Both timers are started from here, so they start within a tick
+			of each other. */
+			xHardTimerStart( xHardTimer, hardtimerUS_TO_COUNTS( mainPERIOD_US ), hardtimerUS_TO_COUNTS( mainPERIOD_US ) );
+			xTimerStart( xSoftTimer, portMAX_DELAY );
+
+			vTaskDelay( mainPHASE_TICKS );
+
+			vHardTimerStop( xHardTimer );
+			xTimerStop( xSoftTimer, portMAX_DELAY );
+
+			if( xLoadTask != NULL )
+			{
+				vTaskDelete( xLoadTask );
+				xLoadTask = NULL;
+			}
+
+			/* Let the timer task process the stop. */
+			vTaskDelay( 10 );
+
+			prvPrintJitter( "hard", ( xLoaded != pdFALSE ) ? "loaded" : "idle", &xHardJitter );
+			prvPrintJitter( "daemon", ( xLoaded != pdFALSE ) ? "loaded" : "idle", &xSoftJitter );
+		}
+
+		sprintf( cBuffer, "hard timers: %lu hard timer periods missed\r\n", ( unsigned long ) ulHardTimerGetOverruns( xHardTimer ) );
+		vBenchPrint( cBuffer );
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintJitter( const char *pcTimer, const char *pcLoad, BenchJitter_t *pxJitter )
+{
+char cBuffer[ 160 ];
+
+	snprintf( cBuffer, sizeof( cBuffer ), "hard timers: %-6s %-6s %5lu periods, jitter median %4lu us, 99%% %4lu us, longest %4lu us, %lu skipped\r\n",
+			  pcTimer,
+			  pcLoad,
+			  pxJitter->xJitter.ulSamples,
+			  ulBenchHistogramPercentile( &( pxJitter->xJitter ), 500UL ),
+			  ulBenchHistogramPercentile( &( pxJitter->xJitter ), 990UL ),
+			  pxJitter->xJitter.ulLongest,
+			  pxJitter->ulSkipped );
+	vBenchPrint( cBuffer );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,455 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Heap benchmark.
+ *
+ * Measures, in CPU cycles, how long pvPortMalloc() and vPortFree() take while
+ * the heap is churned by two randomised traces of allocations and frees:
+ *
+ *  - tasks: blocks the size of task control blocks and queues (of varying
+ *    size), minimal task stacks and the occasional large stack, the way
+ *    creating and deleting tasks and queues churns the heap, with up to 63
+ *    blocks live at once;
+ *
+ *  - random: sizes spread evenly over each power of two from 8 bytes to 4 KB,
+ *    with up to 96 blocks live at once, which fragments the heap far more.
+ *
+ * Each call is made with interrupts masked so the longest call is the longest
+ * the heap itself took.  Both traces run first untimed, so the host has
+ * touched every page of the heap before anything is measured.
+ *
+ * At the end of each trace, with its blocks still allocated, the largest block
+ * that can be allocated is found and compared with the total free, as a measure
+ * of how fragmented the heap has become.
+ *
+ * The benchmark is built once for each heap, named by benchHEAP_NAME, with
+ * benchUSE_REGIONS set to 1 for the heaps that take their memory from
+ * vPortDefineHeapRegions().  The results are printed on UART1, then the
+ * scheduler is stopped (which ends the process when running on the Linux
+ * host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of allocations and frees made by each trace. */
+#define mainOPERATIONS			( 200000UL )
+#define mainWARM_UP_OPERATIONS	( 20000UL )
+
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* The blocks live at once in the tasks trace, of each kind. */
+#define mainSMALL_SLOTS			( 40 )
+#define mainSTACK_SLOTS			( 20 )
+#define mainLARGE_SLOTS			( 3 )
+
+#define mainSMALL_MAX_SIZE		( 32 * sizeof( void * ) )
+#define mainSTACK_SIZE			( configMINIMAL_STACK_SIZE * sizeof( StackType_t ) )
+#define mainLARGE_SIZE			( 4 * configMINIMAL_STACK_SIZE * sizeof( StackType_t ) )
+
+/* The blocks live at once in the random trace, and the number of powers of two
+its sizes are spread over, starting from 8 bytes. */
+#define mainRANDOM_SLOTS		( 96 )
+#define mainRANDOM_SIZE_RANGES	( 9 )
+
+#define mainMAX_SLOTS			( 96 )
+
+#define mainSTRINGIFY( x )		#x
+#define mainHEAP_NAME( x )		mainSTRINGIFY( x )
+
+#ifndef benchUSE_REGIONS
+	#define benchUSE_REGIONS	0
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the traces, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Make ulOperations random allocations and frees, as the tasks trace or the
+ * random trace.  The blocks allocated at the end are left allocated.
+ */
+static void prvRunTrace( BaseType_t xRandomTrace, unsigned long ulOperations );
+
+/*
+ * Allocate or free the block in one slot, timing the call.
+ */
+static void prvToggleSlot( void **ppvSlot, size_t xSize );
+
+/*
+ * Free every block left allocated by a trace.
+ */
+static void prvFreeAll( void );
+
+/*
+ * Find the largest block that can be allocated now.
+ */
+static size_t prvLargestAllocation( void );
+
+/*
+ * Print the results of a trace.
+ */
+static void prvPrintTrace( const char *pcTrace );
+
+/*
+ * Add a sample, less the cost of reading the cycle counter, to a histogram.
+ */
+static void prvRecordSample( BenchHistogram_t *pxHistogram, unsigned long ulCycles );
+
+/*
+ * "" or, when the percentile fell in the last bucket and so is only a lower
+ * bound, ">=".
+ */
+static const char *prvAtLeast( unsigned long ulPercentile );
+
+/*
+ * A small pseudo random number generator, so every heap sees the same order
+ * of calls.
+ */
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static void *pvSlots[ mainMAX_SLOTS ];
+
+/* The calls are counted in histograms of one cycle buckets. */
+static BenchHistogram_t xMallocHistogram, xFreeHistogram;
+static unsigned long ulFailedAllocations = 0;
+
+static unsigned long ulRandomState = 0x12345678UL;
+
+/* Only calls made while this is set are counted. */
+static BaseType_t xRecording = pdFALSE;
+
+/* The cost of the two cycle counter reads made around each call. */
+static unsigned long ulOverhead = 0;
+
+#if( benchUSE_REGIONS == 1 )
+	/* Two regions making up the same total as configTOTAL_HEAP_SIZE. */
+	static uint8_t ucRegion1[ configTOTAL_HEAP_SIZE / 2 ];
+	static uint8_t ucRegion2[ configTOTAL_HEAP_SIZE / 2 ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	/* The heap is set up first, as the serial driver allocates its semaphores
+	from it. */
+	#if( benchUSE_REGIONS == 1 )
+	{
+	HeapRegion_t xRegions[ 3 ];
+	uint8_t *pucLow = ucRegion1, *pucHigh = ucRegion2;
+
+		/* heap_5.c needs the regions in address order. */
+		if( pucHigh < pucLow )
+		{
+			pucLow = ucRegion2;
+			pucHigh = ucRegion1;
+		}
+
+		xRegions[ 0 ].pucStartAddress = pucLow;
+		xRegions[ 0 ].xSizeInBytes = sizeof( ucRegion1 );
+		xRegions[ 1 ].pucStartAddress = pucHigh;
+		xRegions[ 1 ].xSizeInBytes = sizeof( ucRegion2 );
+		xRegions[ 2 ].pucStartAddress = NULL;
+		xRegions[ 2 ].xSizeInBytes = 0;
+
+		vPortDefineHeapRegions( xRegions );
+	}
+	#endif /* benchUSE_REGIONS */
+
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xMallocHistogram, 1UL );
+	vBenchHistogramInit( &xFreeHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulRandomState = ( ulRandomState * 1103515245UL ) + 12345UL;
+	return ( ulRandomState >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSample( BenchHistogram_t *pxHistogram, unsigned long ulCycles )
+{
+	ulCycles = ( ulCycles > ulOverhead ) ? ( ulCycles - ulOverhead ) : 0;
+	vBenchHistogramRecord( pxHistogram, ulCycles );
+}
+/*-----------------------------------------------------------*/
+
+static const char *prvAtLeast( unsigned long ulPercentile )
+{
+	return ( ulPercentile == ( benchHISTOGRAM_BUCKETS - 1UL ) ) ? ">=" : "";
+}
+/*-----------------------------------------------------------*/
+
+static void prvToggleSlot( void **ppvSlot, size_t xSize )
+{
+unsigned long ulStart, ulCycles;
+
+	if( *ppvSlot == NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulStart = benchGET_CYCLE_COUNT();
+			*ppvSlot = pvPortMalloc( xSize );
+			ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+		}
+		taskEXIT_CRITICAL();
+
+		if( *ppvSlot == NULL )
+		{
+			ulFailedAllocations++;
+		}
+		else
+		{
+			/* Touch the block, as its owner would. */
+			memset( *ppvSlot, 0xa5, xSize );
+		}
+
+		if( xRecording != pdFALSE )
+		{
+			prvRecordSample( &xMallocHistogram, ulCycles );
+		}
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			ulStart = benchGET_CYCLE_COUNT();
+			vPortFree( *ppvSlot );
+			ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+		}
+		taskEXIT_CRITICAL();
+
+		*ppvSlot = NULL;
+
+		if( xRecording != pdFALSE )
+		{
+			prvRecordSample( &xFreeHistogram, ulCycles );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTrace( BaseType_t xRandomTrace, unsigned long ulOperations )
+{
+unsigned long ulOperation, ulKind, ulRange;
+
+	for( ulOperation = 0; ulOperation < ulOperations; ulOperation++ )
+	{
+		if( xRandomTrace != pdFALSE )
+		{
+			ulRange = 8UL << ( prvRandom() % mainRANDOM_SIZE_RANGES );
+			prvToggleSlot( &( pvSlots[ prvRandom() % mainRANDOM_SLOTS ] ), ( size_t ) ( ulRange + ( prvRandom() % ulRange ) ) );
+		}
+		else
+		{
+			ulKind = prvRandom() % 100UL;
+
+			if( ulKind < 60UL )
+			{
+				prvToggleSlot( &( pvSlots[ prvRandom() % mainSMALL_SLOTS ] ), 16U + ( prvRandom() % ( mainSMALL_MAX_SIZE - 16U ) ) );
+			}
+			else if( ulKind < 97UL )
+			{
+				prvToggleSlot( &( pvSlots[ mainSMALL_SLOTS + ( prvRandom() % mainSTACK_SLOTS ) ] ), mainSTACK_SIZE );
+			}
+			else
+			{
+				prvToggleSlot( &( pvSlots[ mainSMALL_SLOTS + mainSTACK_SLOTS + ( prvRandom() % mainLARGE_SLOTS ) ] ), mainLARGE_SIZE );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeAll( void )
+{
+UBaseType_t x;
+
+	for( x = 0; x < mainMAX_SLOTS; x++ )
+	{
+		vPortFree( pvSlots[ x ] );
+		pvSlots[ x ] = NULL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestAllocation( void )
+{
+size_t xLow = 0, xHigh = xPortGetFreeHeapSize(), xTry;
+void *pv;
+
+	/* Binary search for the largest size that can be allocated, xLow always
+	being a size that can be. */
+	while( xLow < xHigh )
+	{
+		xTry = xLow + ( ( xHigh - xLow + 1U ) / 2U );
+		pv = pvPortMalloc( xTry );
+
+		if( pv != NULL )
+		{
+			vPortFree( pv );
+			xLow = xTry;
+		}
+		else
+		{
+			xHigh = xTry - 1U;
+		}
+	}
+
+	return xLow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintTrace( const char *pcTrace )
+{
+char cBuffer[ 140 ];
+size_t xFree, xLargest;
+unsigned long ulMedian, ulTail;
+
+	ulMedian = ulBenchHistogramPercentile( &xMallocHistogram, 500UL );
+	ulTail = ulBenchHistogramPercentile( &xMallocHistogram, 999UL );
+
+	sprintf( cBuffer, "heap: %-9s %-6s malloc median %s%lu, 99.9%% %s%lu, longest %lu cycles\r\n",
+			 mainHEAP_NAME( benchHEAP_NAME ),
+			 pcTrace,
+			 prvAtLeast( ulMedian ),
+			 ulMedian,
+			 prvAtLeast( ulTail ),
+			 ulTail,
+			 xMallocHistogram.ulLongest );
+	vBenchPrint( cBuffer );
+
+	ulMedian = ulBenchHistogramPercentile( &xFreeHistogram, 500UL );
+	ulTail = ulBenchHistogramPercentile( &xFreeHistogram, 999UL );
+
+	sprintf( cBuffer, "heap: %-9s %-6s free   median %s%lu, 99.9%% %s%lu, longest %lu cycles\r\n",
+			 mainHEAP_NAME( benchHEAP_NAME ),
+			 pcTrace,
+			 prvAtLeast( ulMedian ),
+			 ulMedian,
+			 prvAtLeast( ulTail ),
+			 ulTail,
+			 xFreeHistogram.ulLongest );
+	vBenchPrint( cBuffer );
+
+	/* Fragmentation is the share of the free space that cannot be handed out
+	as one block. */
+	xFree = xPortGetFreeHeapSize();
+	xLargest = prvLargestAllocation();
+
+	sprintf( cBuffer, "heap: %-9s %-6s %lu failed allocations, %lu bytes free, largest %lu, %lu%% fragmented\r\n",
+			 mainHEAP_NAME( benchHEAP_NAME ),
+			 pcTrace,
+			 ulFailedAllocations,
+			 ( unsigned long ) xFree,
+			 ( unsigned long ) xLargest,
+			 ( xFree > 0U ) ? ( unsigned long ) ( 100U - ( ( xLargest * 100U ) / xFree ) ) : 0UL );
+	vBenchPrint( cBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulOperation, ulStart;
+BaseType_t xRandomTrace;
+
+	( void ) pvParameters;
+
+	/* The cost of the two cycle counter reads made around each call, measured
+	in the same way as the calls themselves. */
+	for( ulOperation = 0; ulOperation < 10000UL; ulOperation++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulStart = benchGET_CYCLE_COUNT();
+			prvRecordSample( &xMallocHistogram, benchGET_CYCLE_COUNT() - ulStart );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xMallocHistogram );
+
+	/* Touch the whole heap before anything is measured. */
+	for( xRandomTrace = pdFALSE; xRandomTrace <= pdTRUE; xRandomTrace++ )
+	{
+		prvRunTrace( xRandomTrace, mainWARM_UP_OPERATIONS );
+		prvFreeAll();
+	}
+
+	for( xRandomTrace = pdFALSE; xRandomTrace <= pdTRUE; xRandomTrace++ )
+	{
+		vBenchHistogramClear( &xMallocHistogram );
+		vBenchHistogramClear( &xFreeHistogram );
+		ulFailedAllocations = 0;
+
+		xRecording = pdTRUE;
+		prvRunTrace( xRandomTrace, mainOPERATIONS );
+		xRecording = pdFALSE;
+
+		prvPrintTrace( ( xRandomTrace != pdFALSE ) ? "random" : "tasks" );
+		prvFreeAll();
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,262 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Logger benchmark.
+ *
+ *  - cost: a task writes mainSAMPLES lines, formatting each with sprintf() and
+ *    passing it to vSerialPutString() as the applications do, then writes the
+ *    same records through xLoggerPrint().  The median cycles of each call are
+ *    compared.
+ *
+ *  - drops: mainPRODUCERS tasks each log mainBURST_RECORDS records back to
+ *    back, far more than the ring buffer holds, and the records each saw
+ *    refused are compared with the drops the logger counted against it.
+ *
+ *  - filter: records below the level are logged with the level raised.  None
+ *    may be kept, or counted as drops.
+ *
+ * The results are logged too, so with loggerBINARY set to 1 the whole output
+ * can be read with Tools/log_decode.c:
+ *
+ *   ./build/bench_logger_1 | ./build/log_decode
+ *
+ * Then the scheduler is stopped (which ends the process when running on the
+ * Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+#include "logger.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* One record every mainSAMPLE_PERIOD ticks is less than the UART can send as
+text, so none are dropped while the cost is measured. */
+#define mainSAMPLES				( 40UL )
+#define mainSAMPLE_PERIOD		( ( TickType_t ) 4 )
+
+#define mainPRODUCERS			( 3UL )
+#define mainBURST_RECORDS		( 40UL )
+#define mainFILTERED_RECORDS	( 10UL )
+
+/* Long enough for the drain task to send a full ring buffer as text. */
+#define mainDRAIN_TICKS			( ( TickType_t ) 300 )
+
+#define mainLOGGER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainPRODUCER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define mainCONTROL_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Writes the samples through sprintf() and the driver, then through the
+ * logger, timing each call.
+ */
+static void prvSampleTask( void *pvParameters );
+
+/*
+ * Logs mainBURST_RECORDS records as fast as it can.
+ */
+static void prvBurstTask( void *pvParameters );
+
+/*
+ * Runs the phases and logs the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * The median of ulCount cycle counts, which are sorted.
+ */
+static unsigned long prvMedian( unsigned long *pulCycles, unsigned long ulCount );
+static int prvCompare( const void *pvA, const void *pvB );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xControlTask = NULL;
+static TaskHandle_t xBurstTasks[ mainPRODUCERS ];
+
+static unsigned long ulLoggerCycles[ mainSAMPLES ];
+static unsigned long ulDirectCycles[ mainSAMPLES ];
+static volatile unsigned long ulRefused[ mainPRODUCERS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+
+	vLoggerStart( mainLOGGER_PRIORITY );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4, NULL, mainCONTROL_PRIORITY, &xControlTask );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSampleTask( void *pvParameters )
+{
+unsigned long ulSample, ulStart;
+char cLine[ 80 ];
+
+	( void ) pvParameters;
+
+	for( ulSample = 0; ulSample < mainSAMPLES; ulSample++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		sprintf( cLine, "%8lu I %-8s sample %lu of %lu, value %lu\r\n",
+				 ( unsigned long ) xTaskGetTickCount(), pcTaskGetName( NULL ), ulSample, mainSAMPLES, ulSample * 7UL );
+		( void ) vSerialPutString( ( const signed char * ) cLine, ( unsigned short ) strlen( cLine ) );
+		ulDirectCycles[ ulSample ] = benchGET_CYCLE_COUNT() - ulStart;
+
+		vTaskDelay( mainSAMPLE_PERIOD );
+	}
+
+	for( ulSample = 0; ulSample < mainSAMPLES; ulSample++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		( void ) xLoggerPrint( loggerLEVEL_INFO, benchSAMPLE, ulSample, mainSAMPLES, ulSample * 7UL );
+		ulLoggerCycles[ ulSample ] = benchGET_CYCLE_COUNT() - ulStart;
+
+		vTaskDelay( mainSAMPLE_PERIOD );
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBurstTask( void *pvParameters )
+{
+unsigned long ulProducer = ( unsigned long ) ( uintptr_t ) pvParameters, ulRecord;
+
+	for( ulRecord = 0; ulRecord < mainBURST_RECORDS; ulRecord++ )
+	{
+		if( xLoggerPrint( loggerLEVEL_INFO, benchBURST, ulRecord, 0, 0 ) == pdFALSE )
+		{
+			ulRefused[ ulProducer ]++;
+		}
+	}
+
+	xTaskNotifyGive( xControlTask );
+
+	/* Suspended rather than deleted, so the handle stays valid for
+	ulLoggerGetDropped(). */
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+unsigned long ulProducer, ulRecord, ulKept = 0, ulDroppedBefore;
+
+	( void ) pvParameters;
+
+	/* Cost. */
+	xTaskCreate( prvSampleTask, "Sampler", configMINIMAL_STACK_SIZE * 4, NULL, mainPRODUCER_PRIORITY, NULL );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	vTaskDelay( mainDRAIN_TICKS );
+
+	/* Drops. */
+	for( ulProducer = 0; ulProducer < mainPRODUCERS; ulProducer++ )
+	{
+		xTaskCreate( prvBurstTask, "Burst", configMINIMAL_STACK_SIZE * 4, ( void * ) ( uintptr_t ) ulProducer, mainPRODUCER_PRIORITY, &( xBurstTasks[ ulProducer ] ) );
+	}
+
+	for( ulProducer = 0; ulProducer < mainPRODUCERS; ulProducer++ )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+	}
+
+	vTaskDelay( mainDRAIN_TICKS );
+
+	/* Filter. */
+	ulDroppedBefore = ulLoggerGetDropped( NULL ) + ulLoggerGetDropped( xControlTask );
+	vLoggerSetLevel( loggerLEVEL_WARNING );
+
+	for( ulRecord = 0; ulRecord < mainFILTERED_RECORDS; ulRecord++ )
+	{
+		if( xLoggerPrint( loggerLEVEL_INFO, benchFILTERED, ulRecord, 0, 0 ) != pdFALSE )
+		{
+			ulKept++;
+		}
+	}
+
+	vLoggerSetLevel( loggerLEVEL_DEBUG );
+
+	/* Results. */
+	( void ) xLoggerPrint( loggerLEVEL_INFO, benchCOST, prvMedian( ulLoggerCycles, mainSAMPLES ), prvMedian( ulDirectCycles, mainSAMPLES ), 0 );
+
+	for( ulProducer = 0; ulProducer < mainPRODUCERS; ulProducer++ )
+	{
+		( void ) xLoggerPrint( loggerLEVEL_INFO, benchDROPS, ulProducer, ulRefused[ ulProducer ], mainBURST_RECORDS );
+		( void ) xLoggerPrint( loggerLEVEL_INFO, benchDROPPED, ulProducer, ulLoggerGetDropped( xBurstTasks[ ulProducer ] ), 0 );
+	}
+
+	( void ) xLoggerPrint( loggerLEVEL_INFO, benchFILTER, ulKept, mainFILTERED_RECORDS,
+						   ( ulLoggerGetDropped( NULL ) + ulLoggerGetDropped( xControlTask ) ) - ulDroppedBefore );
+
+	/* Let the logger and then the UART send the last of it. */
+	vTaskDelay( mainDRAIN_TICKS );
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvMedian( unsigned long *pulCycles, unsigned long ulCount )
+{
+	qsort( pulCycles, ulCount, sizeof( unsigned long ), prvCompare );
+
+	return pulCycles[ ulCount / 2UL ];
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompare( const void *pvA, const void *pvB )
+{
+unsigned long ulA = *( const unsigned long * ) pvA, ulB = *( const unsigned long * ) pvB;
+
+	return ( ulA > ulB ) - ( ulA < ulB );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,246 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Queue batch benchmark.
+ *
+ * A producer posts bursts of characters to a queue drained by a consumer of
+ * higher priority, the way the UART consumer task of A2_Task3 is fed.  Each
+ * burst is passed twice:
+ *
+ *  - one item per call: xQueueSend() for every character, and xQueueReceive()
+ *    for every character, so the consumer is woken for each one;
+ *
+ *  - batched: one xQueueSendMultiple() call for the burst, and
+ *    xQueueReceiveMultiple() drains it in one go.
+ *
+ * The cycles per character and the context switches per burst are printed on
+ * UART1, then the scheduler is stopped (which ends the process when running on
+ * the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of bursts passed each way, and the characters in each. */
+#define mainBURSTS				( 2000UL )
+#define mainBURST_LENGTH		( 16 )
+
+#define mainPRODUCER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define mainCONSUMER_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+#define mainQUEUE_LENGTH		( mainBURST_LENGTH )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Posts the bursts, then prints the results.
+ */
+static void prvProducerTask( void *pvParameters );
+
+/*
+ * Drains the queue, one item at a time or in batches.
+ */
+static void prvConsumerTask( void *pvParameters );
+
+/*
+ * Post every burst, one item per call or in one call per burst, and return the
+ * number of cycles taken.
+ */
+static unsigned long prvPassBursts( BaseType_t xBatched );
+
+/*-----------------------------------------------------------*/
+
+/* Incremented by traceTASK_SWITCHED_IN() - see FreeRTOSConfig.h. */
+volatile unsigned long ulBenchContextSwitches = 0;
+
+static QueueHandle_t xQueue = NULL;
+
+/* Set by the producer before each run to tell the consumer how to drain the
+queue. */
+static volatile BaseType_t xConsumerBatched = pdFALSE;
+
+/* The characters received by the consumer, and a sum of them, so the results
+can be checked. */
+static volatile unsigned long ulCharactersReceived = 0;
+static volatile unsigned long ulChecksum = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+
+	xQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( char ) );
+
+	xTaskCreate( prvConsumerTask, "Cons", configMINIMAL_STACK_SIZE * 2, NULL, mainCONSUMER_PRIORITY, NULL );
+	xTaskCreate( prvProducerTask, "Prod", configMINIMAL_STACK_SIZE * 4, NULL, mainPRODUCER_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+char cBuffer[ mainBURST_LENGTH ];
+UBaseType_t uxReceived, uxIndex;
+unsigned long ulSum;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xConsumerBatched != pdFALSE )
+		{
+			uxReceived = xQueueReceiveMultiple( xQueue, cBuffer, mainBURST_LENGTH, portMAX_DELAY );
+		}
+		else
+		{
+			uxReceived = ( xQueueReceive( xQueue, cBuffer, portMAX_DELAY ) == pdPASS ) ? 1U : 0U;
+		}
+
+		ulSum = 0;
+
+		for( uxIndex = 0; uxIndex < uxReceived; uxIndex++ )
+		{
+			ulSum += ( unsigned char ) cBuffer[ uxIndex ];
+		}
+
+		ulChecksum += ulSum;
+		ulCharactersReceived += uxReceived;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvPassBursts( BaseType_t xBatched )
+{
+char cBurst[ mainBURST_LENGTH ];
+unsigned long ulBurst, ulStart;
+UBaseType_t uxIndex, uxSent;
+
+	xConsumerBatched = xBatched;
+
+	/* Let the consumer pick up the new mode: it is blocked on the empty queue
+	in whichever call it made last, and takes the next item with that call. */
+	( void ) xQueueSend( xQueue, "\0", portMAX_DELAY );
+	ulCharactersReceived = 0;
+	ulChecksum = 0;
+	ulBenchContextSwitches = 0;
+
+	ulStart = benchGET_CYCLE_COUNT();
+
+	for( ulBurst = 0; ulBurst < mainBURSTS; ulBurst++ )
+	{
+		for( uxIndex = 0; uxIndex < mainBURST_LENGTH; uxIndex++ )
+		{
+			cBurst[ uxIndex ] = ( char ) ( ulBurst + uxIndex );
+		}
+
+		if( xBatched != pdFALSE )
+		{
+			uxSent = 0;
+
+			while( uxSent < mainBURST_LENGTH )
+			{
+				uxSent += xQueueSendMultiple( xQueue, &( cBurst[ uxSent ] ), mainBURST_LENGTH - uxSent, portMAX_DELAY );
+			}
+		}
+		else
+		{
+			for( uxIndex = 0; uxIndex < mainBURST_LENGTH; uxIndex++ )
+			{
+				( void ) xQueueSend( xQueue, &( cBurst[ uxIndex ] ), portMAX_DELAY );
+			}
+		}
+	}
+
+	return benchGET_CYCLE_COUNT() - ulStart;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+unsigned long ulCycles, ulSwitches, ulExpectedSum = 0, ulBurst;
+UBaseType_t uxIndex;
+BaseType_t xBatched;
+char cBuffer[ 140 ];
+
+	( void ) pvParameters;
+
+	for( ulBurst = 0; ulBurst < mainBURSTS; ulBurst++ )
+	{
+		for( uxIndex = 0; uxIndex < mainBURST_LENGTH; uxIndex++ )
+		{
+			ulExpectedSum += ( unsigned char ) ( ulBurst + uxIndex );
+		}
+	}
+
+	for( xBatched = pdFALSE; xBatched <= pdTRUE; xBatched++ )
+	{
+		ulCycles = prvPassBursts( xBatched );
+		ulSwitches = ulBenchContextSwitches;
+
+		/* The consumer has the higher priority so has already taken the last
+		burst. */
+		sprintf( cBuffer, "queue batch: %-8s %lu bursts of %d, %lu cycles per item, %lu.%02lu context switches per burst%s\r\n",
+				 ( xBatched != pdFALSE ) ? "batched" : "per item",
+				 mainBURSTS,
+				 mainBURST_LENGTH,
+				 ulCycles / ( mainBURSTS * mainBURST_LENGTH ),
+				 ulSwitches / mainBURSTS,
+				 ( ( ulSwitches % mainBURSTS ) * 100UL ) / mainBURSTS,
+				 ( ( ulCharactersReceived == ( mainBURSTS * mainBURST_LENGTH ) ) && ( ulChecksum == ulExpectedSum ) ) ? "" : " - ITEMS LOST" );
+		vBenchPrint( cBuffer );
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
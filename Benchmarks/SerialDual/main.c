@@ -0,0 +1,341 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * UART0 and UART1 throughput benchmark.
+ *
+ * Each port is given a writer task, which sends mainLINES numbered lines with
+ * xSerialPortWrite() as fast as the driver takes them, and a reader task,
+ * which reads mainRX_BYTES known characters with xSerialPortRead().  The
+ * transmitters are connected to temporary files and the receivers fed from
+ * them.
+ *
+ * The run is made first on UART1 alone, then on both ports at once.  The time
+ * each port takes to send its lines is compared with the time the baud rate
+ * allows, and the lines and characters that arrived intact are counted - a
+ * port that slowed the other down, or lost or mixed up characters, shows up
+ * in the results.  They are printed on UART1, then the scheduler is stopped
+ * (which ends the process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Constants for the UART. */
+#define mainBITS_PER_CHAR		( 10UL )
+#define mainCLOCK_SCALING		( 16UL )
+#define mainDIVISOR				( configCPU_CLOCK_HZ / ( benchCOM_BAUD_RATE * mainCLOCK_SCALING ) )
+
+/* The lines each writer sends.  Each is mainLINE_LENGTH characters long. */
+#define mainLINES				( 96UL )
+#define mainLINE_LENGTH			( 48 )
+#define mainLINE_FORMAT			"uart%lu line %04lu ..............................\r\n"
+
+/* The characters each reader expects, read mainRX_CHUNK at a time. */
+#define mainRX_BYTES			( 4096UL )
+#define mainRX_CHUNK			( 64U )
+#define mainRX_TIMEOUT			( ( TickType_t ) 500 )
+
+#define mainPORTS				( 2 )
+#define mainTEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainCONTROL_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/* A port under test, and its results. */
+typedef struct PORT_TEST
+{
+	xComPortHandle xPort;
+	unsigned long ulUart;
+	FILE *pxTxCapture;
+	FILE *pxRxSource;
+	TickType_t xTxTicks;
+	unsigned long ulShortWrites;
+	unsigned long ulRxIntact;
+} PortTest_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Writes the lines of the port pointed to by pvParameters, and waits for them
+ * to be sent.
+ */
+static void prvWriterTask( void *pvParameters );
+
+/*
+ * Reads the characters fed to the port pointed to by pvParameters.
+ */
+static void prvReaderTask( void *pvParameters );
+
+/*
+ * Runs UART1 alone, then both ports, and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Connects the ports to files, runs a writer and a reader on each at once,
+ * then prints the results under pcName.
+ */
+static void prvRunPhase( PortTest_t * const pxTests[], unsigned long ulPorts, const char *pcName );
+
+/*
+ * Checks the lines written to iFd.  Returns the number that arrived intact and
+ * in order.
+ */
+static unsigned long prvCheckLines( int iFd, unsigned long ulUart );
+
+/*
+ * The character a reader expects at ulIndex.
+ */
+static char prvRxCharacter( unsigned long ulUart, unsigned long ulIndex );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xControlTask = NULL;
+static TickType_t xStart = 0;
+static PortTest_t xTests[ mainPORTS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_STOPPED );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4, NULL, mainCONTROL_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+PortTest_t *pxTest = ( PortTest_t * ) pvParameters;
+unsigned long ulLine;
+char cLine[ mainLINE_LENGTH + 1 ];
+
+	for( ulLine = 0; ulLine < mainLINES; ulLine++ )
+	{
+		sprintf( cLine, mainLINE_FORMAT, pxTest->ulUart, ulLine );
+
+		if( xSerialPortWrite( pxTest->xPort, ( const signed char * ) cLine, mainLINE_LENGTH, portMAX_DELAY ) != mainLINE_LENGTH )
+		{
+			pxTest->ulShortWrites++;
+		}
+	}
+
+	( void ) xSerialPortFlush( pxTest->xPort, portMAX_DELAY );
+	pxTest->xTxTicks = xTaskGetTickCount() - xStart;
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+PortTest_t *pxTest = ( PortTest_t * ) pvParameters;
+unsigned long ulIndex = 0;
+unsigned short usRead, usChar;
+signed char cChunk[ mainRX_CHUNK ];
+
+	while( ulIndex < mainRX_BYTES )
+	{
+		usRead = xSerialPortRead( pxTest->xPort, cChunk, mainRX_CHUNK, mainRX_TIMEOUT );
+		if( usRead == 0 )
+		{
+			/* Characters were lost, so the rest will never come. */
+			break;
+		}
+
+		for( usChar = 0; usChar < usRead; usChar++ )
+		{
+			if( ( char ) cChunk[ usChar ] == prvRxCharacter( pxTest->ulUart, ulIndex ) )
+			{
+				pxTest->ulRxIntact++;
+			}
+
+			ulIndex++;
+		}
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+PortTest_t * const pxUart1Alone[] = { &( xTests[ 1 ] ) };
+PortTest_t * const pxBoth[] = { &( xTests[ 0 ] ), &( xTests[ 1 ] ) };
+
+	( void ) pvParameters;
+
+	xControlTask = xTaskGetCurrentTaskHandle();
+
+	xTests[ 0 ].xPort = xSerialPortInit( serCOM1, ser115200, serNO_PARITY, serBITS_8, serSTOP_1 );
+	xTests[ 0 ].ulUart = 0;
+	xTests[ 1 ].xPort = xSerialPortInit( serCOM2, ser115200, serNO_PARITY, serBITS_8, serSTOP_1 );
+	xTests[ 1 ].ulUart = 1;
+	configASSERT( xTests[ 0 ].xPort );
+	configASSERT( xTests[ 1 ].xPort );
+
+	prvRunPhase( pxUart1Alone, 1, "uart1 alone" );
+	prvRunPhase( pxBoth, mainPORTS, "both ports" );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunPhase( PortTest_t * const pxTests[], unsigned long ulPorts, const char *pcName )
+{
+PortTest_t *pxTest;
+unsigned long ulPort, ulIndex, ulIntact, ulIdealTicks;
+char cBuffer[ 140 ];
+
+	/* The results of the last phase have to leave UART1 before it is
+	connected to a file. */
+	( void ) xSerialFlush( portMAX_DELAY );
+
+	for( ulPort = 0; ulPort < ulPorts; ulPort++ )
+	{
+		pxTest = pxTests[ ulPort ];
+		pxTest->xTxTicks = 0;
+		pxTest->ulShortWrites = 0;
+		pxTest->ulRxIntact = 0;
+
+		pxTest->pxTxCapture = tmpfile();
+		pxTest->pxRxSource = tmpfile();
+		configASSERT( pxTest->pxTxCapture );
+		configASSERT( pxTest->pxRxSource );
+
+		for( ulIndex = 0; ulIndex < mainRX_BYTES; ulIndex++ )
+		{
+			fputc( prvRxCharacter( pxTest->ulUart, ulIndex ), pxTest->pxRxSource );
+		}
+
+		fflush( pxTest->pxRxSource );
+		( void ) lseek( fileno( pxTest->pxRxSource ), 0, SEEK_SET );
+	}
+
+	/* Start the characters flowing and the tasks together. */
+	xStart = xTaskGetTickCount();
+
+	for( ulPort = 0; ulPort < ulPorts; ulPort++ )
+	{
+		pxTest = pxTests[ ulPort ];
+		vSimConnectUart( pxTest->ulUart, fileno( pxTest->pxTxCapture ), fileno( pxTest->pxRxSource ) );
+		xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE * 4, pxTest, mainTEST_PRIORITY, NULL );
+		xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE * 4, pxTest, mainTEST_PRIORITY, NULL );
+	}
+
+	for( ulPort = 0; ulPort < ( ulPorts * 2UL ); ulPort++ )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+	}
+
+	vSimConnectUart( 0, -1, -1 );
+	vSimConnectUart( 1, STDOUT_FILENO, -1 );
+
+	/* At the baud rate the divisor actually gives. */
+	ulIdealTicks = ( unsigned long ) ( ( ( unsigned long long ) mainLINES * mainLINE_LENGTH * mainBITS_PER_CHAR * configTICK_RATE_HZ * mainCLOCK_SCALING * mainDIVISOR ) / configCPU_CLOCK_HZ );
+
+	for( ulPort = 0; ulPort < ulPorts; ulPort++ )
+	{
+		pxTest = pxTests[ ulPort ];
+		ulIntact = prvCheckLines( fileno( pxTest->pxTxCapture ), pxTest->ulUart );
+		fclose( pxTest->pxTxCapture );
+		fclose( pxTest->pxRxSource );
+
+		sprintf( cBuffer, "serial dual: %s: uart%lu tx %lu bytes in %lu ticks (ideal %lu), %lu of %lu lines intact, %lu short writes\r\n",
+				 pcName, pxTest->ulUart, mainLINES * mainLINE_LENGTH, ( unsigned long ) pxTest->xTxTicks, ulIdealTicks,
+				 ulIntact, mainLINES, pxTest->ulShortWrites );
+		vBenchPrint( cBuffer );
+
+		sprintf( cBuffer, "serial dual: %s: uart%lu rx %lu of %lu bytes intact\r\n",
+				 pcName, pxTest->ulUart, pxTest->ulRxIntact, mainRX_BYTES );
+		vBenchPrint( cBuffer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCheckLines( int iFd, unsigned long ulUart )
+{
+unsigned long ulIntact = 0;
+char cLine[ mainLINE_LENGTH + 1 ], cExpected[ mainLINE_LENGTH + 1 ];
+
+	( void ) lseek( iFd, 0, SEEK_SET );
+
+	while( read( iFd, cLine, mainLINE_LENGTH ) == mainLINE_LENGTH )
+	{
+		cLine[ mainLINE_LENGTH ] = '\0';
+
+		/* Each line has to be the next one of the port's writer. */
+		sprintf( cExpected, mainLINE_FORMAT, ulUart, ulIntact );
+
+		if( strcmp( cLine, cExpected ) != 0 )
+		{
+			break;
+		}
+
+		ulIntact++;
+	}
+
+	return ulIntact;
+}
+/*-----------------------------------------------------------*/
+
+static char prvRxCharacter( unsigned long ulUart, unsigned long ulIndex )
+{
+	/* A different sequence on each port, so characters crossing from one to
+	the other are noticed. */
+	return ( char ) ( 'A' + ( ( ulIndex + ( ulUart * 13UL ) ) % 26UL ) );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,235 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * UART1 transmit benchmark.
+ *
+ * Two tasks of the same priority each write mainLINES numbered lines with
+ * xSerialWrite(), as fast as the driver takes them, while UART1 is connected
+ * to a temporary file in place of stdout.  When both are done and the driver
+ * has flushed, the file is read back and checked line by line, so a message
+ * that was dropped, or interleaved with the other task's, shows up as lost.
+ *
+ * The THRE interrupts are counted by wrapping vUART_ISRHandler() at link
+ * time.  The driver is built once writing one character to the FIFO per
+ * interrupt (serTX_FIFO_DEPTH 1) and once filling the whole FIFO
+ * (serTX_FIFO_DEPTH 16).  The results are printed on UART1, then the scheduler
+ * is stopped (which ends the process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Constants for the UART. */
+#define mainBITS_PER_CHAR		( 10UL )
+#define mainCLOCK_SCALING		( 16UL )
+#define mainDIVISOR				( configCPU_CLOCK_HZ / ( benchCOM_BAUD_RATE * mainCLOCK_SCALING ) )
+
+/* The lines each writer sends.  Each is mainLINE_LENGTH characters long. */
+#define mainWRITERS				( 2 )
+#define mainLINES				( 100UL )
+#define mainLINE_LENGTH			( 48 )
+#define mainLINE_FORMAT			"writer %lu line %04lu ...........................\r\n"
+
+#define mainWRITER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainCONTROL_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Writes the lines of the writer numbered pvParameters.
+ */
+static void prvWriterTask( void *pvParameters );
+
+/*
+ * Starts the writers, waits for them, then checks and prints the results.
+ */
+static void prvControlTask( void *pvParameters );
+
+/*
+ * Checks the lines written to iFd.  Returns the number that arrived intact and
+ * in order.
+ */
+static unsigned long prvCheckLines( int iFd );
+
+/*
+ * Counts the UART1 interrupts, then calls the driver's handler.
+ */
+void __real_vUART_ISRHandler( void );
+void __wrap_vUART_ISRHandler( void );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xControlTask = NULL;
+static volatile unsigned long ulInterrupts = 0;
+static unsigned long ulShortWrites = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_STOPPED );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE * 4, NULL, mainCONTROL_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void __wrap_vUART_ISRHandler( void )
+{
+	ulInterrupts++;
+	__real_vUART_ISRHandler();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+unsigned long ulWriter = ( unsigned long ) ( uintptr_t ) pvParameters, ulLine;
+char cLine[ mainLINE_LENGTH + 1 ];
+
+	for( ulLine = 0; ulLine < mainLINES; ulLine++ )
+	{
+		sprintf( cLine, mainLINE_FORMAT, ulWriter, ulLine );
+
+		if( xSerialWrite( ( const signed char * ) cLine, mainLINE_LENGTH, portMAX_DELAY ) != mainLINE_LENGTH )
+		{
+			ulShortWrites++;
+		}
+	}
+
+	xTaskNotifyGive( xControlTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+FILE *pxCapture;
+unsigned long ulWriter, ulIntact, ulBytes, ulIdealTicks;
+TickType_t xStart, xTicks;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	xControlTask = xTaskGetCurrentTaskHandle();
+
+	/* Send UART1 to a file for the run. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	pxCapture = tmpfile();
+	configASSERT( pxCapture );
+	vSimConnectUart( 1, fileno( pxCapture ), -1 );
+
+	xStart = xTaskGetTickCount();
+	ulInterrupts = 0;
+
+	for( ulWriter = 0; ulWriter < mainWRITERS; ulWriter++ )
+	{
+		xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE * 4, ( void * ) ( uintptr_t ) ulWriter, mainWRITER_PRIORITY, NULL );
+	}
+
+	for( ulWriter = 0; ulWriter < mainWRITERS; ulWriter++ )
+	{
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+	}
+
+	( void ) xSerialFlush( portMAX_DELAY );
+	xTicks = xTaskGetTickCount() - xStart;
+
+	vSimConnectUart( 1, STDOUT_FILENO, STDIN_FILENO );
+	ulIntact = prvCheckLines( fileno( pxCapture ) );
+	fclose( pxCapture );
+
+	ulBytes = mainWRITERS * mainLINES * mainLINE_LENGTH;
+	/* At the baud rate the divisor actually gives. */
+	ulIdealTicks = ( unsigned long ) ( ( ( unsigned long long ) ulBytes * mainBITS_PER_CHAR * configTICK_RATE_HZ * mainCLOCK_SCALING * mainDIVISOR ) / configCPU_CLOCK_HZ );
+
+	sprintf( cBuffer, "serial tx: fifo fill %2u: %lu bytes in %lu ticks (ideal %lu), %lu interrupts, %lu.%lu bytes each\r\n",
+			 ( unsigned ) serTX_FIFO_DEPTH, ulBytes, ( unsigned long ) xTicks, ulIdealTicks, ulInterrupts,
+			 ulBytes / ulInterrupts, ( ( ulBytes * 10UL ) / ulInterrupts ) % 10UL );
+	vBenchPrint( cBuffer );
+
+	sprintf( cBuffer, "serial tx: fifo fill %2u: %lu writers, %lu of %lu lines intact, %lu short writes\r\n",
+			 ( unsigned ) serTX_FIFO_DEPTH, ( unsigned long ) mainWRITERS, ulIntact, mainWRITERS * mainLINES, ulShortWrites );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCheckLines( int iFd )
+{
+unsigned long ulNext[ mainWRITERS ] = { 0 }, ulWriter, ulIntact = 0;
+char cLine[ mainLINE_LENGTH + 1 ], cExpected[ mainLINE_LENGTH + 1 ];
+
+	( void ) lseek( iFd, 0, SEEK_SET );
+
+	while( read( iFd, cLine, mainLINE_LENGTH ) == mainLINE_LENGTH )
+	{
+		cLine[ mainLINE_LENGTH ] = '\0';
+
+		/* Each line has to be the next one of one of the writers. */
+		for( ulWriter = 0; ulWriter < mainWRITERS; ulWriter++ )
+		{
+			sprintf( cExpected, mainLINE_FORMAT, ulWriter, ulNext[ ulWriter ] );
+
+			if( strcmp( cLine, cExpected ) == 0 )
+			{
+				ulNext[ ulWriter ]++;
+				ulIntact++;
+				break;
+			}
+		}
+	}
+
+	return ulIntact;
+}
+/*-----------------------------------------------------------*/
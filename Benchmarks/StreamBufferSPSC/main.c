@@ -0,0 +1,489 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Single producer, single consumer stream buffer benchmark.
+ *
+ * Streams data through stream buffers the way a UART or ADC driver would, and
+ * measures how long interrupts are masked while it does - the time an
+ * interrupt arriving then has to wait, so the interrupt latency the stream
+ * adds:
+ *
+ *  - interrupt to task: the Timer1 match 0 interrupt, once a tick, writes
+ *    mainISR_BYTES bytes in mainISR_CHUNK byte pieces, as an interrupt
+ *    draining a receive FIFO would, and a task blocked on the buffer reads
+ *    them in mainTASK_CHUNK byte pieces.  The cycles the interrupt takes are
+ *    counted too.
+ *
+ *  - task to task: a task writes mainTASK_CHUNK byte pieces with a block time
+ *    and a higher priority task, woken at the trigger level, reads them, both
+ *    as fast as they can.
+ *
+ * Every byte read is checked against the sequence written.
+ *
+ * The benchmark is built with the stream buffers locking to move data, and
+ * in the single producer, single consumer mode (configUSE_STREAM_BUFFER_SPSC),
+ * which only locks to block or wake a task.  On the host every critical
+ * section a task enters is timed, through wrappers linked in front of
+ * vPortEnterCritical() and vPortExitCritical(); the longest is the most an
+ * interrupt is held off.  The results are printed on UART1, then the
+ * scheduler is stopped (which ends the process when running on the Linux
+ * host).
+ *
+ * The interrupt asks for a context switch with portYIELD_FROM_ISR(), as the
+ * simulated interrupts of the host build can.  On the target it would need an
+ * entry point that saves and restores the task context, as serialISR.s does.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Timer1 match 0 interrupt, in the VIC slot after the tick and UART1. */
+#define mainMCR_MR0_INTERRUPT	( ( unsigned long ) 0x01 )
+#define mainIR_MR0				( ( unsigned long ) 0x01 )
+#define mainVIC_CHANNEL			( ( unsigned long ) 0x0005 )
+#define mainVIC_CHANNEL_BIT		( ( unsigned long ) 0x0020 )
+#define mainVIC_ENABLE			( ( unsigned long ) 0x0020 )
+#define mainCLEAR_VIC_INTERRUPT	( 0 )
+
+/* The interrupt is next due this long after it last ran. */
+#define mainINTERRUPT_US		( 1000UL )
+
+/* What the interrupt writes each time it runs, and in what pieces. */
+#define mainISR_BYTES			( 64 )
+#define mainISR_CHUNK			( 8 )
+
+/* The pieces the tasks write and read in. */
+#define mainTASK_CHUNK			( 16 )
+
+#define mainBUFFER_SIZE			( 512 )
+#define mainTRIGGER_LEVEL		( 128 )
+
+/* The reader is only woken once the trigger level is reached, so it times out
+to read the last bytes. */
+#define mainREADER_BLOCK_TICKS	( ( TickType_t ) 10 )
+
+/* How long the interrupt runs for, and how much the writing task writes. */
+#define mainISR_PHASE_TICKS		( ( TickType_t ) 2000 / portTICK_PERIOD_MS )
+#define mainTASK_PHASE_CHUNKS	( 50000UL )
+
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainREADER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+#define mainHISTOGRAM_CYCLES	( 16UL )
+
+/* Masked times at least this long are counted per MB, which unlike the
+percentiles does not depend on how many short sections there were. */
+#define mainLONG_SECTION_CYCLES	( 512UL )
+
+#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+	#define mainMODE			"spsc"
+#else
+	#define mainMODE			"locked"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the two phases, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Reads the stream and checks it, until it has read ulReaderBytes bytes.
+ */
+static void prvReaderTask( void *pvParameters );
+
+/*
+ * The Timer1 match 0 interrupt, which writes to the stream buffer.
+ */
+static void prvTimer1ISR( void );
+
+/*
+ * Start and stop the interrupt.
+ */
+static void prvStartInterrupt( void );
+static void prvStopInterrupt( void );
+
+/*
+ * Start a phase, with a new stream buffer and reader.
+ */
+static void prvStartPhase( size_t xTriggerLevel, unsigned long ulBytes );
+
+/*
+ * Wait for the reader to finish, then print the results of the phase.
+ */
+static void prvEndPhase( const char *pcPhase );
+
+/*-----------------------------------------------------------*/
+
+static StreamBufferHandle_t xStream = NULL;
+static TaskHandle_t xBenchmarkTask = NULL;
+
+/* The bytes the reader is to read, and the errors it found in them. */
+static volatile unsigned long ulReaderBytes = 0, ulReaderErrors = 0;
+
+/* The next byte written by the interrupt, the bytes it could not write, and
+the cycles it took. */
+static unsigned char ucIsrNext = 0;
+static volatile unsigned long ulIsrDropped = 0, ulIsrCalls = 0, ulIsrCycles = 0, ulIsrLongest = 0;
+
+/* The times interrupts were masked by tasks over one phase, counted in a
+histogram of mainHISTOGRAM_CYCLES cycle buckets.  The host is itself preempted
+now and then, so percentiles are reported rather than the longest. */
+static BenchHistogram_t xMasking;
+
+/*-----------------------------------------------------------*/
+
+#if( benchTIME_CRITICAL_SECTIONS == 1 )
+
+	/* The functions the wrappers wrap, renamed by the linker. */
+	extern void __real_vPortEnterCritical( void );
+	extern void __real_vPortExitCritical( void );
+
+	void __wrap_vPortEnterCritical( void );
+	void __wrap_vPortExitCritical( void );
+
+	/* The nesting of the running task, and when it masked interrupts. */
+	static unsigned long ulMaskNesting = 0, ulMaskedAt = 0;
+
+	/* The rest of a critical section a task is switched back into is not
+	timed, as on the host it would include switching the threads. */
+	static BaseType_t xMaskTimed = pdFALSE;
+
+	static void prvRecordMasking( void )
+	{
+	unsigned long ulCycles;
+
+		ulCycles = benchGET_CYCLE_COUNT() - ulMaskedAt;
+		vBenchHistogramRecord( &xMasking, ulCycles );
+	}
+	/*-----------------------------------------------------------*/
+
+	void __wrap_vPortEnterCritical( void )
+	{
+		__real_vPortEnterCritical();
+
+		/* Interrupts are already masked inside a simulated interrupt. */
+		if( xPortIsInsideInterrupt() == pdFALSE )
+		{
+			if( ulMaskNesting == 0UL )
+			{
+				ulMaskedAt = benchGET_CYCLE_COUNT();
+				xMaskTimed = pdTRUE;
+			}
+
+			ulMaskNesting++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void __wrap_vPortExitCritical( void )
+	{
+		if( ( xPortIsInsideInterrupt() == pdFALSE ) && ( ulMaskNesting > 0UL ) )
+		{
+			ulMaskNesting--;
+
+			if( ( ulMaskNesting == 0UL ) && ( xMaskTimed != pdFALSE ) )
+			{
+				prvRecordMasking();
+			}
+		}
+
+		__real_vPortExitCritical();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vBenchTaskSwitchedOut( void )
+	{
+		/* The task that is switched in masks interrupts or not as it did when
+		it was switched out, so the time ends here. */
+		if( ( ulMaskNesting > 0UL ) && ( xMaskTimed != pdFALSE ) )
+		{
+			prvRecordMasking();
+		}
+
+		vTaskSetThreadLocalStoragePointer( NULL, 0, ( void * ) ulMaskNesting );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vBenchTaskSwitchedIn( void )
+	{
+		ulMaskNesting = ( unsigned long ) pvTaskGetThreadLocalStoragePointer( NULL, 0 );
+		xMaskTimed = pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* benchTIME_CRITICAL_SECTIONS */
+
+int main( void )
+{
+	/* Set up first, as the serial driver enters critical sections. */
+	vBenchHistogramInit( &xMasking, mainHISTOGRAM_CYCLES );
+	vBenchSetupHardware( benchTIMER1_MICROSECONDS );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, &xBenchmarkTask );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimer1ISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+unsigned char ucChunk[ mainISR_CHUNK ];
+unsigned long ulStart, ulCycles;
+size_t xChunk, xByte;
+
+	T1IR = mainIR_MR0;
+
+	ulStart = benchGET_CYCLE_COUNT();
+
+	for( xChunk = 0; xChunk < ( mainISR_BYTES / mainISR_CHUNK ); xChunk++ )
+	{
+		for( xByte = 0; xByte < mainISR_CHUNK; xByte++ )
+		{
+			ucChunk[ xByte ] = ucIsrNext++;
+		}
+
+		if( xStreamBufferSendFromISR( xStream, ucChunk, mainISR_CHUNK, &xHigherPriorityTaskWoken ) != mainISR_CHUNK )
+		{
+			/* The reader is behind.  Later bytes will not follow on. */
+			ulIsrDropped += mainISR_CHUNK;
+		}
+	}
+
+	ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+
+	/* A count taken across a reset of the counter is dropped. */
+	if( ulCycles < 0x80000000UL )
+	{
+		ulIsrCalls++;
+		ulIsrCycles += ulCycles;
+
+		if( ulCycles > ulIsrLongest )
+		{
+			ulIsrLongest = ulCycles;
+		}
+	}
+
+	T1MR0 = T1TC + mainINTERRUPT_US;
+
+	/* Clear the ISR in the VIC. */
+	VICVectAddr = mainCLEAR_VIC_INTERRUPT;
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartInterrupt( void )
+{
+	taskENTER_CRITICAL();
+	{
+		VICIntSelect &= ~( mainVIC_CHANNEL_BIT );
+		VICIntEnable |= mainVIC_CHANNEL_BIT;
+		VICVectAddr2 = ( unsigned long ) prvTimer1ISR;
+		VICVectCntl2 = mainVIC_CHANNEL | mainVIC_ENABLE;
+
+		T1MR0 = T1TC + mainINTERRUPT_US;
+		T1MCR |= mainMCR_MR0_INTERRUPT;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopInterrupt( void )
+{
+	taskENTER_CRITICAL();
+	{
+		T1MCR &= ~mainMCR_MR0_INTERRUPT;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+unsigned char ucChunk[ mainTASK_CHUNK ], ucNext = 0;
+unsigned long ulRead = 0;
+size_t xReceived, xByte;
+
+	( void ) pvParameters;
+
+	while( ulRead < ulReaderBytes )
+	{
+		xReceived = xStreamBufferReceive( xStream, ucChunk, sizeof( ucChunk ), mainREADER_BLOCK_TICKS );
+
+		for( xByte = 0; xByte < xReceived; xByte++ )
+		{
+			if( ucChunk[ xByte ] != ucNext )
+			{
+				ulReaderErrors++;
+				ucNext = ucChunk[ xByte ];
+			}
+
+			ucNext++;
+		}
+
+		ulRead += xReceived;
+	}
+
+	xTaskNotifyGive( xBenchmarkTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartPhase( size_t xTriggerLevel, unsigned long ulBytes )
+{
+	xStream = xStreamBufferCreate( mainBUFFER_SIZE, xTriggerLevel );
+	configASSERT( xStream );
+
+	ulReaderBytes = ulBytes;
+	ulReaderErrors = 0;
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE * 2, NULL, mainREADER_PRIORITY, NULL );
+
+	/* Let the reader block before anything is written. */
+	vTaskDelay( 2 );
+	vBenchHistogramClear( &xMasking );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndPhase( const char *pcPhase )
+{
+static BenchHistogram_t xResult;
+unsigned long ulPerKB;
+char cBuffer[ 120 ];
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	/* Copied before anything else here masks interrupts. */
+	xResult = xMasking;
+	ulPerKB = ( ulReaderBytes + 1023UL ) / 1024UL;
+
+	vStreamBufferDelete( xStream );
+	xStream = NULL;
+
+	sprintf( cBuffer, "stream buffer %-6s: %s, %lu bytes, %lu errors, masked %lu times and %lu cycles per KB\r\n",
+			 mainMODE,
+			 pcPhase,
+			 ulReaderBytes,
+			 ulReaderErrors,
+			 xResult.ulSamples / ulPerKB,
+			 xResult.ulTotal / ulPerKB );
+	vBenchPrint( cBuffer );
+
+	sprintf( cBuffer, "stream buffer %-6s: %s, masked median %lu cycles, 99%% %lu cycles, 99.9%% %lu cycles\r\n",
+			 mainMODE,
+			 pcPhase,
+			 ulBenchHistogramPercentile( &xResult, 500UL ),
+			 ulBenchHistogramPercentile( &xResult, 990UL ),
+			 ulBenchHistogramPercentile( &xResult, 999UL ) );
+	vBenchPrint( cBuffer );
+
+	sprintf( cBuffer, "stream buffer %-6s: %s, masked %lu cycles or longer %lu times per MB\r\n",
+			 mainMODE,
+			 pcPhase,
+			 mainLONG_SECTION_CYCLES,
+			 ( ulBenchHistogramCountFrom( &xResult, mainLONG_SECTION_CYCLES ) * 1024UL ) / ulPerKB );
+	vBenchPrint( cBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned char ucChunk[ mainTASK_CHUNK ], ucNext = 0;
+unsigned long ulChunk, ulStart, ulCycles;
+size_t xByte;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	/* Interrupt to task.  The reader is woken by each byte, as a driver's
+	reader would be. */
+	prvStartPhase( 1, ( mainISR_PHASE_TICKS * mainISR_BYTES ) );
+	prvStartInterrupt();
+
+	while( ( ulIsrCalls * mainISR_BYTES ) < ulReaderBytes )
+	{
+		vTaskDelay( 10 );
+	}
+
+	prvStopInterrupt();
+	prvEndPhase( "isr to task" );
+
+	sprintf( cBuffer, "stream buffer %-6s: isr to task, isr average %lu cycles, longest %lu cycles, %lu bytes dropped\r\n",
+			 mainMODE,
+			 ulIsrCycles / ( ( ulIsrCalls != 0UL ) ? ulIsrCalls : 1UL ),
+			 ulIsrLongest,
+			 ulIsrDropped );
+	vBenchPrint( cBuffer );
+
+	/* Task to task. */
+	prvStartPhase( mainTRIGGER_LEVEL, mainTASK_PHASE_CHUNKS * mainTASK_CHUNK );
+	ulStart = benchGET_CYCLE_COUNT();
+
+	for( ulChunk = 0; ulChunk < mainTASK_PHASE_CHUNKS; ulChunk++ )
+	{
+		for( xByte = 0; xByte < mainTASK_CHUNK; xByte++ )
+		{
+			ucChunk[ xByte ] = ucNext++;
+		}
+
+		( void ) xStreamBufferSend( xStream, ucChunk, sizeof( ucChunk ), portMAX_DELAY );
+	}
+
+	ulCycles = ( benchGET_CYCLE_COUNT() - ulStart ) / mainTASK_PHASE_CHUNKS;
+	prvEndPhase( "task to task" );
+
+	sprintf( cBuffer, "stream buffer %-6s: task to task, %lu cycles per %d bytes\r\n", mainMODE, ulCycles, mainTASK_CHUNK );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
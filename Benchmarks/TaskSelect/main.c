@@ -0,0 +1,185 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Ready task selection benchmark.
+ *
+ * Measures, in CPU cycles, how long vTaskSwitchContext() takes to select the
+ * next task to run, with configUSE_PORT_OPTIMISED_TASK_SELECTION set to 0 (the
+ * generic search of the ready lists) or 1 (the port's ready priority bitmap).
+ *
+ * The worst case for the generic search is set up on purpose: a task at the
+ * highest priority repeatedly suspends itself and is resumed by a task at
+ * priority 1, so every other selection has to walk down every empty ready list
+ * between the two.  The results are printed on UART1, then the scheduler is
+ * stopped (which ends the process when running on the Linux host).
+ *
+ * The median is printed as measured, next to the cost of the two counter reads
+ * around it, rather than with that cost taken off.  On a host the bitmap
+ * selection takes no longer than the jitter of the reads themselves, so the
+ * difference would round to nothing.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of times the high priority task is resumed.  Each round trip is
+two task selections. */
+#define mainROUND_TRIPS			( 20000UL )
+
+#define mainLOW_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainHIGH_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	#define mainSELECTION_MODE	"bitmap"
+#else
+	#define mainSELECTION_MODE	"generic"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Repeatedly suspends itself at the highest priority.
+ */
+static void prvHighPriorityTask( void *pvParameters );
+
+/*
+ * Resumes the high priority task, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* Written by traceTASK_SWITCHED_OUT() - see FreeRTOSConfig.h. */
+volatile unsigned long ulBenchSelectStart = 0;
+
+/* Only selections made while this is set are counted. */
+static volatile BaseType_t xRecording = pdFALSE;
+
+/* Selections are counted in a histogram of one cycle buckets, and the median
+is reported as it is not skewed by the occasional selection that is
+interrupted. */
+static BenchHistogram_t xHistogram;
+
+static TaskHandle_t xHighPriorityTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvHighPriorityTask, "High", configMINIMAL_STACK_SIZE, NULL, mainHIGH_PRIORITY, &xHighPriorityTask );
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, mainLOW_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchRecordSelection( unsigned long ulCycles )
+{
+	if( xRecording != pdFALSE )
+	{
+		vBenchHistogramRecord( &xHistogram, ulCycles );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighPriorityTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulRound, ulStart, ulOverhead, ulSelections, ulMedian;
+char cBuffer[ 160 ];
+
+	( void ) pvParameters;
+
+	/* The cost of the two cycle counter reads made around each selection,
+	measured in the same way as the selections themselves. */
+	for( ulRound = 0; ulRound < ( mainROUND_TRIPS * 2UL ); ulRound++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xHistogram );
+
+	xRecording = pdTRUE;
+
+	for( ulRound = 0; ulRound < mainROUND_TRIPS; ulRound++ )
+	{
+		vTaskResume( xHighPriorityTask );
+	}
+
+	xRecording = pdFALSE;
+
+	ulSelections = xHistogram.ulSamples;
+	ulMedian = ulBenchHistogramMedian( &xHistogram );
+
+	snprintf( cBuffer, sizeof( cBuffer ), "task select: %-7s %2d priorities, %lu selections, median %lu cycles, of which %lu reading the counter\r\n",
+			  mainSELECTION_MODE,
+			  ( int ) configMAX_PRIORITIES,
+			  ulSelections,
+			  ulMedian,
+			  ulOverhead );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
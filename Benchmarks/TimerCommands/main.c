@@ -0,0 +1,241 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Timer command queue benchmark.
+ *
+ * Eight one-shot timers debounce eight inputs: each is reset on every edge,
+ * and expires mainDEBOUNCE_TICKS after the last.  The benchmark task, above
+ * the timer task, plays bursts of mainEDGES_PER_BURST edges on every input,
+ * each burst lasting a few ticks, with xTimerReset() told not to wait - as an
+ * edge handler could not.  The timer task only runs between bursts.  Built with configUSE_TIMER_COMMAND_COALESCING set to 0,
+ * every reset needs a place in the timer command queue, so most find it full
+ * and fail, so a timer runs from an earlier edge than the last and expires
+ * early.  Set to 1, resets are folded into the one each timer already has
+ * queued.
+ *
+ * Reported are the CPU cycles taken by xTimerReset(), how many resets failed,
+ * how many commands the timer task processed, and whether each timer expired
+ * once, and no earlier than mainDEBOUNCE_TICKS after its last reset.  The
+ * results are printed on UART1, then the scheduler is stopped (which ends the
+ * process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define mainBENCH_PRIORITY		( configTIMER_TASK_PRIORITY + 2 )
+
+#define mainINPUTS				( 8 )
+#define mainDEBOUNCE_TICKS		( ( TickType_t ) 20 )
+#define mainEDGES_PER_BURST		( 16 )
+#define mainBURSTS				( 200 )
+
+/* The time between the edges of a burst, in timer 1 counts. */
+#define mainEDGE_GAP_COUNTS		( configCPU_CLOCK_HZ / 4000UL )
+
+#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	#define mainCOMMAND_MODE	"coalesced"
+#else
+	#define mainCOMMAND_MODE	"queued"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Plays the edges, waits for the timers to expire, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Checks the timer expired once, and not early.
+ */
+static void prvDebounceCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ mainINPUTS ];
+
+/* The tick each input's timer was last reset on, and how often it expired. */
+static TickType_t xLastReset[ mainINPUTS ];
+static unsigned long ulExpiries[ mainINPUTS ];
+static volatile unsigned long ulEarly = 0;
+
+static volatile unsigned long ulCommandsReceived = 0;
+
+/* Resets are counted in a histogram of one cycle buckets, and the median is
+reported as it is not skewed by the occasional call that is interrupted. */
+static BenchHistogram_t xHistogram;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchCommandReceived( void )
+{
+	ulCommandsReceived++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDebounceCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxInput = ( UBaseType_t ) pvTimerGetTimerID( xTimer );
+
+	ulExpiries[ uxInput ]++;
+
+	if( ( xTaskGetTickCount() - xLastReset[ uxInput ] ) < mainDEBOUNCE_TICKS )
+	{
+		ulEarly++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+UBaseType_t uxBurst, uxEdge, uxInput;
+unsigned long ulStart, ulCycles, ulEdgeTime, ulResets = 0, ulFailed = 0, ulWrongExpiries = 0;
+BaseType_t xResult;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	for( uxInput = 0; uxInput < mainINPUTS; uxInput++ )
+	{
+		xTimers[ uxInput ] = xTimerCreate( "Debounce", mainDEBOUNCE_TICKS, pdFALSE, ( void * ) uxInput, prvDebounceCallback );
+	}
+
+	for( uxBurst = 0; uxBurst < mainBURSTS; uxBurst++ )
+	{
+		for( uxEdge = 0; uxEdge < mainEDGES_PER_BURST; uxEdge++ )
+		{
+			/* Wait for the next edge without blocking, so the timer task
+			cannot run. */
+			ulEdgeTime = T1TC;
+
+			while( ( T1TC - ulEdgeTime ) < mainEDGE_GAP_COUNTS )
+			{
+				/* Spin. */
+			}
+
+			for( uxInput = 0; uxInput < mainINPUTS; uxInput++ )
+			{
+				xLastReset[ uxInput ] = xTaskGetTickCount();
+
+				ulStart = benchGET_CYCLE_COUNT();
+				xResult = xTimerReset( xTimers[ uxInput ], 0 );
+				ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+
+				vBenchHistogramRecord( &xHistogram, ulCycles );
+				ulResets++;
+
+				if( xResult != pdPASS )
+				{
+					ulFailed++;
+				}
+			}
+		}
+
+		/* Let the timer task process what was queued. */
+		vTaskDelay( 1 );
+	}
+
+	/* The inputs are quiet - each timer expires once. */
+	vTaskDelay( mainDEBOUNCE_TICKS * 2 );
+
+	for( uxInput = 0; uxInput < mainINPUTS; uxInput++ )
+	{
+		if( ulExpiries[ uxInput ] != 1UL )
+		{
+			ulWrongExpiries++;
+		}
+	}
+
+	sprintf( cBuffer, "timer commands: %-9s %lu resets, %lu failed, %lu processed, median %lu cycles\r\n",
+			 mainCOMMAND_MODE,
+			 ulResets,
+			 ulFailed,
+			 ulCommandsReceived,
+			 ulBenchHistogramMedian( &xHistogram ) );
+	vBenchPrint( cBuffer );
+
+	sprintf( cBuffer, "timer commands: %-9s %lu timers expired early, %lu not exactly once\r\n",
+			 mainCOMMAND_MODE,
+			 ulEarly,
+			 ulWrongExpiries );
+	vBenchPrint( cBuffer );
+
+	#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	{
+	TimerCommandQueueStats_t xStats;
+
+		vTimerGetCommandQueueStats( &xStats );
+		sprintf( cBuffer, "timer commands: %-9s %lu sent, %lu coalesced, %lu dropped, depth %lu, most %lu, %lu batches\r\n",
+				 mainCOMMAND_MODE,
+				 ( unsigned long ) xStats.uxCommandsSent,
+				 ( unsigned long ) xStats.uxCommandsCoalesced,
+				 ( unsigned long ) xStats.uxCommandsDropped,
+				 ( unsigned long ) xStats.uxQueueDepth,
+				 ( unsigned long ) xStats.uxQueueHighWaterMark,
+				 ( unsigned long ) xStats.uxBatches );
+		vBenchPrint( cBuffer );
+	}
+	#endif
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
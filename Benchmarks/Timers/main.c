@@ -0,0 +1,308 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Software timer benchmark.
+ *
+ * Measures, in CPU cycles, how long the timer daemon takes to process an
+ * xTimerReset() command as the number of active timers grows from 10 to 1000,
+ * with configUSE_TIMER_WHEEL set to 0 (vListInsert() into the timer list sorted
+ * by expiry time) or 1 (xListWheelInsert() into the timer wheel).
+ *
+ * The daemon runs below the benchmark task, which queues batches of resets of
+ * randomly chosen auto-reload timers and then lets the daemon process them.
+ * Each sample is the time from one command reaching the daemon to the next,
+ * which is the reset plus the cost of receiving a command from the queue, so
+ * only the change as the timers are added depends on how timers are kept.
+ *
+ * One-shot timers of pseudo random periods, some beyond the reach of the
+ * wheel, are then started and checked to expire on the tick they are due.  The
+ * tick count overflows while they run.  The results are printed on UART1, then
+ * the scheduler is stopped (which ends the process when running on the Linux
+ * host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+#define mainBENCH_PRIORITY		( configTIMER_TASK_PRIORITY + 1 )
+
+/* The numbers of active timers the resets are timed with. */
+#define mainTIMER_STEPS			( 3 )
+#define mainMAX_TIMERS			( 1000 )
+
+/* Commands are queued in batches no longer than the timer queue, and each
+batch is processed while the benchmark task waits for one tick. */
+#define mainBATCH_COMMANDS		( 16 )
+#define mainBATCHES				( 200 )
+
+/* The auto-reload timers have periods within the reach of the wheel. */
+#define mainMIN_PERIOD			( 500UL )
+#define mainPERIOD_RANGE		( 500UL )
+
+/* The one-shot timers that are checked, and the range of their periods,
+which reaches beyond the wheel. */
+#define mainCHECK_TIMERS		( 32 )
+#define mainMIN_CHECK_PERIOD	( 10UL )
+#define mainMAX_CHECK_PERIOD	( 3000UL )
+
+#if( configUSE_TIMER_WHEEL == 1 )
+	#define mainTIMER_MODE		"wheel"
+#else
+	#define mainTIMER_MODE		"list"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times the resets, checks the one-shot timers, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Start the timers from uxFirst up to uxLast, a batch at a time.
+ */
+static void prvStartTimers( UBaseType_t uxFirst, UBaseType_t uxLast );
+
+/*
+ * The callbacks of the auto-reload timers, which do nothing, and of the
+ * one-shot timers, which check they expired on time.
+ */
+static void prvReloadCallback( TimerHandle_t xTimer );
+static void prvCheckCallback( TimerHandle_t xTimer );
+
+/*
+ * A small pseudo random number generator, so both builds see the same
+ * commands.
+ */
+static unsigned long prvRandom( void );
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimers[ mainMAX_TIMERS ];
+static TimerHandle_t xCheckTimers[ mainCHECK_TIMERS ];
+
+/* The tick on which each one-shot timer is due. */
+static TickType_t xCheckExpiry[ mainCHECK_TIMERS ];
+
+static volatile unsigned long ulExpired = 0, ulEarly = 0, ulLate = 0;
+
+/* Only commands received while this is set are counted. */
+static volatile BaseType_t xRecording = pdFALSE;
+
+/* The commands of the current batch received so far, and when the last was. */
+static volatile unsigned long ulBatchCommands = 0;
+static unsigned long ulLastCommand = 0;
+
+/* Resets are counted in a histogram of one cycle buckets, and the median is
+reported as it is not skewed by the occasional command that is interrupted. */
+static BenchHistogram_t xHistogram;
+
+static unsigned long ulRandomState = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchCommandReceived( void )
+{
+unsigned long ulNow = benchGET_CYCLE_COUNT();
+
+	if( xRecording != pdFALSE )
+	{
+		/* The first command of a batch has nothing before it to time. */
+		if( ulBatchCommands > 0UL )
+		{
+			vBenchHistogramRecord( &xHistogram, ulNow - ulLastCommand );
+		}
+
+		ulBatchCommands++;
+	}
+
+	ulLastCommand = benchGET_CYCLE_COUNT();
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRandom( void )
+{
+	ulRandomState = ( ulRandomState * 1103515245UL ) + 12345UL;
+	return ( ulRandomState >> 16 ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReloadCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckCallback( TimerHandle_t xTimer )
+{
+TickType_t xLateBy;
+
+	/* The difference is taken so the check holds across the overflow. */
+	xLateBy = xTaskGetTickCount() - xCheckExpiry[ ( UBaseType_t ) pvTimerGetTimerID( xTimer ) ];
+
+	if( xLateBy > ( portMAX_DELAY / 2 ) )
+	{
+		ulEarly++;
+	}
+	else if( xLateBy > 1 )
+	{
+		ulLate++;
+	}
+
+	ulExpired++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTimers( UBaseType_t uxFirst, UBaseType_t uxLast )
+{
+UBaseType_t x;
+
+	for( x = uxFirst; x < uxLast; x++ )
+	{
+		( void ) xTimerStart( xTimers[ x ], 0 );
+
+		if( ( x % mainBATCH_COMMANDS ) == ( mainBATCH_COMMANDS - 1 ) )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+static const UBaseType_t uxTimerSteps[ mainTIMER_STEPS ] = { 10, 100, mainMAX_TIMERS };
+UBaseType_t uxStep, uxCreated = 0, x;
+unsigned long ulBatch;
+TickType_t xPeriod;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	for( uxStep = 0; uxStep < mainTIMER_STEPS; uxStep++ )
+	{
+		for( x = uxCreated; x < uxTimerSteps[ uxStep ]; x++ )
+		{
+			xTimers[ x ] = xTimerCreate( "Reload", ( TickType_t ) ( mainMIN_PERIOD + ( prvRandom() % mainPERIOD_RANGE ) ), pdTRUE, NULL, prvReloadCallback );
+		}
+
+		prvStartTimers( uxCreated, uxTimerSteps[ uxStep ] );
+		uxCreated = uxTimerSteps[ uxStep ];
+
+		for( ulBatch = 0; ulBatch < mainBATCHES; ulBatch++ )
+		{
+			ulBatchCommands = 0;
+			xRecording = pdTRUE;
+
+			for( x = 0; x < mainBATCH_COMMANDS; x++ )
+			{
+				( void ) xTimerReset( xTimers[ prvRandom() % uxCreated ], 0 );
+			}
+
+			/* The daemon processes the batch. */
+			vTaskDelay( 1 );
+			xRecording = pdFALSE;
+		}
+
+		sprintf( cBuffer, "timers: %-5s %4lu timers, reset median %lu cycles\r\n",
+				 mainTIMER_MODE,
+				 ( unsigned long ) uxCreated,
+				 ulBenchHistogramMedian( &xHistogram ) );
+		vBenchPrint( cBuffer );
+	}
+
+	/* Start the one-shot timers. */
+	for( x = 0; x < mainCHECK_TIMERS; x++ )
+	{
+		xPeriod = ( TickType_t ) ( mainMIN_CHECK_PERIOD + ( ( ( prvRandom() << 15 ) | prvRandom() ) % ( mainMAX_CHECK_PERIOD - mainMIN_CHECK_PERIOD ) ) );
+		xCheckTimers[ x ] = xTimerCreate( "Check", xPeriod, pdFALSE, ( void * ) x, prvCheckCallback );
+
+		vTaskSuspendAll();
+		{
+			/* The tick count does not change while the scheduler is suspended,
+			so the timer is due one period after the tick noted here. */
+			xCheckExpiry[ x ] = xTaskGetTickCount() + xPeriod;
+			( void ) xTimerStart( xCheckTimers[ x ], 0 );
+		}
+		( void ) xTaskResumeAll();
+
+		if( ( x % mainBATCH_COMMANDS ) == ( mainBATCH_COMMANDS - 1 ) )
+		{
+			vTaskDelay( 1 );
+		}
+	}
+
+	vTaskDelay( ( TickType_t ) ( mainMAX_CHECK_PERIOD + 10UL ) );
+
+	sprintf( cBuffer, "timers: %-5s %lu of %d one-shot timers expired, %lu early, %lu late\r\n",
+			 mainTIMER_MODE,
+			 ulExpired,
+			 mainCHECK_TIMERS,
+			 ulEarly,
+			 ulLate );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,168 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Trace recorder benchmark.
+ *
+ * Measures, in CPU cycles, how long the trace recorder takes to write one
+ * record: the cost every kernel trace hook adds when the recorder is enabled.
+ * Records are written back to back from a task, with the drain task not
+ * started, so the ring buffer is overwritten as it would be by a burst of
+ * events the drain task could not keep up with.
+ *
+ * A queue send and receive, which writes two records, is measured too, with
+ * configUSE_TRACE_RECORDER set to 1 and to 0, to show the cost in use.  The
+ * results are printed on UART1, then the scheduler is stopped (which ends the
+ * process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of times each operation is measured. */
+#define mainSAMPLES				( 20000UL )
+
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* An application event, as the application would write one. */
+#define mainBENCH_EVENT			( ( uint8_t ) 0x80 )
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	#define mainRECORDER_MODE	"on"
+#else
+	#define mainRECORDER_MODE	"off"
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Writes the records, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* Samples are counted in a histogram of one cycle buckets, and the median is
+reported as it is not skewed by the occasional sample that is interrupted. */
+static BenchHistogram_t xHistogram;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulSample, ulStart, ulOverhead, ulRecord, ulQueue;
+QueueHandle_t xQueue;
+uint32_t ulItem = 0;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	xQueue = xQueueCreate( 1, sizeof( ulItem ) );
+	configASSERT( xQueue );
+
+	/* The cost of the two cycle counter reads made around each sample,
+	measured in the same way as the samples themselves. */
+	for( ulSample = 0; ulSample < mainSAMPLES; ulSample++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xHistogram );
+
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		for( ulSample = 0; ulSample < mainSAMPLES; ulSample++ )
+		{
+			ulStart = benchGET_CYCLE_COUNT();
+			vTraceRecord( mainBENCH_EVENT, ( uint8_t ) ulSample, ( uint16_t ) ulSample );
+			vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+		}
+
+		ulRecord = ulBenchHistogramMedian( &xHistogram );
+		ulRecord = ( ulRecord > ulOverhead ) ? ( ulRecord - ulOverhead ) : 0;
+	}
+	#else
+	{
+		ulRecord = 0;
+	}
+	#endif
+
+	for( ulSample = 0; ulSample < mainSAMPLES; ulSample++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		( void ) xQueueSend( xQueue, &ulItem, 0 );
+		( void ) xQueueReceive( xQueue, &ulItem, 0 );
+		vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulQueue = ulBenchHistogramMedian( &xHistogram );
+	ulQueue = ( ulQueue > ulOverhead ) ? ( ulQueue - ulOverhead ) : 0;
+
+	sprintf( cBuffer, "trace recorder: %-3s median %lu cycles per record, %lu cycles per queue send and receive\r\n",
+			 mainRECORDER_MODE,
+			 ulRecord,
+			 ulQueue );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,378 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Zero-copy queue benchmark.
+ *
+ * Measures, in CPU cycles, how long it takes to pass one message of 4, 64,
+ * 256, 1024 and 4096 bytes from a sender to a receiver:
+ *
+ *  - copied: the sender writes the message into a buffer of its own and sends
+ *    it with xQueueSend(), which copies it into the queue, and xQueueReceive()
+ *    copies it out into a buffer of the receiver's;
+ *
+ *  - by reference: the sender takes a block from a block pool, writes the
+ *    message into it in place and sends the pointer with
+ *    xQueueSendByReference(), and the receiver reads the message where it is
+ *    and releases the block.
+ *
+ * Both write every byte of the message and read it back once.  The cost of
+ * taking and releasing a block on its own is also reported, as it is the price
+ * paid for not copying.  The copied path moves twice the message size through
+ * the queue storage, the by reference path twice the size of a pointer.
+ *
+ * On the Linux host every critical section is a pair of pthread_sigmask()
+ * system calls, so the by reference path, which enters four critical sections
+ * per message rather than two, takes longer there at every size; the copy
+ * only adds a cycle or so per byte.  On the LPC21xx a critical section is a
+ * handful of instructions and the copy dominates.
+ *
+ * The host build also reports how long interrupts were masked per message, not
+ * counting the system calls that mask and unmask them.  The copies into and
+ * out of the queue storage are made with interrupts masked, so for the copied
+ * path this grows with the message size, while the by reference path only
+ * ever masks them to move a pointer or a block.  That is how long an interrupt
+ * can be held off, and unlike the time taken it does not depend on how
+ * expensive masking is.  The results are printed on UART1, then the scheduler
+ * is stopped (which ends the process when running on the Linux host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "block_pool.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of messages passed at each size. */
+#define mainMESSAGES			( 20000UL )
+
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+#define mainQUEUE_LENGTH		( 4 )
+#define mainMAX_MESSAGE_SIZE	( 4096 )
+
+#define mainHISTOGRAM_CYCLES	( 2UL )
+
+/*-----------------------------------------------------------*/
+
+/* The median time taken, and the median time interrupts were masked and the
+critical sections entered, per message. */
+typedef struct BENCH_RESULT
+{
+	unsigned long ulCycles;
+	unsigned long ulMaskedCycles;
+	unsigned long ulSections;
+} BenchResult_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Passes the messages, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Pass one message of xSize bytes each way.
+ */
+static void prvPassCopied( QueueHandle_t xQueue, size_t xSize, unsigned char ucFill );
+static void prvPassByReference( QueueHandle_t xQueue, BlockPoolHandle_t xPool, size_t xSize, unsigned char ucFill );
+
+/*
+ * Pass mainMESSAGES messages of xSize bytes one way or the other, and fill in
+ * pxResult.
+ */
+static void prvMeasure( BaseType_t xByReference, QueueHandle_t xQueue, BlockPoolHandle_t xPool, size_t xSize, BenchResult_t *pxResult );
+
+/*-----------------------------------------------------------*/
+
+static const size_t xMessageSizes[] = { 4, 64, 256, 1024, 4096 };
+
+/* Samples are counted in histograms of mainHISTOGRAM_CYCLES cycle buckets, and
+the median is reported as it is not skewed by the occasional sample that is
+interrupted. */
+static BenchHistogram_t xTaken, xMasked;
+
+/* The cost of the two cycle counter reads made around each sample. */
+static unsigned long ulOverhead = 0;
+
+/* The receiver adds up the bytes it reads, so the reads are not optimised
+away. */
+static volatile unsigned long ulChecksum = 0;
+
+/*-----------------------------------------------------------*/
+
+#if( benchTIME_CRITICAL_SECTIONS == 1 )
+
+	/* The functions the wrappers wrap, renamed by the linker. */
+	extern void __real_vPortEnterCritical( void );
+	extern void __real_vPortExitCritical( void );
+
+	void __wrap_vPortEnterCritical( void );
+	void __wrap_vPortExitCritical( void );
+
+	/* The nesting, when interrupts were masked, and the cycles they have been
+	masked for and the critical sections entered so far. */
+	static unsigned long ulMaskNesting = 0, ulMaskedAt = 0;
+	static unsigned long ulMaskedCycles = 0, ulMaskedSections = 0;
+
+	void __wrap_vPortEnterCritical( void )
+	{
+		__real_vPortEnterCritical();
+
+		if( ulMaskNesting == 0UL )
+		{
+			ulMaskedAt = benchGET_CYCLE_COUNT();
+		}
+
+		ulMaskNesting++;
+	}
+	/*-----------------------------------------------------------*/
+
+	void __wrap_vPortExitCritical( void )
+	{
+		if( ulMaskNesting > 0UL )
+		{
+			ulMaskNesting--;
+
+			if( ulMaskNesting == 0UL )
+			{
+				ulMaskedCycles += benchGET_CYCLE_COUNT() - ulMaskedAt;
+				ulMaskedSections++;
+			}
+		}
+
+		__real_vPortExitCritical();
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* benchTIME_CRITICAL_SECTIONS */
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xTaken, mainHISTOGRAM_CYCLES );
+	vBenchHistogramInit( &xMasked, mainHISTOGRAM_CYCLES );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 8, NULL, mainBENCH_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasure( BaseType_t xByReference, QueueHandle_t xQueue, BlockPoolHandle_t xPool, size_t xSize, BenchResult_t *pxResult )
+{
+unsigned long ulMessage, ulStart, ulCycles;
+#if( benchTIME_CRITICAL_SECTIONS == 1 )
+	unsigned long ulMaskedBefore, ulSectionsBefore = ulMaskedSections;
+#endif
+
+	for( ulMessage = 0; ulMessage < mainMESSAGES; ulMessage++ )
+	{
+		#if( benchTIME_CRITICAL_SECTIONS == 1 )
+		{
+			ulMaskedBefore = ulMaskedCycles;
+		}
+		#endif
+
+		ulStart = benchGET_CYCLE_COUNT();
+
+		if( xByReference != pdFALSE )
+		{
+			prvPassByReference( xQueue, xPool, xSize, ( unsigned char ) ulMessage );
+		}
+		else
+		{
+			prvPassCopied( xQueue, xSize, ( unsigned char ) ulMessage );
+		}
+
+		ulCycles = benchGET_CYCLE_COUNT() - ulStart;
+		vBenchHistogramRecord( &xTaken, ulCycles );
+
+		#if( benchTIME_CRITICAL_SECTIONS == 1 )
+		{
+			vBenchHistogramRecord( &xMasked, ulMaskedCycles - ulMaskedBefore );
+		}
+		#endif
+	}
+
+	ulCycles = ulBenchHistogramMedian( &xTaken );
+	pxResult->ulCycles = ( ulCycles > ulOverhead ) ? ( ulCycles - ulOverhead ) : 0;
+
+	#if( benchTIME_CRITICAL_SECTIONS == 1 )
+	{
+		pxResult->ulMaskedCycles = ulBenchHistogramMedian( &xMasked );
+		pxResult->ulSections = ( ulMaskedSections - ulSectionsBefore ) / mainMESSAGES;
+	}
+	#else
+	{
+		pxResult->ulMaskedCycles = 0;
+		pxResult->ulSections = 0;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvPassCopied( QueueHandle_t xQueue, size_t xSize, unsigned char ucFill )
+{
+/* Static as the largest messages do not fit on the task's stack. */
+static unsigned char ucSent[ mainMAX_MESSAGE_SIZE ], ucReceived[ mainMAX_MESSAGE_SIZE ];
+size_t xByte;
+unsigned long ulSum = 0;
+
+	memset( ucSent, ucFill, xSize );
+	( void ) xQueueSend( xQueue, ucSent, 0 );
+
+	( void ) xQueueReceive( xQueue, ucReceived, 0 );
+
+	for( xByte = 0; xByte < xSize; xByte++ )
+	{
+		ulSum += ucReceived[ xByte ];
+	}
+
+	ulChecksum += ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPassByReference( QueueHandle_t xQueue, BlockPoolHandle_t xPool, size_t xSize, unsigned char ucFill )
+{
+unsigned char *pucBlock;
+size_t xByte;
+unsigned long ulSum = 0;
+
+	pucBlock = pvBlockPoolTake( xPool );
+	configASSERT( pucBlock );
+	memset( pucBlock, ucFill, xSize );
+	( void ) xQueueSendByReference( xQueue, pucBlock, 0 );
+
+	pucBlock = NULL;
+	( void ) xQueueReceiveByReference( xQueue, ( void ** ) &pucBlock, 0 );
+
+	for( xByte = 0; xByte < xSize; xByte++ )
+	{
+		ulSum += pucBlock[ xByte ];
+	}
+
+	vBlockPoolRelease( xPool, pucBlock );
+
+	ulChecksum += ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulMessage, ulStart, ulPool;
+BenchResult_t xCopied, xByReference;
+void *pvBlock;
+size_t xSize, xIndex;
+QueueHandle_t xCopyQueue, xReferenceQueue;
+BlockPoolHandle_t xPool;
+char cBuffer[ 140 ];
+
+	( void ) pvParameters;
+
+	/* The cost of the two cycle counter reads made around each sample,
+	measured in the same way as the samples themselves. */
+	for( ulMessage = 0; ulMessage < mainMESSAGES; ulMessage++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		vBenchHistogramRecord( &xTaken, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xTaken );
+
+	for( xIndex = 0; xIndex < ( sizeof( xMessageSizes ) / sizeof( xMessageSizes[ 0 ] ) ); xIndex++ )
+	{
+		xSize = xMessageSizes[ xIndex ];
+
+		xCopyQueue = xQueueCreate( mainQUEUE_LENGTH, xSize );
+		xReferenceQueue = xQueueCreateByReference( mainQUEUE_LENGTH );
+		xPool = xBlockPoolCreate( xSize, mainQUEUE_LENGTH + 1 );
+		configASSERT( xCopyQueue && xReferenceQueue && xPool );
+
+		prvMeasure( pdFALSE, xCopyQueue, NULL, xSize, &xCopied );
+		prvMeasure( pdTRUE, xReferenceQueue, xPool, xSize, &xByReference );
+
+		for( ulMessage = 0; ulMessage < mainMESSAGES; ulMessage++ )
+		{
+			ulStart = benchGET_CYCLE_COUNT();
+			pvBlock = pvBlockPoolTake( xPool );
+			vBlockPoolRelease( xPool, pvBlock );
+			vBenchHistogramRecord( &xTaken, benchGET_CYCLE_COUNT() - ulStart );
+		}
+
+		ulPool = ulBenchHistogramMedian( &xTaken );
+		ulPool = ( ulPool > ulOverhead ) ? ( ulPool - ulOverhead ) : 0;
+
+		sprintf( cBuffer, "zero copy queue: %4lu byte messages, copied %lu cycles, by reference %lu cycles (pool take and release %lu)\r\n",
+				 ( unsigned long ) xSize,
+				 xCopied.ulCycles,
+				 xByReference.ulCycles,
+				 ulPool );
+		vBenchPrint( cBuffer );
+
+		#if( benchTIME_CRITICAL_SECTIONS == 1 )
+		{
+			sprintf( cBuffer, "zero copy queue: %4lu byte messages, masked copied %lu cycles in %lu sections, by reference %lu cycles in %lu sections\r\n",
+					 ( unsigned long ) xSize,
+					 xCopied.ulMaskedCycles,
+					 xCopied.ulSections,
+					 xByReference.ulMaskedCycles,
+					 xByReference.ulSections );
+			vBenchPrint( cBuffer );
+		}
+		#endif
+
+		vQueueDelete( xCopyQueue );
+		vQueueDelete( xReferenceQueue );
+		vBlockPoolDelete( xPool );
+	}
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,392 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Zero copy stream and message buffer benchmark.
+ *
+ * Measures, in CPU cycles, how long it takes to pass 16, 64 and 256 bytes
+ * through a stream buffer and through a message buffer:
+ *
+ *  - copied: the sender writes the data into a buffer of its own and sends it
+ *    with xStreamBufferSend(), which copies it into the buffer's storage, and
+ *    xStreamBufferReceive() copies it out into a buffer of the receiver's;
+ *
+ *  - zero copy: the sender writes the data in place in the storage reserved
+ *    with xStreamBufferReserve() and commits it, and the receiver reads it
+ *    where it is through xStreamBufferPeekContiguous() and consumes it.
+ *
+ * Both write every byte and read it back once, and the storage is not a
+ * multiple of the sizes, so the data wraps - in the stream buffer that takes a
+ * second reservation and peek, in the message buffer the message is moved to
+ * the start of the storage.  The sums of the bytes read are compared, so a
+ * byte lost or misplaced shows as a mismatch.
+ *
+ * A second task then receives messages of every length from 1 to
+ * mainMAX_MESSAGE_SIZE bytes through the zero copy API while it is blocked,
+ * checking each, to show a reader blocked in xStreamBufferPeekContiguous() is
+ * woken by xStreamBufferCommit(), and a stream buffer reader is woken only
+ * once its trigger level is reached.  The results are printed on UART1, then
+ * the scheduler is stopped (which ends the process when running on the Linux
+ * host).
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* The number of times the data is passed at each size. */
+#define mainPASSES				( 20000UL )
+
+#define mainBENCH_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainREADER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+/* Not a multiple of any of the sizes, so the data wraps at a different place
+each time round. */
+#define mainBUFFER_SIZE			( 1000 )
+#define mainMAX_MESSAGE_SIZE	( 256 )
+
+/* The trigger level of the stream buffer the blocked reader waits on. */
+#define mainTRIGGER_LEVEL		( 32 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Passes the data, then prints the results.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Receives through the zero copy API while blocked, checking what it receives.
+ */
+static void prvReaderTask( void *pvParameters );
+
+/*
+ * Pass xSize bytes each way, returning the sum of the bytes read.
+ */
+static unsigned long prvPassCopied( StreamBufferHandle_t xBuffer, size_t xSize, unsigned char ucFill );
+static unsigned long prvPassZeroCopy( StreamBufferHandle_t xBuffer, size_t xSize, unsigned char ucFill );
+
+/*-----------------------------------------------------------*/
+
+static const size_t xSizes[] = { 16, 64, 256 };
+
+/* Samples are counted in a histogram of one cycle buckets, and the median is
+reported as it is not skewed by the occasional sample that is interrupted. */
+static BenchHistogram_t xHistogram;
+
+/* Written to by the reader task, read by the benchmark task once the reader
+has finished. */
+static StreamBufferHandle_t xReaderStream = NULL;
+static MessageBufferHandle_t xReaderMessages = NULL;
+static TaskHandle_t xBenchmarkTask = NULL;
+static volatile unsigned long ulReaderErrors = 0, ulEarlyWakes = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vBenchSetupHardware( benchTIMER1_CYCLES );
+	vBenchHistogramInit( &xHistogram, 1UL );
+
+	xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 8, NULL, mainBENCH_PRIORITY, &xBenchmarkTask );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvPassCopied( StreamBufferHandle_t xBuffer, size_t xSize, unsigned char ucFill )
+{
+unsigned char ucSent[ mainMAX_MESSAGE_SIZE ], ucReceived[ mainMAX_MESSAGE_SIZE ];
+size_t xByte, xReceived;
+unsigned long ulSum = 0;
+
+	for( xByte = 0; xByte < xSize; xByte++ )
+	{
+		ucSent[ xByte ] = ( unsigned char ) ( ucFill + xByte );
+	}
+
+	( void ) xStreamBufferSend( xBuffer, ucSent, xSize, 0 );
+	xReceived = xStreamBufferReceive( xBuffer, ucReceived, sizeof( ucReceived ), 0 );
+
+	for( xByte = 0; xByte < xReceived; xByte++ )
+	{
+		ulSum += ucReceived[ xByte ];
+	}
+
+	return ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvPassZeroCopy( StreamBufferHandle_t xBuffer, size_t xSize, unsigned char ucFill )
+{
+unsigned char *pucData;
+const unsigned char *pucRead;
+size_t xByte, xDone, xReserved, xPeeked;
+unsigned long ulSum = 0;
+
+	/* A stream buffer may take two reservations where the data wraps. */
+	for( xDone = 0; xDone < xSize; xDone += xReserved )
+	{
+		xReserved = xStreamBufferReserve( xBuffer, ( void ** ) &pucData, xSize - xDone, 0 );
+		configASSERT( xReserved );
+
+		for( xByte = 0; xByte < xReserved; xByte++ )
+		{
+			pucData[ xByte ] = ( unsigned char ) ( ucFill + xDone + xByte );
+		}
+
+		( void ) xStreamBufferCommit( xBuffer, xReserved );
+	}
+
+	while( ( xPeeked = xStreamBufferPeekContiguous( xBuffer, ( const void ** ) &pucRead, 0 ) ) != 0 )
+	{
+		for( xByte = 0; xByte < xPeeked; xByte++ )
+		{
+			ulSum += pucRead[ xByte ];
+		}
+
+		( void ) xStreamBufferConsume( xBuffer, xPeeked );
+	}
+
+	return ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+const unsigned char *pucRead;
+size_t xLength, xExpected, xByte, xTotal = 0;
+unsigned char ucNext = 0;
+
+	( void ) pvParameters;
+
+	/* One message of each length, each byte its index. */
+	for( xExpected = 1; xExpected <= mainMAX_MESSAGE_SIZE; xExpected++ )
+	{
+		xLength = xMessageBufferPeekContiguous( xReaderMessages, ( const void ** ) &pucRead, portMAX_DELAY );
+
+		if( xLength != xExpected )
+		{
+			ulReaderErrors++;
+		}
+
+		for( xByte = 0; xByte < xLength; xByte++ )
+		{
+			if( pucRead[ xByte ] != ( unsigned char ) xByte )
+			{
+				ulReaderErrors++;
+			}
+		}
+
+		( void ) xMessageBufferConsume( xReaderMessages, xLength );
+	}
+
+	/* The same bytes as a stream.  Each wake must find the trigger level, or
+	all that is left. */
+	xExpected = ( mainMAX_MESSAGE_SIZE * ( mainMAX_MESSAGE_SIZE + 1 ) ) / 2;
+
+	while( xTotal < xExpected )
+	{
+		xLength = xStreamBufferPeekContiguous( xReaderStream, ( const void ** ) &pucRead, portMAX_DELAY );
+
+		if( ( xStreamBufferBytesAvailable( xReaderStream ) < mainTRIGGER_LEVEL ) && ( ( xTotal + xStreamBufferBytesAvailable( xReaderStream ) ) < xExpected ) )
+		{
+			ulEarlyWakes++;
+		}
+
+		for( xByte = 0; xByte < xLength; xByte++ )
+		{
+			if( pucRead[ xByte ] != ucNext++ )
+			{
+				ulReaderErrors++;
+			}
+		}
+
+		( void ) xStreamBufferConsume( xReaderStream, xLength );
+		xTotal += xLength;
+
+		/* Consume the rest of what woke it before blocking again. */
+		while( ( xLength = xStreamBufferPeekContiguous( xReaderStream, ( const void ** ) &pucRead, 0 ) ) != 0 )
+		{
+			for( xByte = 0; xByte < xLength; xByte++ )
+			{
+				if( pucRead[ xByte ] != ucNext++ )
+				{
+					ulReaderErrors++;
+				}
+			}
+
+			( void ) xStreamBufferConsume( xReaderStream, xLength );
+			xTotal += xLength;
+		}
+	}
+
+	xTaskNotifyGive( xBenchmarkTask );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+unsigned long ulPass, ulStart, ulOverhead, ulCopied, ulZeroCopy, ulCopiedSum, ulZeroCopySum;
+unsigned char *pucData;
+size_t xSize, xIndex, xByte, xReserved, xDone;
+StreamBufferHandle_t xBuffer;
+BaseType_t xIsMessageBuffer;
+char cBuffer[ 120 ];
+
+	( void ) pvParameters;
+
+	/* The cost of the two cycle counter reads made around each sample,
+	measured in the same way as the samples themselves. */
+	for( ulPass = 0; ulPass < mainPASSES; ulPass++ )
+	{
+		ulStart = benchGET_CYCLE_COUNT();
+		vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+	}
+
+	ulOverhead = ulBenchHistogramMedian( &xHistogram );
+
+	for( xIsMessageBuffer = pdFALSE; xIsMessageBuffer <= pdTRUE; xIsMessageBuffer++ )
+	{
+		for( xIndex = 0; xIndex < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); xIndex++ )
+		{
+			xSize = xSizes[ xIndex ];
+
+			if( xIsMessageBuffer != pdFALSE )
+			{
+				xBuffer = xMessageBufferCreate( mainBUFFER_SIZE );
+			}
+			else
+			{
+				xBuffer = xStreamBufferCreate( mainBUFFER_SIZE, 1 );
+			}
+
+			configASSERT( xBuffer );
+			ulCopiedSum = 0;
+			ulZeroCopySum = 0;
+
+			for( ulPass = 0; ulPass < mainPASSES; ulPass++ )
+			{
+				ulStart = benchGET_CYCLE_COUNT();
+				ulCopiedSum += prvPassCopied( xBuffer, xSize, ( unsigned char ) ulPass );
+				vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+			}
+
+			ulCopied = ulBenchHistogramMedian( &xHistogram );
+			ulCopied = ( ulCopied > ulOverhead ) ? ( ulCopied - ulOverhead ) : 0;
+
+			for( ulPass = 0; ulPass < mainPASSES; ulPass++ )
+			{
+				ulStart = benchGET_CYCLE_COUNT();
+				ulZeroCopySum += prvPassZeroCopy( xBuffer, xSize, ( unsigned char ) ulPass );
+				vBenchHistogramRecord( &xHistogram, benchGET_CYCLE_COUNT() - ulStart );
+			}
+
+			ulZeroCopy = ulBenchHistogramMedian( &xHistogram );
+			ulZeroCopy = ( ulZeroCopy > ulOverhead ) ? ( ulZeroCopy - ulOverhead ) : 0;
+
+			sprintf( cBuffer, "%s buffer: %3lu bytes, copied %lu cycles, zero copy %lu cycles, sums %s\r\n",
+					 ( xIsMessageBuffer != pdFALSE ) ? "message" : "stream",
+					 ( unsigned long ) xSize,
+					 ulCopied,
+					 ulZeroCopy,
+					 ( ulCopiedSum == ulZeroCopySum ) ? "match" : "DIFFER" );
+			vBenchPrint( cBuffer );
+
+			vStreamBufferDelete( xBuffer );
+		}
+	}
+
+	/* Feed the blocked reader, which runs at a higher priority, so each
+	commit that reaches its trigger level runs it at once. */
+	xReaderMessages = xMessageBufferCreate( mainBUFFER_SIZE );
+	xReaderStream = xStreamBufferCreate( mainBUFFER_SIZE, mainTRIGGER_LEVEL );
+	configASSERT( xReaderMessages && xReaderStream );
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE * 4, NULL, mainREADER_PRIORITY, NULL );
+
+	for( xSize = 1; xSize <= mainMAX_MESSAGE_SIZE; xSize++ )
+	{
+		xReserved = xMessageBufferReserve( xReaderMessages, ( void ** ) &pucData, xSize, portMAX_DELAY );
+		configASSERT( xReserved == xSize );
+
+		for( xByte = 0; xByte < xSize; xByte++ )
+		{
+			pucData[ xByte ] = ( unsigned char ) xByte;
+		}
+
+		( void ) xMessageBufferCommit( xReaderMessages, xSize );
+	}
+
+	ulPass = 0;
+
+	for( xSize = 1; xSize <= mainMAX_MESSAGE_SIZE; xSize++ )
+	{
+		for( xDone = 0; xDone < xSize; xDone += xReserved )
+		{
+			xReserved = xStreamBufferReserve( xReaderStream, ( void ** ) &pucData, xSize - xDone, portMAX_DELAY );
+
+			for( xByte = 0; xByte < xReserved; xByte++ )
+			{
+				pucData[ xByte ] = ( unsigned char ) ulPass++;
+			}
+
+			( void ) xStreamBufferCommit( xReaderStream, xReserved );
+		}
+	}
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	sprintf( cBuffer, "blocked reader: %lu errors, %lu wakes below the trigger level\r\n", ulReaderErrors, ulEarlyWakes );
+	vBenchPrint( cBuffer );
+
+	/* Let the last characters leave the UART. */
+	( void ) xSerialFlush( portMAX_DELAY );
+	vTaskEndScheduler();
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
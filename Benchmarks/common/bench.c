@@ -0,0 +1,163 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	BENCHMARK SCAFFOLDING - see bench.h.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lpc21xx.h"
+
+/* Peripheral includes. */
+#include "serial.h"
+
+#include "bench.h"
+
+/*-----------------------------------------------------------*/
+
+/* Constants to setup I/O and processor. */
+#define benchBUS_CLK_FULL			( ( unsigned char ) 0x01 )
+
+/*-----------------------------------------------------------*/
+
+void vBenchSetupHardware( unsigned long ulTimer1Divisor )
+{
+	/* Configure UART */
+	( void ) xSerialPortInitMinimal( benchCOM_BAUD_RATE );
+
+	/* Setup the peripheral bus to be the same as the PLL output. */
+	VPBDIV = benchBUS_CLK_FULL;
+
+	if( ulTimer1Divisor != benchTIMER1_STOPPED )
+	{
+		/* Timer 1 free runs at the peripheral clock over the divisor. */
+		T1PR = ulTimer1Divisor - 1UL;
+		T1TCR = 0x2;
+		T1TCR = 0x1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchPrint( const char *pcString )
+{
+unsigned short usLength = 0;
+
+	while( pcString[ usLength ] != '\0' )
+	{
+		usLength++;
+	}
+
+	while( vSerialPutString( ( const signed char * ) pcString, usLength ) == pdFALSE )
+	{
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchHistogramInit( BenchHistogram_t *pxHistogram, unsigned long ulWidth )
+{
+	memset( pxHistogram, 0x00, sizeof( *pxHistogram ) );
+	pxHistogram->ulWidth = ulWidth;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchHistogramClear( BenchHistogram_t *pxHistogram )
+{
+	vBenchHistogramInit( pxHistogram, pxHistogram->ulWidth );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchHistogramRecord( BenchHistogram_t *pxHistogram, unsigned long ulSample )
+{
+unsigned long ulBucket;
+
+	pxHistogram->ulSamples++;
+	pxHistogram->ulTotal += ulSample;
+
+	if( ulSample > pxHistogram->ulLongest )
+	{
+		pxHistogram->ulLongest = ulSample;
+	}
+
+	ulBucket = ulSample / pxHistogram->ulWidth;
+
+	if( ulBucket >= benchHISTOGRAM_BUCKETS )
+	{
+		ulBucket = benchHISTOGRAM_BUCKETS - 1UL;
+	}
+
+	pxHistogram->ulBuckets[ ulBucket ]++;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulBenchHistogramPercentile( const BenchHistogram_t *pxHistogram, unsigned long ulPerMille )
+{
+unsigned long ulBucket, ulSeen = 0;
+
+	for( ulBucket = 0; ulBucket < ( benchHISTOGRAM_BUCKETS - 1UL ); ulBucket++ )
+	{
+		ulSeen += pxHistogram->ulBuckets[ ulBucket ];
+
+		if( ( ulSeen * 1000UL ) >= ( pxHistogram->ulSamples * ulPerMille ) )
+		{
+			break;
+		}
+	}
+
+	/* The top of the bucket. */
+	return ( ( ulBucket + 1UL ) * pxHistogram->ulWidth ) - 1UL;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulBenchHistogramMedian( BenchHistogram_t *pxHistogram )
+{
+unsigned long ulMedian;
+
+	ulMedian = ulBenchHistogramPercentile( pxHistogram, 500UL );
+	vBenchHistogramClear( pxHistogram );
+
+	return ulMedian;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulBenchHistogramCountFrom( const BenchHistogram_t *pxHistogram, unsigned long ulSample )
+{
+unsigned long ulBucket, ulCount = 0;
+
+	for( ulBucket = ulSample / pxHistogram->ulWidth; ulBucket < benchHISTOGRAM_BUCKETS; ulBucket++ )
+	{
+		ulCount += pxHistogram->ulBuckets[ ulBucket ];
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,149 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	BENCHMARK SCAFFOLDING.
+
+	What every benchmark in Benchmarks needs besides the code it measures:
+
+	 - vBenchSetupHardware() sets the peripheral bus to the CPU clock, opens
+	   UART1 for the results and starts Timer1 free running.
+
+	 - vBenchPrint() writes a string on UART1, waiting for the driver to take
+	   it.  A benchmark prints its results, calls xSerialFlush() to let them
+	   leave the UART, then stops the scheduler, which ends the process when
+	   running on the Linux host.
+
+	 - benchGET_CYCLE_COUNT() reads a counter of CPU cycles.  On the target
+	   that is Timer1, started by vBenchSetupHardware( benchTIMER1_CYCLES ).
+	   A host does most of what is timed in less than one count of the
+	   simulated timer, so the host build reads the processor's time stamp
+	   counter instead.  A benchmark that counts with another timer on the
+	   target defines benchGET_CYCLE_COUNT() for the target in its
+	   FreeRTOSConfig.h.
+
+	 - A BenchHistogram_t counts samples in buckets, the last one also holding
+	   everything longer, and gives their percentiles.  The median is reported
+	   rather than the mean as it is not skewed by the occasional sample the
+	   host interrupted.
+
+	This header only needs lpc21xx.h, so a FreeRTOSConfig.h that times
+	something from a trace macro can include it.  bench.c is built once for
+	all the benchmarks - see CMakeLists.txt.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <lpc21xx.h>
+
+/*-----------------------------------------------------------*/
+
+/* The rate UART1 is opened at. */
+#define benchCOM_BAUD_RATE			( ( unsigned long ) 115200 )
+
+/* What vBenchSetupHardware() divides the peripheral clock by for Timer1:
+nothing, as it is left stopped, nothing, as it counts every CPU cycle, or down
+to microseconds, as in the applications. */
+#define benchTIMER1_STOPPED			( 0UL )
+#define benchTIMER1_CYCLES			( 1UL )
+#define benchTIMER1_MICROSECONDS	( configCPU_CLOCK_HZ / 1000000UL )
+
+#ifndef benchGET_CYCLE_COUNT
+	#if defined( __x86_64__ ) || defined( __i386__ )
+		#include <x86intrin.h>
+		#define benchGET_CYCLE_COUNT()	( ( unsigned long ) __rdtsc() )
+	#else
+		#define benchGET_CYCLE_COUNT()	T1TC
+	#endif
+#endif
+
+/* The number of buckets in a histogram. */
+#define benchHISTOGRAM_BUCKETS		( 16384UL )
+
+/*-----------------------------------------------------------*/
+
+typedef struct BENCH_HISTOGRAM
+{
+	unsigned long ulBuckets[ benchHISTOGRAM_BUCKETS ];
+	unsigned long ulWidth;		/*<< The samples each bucket spans. */
+	unsigned long ulSamples;
+	unsigned long ulTotal;		/*<< The sum of the samples. */
+	unsigned long ulLongest;
+} BenchHistogram_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set the VPB to the CPU clock, open UART1 at benchCOM_BAUD_RATE and, unless
+ * ulTimer1Divisor is benchTIMER1_STOPPED, reset Timer1 and start it counting
+ * once every ulTimer1Divisor peripheral clocks.
+ */
+void vBenchSetupHardware( unsigned long ulTimer1Divisor );
+
+/*
+ * Print a string on UART1, waiting for the driver to accept it.
+ */
+void vBenchPrint( const char *pcString );
+
+/*
+ * Empty a histogram and set the samples each of its buckets spans, which must
+ * not be 0.
+ */
+void vBenchHistogramInit( BenchHistogram_t *pxHistogram, unsigned long ulWidth );
+
+/*
+ * Empty a histogram for the next set of samples, keeping its bucket width.
+ */
+void vBenchHistogramClear( BenchHistogram_t *pxHistogram );
+
+/*
+ * Add a sample.
+ */
+void vBenchHistogramRecord( BenchHistogram_t *pxHistogram, unsigned long ulSample );
+
+/*
+ * The sample the given share, in thousandths, of the samples are at or below,
+ * rounded up to the top of its bucket.  For a percentile in the last bucket
+ * that is ( benchHISTOGRAM_BUCKETS * ulWidth ) - 1, though the samples may be
+ * longer.
+ */
+unsigned long ulBenchHistogramPercentile( const BenchHistogram_t *pxHistogram, unsigned long ulPerMille );
+
+/*
+ * The median, as ulBenchHistogramPercentile( pxHistogram, 500 ), after which
+ * the histogram is cleared for the next set of samples.
+ */
+unsigned long ulBenchHistogramMedian( BenchHistogram_t *pxHistogram );
+
+/*
+ * The number of samples of at least ulSample, which should be a multiple of
+ * the bucket width.
+ */
+unsigned long ulBenchHistogramCountFrom( const BenchHistogram_t *pxHistogram, unsigned long ulSample );
+
+#endif /* BENCH_H */
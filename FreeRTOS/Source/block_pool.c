@@ -0,0 +1,306 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "block_pool.h"
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to build block_pool.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* Round a size up to a multiple of portBYTE_ALIGNMENT. */
+#define bpALIGN_UP( xSize )		( ( ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Check that a block belongs to a pool. */
+#define bpASSERT_BLOCK_IN_POOL( pxBlockPool, pvBlock )																	\
+	configASSERT( ( ( uint8_t * ) ( pvBlock ) >= ( pxBlockPool )->pucBlocks ) &&												\
+				  ( ( uint8_t * ) ( pvBlock ) < &( ( pxBlockPool )->pucBlocks[ ( pxBlockPool )->xBlockStride * ( size_t ) ( pxBlockPool )->uxBlockCount ] ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* A free block holds the link to the next free block. */
+typedef struct BlockPoolFreeBlock
+{
+	struct BlockPoolFreeBlock *pxNextFreeBlock;
+} BlockPoolFreeBlock_t;
+
+/* Structure that holds the state of a block pool.  The blocks follow it in the
+same allocation. */
+typedef struct BlockPoolDef_t /*lint !e9058 Style convention uses tag. */
+{
+	BlockPoolFreeBlock_t *pxFreeBlocks;	/* The most recently released free block, or NULL if there are none. */
+	uint8_t *pucBlocks;					/* The first block. */
+	size_t xBlockSize;					/* The size requested for each block. */
+	size_t xBlockStride;				/* The distance between blocks - the block size rounded up to keep each block aligned. */
+	UBaseType_t uxBlockCount;
+	UBaseType_t uxFreeCount;
+	UBaseType_t uxMinimumFreeCount;
+} BlockPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Unlink the most recently released free block, or return NULL if there are
+ * none.  Called with interrupts masked.
+ */
+static void *prvTakeBlock( BlockPool_t * const pxBlockPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Link a block onto the free blocks.  Called with interrupts masked.
+ */
+static void prvReleaseBlock( BlockPool_t * const pxBlockPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount )
+{
+BlockPool_t *pxBlockPool;
+const size_t xHeaderSize = bpALIGN_UP( sizeof( BlockPool_t ) );
+size_t xBlockStride;
+UBaseType_t uxBlock;
+
+	configASSERT( xBlockSize > ( size_t ) 0 );
+	configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+	/* A free block has to be big enough to hold the link to the next. */
+	if( xBlockSize < sizeof( BlockPoolFreeBlock_t ) )
+	{
+		xBlockStride = bpALIGN_UP( sizeof( BlockPoolFreeBlock_t ) );
+	}
+	else
+	{
+		xBlockStride = bpALIGN_UP( xBlockSize );
+	}
+
+	/* Check for multiplication overflow. */
+	configASSERT( ( ( SIZE_MAX - xHeaderSize ) / xBlockStride ) >= ( size_t ) uxBlockCount );
+
+	pxBlockPool = ( BlockPool_t * ) pvPortMalloc( xHeaderSize + ( xBlockStride * ( size_t ) uxBlockCount ) ); /*lint !e9079 !e9087 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+
+	if( pxBlockPool != NULL )
+	{
+		pxBlockPool->pxFreeBlocks = NULL;
+		pxBlockPool->pucBlocks = ( ( uint8_t * ) pxBlockPool ) + xHeaderSize; /*lint !e9016 Pointer arithmetic allowed on char types. */
+		pxBlockPool->xBlockSize = xBlockSize;
+		pxBlockPool->xBlockStride = xBlockStride;
+		pxBlockPool->uxBlockCount = uxBlockCount;
+		pxBlockPool->uxFreeCount = ( UBaseType_t ) 0;
+
+		/* Every block starts free.  They are linked last first, so the first
+		block is the first to be taken. */
+		for( uxBlock = uxBlockCount; uxBlock > ( UBaseType_t ) 0; uxBlock-- )
+		{
+			prvReleaseBlock( pxBlockPool, &( pxBlockPool->pucBlocks[ xBlockStride * ( size_t ) ( uxBlock - ( UBaseType_t ) 1 ) ] ) );
+		}
+
+		pxBlockPool->uxMinimumFreeCount = uxBlockCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlockPool;
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolDelete( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = xBlockPool;
+
+	configASSERT( pxBlockPool );
+	configASSERT( pxBlockPool->uxFreeCount == pxBlockPool->uxBlockCount );
+
+	vPortFree( pxBlockPool );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTakeBlock( BlockPool_t * const pxBlockPool )
+{
+BlockPoolFreeBlock_t * const pxBlock = pxBlockPool->pxFreeBlocks;
+
+	if( pxBlock != NULL )
+	{
+		pxBlockPool->pxFreeBlocks = pxBlock->pxNextFreeBlock;
+		( pxBlockPool->uxFreeCount )--;
+
+		if( pxBlockPool->uxFreeCount < pxBlockPool->uxMinimumFreeCount )
+		{
+			pxBlockPool->uxMinimumFreeCount = pxBlockPool->uxFreeCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBlock( BlockPool_t * const pxBlockPool, void *pvBlock )
+{
+BlockPoolFreeBlock_t * const pxBlock = ( BlockPoolFreeBlock_t * ) pvBlock; /*lint !e9079 !e9087 Blocks are aligned to portBYTE_ALIGNMENT. */
+
+	pxBlock->pxNextFreeBlock = pxBlockPool->pxFreeBlocks;
+	pxBlockPool->pxFreeBlocks = pxBlock;
+	( pxBlockPool->uxFreeCount )++;
+
+	/* More blocks released than were taken means a block was released twice,
+	or to the wrong pool. */
+	configASSERT( pxBlockPool->uxFreeCount <= pxBlockPool->uxBlockCount );
+}
+/*-----------------------------------------------------------*/
+
+void *pvBlockPoolTake( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = xBlockPool;
+void *pvBlock;
+
+	configASSERT( pxBlockPool );
+
+	taskENTER_CRITICAL();
+	{
+		pvBlock = prvTakeBlock( pxBlockPool );
+	}
+	taskEXIT_CRITICAL();
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvBlockPoolTakeFromISR( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = xBlockPool;
+void *pvBlock;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxBlockPool );
+
+	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvBlock = prvTakeBlock( pxBlockPool );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolRelease( BlockPoolHandle_t xBlockPool, void *pvBlock )
+{
+BlockPool_t * const pxBlockPool = xBlockPool;
+
+	configASSERT( pxBlockPool );
+	bpASSERT_BLOCK_IN_POOL( pxBlockPool, pvBlock );
+
+	taskENTER_CRITICAL();
+	{
+		prvReleaseBlock( pxBlockPool, pvBlock );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolReleaseFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock )
+{
+BlockPool_t * const pxBlockPool = xBlockPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxBlockPool );
+	bpASSERT_BLOCK_IN_POOL( pxBlockPool, pvBlock );
+
+	uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvReleaseBlock( pxBlockPool, pvBlock );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t const * const pxBlockPool = xBlockPool;
+
+	configASSERT( pxBlockPool );
+
+	return pxBlockPool->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBlockPoolGetFreeCount( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t const * const pxBlockPool = xBlockPool;
+
+	configASSERT( pxBlockPool );
+
+	return pxBlockPool->uxFreeCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBlockPoolGetMinimumFreeCount( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t const * const pxBlockPool = xBlockPool;
+
+	configASSERT( pxBlockPool );
+
+	return pxBlockPool->uxMinimumFreeCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendByReference( QueueHandle_t xQueue, void *pvBlock, TickType_t xTicksToWait )
+{
+	/* Only the pointer is copied into the queue. */
+	return xQueueSend( xQueue, &pvBlock, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendByReferenceFromISR( QueueHandle_t xQueue, void *pvBlock, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+	return xQueueSendFromISR( xQueue, &pvBlock, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
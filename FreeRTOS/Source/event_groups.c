@@ -60,6 +60,19 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* When bits can be set directly from an interrupt the list of waiting tasks,
+and the bits, are also accessed by interrupts, so the task level functions
+disable interrupts around them as well as suspending the scheduler.  The
+scheduler is still suspended, as vTaskPlaceOnUnorderedEventList() and
+vTaskRemoveFromUnorderedEventList() require it. */
+#if( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+	#define eventENTER_WAITING_LIST_ACCESS()	taskENTER_CRITICAL()
+	#define eventEXIT_WAITING_LIST_ACCESS()		taskEXIT_CRITICAL()
+#else
+	#define eventENTER_WAITING_LIST_ACCESS()
+	#define eventEXIT_WAITING_LIST_ACCESS()
+#endif
+
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
@@ -204,6 +217,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITING_LIST_ACCESS();
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -246,6 +260,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventEXIT_WAITING_LIST_ACCESS();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +342,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITING_LIST_ACCESS();
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -394,6 +410,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventEXIT_WAITING_LIST_ACCESS();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,7 +502,29 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* Cleared here rather than by the timer task, so a clear cannot be
+		overtaken by a set made directly from a later interrupt. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
@@ -533,6 +572,7 @@ BaseType_t xMatchFound = pdFALSE;
 	pxList = &( pxEventBits->xTasksWaitingForBits );
 	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
+	eventENTER_WAITING_LIST_ACCESS();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
@@ -604,6 +644,7 @@ BaseType_t xMatchFound = pdFALSE;
 		bit was set in the control word. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
 	}
+	eventEXIT_WAITING_LIST_ACCESS();
 	( void ) xTaskResumeAll();
 
 	return pxEventBits->uxEventBits;
@@ -619,13 +660,17 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		eventENTER_WAITING_LIST_ACCESS();
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being
+				deleted and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
 		}
+		eventEXIT_WAITING_LIST_ACCESS();
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
@@ -703,7 +748,87 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	ListItem_t *pxListItem, *pxNext;
+	ListItem_t const *pxListEnd;
+	List_t const * pxList;
+	EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xWoken = pdFALSE;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		pxList = &( pxEventBits->xTasksWaitingForBits );
+		pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+		/* The same walk as xEventGroupSetBits(), made with interrupts masked
+		instead of with the scheduler suspended.  Each waiting task is looked
+		at once, so the time taken is bounded by the number of tasks that wait
+		on this event group. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+
+			/* Set the bits. */
+			pxEventBits->uxEventBits |= uxBitsToSet;
+
+			while( pxListItem != pxListEnd )
+			{
+				pxNext = listGET_NEXT( pxListItem );
+				uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+				/* Split the bits waited for from the control bits. */
+				uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+				if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE ) != pdFALSE )
+				{
+					if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBitsWaitedFor;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Moves the task to the ready list, or to the pending ready
+					list if the scheduler is suspended. */
+					if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+					{
+						xWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				pxListItem = pxNext;
+			}
+
+			/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+			bit was set in the control word. */
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( pxHigherPriorityTaskWoken != NULL ) && ( xWoken != pdFALSE ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
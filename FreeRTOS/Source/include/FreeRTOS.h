@@ -884,6 +884,59 @@ hold explicit before calling the code. */
 	#define configINITIAL_TICK_COUNT 0
 #endif
 
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configUSE_TIMER_COMMAND_COALESCING
+	#define configUSE_TIMER_COMMAND_COALESCING 0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+	#define configTIMER_COMMAND_BATCH_SIZE 8
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR_SET
+	#define configUSE_EVENT_GROUP_DIRECT_ISR_SET 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+	#define configUSE_STREAM_BUFFER_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_SPSC
+	#define configUSE_STREAM_BUFFER_SPSC 0
+#endif
+
+#if( ( configUSE_STREAM_BUFFER_SPSC == 1 ) && !defined( portMEMORY_BARRIER ) )
+	/* The indexes of a stream buffer must be stored after the data they
+	cover. */
+	#error configUSE_STREAM_BUFFER_SPSC requires the port to define portMEMORY_BARRIER()
+#endif
+
+#ifndef configLIST_WHEEL_LEVELS
+	/* Two levels of 32 slots hold timeouts of up to 1023 ticks. */
+	#define configLIST_WHEEL_LEVELS 2
+#endif
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	#if( ( configLIST_WHEEL_LEVELS < 1 ) || ( configLIST_WHEEL_LEVELS > 3 ) )
+		#error configLIST_WHEEL_LEVELS must be between 1 and 3 when configUSE_16_BIT_TICKS is 1.
+	#endif
+#else
+	#if( ( configLIST_WHEEL_LEVELS < 1 ) || ( configLIST_WHEEL_LEVELS > 6 ) )
+		#error configLIST_WHEEL_LEVELS must be between 1 and 6.
+	#endif
+#endif
+
 #if( portTICK_TYPE_IS_ATOMIC == 0 )
 	/* Either variables of tick type cannot be read atomically, or
 	portTICK_TYPE_IS_ATOMIC was not set - map the critical sections used when
@@ -1138,7 +1191,11 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		uint32_t		ulDummy16[ 2 ];
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy23[ 4 ];
+		uint32_t		ulDummy24;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -1257,6 +1314,10 @@ typedef struct xSTATIC_TIMER
 		UBaseType_t		uxDummy7;
 	#endif
 	uint8_t 			ucDummy8;
+	#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		UBaseType_t		uxDummy9[ 3 ];
+		TickType_t		xDummy10;
+	#endif
 
 } StaticTimer_t;
 
@@ -1282,6 +1343,9 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		size_t uxDummy5[ 2 ];
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -0,0 +1,293 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Block pools and by-reference queues pass messages between tasks and
+ * interrupts without copying them.
+ *
+ * A block pool holds a fixed number of blocks of one size.  A sender takes a
+ * block from the pool, writes the message into it in place, and sends only a
+ * pointer to the block through a by-reference queue.  The receiver reads the
+ * message where it is, then releases the block back to the pool.  The time
+ * spent in critical sections is that of copying one pointer, whatever the size
+ * of the message.
+ *
+ * The free blocks of a pool are kept on a list threaded through the blocks
+ * themselves, so taking and releasing a block are constant time, a few
+ * instructions in a critical section.  Taking a block does not wait: a pool
+ * should have a block for each place in the by-reference queues it feeds, plus
+ * one for each sender and receiver that holds a block at a time.
+ *
+ * The pool does not track which task holds a block.  A block must be released
+ * to the pool it was taken from, once, and not used after it is released.
+ */
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include block_pool.h"
+#endif
+
+#include "queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which block pools are referenced.  For example, a call to
+ * xBlockPoolCreate() returns a BlockPoolHandle_t variable that can then be
+ * used as a parameter to pvBlockPoolTake() and vBlockPoolRelease().
+ */
+struct BlockPoolDef_t;
+typedef struct BlockPoolDef_t * BlockPoolHandle_t;
+
+/**
+ * block_pool.h
+ * <pre>BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );</pre>
+ *
+ * Creates a block pool using dynamically allocated memory.
+ *
+ * @param xBlockSize The size, in bytes, of each block.  Blocks are aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @return The handle of the pool, or NULL if there was not enough heap.
+ *
+ * \defgroup xBlockPoolCreate xBlockPoolCreate
+ * \ingroup BlockPool
+ */
+BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>void vBlockPoolDelete( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * Frees a block pool.  Every block must have been released.
+ *
+ * \defgroup vBlockPoolDelete vBlockPoolDelete
+ * \ingroup BlockPool
+ */
+void vBlockPoolDelete( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>void *pvBlockPoolTake( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * Takes a block from a pool.
+ *
+ * @return The block, or NULL if none is free.
+ *
+ * \defgroup pvBlockPoolTake pvBlockPoolTake
+ * \ingroup BlockPool
+ */
+void *pvBlockPoolTake( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>void *pvBlockPoolTakeFromISR( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * A version of pvBlockPoolTake() that can be called from an interrupt.
+ *
+ * \defgroup pvBlockPoolTakeFromISR pvBlockPoolTakeFromISR
+ * \ingroup BlockPool
+ */
+void *pvBlockPoolTakeFromISR( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>void vBlockPoolRelease( BlockPoolHandle_t xBlockPool, void *pvBlock );</pre>
+ *
+ * Returns a block to the pool it was taken from.
+ *
+ * \defgroup vBlockPoolRelease vBlockPoolRelease
+ * \ingroup BlockPool
+ */
+void vBlockPoolRelease( BlockPoolHandle_t xBlockPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>void vBlockPoolReleaseFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock );</pre>
+ *
+ * A version of vBlockPoolRelease() that can be called from an interrupt.
+ *
+ * \defgroup vBlockPoolReleaseFromISR vBlockPoolReleaseFromISR
+ * \ingroup BlockPool
+ */
+void vBlockPoolReleaseFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * @return The size, in bytes, of the blocks of the pool.
+ *
+ * \defgroup xBlockPoolGetBlockSize xBlockPoolGetBlockSize
+ * \ingroup BlockPool
+ */
+size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>UBaseType_t uxBlockPoolGetFreeCount( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * @return The number of blocks that are free.
+ *
+ * \defgroup uxBlockPoolGetFreeCount uxBlockPoolGetFreeCount
+ * \ingroup BlockPool
+ */
+UBaseType_t uxBlockPoolGetFreeCount( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>UBaseType_t uxBlockPoolGetMinimumFreeCount( BlockPoolHandle_t xBlockPool );</pre>
+ *
+ * @return The lowest number of blocks that have been free since the pool was
+ * created, which shows how close the pool has come to running out.
+ *
+ * \defgroup uxBlockPoolGetMinimumFreeCount uxBlockPoolGetMinimumFreeCount
+ * \ingroup BlockPool
+ */
+UBaseType_t uxBlockPoolGetMinimumFreeCount( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * By-reference queues.  These are ordinary queues whose items are block
+ * pointers, so any queue API function can be used on them as well.
+ *----------------------------------------------------------*/
+
+/**
+ * block_pool.h
+ * <pre>QueueHandle_t xQueueCreateByReference( UBaseType_t uxQueueLength );</pre>
+ *
+ * Creates a queue that holds up to uxQueueLength block pointers.
+ *
+ * Example usage:
+   <pre>
+ BlockPoolHandle_t xPool;
+ QueueHandle_t xQueue;
+
+ void vSender( void *pvParameters )
+ {
+ char *pcMessage;
+
+	 for( ;; )
+	 {
+		 // Write the message straight into a block...
+		 pcMessage = pvBlockPoolTake( xPool );
+
+		 if( pcMessage != NULL )
+		 {
+			 sprintf( pcMessage, "tick %u", ( unsigned ) xTaskGetTickCount() );
+
+			 // ...and send only the pointer.
+			 xQueueSendByReference( xQueue, pcMessage, portMAX_DELAY );
+		 }
+
+		 vTaskDelay( 10 );
+	 }
+ }
+
+ void vReceiver( void *pvParameters )
+ {
+ char *pcMessage;
+
+	 for( ;; )
+	 {
+		 if( xQueueReceiveByReference( xQueue, ( void ** ) &pcMessage, portMAX_DELAY ) == pdPASS )
+		 {
+			 vPrint( pcMessage );
+			 vBlockPoolRelease( xPool, pcMessage );
+		 }
+	 }
+ }
+   </pre>
+ * \defgroup xQueueCreateByReference xQueueCreateByReference
+ * \ingroup BlockPool
+ */
+#define xQueueCreateByReference( uxQueueLength ) xQueueCreate( ( uxQueueLength ), sizeof( void * ) )
+
+/**
+ * block_pool.h
+ * <pre>BaseType_t xQueueSendByReference( QueueHandle_t xQueue, void *pvBlock, TickType_t xTicksToWait );</pre>
+ *
+ * Sends a block to the back of a by-reference queue.  The block belongs to the
+ * receiver from then on.
+ *
+ * @return pdPASS if the block was sent, otherwise errQUEUE_FULL, in which case
+ * the block still belongs to the sender.
+ *
+ * \defgroup xQueueSendByReference xQueueSendByReference
+ * \ingroup BlockPool
+ */
+BaseType_t xQueueSendByReference( QueueHandle_t xQueue, void *pvBlock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>BaseType_t xQueueSendByReferenceFromISR( QueueHandle_t xQueue, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xQueueSendByReference() that can be called from an interrupt.
+ *
+ * \defgroup xQueueSendByReferenceFromISR xQueueSendByReferenceFromISR
+ * \ingroup BlockPool
+ */
+BaseType_t xQueueSendByReferenceFromISR( QueueHandle_t xQueue, void *pvBlock, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>BaseType_t xQueueReceiveByReference( QueueHandle_t xQueue, void **ppvBlock, TickType_t xTicksToWait );</pre>
+ *
+ * Receives a block from a by-reference queue.  The receiver releases the block
+ * to its pool once it has finished with the message.
+ *
+ * @param ppvBlock Set to the block received.
+ *
+ * @return pdPASS if a block was received, otherwise pdFAIL.
+ *
+ * \defgroup xQueueReceiveByReference xQueueReceiveByReference
+ * \ingroup BlockPool
+ */
+#define xQueueReceiveByReference( xQueue, ppvBlock, xTicksToWait ) xQueueReceive( ( xQueue ), ( ppvBlock ), ( xTicksToWait ) )
+
+/**
+ * block_pool.h
+ * <pre>BaseType_t xQueueReceiveByReferenceFromISR( QueueHandle_t xQueue, void **ppvBlock, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xQueueReceiveByReference() that can be called from an
+ * interrupt.
+ *
+ * \defgroup xQueueReceiveByReferenceFromISR xQueueReceiveByReferenceFromISR
+ * \ingroup BlockPool
+ */
+#define xQueueReceiveByReferenceFromISR( xQueue, ppvBlock, pxHigherPriorityTaskWoken ) xQueueReceiveFromISR( ( xQueue ), ( ppvBlock ), ( pxHigherPriorityTaskWoken ) )
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( BLOCK_POOL_H ) */
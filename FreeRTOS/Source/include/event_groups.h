@@ -369,6 +369,10 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_ISR_SET is set to 1 in FreeRTOSConfig.h the
+ * bits are instead cleared directly, so the clear is always ordered with the
+ * sets made by xEventGroupSetBitsFromISR(), and pdPASS is always returned.
+ *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
  * @param uxBitsToClear A bitwise value that indicates the bit or bits to clear.
@@ -404,7 +408,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
@@ -500,6 +504,17 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_ISR_SET is set to 1 in FreeRTOSConfig.h the
+ * bits are instead set, and the tasks waiting for them unblocked, directly in
+ * the interrupt.  That saves posting to the timer queue and switching to the
+ * timer task before a waiting task can run, at the cost of the walk of the
+ * waiting tasks being made with interrupts masked - it looks at each task that
+ * waits on the event group once, so it is bounded by the number of them.  The
+ * task level event group functions then also disable interrupts while they
+ * access the waiting tasks.  The timer task is not needed, pdPASS is always
+ * returned, and *pxHigherPriorityTaskWoken is set to pdTRUE if a task was
+ * unblocked that has a priority above that of the interrupted task.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -556,7 +571,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
@@ -389,6 +389,23 @@ void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIV
  */
 void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
 
+/*
+ * Insert a list item into a list, immediately in front of another item.  Used
+ * to keep a list in an order that cannot be expressed by the item values.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxPosition The item, already in pxList, that the new item is placed
+ * in front of.  Pass the list end marker to place the new item at the end of
+ * the list.
+ *
+ * @param pxNewListItem The list item to be inserted into the list.
+ *
+ * \page vListInsertBefore vListInsertBefore
+ * \ingroup LinkedList
+ */
+void vListInsertBefore( List_t * const pxList, ListItem_t * const pxPosition, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
 /*
  * Remove an item from a list.  The list item has a pointer to the list that
  * it is in, so only the list item need be passed into the function.
@@ -404,6 +421,108 @@ void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) P
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+#if( ( configUSE_DELAYED_TASK_WHEEL == 1 ) || ( configUSE_TIMER_WHEEL == 1 ) )
+
+/*
+ * Hierarchical timing wheel.
+ *
+ * A wheel holds list items ordered by their item value, which is the tick at
+ * which the item expires, in the same way as a list sorted by vListInsert().
+ * Insertion and removal take a constant time however many items are held.
+ *
+ * Each of the configLIST_WHEEL_LEVELS levels has 32 slots, and each slot is
+ * an ordinary List_t, so items are removed with uxListRemove() as usual.  A
+ * slot of level 0 holds the items that expire on one particular tick.  A slot
+ * of level n holds the items that expire within one particular run of 32^n
+ * ticks - they are moved (cascaded) to the lower levels when the wheel reaches
+ * the start of that run.  Items that expire 32^configLIST_WHEEL_LEVELS or more
+ * ticks after the wheel's time cannot be held, and have to be kept elsewhere.
+ */
+#define listWHEEL_SLOT_BITS		( 5U )
+#define listWHEEL_SLOTS			( ( UBaseType_t ) 1U << listWHEEL_SLOT_BITS )
+
+typedef struct xLIST_WHEEL
+{
+	TickType_t xTime;														/*< The tick the wheel has been advanced to. */
+	uint32_t ulOccupied[ configLIST_WHEEL_LEVELS ];						/*< Bit n is set if slot n of the level may hold items. */
+	List_t xSlots[ configLIST_WHEEL_LEVELS ][ listWHEEL_SLOTS ];
+} ListWheel_t;
+
+/*
+ * Access macro to determine if a list is one of the slots of a wheel.
+ *
+ * \page listWHEEL_OWNS_LIST listWHEEL_OWNS_LIST
+ * \ingroup LinkedList
+ */
+#define listWHEEL_OWNS_LIST( pxWheel, pxList )	( ( ( pxList ) >= &( ( pxWheel )->xSlots[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( ( pxWheel )->xSlots[ configLIST_WHEEL_LEVELS - 1 ][ listWHEEL_SLOTS - 1 ] ) ) )
+
+/*
+ * Must be called before a wheel is used.
+ *
+ * @param pxWheel Pointer to the wheel being initialised.
+ *
+ * @param xTime The current tick count.
+ *
+ * \page vListWheelInitialise vListWheelInitialise
+ * \ingroup LinkedList
+ */
+void vListWheelInitialise( ListWheel_t * const pxWheel, const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a list item into a wheel, in the slot that corresponds to its item
+ * value (the tick at which it expires).
+ *
+ * @param pxWheel The wheel into which the item is to be inserted.
+ *
+ * @param pxNewListItem The item to insert.  Its value must be later than xNow.
+ *
+ * @param xNow The current tick count.
+ *
+ * @return pdTRUE if the item was inserted.  pdFALSE if it expires too far in
+ * the future to be held by the wheel, in which case it was not inserted.
+ *
+ * \page xListWheelInsert xListWheelInsert
+ * \ingroup LinkedList
+ */
+BaseType_t xListWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem, const TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the wheel towards xNow, stopping at the first tick on which items
+ * expire.
+ *
+ * @param pxWheel The wheel to advance.
+ *
+ * @param xNow The current tick count.
+ *
+ * @return The slot holding the items that have expired, all of which must be
+ * removed before the wheel is used again, or NULL once the wheel has reached
+ * xNow with no further items to expire.
+ *
+ * \page pxListWheelAdvance pxListWheelAdvance
+ * \ingroup LinkedList
+ */
+List_t * pxListWheelAdvance( ListWheel_t * const pxWheel, const TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find how long the wheel can be left before pxListWheelAdvance() needs to be
+ * called.  This may be before the first item expires, as items also have to be
+ * moved between levels, and after items are removed it may be earlier than
+ * necessary - but it is never later.
+ *
+ * @param pxWheel The wheel to query.
+ *
+ * @param xNow The current tick count.
+ *
+ * @return The number of ticks after xNow at which the wheel needs to be
+ * advanced, or portMAX_DELAY if the wheel is empty.
+ *
+ * \page xListWheelTicksToNextEvent xListWheelTicksToNextEvent
+ * \ingroup LinkedList
+ */
+TickType_t xListWheelTicksToNextEvent( const ListWheel_t * const pxWheel, const TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL || configUSE_TIMER_WHEEL */
+
 #ifdef __cplusplus
 }
 #endif
@@ -796,6 +796,48 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer, void **ppvData, size_t xLengthBytes, TickType_t xTicksToWait );
+size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes );
+size_t xMessageBufferPeekContiguous( MessageBufferHandle_t xMessageBuffer, const void **ppvData, TickType_t xTicksToWait );
+size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer, size_t xLengthBytes );
+</pre>
+ *
+ * Only available when configUSE_STREAM_BUFFER_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Write and read messages in place, without copying them, as described for
+ * xStreamBufferReserve(), xStreamBufferCommit(), xStreamBufferPeekContiguous()
+ * and xStreamBufferConsume() in stream_buffer.h.  Each has a FromISR version.
+ *
+ * xMessageBufferReserve() reserves room for the whole message or returns 0.
+ * xMessageBufferCommit() sends the first xLengthBytes of it as one message.
+ * xMessageBufferPeekContiguous() returns the whole of the next message, and
+ * xMessageBufferConsume() removes it, so must be passed its length.
+ *
+ * Messages are kept contiguous, so when the zero copy API is enabled a message
+ * can be at most half the buffer size, less sizeof( size_t ).  This applies to
+ * xMessageBufferSend() as well, which uses the same layout.
+ *
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, ppvData, xLengthBytes, xTicksToWait ) xStreamBufferReserve( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xLengthBytes, xTicksToWait )
+#define xMessageBufferReserveFromISR( xMessageBuffer, ppvData, xLengthBytes ) xStreamBufferReserveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xLengthBytes )
+#define xMessageBufferCommit( xMessageBuffer, xLengthBytes ) xStreamBufferCommit( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes )
+#define xMessageBufferCommitFromISR( xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+#define xMessageBufferPeekContiguous( xMessageBuffer, ppvData, xTicksToWait ) xStreamBufferPeekContiguous( ( StreamBufferHandle_t ) xMessageBuffer, ppvData, xTicksToWait )
+#define xMessageBufferPeekContiguousFromISR( xMessageBuffer, ppvData ) xStreamBufferPeekContiguousFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvData )
+#define xMessageBufferConsume( xMessageBuffer, xLengthBytes ) xStreamBufferConsume( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes )
+#define xMessageBufferConsumeFromISR( xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xLengthBytes, pxHigherPriorityTaskWoken )
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
@@ -138,6 +138,17 @@ typedef struct xHeapStats
 	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass information about one size class of heap_pool.c out of
+vPortGetHeapPoolClassStats(). */
+typedef struct xHeapPoolClassStats
+{
+	size_t xBlockSize;				/* The size of each block of the class, in bytes. */
+	size_t xBlockCount;				/* The number of blocks in the class. */
+	size_t xFreeBlocks;				/* The number of blocks of the class free at the time vPortGetHeapPoolClassStats() is called. */
+	size_t xMinimumEverFreeBlocks;	/* The minimum number of blocks of the class there have been free since the system booted - xBlockCount less this is the high-water mark of the class. */
+	size_t xFailedAllocations;		/* The number of calls to pvPortMalloc() for a size that belongs in the class that returned NULL. */
+} HeapPoolClassStats_t;
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -157,6 +168,13 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t *pxHeapStats );
 
+/*
+ * Used by heap_pool.c to report the number of size classes, set by
+ * configHEAP_POOL_BLOCK_SIZES, and how the blocks of one of them are used.
+ */
+UBaseType_t uxPortGetHeapPoolClassCount( void ) PRIVILEGED_FUNCTION;
+void vPortGetHeapPoolClassStats( UBaseType_t uxClass, HeapPoolClassStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -1384,6 +1384,168 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+								   QueueHandle_t xQueue,
+								   const void * pvItems,
+								   UBaseType_t uxItemCount,
+								   TickType_t xTicksToWait
+							   );
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue in one call.  As many
+ * items as there is room for are copied in a single critical section, and the
+ * tasks waiting to receive from the queue are woken (and a context switch
+ * requested, if needed) once for the whole batch rather than once per item.
+ *
+ * If the queue is full the calling task blocks until there is room for at
+ * least one item or xTicksToWait expires.  Fewer than uxItemCount items are
+ * posted if the queue fills, so the caller can loop on the remainder.
+ *
+ * Cannot be used with semaphores or mutexes.  This function must not be used
+ * in an interrupt service routine.  See xQueueSendMultipleFromISR() for an
+ * alternative which may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxItemCount items, stored one after another,
+ * each the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it already be full.
+ *
+ * @return The number of items posted, which is 0 if the queue stayed full for
+ * xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ uint8_t ucBurst[ 16 ];
+
+ void vATask( void *pvParameters )
+ {
+ UBaseType_t uxSent = 0;
+
+	// ... fill ucBurst, then post all of it to a queue of uint8_t.
+	while( uxSent < sizeof( ucBurst ) )
+	{
+		uxSent += xQueueSendMultiple( xQueue, &( ucBurst[ uxSent ] ), sizeof( ucBurst ) - uxSent, portMAX_DELAY );
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultipleFromISR(
+										  QueueHandle_t xQueue,
+										  const void * pvItems,
+										  UBaseType_t uxItemCount,
+										  BaseType_t *pxHigherPriorityTaskWoken
+									  );
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be used from an interrupt service
+ * routine.  Posts as many of the uxItemCount items as there is room for, never
+ * blocks, and returns the number posted.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items unblocked
+ * a task with a priority higher than the currently running task, in which case
+ * a context switch should be requested before the interrupt is exited.
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+									  QueueHandle_t xQueue,
+									  void *pvBuffer,
+									  UBaseType_t uxMaxItems,
+									  TickType_t xTicksToWait
+								  );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue in one call.  Every item waiting
+ * in the queue, up to uxMaxItems, is copied out in a single critical section,
+ * and the tasks waiting for space on the queue are woken once for the whole
+ * batch.  A task draining a bursty queue therefore pays the critical section,
+ * queue lock and context switch costs once per burst instead of once per item.
+ *
+ * If the queue is empty the calling task blocks until at least one item
+ * arrives or xTicksToWait expires.
+ *
+ * Cannot be used with semaphores or mutexes.  This function must not be used
+ * in an interrupt service routine.  See xQueueReceiveMultipleFromISR() for an
+ * alternative that can.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxItems items, into
+ * which the received items are copied one after another.
+ *
+ * @param uxMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, which is 0 if the queue stayed empty
+ * for xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ void vUartConsumerTask( void *pvParameters )
+ {
+ char cBuffer[ 16 ];
+ UBaseType_t uxReceived;
+
+	for( ;; )
+	{
+		// Take whatever the producers have queued, up to 16 characters.
+		uxReceived = xQueueReceiveMultiple( xQueue, cBuffer, sizeof( cBuffer ), portMAX_DELAY );
+		vSerialPutString( ( const signed char * ) cBuffer, ( unsigned short ) uxReceived );
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultipleFromISR(
+											 QueueHandle_t xQueue,
+											 void *pvBuffer,
+											 UBaseType_t uxMaxItems,
+											 BaseType_t *pxHigherPriorityTaskWoken
+										 );
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be used from an interrupt
+ * service routine.  Receives as many items as are waiting, up to uxMaxItems,
+ * never blocks, and returns the number received.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing space in the queue
+ * unblocked a task with a priority higher than the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
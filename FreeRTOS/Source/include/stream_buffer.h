@@ -46,6 +46,15 @@
  * (such as xStreamBufferReceive()) inside a critical section section and set the
  * receive block time to 0.
  *
+ * Setting configUSE_STREAM_BUFFER_SPSC to 1 in FreeRTOSConfig.h relies on that
+ * single writer and single reader to keep interrupts enabled while data is
+ * moved.  The writer only moves the head and the reader only moves the tail,
+ * each with one ordered store, and a critical section, or the scheduler being
+ * suspended, is only used when a task has to block or has to be woken.  This
+ * shortens the time interrupts are masked by a task streaming to or from an
+ * interrupt.  A sbSEND_COMPLETED() or sbRECEIVE_COMPLETED() supplied by the
+ * application is called as before.
+ *
  */
 
 #ifndef STREAM_BUFFER_H
@@ -833,6 +842,186 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             void **ppvData,
+                             size_t xWantedBytes,
+                             TickType_t xTicksToWait );
+size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    void **ppvData,
+                                    size_t xWantedBytes );
+</pre>
+ *
+ * Only available when configUSE_STREAM_BUFFER_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * The first half of writing to a stream or message buffer without a copy.
+ * Returns a pointer into the buffer's own storage, which the writer fills in
+ * place - from a DMA transfer, or by formatting straight into it - then makes
+ * visible to the reader with xStreamBufferCommit().  Nothing is visible to the
+ * reader until it is committed.
+ *
+ * A stream buffer reserves as much of xWantedBytes as is free before the end
+ * of its storage, so a write that would wrap takes two reservations.  A
+ * message buffer reserves the whole message or nothing.  With the zero copy
+ * API every message in a message buffer is held contiguously, so a message can
+ * be at most half the buffer, less the bytes that hold its length.
+ *
+ * Like xStreamBufferSend(), only one task or interrupt may write to the buffer,
+ * and only the writer may reserve.  A later reservation replaces an earlier
+ * one that was not committed.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param ppvData Set to where the reserved bytes start, or to NULL if nothing
+ * was reserved.
+ *
+ * @param xWantedBytes The bytes wanted - for a message buffer, the length of
+ * the message.
+ *
+ * @param xTicksToWait The most time to wait for space, as xStreamBufferSend()
+ * waits.  A stream buffer waits for all of xWantedBytes to be free.
+ *
+ * @return The number of bytes reserved, which may be less than xWantedBytes for
+ * a stream buffer, and is 0 if there was no space.
+ *
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+							 void **ppvData,
+							 size_t xWantedBytes,
+							 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+									void **ppvData,
+									size_t xWantedBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes );
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytes,
+                                   BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Only available when configUSE_STREAM_BUFFER_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Make the first xBytes of the last reservation visible to the reader, and
+ * release the rest.  A task blocked to receive is unblocked once the bytes in
+ * the buffer reach its trigger level, as for xStreamBufferSend().  A message
+ * buffer holds the committed bytes as one message.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param xBytes The bytes written, no more than were reserved.  0 abandons the
+ * reservation.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of a higher priority
+ * than the interrupted task was unblocked, as for xStreamBufferSendFromISR().
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xBytes,
+								   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    const void **ppvData,
+                                    TickType_t xTicksToWait );
+size_t xStreamBufferPeekContiguousFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           const void **ppvData );
+</pre>
+ *
+ * Only available when configUSE_STREAM_BUFFER_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * The first half of reading from a stream or message buffer without a copy.
+ * Returns a pointer to the oldest data in the buffer's own storage, which stays
+ * valid until it is released with xStreamBufferConsume().
+ *
+ * A stream buffer returns the bytes held before the end of its storage - the
+ * rest are returned once those are consumed.  A message buffer returns the
+ * whole of the next message.
+ *
+ * Like xStreamBufferReceive(), only one task or interrupt may read from the
+ * buffer.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param ppvData Set to where the data starts, or to NULL if there is none.
+ *
+ * @param xTicksToWait The most time to wait for data, as xStreamBufferReceive()
+ * waits - so a stream buffer waits for its trigger level.
+ *
+ * @return The number of bytes at *ppvData, or 0 if there are none.
+ *
+ * \defgroup xStreamBufferPeekContiguous xStreamBufferPeekContiguous
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+									const void **ppvData,
+									TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferPeekContiguousFromISR( StreamBufferHandle_t xStreamBuffer,
+										   const void **ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytes );
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytes,
+                                    BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Only available when configUSE_STREAM_BUFFER_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Release bytes returned by xStreamBufferPeekContiguous(), freeing their space
+ * for the writer and unblocking a writer waiting for it.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param xBytes The bytes to release.  A stream buffer may release fewer than
+ * were peeked.  A message buffer releases the whole message, so xBytes must be
+ * its length.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task of a higher priority
+ * than the interrupted task was unblocked, as for
+ * xStreamBufferReceiveFromISR().
+ *
+ * @return The number of bytes released.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xBytes,
+									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
@@ -143,6 +143,8 @@ typedef struct xTASK_STATUS
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
 	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	uint32_t ulSwitchInCount;		/* The number of times the task has been switched in from another task so far.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	uint32_t ulDeadlineMisses;		/* The number of the task's jobs that completed after their deadline so far.  Only valid when configUSE_EDF_SCHEDULING is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
@@ -1017,6 +1019,91 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Schedule a task by earliest deadline first among the ready tasks of its
+ * priority.  Priorities still come first: a task is only compared by deadline
+ * with the tasks of the same priority, and the tasks that have a period are
+ * selected ahead of those that do not.  Placing all the periodic tasks at one
+ * priority schedules them by EDF alone.
+ *
+ * The task's work is divided into jobs, one released every xPeriod ticks.
+ * The first job is released when this function is called, and the task calls
+ * vTaskWaitForNextPeriod() at the end of each job.  A job that completes more
+ * than xRelativeDeadline ticks after its release is counted as a deadline miss
+ * - see ulTaskGetDeadlineMisses().
+ *
+ * @param xTask Handle to the task being set.  Passing a NULL handle results
+ * in the calling task being set.
+ *
+ * @param xRelativeDeadline The time after its release by which each job must
+ * complete.  0 sets the deadline to the end of the period.
+ *
+ * @param xPeriod The time between the releases of the jobs.  0 returns the
+ * task to being scheduled by priority alone.
+ *
+ * Example usage:
+   <pre>
+ // Toggle an LED every 100 ticks, each toggle due within 20 ticks.
+ void vTaskFunction( void * pvParameters )
+ {
+	 vTaskSetDeadline( NULL, 20, 100 );
+
+	 for( ;; )
+	 {
+		 // Perform the job here.
+
+		 // Wait for the release of the next job.
+		 vTaskWaitForNextPeriod();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a task that has a period, set by vTaskSetDeadline(), to end its
+ * current job.  The job is counted as a deadline miss if it completed after
+ * its deadline.  The task then blocks until the next job is released, one
+ * period after the last, or carries straight on with the next job if its
+ * release time has already passed.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>uint32_t ulTaskGetDeadlineMisses( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * results in the calling task being queried.
+ *
+ * @return The number of the task's jobs that completed after their deadline.
+ * Also reported in TaskStatus_t.ulDeadlineMisses.
+ *
+ * \defgroup ulTaskGetDeadlineMisses ulTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+uint32_t ulTaskGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -2416,6 +2503,22 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM AN INTERRUPT, WITH INTERRUPTS MASKED.
+ *
+ * The version of vTaskRemoveFromUnorderedEventList() used when event group
+ * bits are set directly from an interrupt (configUSE_EVENT_GROUP_DIRECT_ISR_SET).
+ * The scheduler may or may not be suspended, so the task is held on the
+ * pending ready list if it is, as xTaskRemoveFromEventList() does.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was interrupted, otherwise pdFALSE.
+ */
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
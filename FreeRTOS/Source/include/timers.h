@@ -87,6 +87,20 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+/*
+ * The statistics of the timer command queue returned by
+ * vTimerGetCommandQueueStats().
+ */
+typedef struct xTIMER_COMMAND_QUEUE_STATS
+{
+	UBaseType_t uxCommandsSent;			/*<< Timer commands placed on the queue. */
+	UBaseType_t uxCommandsCoalesced;	/*<< Starts and resets folded into one already queued for the same timer, so not placed on the queue. */
+	UBaseType_t uxCommandsDropped;		/*<< Timer commands that failed because the queue stayed full. */
+	UBaseType_t uxQueueDepth;			/*<< Commands waiting in the queue now. */
+	UBaseType_t uxQueueHighWaterMark;	/*<< The most commands there have been waiting in the queue. */
+	UBaseType_t uxBatches;				/*<< The number of times the daemon has taken commands from the queue. */
+} TimerCommandQueueStats_t;
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -1288,6 +1302,34 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerGetCommandQueueStats( TimerCommandQueueStats_t *pxStats );
+ *
+ * configUSE_TIMER_COMMAND_COALESCING must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * With configUSE_TIMER_COMMAND_COALESCING set to 1, a start or reset of a
+ * timer that already has a start or reset waiting in the timer command queue,
+ * with nothing else queued for the timer after it, is not queued.  Only the
+ * command time of the one waiting is updated, so the timer is started from the
+ * last start or reset, as if each had been processed in turn.  A timer reset
+ * on every edge of a bouncing input therefore takes one place in the queue
+ * however often it is reset.  The timer service task also takes commands from
+ * the queue up to configTIMER_COMMAND_BATCH_SIZE at a time, rather than one at
+ * a time.
+ *
+ * A start or reset that is folded into one already queued returns pdPASS
+ * straight away, and is not given to traceTIMER_COMMAND_RECEIVED().
+ *
+ * @param pxStats Filled with the number of commands queued, folded into one
+ * already queued and failed because the queue stayed full since the scheduler
+ * started, the number of commands in the queue now and the most there have
+ * been, and the number of batches the timer service task has taken.
+ */
+#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	void vTimerGetCommandQueueStats( TimerCommandQueueStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -100,6 +100,27 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 }
 /*-----------------------------------------------------------*/
 
+void vListInsertBefore( List_t * const pxList, ListItem_t * const pxPosition, ListItem_t * const pxNewListItem )
+{
+	listTEST_LIST_INTEGRITY( pxList );
+	listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
+
+	pxNewListItem->pxNext = pxPosition;
+	pxNewListItem->pxPrevious = pxPosition->pxPrevious;
+
+	/* Only used during decision coverage testing. */
+	mtCOVERAGE_TEST_DELAY();
+
+	pxPosition->pxPrevious->pxNext = pxNewListItem;
+	pxPosition->pxPrevious = pxNewListItem;
+
+	/* Remember which list the item is in. */
+	pxNewListItem->pxContainer = pxList;
+
+	( pxList->uxNumberOfItems )++;
+}
+/*-----------------------------------------------------------*/
+
 void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
 {
 ListItem_t *pxIterator;
@@ -196,3 +217,266 @@ List_t * const pxList = pxItemToRemove->pxContainer;
 }
 /*-----------------------------------------------------------*/
 
+
+#if( ( configUSE_DELAYED_TASK_WHEEL == 1 ) || ( configUSE_TIMER_WHEEL == 1 ) )
+
+/* Maps the top five bits of ( 2^n * 0x077CB531 ) onto n - see
+prvWheelLowestSetBit(). */
+static const uint8_t ucWheelLowestSetBitTable[ 32 ] =
+{
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+/*
+ * The index of the least significant bit set in ulBitmap, which must not be
+ * zero.  Isolating the bit leaves one of 32 values, which a de Bruijn multiply
+ * maps onto a unique table index - there is no count leading or trailing
+ * zeros instruction on all the processors the kernel runs on.
+ */
+static UBaseType_t prvWheelLowestSetBit( uint32_t ulBitmap );
+
+/*
+ * The number of ticks after the wheel's time at which the wheel next needs to
+ * expire or cascade a slot, or portMAX_DELAY if no slots are occupied.
+ */
+static TickType_t prvWheelTicksToNextEvent( const ListWheel_t * const pxWheel );
+
+/*
+ * Place an item in the slot its item value maps to, relative to the wheel's
+ * time.  Returns pdFALSE if the item expires beyond the last level.
+ */
+static BaseType_t prvWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem );
+
+/*-----------------------------------------------------------*/
+
+void vListWheelInitialise( ListWheel_t * const pxWheel, const TickType_t xTime )
+{
+UBaseType_t uxLevel, uxSlot;
+
+	pxWheel->xTime = xTime;
+
+	for( uxLevel = 0; uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS; uxLevel++ )
+	{
+		pxWheel->ulOccupied[ uxLevel ] = 0UL;
+
+		for( uxSlot = 0; uxSlot < listWHEEL_SLOTS; uxSlot++ )
+		{
+			vListInitialise( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xListWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem, const TickType_t xNow )
+{
+	/* The wheel is only advanced when something is due, so it normally lags
+	xNow.  If nothing is due between the two it can safely be moved to xNow,
+	which extends the reach of the levels as far as possible. */
+	if( prvWheelTicksToNextEvent( pxWheel ) > ( TickType_t ) ( xNow - pxWheel->xTime ) )
+	{
+		pxWheel->xTime = xNow;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return prvWheelInsert( pxWheel, pxNewListItem );
+}
+/*-----------------------------------------------------------*/
+
+List_t * pxListWheelAdvance( ListWheel_t * const pxWheel, const TickType_t xNow )
+{
+TickType_t xTicksToEvent;
+UBaseType_t uxLevel, uxSlot, uxShift;
+List_t *pxSlot;
+ListItem_t *pxItem;
+
+	for( ;; )
+	{
+		xTicksToEvent = prvWheelTicksToNextEvent( pxWheel );
+
+		if( ( xTicksToEvent == portMAX_DELAY ) || ( xTicksToEvent > ( TickType_t ) ( xNow - pxWheel->xTime ) ) )
+		{
+			/* Nothing else is due before xNow. */
+			pxWheel->xTime = xNow;
+			return NULL;
+		}
+
+		if( xTicksToEvent != ( TickType_t ) 0 )
+		{
+			pxWheel->xTime += xTicksToEvent;
+
+			/* Starting from the top level, cascade the slot of every level
+			whose run of ticks starts now.  Each item moves to a lower level,
+			possibly to level 0 if it expires now. */
+			for( uxLevel = ( UBaseType_t ) configLIST_WHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+			{
+				uxShift = uxLevel * listWHEEL_SLOT_BITS;
+
+				if( ( pxWheel->xTime & ( ( ( TickType_t ) 1 << uxShift ) - ( TickType_t ) 1 ) ) == ( TickType_t ) 0 )
+				{
+					uxSlot = ( UBaseType_t ) ( pxWheel->xTime >> uxShift ) & ( listWHEEL_SLOTS - 1U );
+					pxSlot = &( pxWheel->xSlots[ uxLevel ][ uxSlot ] );
+
+					while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+					{
+						pxItem = listGET_HEAD_ENTRY( pxSlot );
+						( void ) uxListRemove( pxItem );
+						( void ) prvWheelInsert( pxWheel, pxItem );
+					}
+
+					pxWheel->ulOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			/* An item was inserted to expire on the tick the wheel had already
+			reached. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The caller empties the level 0 slot of the current tick. */
+		uxSlot = ( UBaseType_t ) pxWheel->xTime & ( listWHEEL_SLOTS - 1U );
+		pxWheel->ulOccupied[ 0 ] &= ~( 1UL << uxSlot );
+		pxSlot = &( pxWheel->xSlots[ 0 ][ uxSlot ] );
+
+		if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			return pxSlot;
+		}
+		else
+		{
+			/* The slot was marked as occupied but its items had since been
+			removed. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xListWheelTicksToNextEvent( const ListWheel_t * const pxWheel, const TickType_t xNow )
+{
+TickType_t xTicksToEvent, xElapsed;
+
+	xTicksToEvent = prvWheelTicksToNextEvent( pxWheel );
+	xElapsed = ( TickType_t ) ( xNow - pxWheel->xTime );
+
+	if( xTicksToEvent == portMAX_DELAY )
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+	else if( xTicksToEvent > xElapsed )
+	{
+		xTicksToEvent -= xElapsed;
+	}
+	else
+	{
+		/* Already due. */
+		xTicksToEvent = ( TickType_t ) 0;
+	}
+
+	return xTicksToEvent;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvWheelLowestSetBit( uint32_t ulBitmap )
+{
+	ulBitmap &= ( uint32_t ) ( ~ulBitmap + 1UL );
+	return ( UBaseType_t ) ucWheelLowestSetBitTable[ ( uint32_t ) ( ulBitmap * 0x077CB531UL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWheelTicksToNextEvent( const ListWheel_t * const pxWheel )
+{
+TickType_t xTicksToEvent = portMAX_DELAY, xTicks, xRun;
+UBaseType_t uxLevel, uxShift, uxCurrent, uxSlots;
+uint32_t ulOccupied;
+
+	for( uxLevel = 0; uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS; uxLevel++ )
+	{
+		ulOccupied = pxWheel->ulOccupied[ uxLevel ];
+
+		if( ulOccupied != 0UL )
+		{
+			uxShift = uxLevel * listWHEEL_SLOT_BITS;
+			uxCurrent = ( UBaseType_t ) ( pxWheel->xTime >> uxShift ) & ( listWHEEL_SLOTS - 1U );
+
+			if( uxLevel == 0U )
+			{
+				/* Rotate so bit 0 is the current tick's slot, then the lowest
+				set bit is the number of ticks to the first item. */
+				if( uxCurrent != 0U )
+				{
+					ulOccupied = ( ulOccupied >> uxCurrent ) | ( ulOccupied << ( listWHEEL_SLOTS - uxCurrent ) );
+				}
+
+				xTicks = ( TickType_t ) prvWheelLowestSetBit( ulOccupied );
+			}
+			else
+			{
+				/* The current slot of this level was cascaded when its run
+				started, so anything in it now belongs to the next revolution.
+				Rotate so bit 0 is the slot after the current one. */
+				uxCurrent = ( uxCurrent + 1U ) & ( listWHEEL_SLOTS - 1U );
+
+				if( uxCurrent != 0U )
+				{
+					ulOccupied = ( ulOccupied >> uxCurrent ) | ( ulOccupied << ( listWHEEL_SLOTS - uxCurrent ) );
+				}
+
+				uxSlots = prvWheelLowestSetBit( ulOccupied ) + 1U;
+
+				/* The slot is cascaded at the start of its run, uxSlots runs of
+				32^uxLevel ticks after the start of the current run. */
+				xRun = ( TickType_t ) 1 << uxShift;
+				xTicks = ( TickType_t ) ( ( ( pxWheel->xTime & ~( xRun - ( TickType_t ) 1 ) ) + ( ( TickType_t ) uxSlots * xRun ) ) - pxWheel->xTime );
+			}
+
+			if( xTicks < xTicksToEvent )
+			{
+				xTicksToEvent = xTicks;
+			}
+		}
+	}
+
+	return xTicksToEvent;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWheelInsert( ListWheel_t * const pxWheel, ListItem_t * const pxNewListItem )
+{
+const TickType_t xTicksToExpire = ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxNewListItem ) - pxWheel->xTime );
+UBaseType_t uxLevel = 0, uxShift = 0, uxSlot;
+BaseType_t xReturn;
+
+	/* Find the lowest level that reaches far enough. */
+	while( ( uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS ) && ( ( xTicksToExpire >> ( uxShift + listWHEEL_SLOT_BITS ) ) != ( TickType_t ) 0 ) )
+	{
+		uxLevel++;
+		uxShift += listWHEEL_SLOT_BITS;
+	}
+
+	if( uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS )
+	{
+		uxSlot = ( UBaseType_t ) ( listGET_LIST_ITEM_VALUE( pxNewListItem ) >> uxShift ) & ( listWHEEL_SLOTS - 1U );
+		vListInsertEnd( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ), pxNewListItem );
+		pxWheel->ulOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_DELAYED_TASK_WHEEL || configUSE_TIMER_WHEEL */
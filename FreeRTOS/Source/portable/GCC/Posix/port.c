@@ -0,0 +1,516 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix (Linux)
+ * host simulator.
+ *
+ * Each task is backed by a pthread.  Only the thread of the task the kernel
+ * has selected is ever allowed to run - every other task thread sits blocked
+ * on its own event until it is switched back in.  SIGALRM, raised by a host
+ * interval timer, plays the part of the tick interrupt, so "disabling
+ * interrupts" blocks SIGALRM in the calling thread.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portNO_CRITICAL_NESTING		( ( uint32_t ) 0 )
+#define portTHREAD_ALIGNMENT		( ( size_t ) 16 )
+
+/*-----------------------------------------------------------*/
+
+/* A binary event used to hand the (single, simulated) processor from one task
+thread to another. */
+typedef struct
+{
+	pthread_mutex_t xMutex;
+	pthread_cond_t xCond;
+	volatile BaseType_t xSignalled;
+} Event_t;
+
+/* The task stack is not used to hold a context in this port.  Instead a
+Thread_t is placed at its top, which maps the task handle onto the pthread
+that executes the task. */
+typedef struct
+{
+	pthread_t xPthread;
+	TaskFunction_t pxCode;
+	void *pvParams;
+	volatile BaseType_t xDying;
+	Event_t xEvent;
+} Thread_t;
+
+/*-----------------------------------------------------------*/
+
+/* The critical nesting count of the task that is currently running.  It is
+saved and restored across every thread switch, so each task effectively has its
+own count.  Initialised to a non zero value so interrupts do not become enabled
+before the first task starts. */
+static volatile uint32_t ulCriticalNesting = 9999UL;
+
+/* Set while the simulated tick interrupt is executing. */
+static volatile BaseType_t xInsideInterrupt = pdFALSE;
+
+/* Set by portYIELD_FROM_ISR() - actioned when the simulated interrupt exits. */
+static volatile BaseType_t xSwitchRequiredFromISR = pdFALSE;
+
+/* The signals that are masked while interrupts are disabled. */
+static sigset_t xInterruptSignals;
+
+/* Used by vPortEndScheduler() to hand control back to the thread that called
+vTaskStartScheduler(). */
+static Event_t xSchedulerEndEvent;
+
+/* Optional board level peripheral model - see portmacro.h. */
+static void ( *pxSimulatedPeripheralsHandler )( void ) = NULL;
+
+/* Pointer to the TCB of the currently executing task. */
+extern void * volatile pxCurrentTCB;
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Maps the top five bits of ( ( 2^(n+1) ) - 1 ) * 0x07C4ACDD onto n - see
+	uxPortGetHighestSetBit() in portmacro.h. */
+	const uint8_t ucPortHighestSetBitTable[ 32 ] =
+	{
+		0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+		8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+	};
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Event helpers.
+ */
+static void prvEventInit( Event_t *pxEvent );
+static void prvEventDelete( Event_t *pxEvent );
+static void prvEventSignal( Event_t *pxEvent );
+static void prvEventWait( Event_t *pxEvent, volatile BaseType_t *pxAbandon );
+
+/*
+ * The entry point of every task thread.  Waits to be switched in for the first
+ * time before calling the task function.
+ */
+static void *prvWaitForStart( void *pvParams );
+
+/*
+ * Suspend the calling task thread and resume another.
+ */
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend );
+
+/*
+ * The simulated tick interrupt.
+ */
+static void prvTimerSignalHandler( int iSignal );
+
+/*
+ * Setup the host timer to generate the tick interrupts.
+ */
+static void prvSetupTimerInterrupt( void );
+static void prvStopTimerInterrupt( void );
+
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( void *pvTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) pvTask;
+
+	/* pxTopOfStack is the first member of the TCB and never moves in this
+	port.  The Thread_t structure sits immediately above it. */
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xThreadAttributes;
+sigset_t xAllSignals, xSavedSignals;
+int iReturned;
+
+	/* Place the Thread_t structure at the top of the task stack. */
+	pxThread = ( Thread_t * ) ( ( ( size_t ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( portTHREAD_ALIGNMENT - 1 ) );
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xDying = pdFALSE;
+	prvEventInit( &( pxThread->xEvent ) );
+
+	/* The thread is created with every signal masked - a new thread inherits
+	the mask of its creator - and unmasks interrupts when it runs for the first
+	time.  The full set is used as xInterruptSignals is not set up until the
+	scheduler starts, after the first tasks have been created. */
+	pthread_attr_init( &xThreadAttributes );
+	pthread_attr_setdetachstate( &xThreadAttributes, PTHREAD_CREATE_JOINABLE );
+
+	sigfillset( &xAllSignals );
+	pthread_sigmask( SIG_SETMASK, &xAllSignals, &xSavedSignals );
+	iReturned = pthread_create( &( pxThread->xPthread ), &xThreadAttributes, prvWaitForStart, pxThread );
+	pthread_sigmask( SIG_SETMASK, &xSavedSignals, NULL );
+
+	pthread_attr_destroy( &xThreadAttributes );
+
+	if( iReturned != 0 )
+	{
+		fprintf( stderr, "pthread_create failed: %s\n", strerror( iReturned ) );
+		abort();
+	}
+
+	return ( ( StackType_t * ) pxThread ) - 1;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xTickAction;
+
+	prvEventInit( &xSchedulerEndEvent );
+
+	sigemptyset( &xInterruptSignals );
+	sigaddset( &xInterruptSignals, SIGALRM );
+
+	/* This thread never runs task code, so keep the simulated interrupts
+	masked here for good. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+
+	memset( &xTickAction, 0, sizeof( xTickAction ) );
+	xTickAction.sa_handler = prvTimerSignalHandler;
+	xTickAction.sa_flags = SA_RESTART;
+	sigfillset( &xTickAction.sa_mask );
+	sigaction( SIGALRM, &xTickAction, NULL );
+
+	/* Start the timer that generates the tick ISR. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	prvEventSignal( &( prvGetThreadFromTask( pxCurrentTCB )->xEvent ) );
+
+	/* Wait until vPortEndScheduler() is called. */
+	prvEventWait( &xSchedulerEndEvent, NULL );
+
+	prvStopTimerInterrupt();
+	prvEventDelete( &xSchedulerEndEvent );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	prvStopTimerInterrupt();
+
+	/* Return to the thread that started the scheduler, then park the calling
+	task thread for good. */
+	prvEventSignal( &xSchedulerEndEvent );
+	prvEventWait( &( prvGetThreadFromTask( pxCurrentTCB )->xEvent ), NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+Thread_t *pxThreadToSuspend;
+
+	vPortEnterCritical();
+	{
+		pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+		vTaskSwitchContext();
+		prvSwitchThread( prvGetThreadFromTask( pxCurrentTCB ), pxThreadToSuspend );
+	}
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	if( xInsideInterrupt != pdFALSE )
+	{
+		/* The switch is performed when the simulated interrupt exits. */
+		xSwitchRequiredFromISR = pdTRUE;
+	}
+	else
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	pthread_sigmask( SIG_UNBLOCK, &xInterruptSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortDisableInterrupts();
+
+	/* Now interrupts are disabled ulCriticalNesting can be accessed
+	directly. */
+	ulCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		/* Decrement the nesting count as we are leaving a critical section. */
+		ulCriticalNesting--;
+
+		/* If the nesting level has reached zero then interrupts should be
+		re-enabled. */
+		if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetSimulatedPeripheralsHandler( void ( *pxHandler )( void ) )
+{
+	pxSimulatedPeripheralsHandler = pxHandler;
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+	( void ) pxPendYield;
+
+	/* The thread exits as soon as it has switched to the next task - see
+	prvSwitchThread(). */
+	prvGetThreadFromTask( pxTaskToDelete )->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+	/* The task is not running, so its thread is either blocked on its event or
+	has already exited.  Wake it with xDying set so it exits, then wait for it
+	before the memory holding the Thread_t is freed. */
+	pxThread->xDying = pdTRUE;
+	prvEventSignal( &( pxThread->xEvent ) );
+	pthread_join( pxThread->xPthread, NULL );
+	prvEventDelete( &( pxThread->xEvent ) );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForStart( void *pvParams )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParams;
+
+	prvEventWait( &( pxThread->xEvent ), &( pxThread->xDying ) );
+
+	/* Switched in for the first time - the task starts with interrupts
+	enabled. */
+	ulCriticalNesting = portNO_CRITICAL_NESTING;
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	/* Tasks must not return. */
+	configASSERT( pdFALSE );
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t *pxThreadToResume, Thread_t *pxThreadToSuspend )
+{
+uint32_t ulSavedCriticalNesting;
+
+	if( pxThreadToResume != pxThreadToSuspend )
+	{
+		/* The critical nesting count belongs to the task, so keep it on the
+		stack of the thread being suspended until it is switched back in. */
+		ulSavedCriticalNesting = ulCriticalNesting;
+
+		prvEventSignal( &( pxThreadToResume->xEvent ) );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+
+		prvEventWait( &( pxThreadToSuspend->xEvent ), &( pxThreadToSuspend->xDying ) );
+
+		ulCriticalNesting = ulSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerSignalHandler( int iSignal )
+{
+Thread_t *pxThreadToSuspend;
+BaseType_t xSwitchRequired;
+
+	( void ) iSignal;
+
+	/* The signal can only be delivered to the thread of the running task, and
+	only while that task has interrupts enabled.  Every signal is masked while
+	the handler executes. */
+	ulCriticalNesting++;
+	xInsideInterrupt = pdTRUE;
+
+	pxThreadToSuspend = prvGetThreadFromTask( pxCurrentTCB );
+
+	/* Increment the tick count - this may make a delayed task ready to run. */
+	xSwitchRequired = xTaskIncrementTick();
+
+	#if( configUSE_PREEMPTION == 0 )
+	{
+		/* The cooperative scheduler only ever switches from the tick if a
+		peripheral handler asked for it. */
+		xSwitchRequired = pdFALSE;
+	}
+	#endif
+
+	if( pxSimulatedPeripheralsHandler != NULL )
+	{
+		pxSimulatedPeripheralsHandler();
+	}
+
+	if( ( xSwitchRequired != pdFALSE ) || ( xSwitchRequiredFromISR != pdFALSE ) )
+	{
+		xSwitchRequiredFromISR = pdFALSE;
+		vTaskSwitchContext();
+	}
+
+	xInsideInterrupt = pdFALSE;
+
+	/* A handler may also have called vTaskSwitchContext() directly, as the
+	ARM7 ISRs do through portEXIT_SWITCHING_ISR(), so always compare with the
+	task that is now selected. */
+	prvSwitchThread( prvGetThreadFromTask( pxCurrentTCB ), pxThreadToSuspend );
+
+	ulCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = ( suseconds_t ) ( 1000000UL / configTICK_RATE_HZ );
+	xTimer.it_value = xTimer.it_interval;
+
+	if( setitimer( ITIMER_REAL, &xTimer, NULL ) != 0 )
+	{
+		perror( "setitimer" );
+		abort();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimerInterrupt( void )
+{
+struct itimerval xTimer;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventInit( Event_t *pxEvent )
+{
+	pthread_mutex_init( &( pxEvent->xMutex ), NULL );
+	pthread_cond_init( &( pxEvent->xCond ), NULL );
+	pxEvent->xSignalled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventDelete( Event_t *pxEvent )
+{
+	pthread_cond_destroy( &( pxEvent->xCond ) );
+	pthread_mutex_destroy( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( Event_t *pxEvent )
+{
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+	pxEvent->xSignalled = pdTRUE;
+	pthread_cond_signal( &( pxEvent->xCond ) );
+	pthread_mutex_unlock( &( pxEvent->xMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( Event_t *pxEvent, volatile BaseType_t *pxAbandon )
+{
+BaseType_t xAbandoned;
+
+	pthread_mutex_lock( &( pxEvent->xMutex ) );
+
+	while( pxEvent->xSignalled == pdFALSE )
+	{
+		pthread_cond_wait( &( pxEvent->xCond ), &( pxEvent->xMutex ) );
+	}
+
+	pxEvent->xSignalled = pdFALSE;
+	xAbandoned = ( pxAbandon != NULL ) ? *pxAbandon : pdFALSE;
+
+	pthread_mutex_unlock( &( pxEvent->xMutex ) );
+
+	if( xAbandoned != pdFALSE )
+	{
+		/* The task was deleted while this thread was waiting. */
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,206 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE size_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32/64-bit host, so reads of the tick count do not
+	need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portINLINE					__inline
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations.  The host has a count leading zeros
+instruction, but the same software bitmap search as the RVDS ARM7_LPC21xx port
+is used so the simulator executes the algorithm the target does. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	/* Set every bit below the most significant set bit, then use a de Bruijn
+	multiply to index a 32 entry table. */
+	extern const uint8_t ucPortHighestSetBitTable[ 32 ];
+
+	static portINLINE UBaseType_t uxPortGetHighestSetBit( uint32_t ulBitmap )
+	{
+		ulBitmap |= ulBitmap >> 1;
+		ulBitmap |= ulBitmap >> 2;
+
+		#if( configMAX_PRIORITIES > 4 )
+			ulBitmap |= ulBitmap >> 4;
+		#endif
+
+		#if( configMAX_PRIORITIES > 8 )
+			ulBitmap |= ulBitmap >> 8;
+		#endif
+
+		#if( configMAX_PRIORITIES > 16 )
+			ulBitmap |= ulBitmap >> 16;
+		#endif
+
+		return ( UBaseType_t ) ucPortHighestSetBitTable[ ( uint32_t ) ( ulBitmap * 0x07C4ACDDUL ) >> 27 ];
+	}
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = uxPortGetHighestSetBit( ( uint32_t ) ( uxReadyPriorities ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/*-----------------------------------------------------------
+ * Scheduler utilities.
+ *
+ * Each task runs in its own pthread, but only the thread of the task selected
+ * by the kernel is ever allowed to run.  The tick is generated by a host
+ * interval timer whose signal plays the role of the tick interrupt.
+ *----------------------------------------------------------*/
+
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portYIELD()					vPortYield()
+#define portYIELD_FROM_ISR( x )		if( ( x ) != pdFALSE ) vPortYieldFromISR()
+#define portEND_SWITCHING_ISR( x )	portYIELD_FROM_ISR( ( x ) )
+
+/* Kept for source compatibility with ISRs written for the ARM7 ports. */
+#define portEXIT_SWITCHING_ISR( x )	portYIELD_FROM_ISR( ( x ) )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  "Interrupts" are the host signals used to
+simulate the tick and peripheral interrupts, so disabling interrupts blocks
+those signals for the calling thread. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+
+#define portDISABLE_INTERRUPTS()	vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()		vPortEnableInterrupts()
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+
+/* Simulated interrupt handlers already run with every simulated interrupt
+masked, so there is nothing further to mask. */
+#define portSET_INTERRUPT_MASK_FROM_ISR()		0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	( void ) ( x )
+/*-----------------------------------------------------------*/
+
+/* Task deletion has to tear down the pthread backing the task. */
+extern void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield );
+extern void vPortCancelThread( void *pxTaskToDelete );
+
+#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield ) vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+#define portCLEAN_UP_TCB( pxTCB )	vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+/*
+ * Install the function the simulated tick interrupt calls once the kernel
+ * tick has been processed.  Board simulations use it to advance their
+ * peripheral models and to call the handlers of any peripheral interrupts
+ * that became pending.  Handlers run in interrupt context - if one of them
+ * selects a different task (for example through portYIELD_FROM_ISR()) the
+ * switch is performed when the simulated interrupt returns.
+ */
+extern void vPortSetSimulatedPeripheralsHandler( void ( *pxHandler )( void ) );
+
+/* Returns pdTRUE when called from within a simulated interrupt. */
+extern BaseType_t xPortIsInsideInterrupt( void );
+/*-----------------------------------------------------------*/
+
+/* Compiler specifics. */
+#define portNOP()	__asm volatile( "nop" )
+
+/* Tasks and simulated interrupts all run on one thread at a time, switched
+through system calls, so stopping the compiler reordering is enough. */
+#define portMEMORY_BARRIER()	__asm volatile( "" ::: "memory" )
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )	void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )	void vFunction( void *pvParameters )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
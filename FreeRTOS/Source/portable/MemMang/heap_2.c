@@ -86,6 +86,9 @@ static BlockLink_t xStart, xEnd;
 /* Keeps track of the number of free bytes remaining, but says nothing about
 fragmentation. */
 static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
 
 /* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
 
@@ -186,6 +189,13 @@ void *pvReturn = NULL;
 				}
 
 				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+
+				xNumberOfSuccessfulAllocations++;
 			}
 		}
 
@@ -227,6 +237,7 @@ BlockLink_t *pxLink;
 			/* Add this block to the list of free blocks. */
 			prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
 			xFreeBytesRemaining += pxLink->xBlockSize;
+			xNumberOfSuccessfulFrees++;
 			traceFREE( pv, pxLink->xBlockSize );
 		}
 		( void ) xTaskResumeAll();
@@ -240,6 +251,12 @@ size_t xPortGetFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -270,3 +287,39 @@ uint8_t *pucAlignedHeap;
 	pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
 }
 /*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		pxBlock = xStart.pxNextFreeBlock;
+
+		/* The free list is ordered by size, so the smallest block is first and
+		the largest last.  pxBlock is NULL if the heap has not been initialised
+		yet. */
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+
+		if( ( pxBlock != NULL ) && ( pxBlock != &xEnd ) )
+		{
+			pxHeapStats->xSizeOfSmallestFreeBlockInBytes = pxBlock->xBlockSize;
+
+			while( pxBlock != &xEnd )
+			{
+				xBlocks++;
+				pxHeapStats->xSizeOfLargestFreeBlockInBytes = pxBlock->xBlockSize;
+				pxBlock = pxBlock->pxNextFreeBlock;
+			}
+		}
+
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+	}
+	( void ) xTaskResumeAll();
+}
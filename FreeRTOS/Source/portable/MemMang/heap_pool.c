@@ -0,0 +1,439 @@
+/*
+ * FreeRTOS Kernel V10.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() with a bounded execution
+ * time, built from a pool of fixed size blocks for each of a small number of
+ * size classes.
+ *
+ * The classes are set in FreeRTOSConfig.h, smallest block first, for example:
+ *
+ *	#define configHEAP_POOL_BLOCK_SIZES		{ 32 * sizeof( void * ), configMINIMAL_STACK_SIZE * sizeof( StackType_t ) }
+ *	#define configHEAP_POOL_BLOCK_COUNTS	{ 12, 6 }
+ *
+ * The blocks of every class are carved out of one array of
+ * configTOTAL_HEAP_SIZE bytes the first time pvPortMalloc() is called.  A
+ * request is served from the smallest class whose blocks are large enough, or
+ * from the next larger class if that one is empty, so the time taken depends
+ * only on the number of classes, never on the allocation history.  Freed blocks
+ * go back to their own class, so the heap cannot fragment - the price is the
+ * space lost rounding each request up to the size of its block.
+ *
+ * vPortGetHeapPoolClassStats() reports the number of blocks of each class ever
+ * in use at once and the requests the class could not serve, from which the
+ * block counts and configTOTAL_HEAP_SIZE can be sized to the application.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if !defined( configHEAP_POOL_BLOCK_SIZES ) || !defined( configHEAP_POOL_BLOCK_COUNTS )
+	#error heap_pool.c requires configHEAP_POOL_BLOCK_SIZES and configHEAP_POOL_BLOCK_COUNTS to be defined in FreeRTOSConfig.h
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* A free block holds the link to the next free block of its class. */
+typedef struct A_POOL_BLOCK
+{
+	struct A_POOL_BLOCK *pxNextFreeBlock;	/*<< The next free block of the same class. */
+} PoolBlock_t;
+
+/* The state of one size class. */
+typedef struct A_POOL_CLASS
+{
+	PoolBlock_t *pxFreeBlocks;		/*<< The free blocks of the class, most recently freed first. */
+	uint8_t *pucStart;				/*<< The first block of the class. */
+	uint8_t *pucEnd;				/*<< One past the last block of the class. */
+	size_t xBlockSize;				/*<< The size of each block, rounded up to portBYTE_ALIGNMENT. */
+	size_t xFreeBlocks;				/*<< The number of blocks in pxFreeBlocks. */
+	size_t xMinimumEverFreeBlocks;	/*<< The lowest xFreeBlocks has been. */
+	size_t xFailedAllocations;		/*<< Requests for this class no class could serve. */
+} PoolClass_t;
+
+static const size_t xClassBlockSizes[] = configHEAP_POOL_BLOCK_SIZES;
+static const size_t xClassBlockCounts[] = configHEAP_POOL_BLOCK_COUNTS;
+
+#define heapNUMBER_OF_CLASSES	( sizeof( xClassBlockSizes ) / sizeof( xClassBlockSizes[ 0 ] ) )
+
+static PoolClass_t xClasses[ heapNUMBER_OF_CLASSES ];
+
+/* Keeps track of the number of free bytes remaining in all the classes
+together, which says nothing about the size of request that can be served. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*
+ * Carves the heap into the blocks of each class before their first use.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Returns the class whose blocks pv lies in, or heapNUMBER_OF_CLASSES if it
+ * lies in none of them.
+ */
+static size_t prvClassOfBlock( const void *pv );
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+PoolClass_t *pxClass;
+PoolBlock_t *pxBlock = NULL;
+size_t xClass, xFirstClass;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to carve out the blocks of each class. */
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+			xHeapHasBeenInitialised = pdTRUE;
+		}
+
+		/* Find the smallest class whose blocks are large enough. */
+		for( xFirstClass = 0; xFirstClass < heapNUMBER_OF_CLASSES; xFirstClass++ )
+		{
+			if( xClasses[ xFirstClass ].xBlockSize >= xWantedSize )
+			{
+				break;
+			}
+		}
+
+		if( ( xWantedSize > 0 ) && ( xFirstClass < heapNUMBER_OF_CLASSES ) )
+		{
+			/* Take a block from that class, or from the next larger class that
+			has one free. */
+			for( xClass = xFirstClass; xClass < heapNUMBER_OF_CLASSES; xClass++ )
+			{
+				pxClass = &( xClasses[ xClass ] );
+
+				if( pxClass->pxFreeBlocks != NULL )
+				{
+					pxBlock = pxClass->pxFreeBlocks;
+					pxClass->pxFreeBlocks = pxBlock->pxNextFreeBlock;
+					pxClass->xFreeBlocks--;
+
+					if( pxClass->xFreeBlocks < pxClass->xMinimumEverFreeBlocks )
+					{
+						pxClass->xMinimumEverFreeBlocks = pxClass->xFreeBlocks;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxClass->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xNumberOfSuccessfulAllocations++;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( pxBlock == NULL )
+			{
+				/* The class the request belongs in, and every larger one, is
+				exhausted. */
+				xClasses[ xFirstClass ].xFailedAllocations++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( ( void * ) pxBlock, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pxBlock == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+PoolClass_t *pxClass;
+PoolBlock_t *pxBlock;
+size_t xClass;
+
+	if( pv != NULL )
+	{
+		xClass = prvClassOfBlock( pv );
+
+		/* The block must have been allocated by pvPortMalloc(). */
+		configASSERT( xClass < heapNUMBER_OF_CLASSES );
+
+		if( xClass < heapNUMBER_OF_CLASSES )
+		{
+			pxClass = &( xClasses[ xClass ] );
+
+			/* This unexpected casting is to keep some compilers from issuing
+			byte alignment warnings. */
+			pxBlock = ( void * ) pv;
+
+			vTaskSuspendAll();
+			{
+				/* A class cannot have more blocks free than it was given, so
+				more would mean a block was freed twice. */
+				configASSERT( pxClass->xFreeBlocks < ( ( size_t ) ( pxClass->pucEnd - pxClass->pucStart ) / pxClass->xBlockSize ) );
+
+				pxBlock->pxNextFreeBlock = pxClass->pxFreeBlocks;
+				pxClass->pxFreeBlocks = pxBlock;
+				pxClass->xFreeBlocks++;
+				xFreeBytesRemaining += pxClass->xBlockSize;
+				xNumberOfSuccessfulFrees++;
+				traceFREE( pv, pxClass->xBlockSize );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetHeapPoolClassCount( void )
+{
+	return ( UBaseType_t ) heapNUMBER_OF_CLASSES;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapPoolClassStats( UBaseType_t uxClass, HeapPoolClassStats_t *pxStats )
+{
+	configASSERT( uxClass < ( UBaseType_t ) heapNUMBER_OF_CLASSES );
+
+	vTaskSuspendAll();
+	{
+		/* Before the first allocation the classes are not carved out yet, so
+		report them from the configuration. */
+		pxStats->xBlockCount = xClassBlockCounts[ uxClass ];
+
+		if( xClasses[ uxClass ].pucStart != NULL )
+		{
+			pxStats->xBlockSize = xClasses[ uxClass ].xBlockSize;
+			pxStats->xFreeBlocks = xClasses[ uxClass ].xFreeBlocks;
+			pxStats->xMinimumEverFreeBlocks = xClasses[ uxClass ].xMinimumEverFreeBlocks;
+		}
+		else
+		{
+			pxStats->xBlockSize = xClassBlockSizes[ uxClass ];
+			pxStats->xFreeBlocks = xClassBlockCounts[ uxClass ];
+			pxStats->xMinimumEverFreeBlocks = xClassBlockCounts[ uxClass ];
+		}
+
+		pxStats->xFailedAllocations = xClasses[ uxClass ].xFailedAllocations;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+size_t xClass, xLargest = 0, xSmallest = ~( ( size_t ) 0 ), xBlocks = 0;
+
+	vTaskSuspendAll();
+	{
+		for( xClass = 0; xClass < heapNUMBER_OF_CLASSES; xClass++ )
+		{
+			if( xClasses[ xClass ].xFreeBlocks > 0U )
+			{
+				xBlocks += xClasses[ xClass ].xFreeBlocks;
+
+				if( xClasses[ xClass ].xBlockSize > xLargest )
+				{
+					xLargest = xClasses[ xClass ].xBlockSize;
+				}
+
+				if( xClasses[ xClass ].xBlockSize < xSmallest )
+				{
+					xSmallest = xClasses[ xClass ].xBlockSize;
+				}
+			}
+		}
+
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xLargest;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks > 0U ) ? xSmallest : 0U;
+		pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvClassOfBlock( const void *pv )
+{
+const uint8_t *puc = ( const uint8_t * ) pv;
+size_t xClass;
+
+	for( xClass = 0; xClass < heapNUMBER_OF_CLASSES; xClass++ )
+	{
+		if( ( puc >= xClasses[ xClass ].pucStart ) && ( puc < xClasses[ xClass ].pucEnd ) )
+		{
+			break;
+		}
+	}
+
+	return xClass;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+PoolClass_t *pxClass;
+PoolBlock_t *pxBlock;
+uint8_t *pucNextBlock;
+size_t xClass, xBlock;
+
+	/* Every block size needs a block count. */
+	configASSERT( sizeof( xClassBlockSizes ) == sizeof( xClassBlockCounts ) );
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	pucNextBlock = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) &ucHeap[ portBYTE_ALIGNMENT ] ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+
+	for( xClass = 0; xClass < heapNUMBER_OF_CLASSES; xClass++ )
+	{
+		pxClass = &( xClasses[ xClass ] );
+
+		/* Each block must be able to hold the free list link, and keep the
+		block after it aligned. */
+		pxClass->xBlockSize = xClassBlockSizes[ xClass ];
+
+		if( pxClass->xBlockSize < sizeof( PoolBlock_t ) )
+		{
+			pxClass->xBlockSize = sizeof( PoolBlock_t );
+		}
+
+		if( ( pxClass->xBlockSize & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			pxClass->xBlockSize += ( portBYTE_ALIGNMENT - ( pxClass->xBlockSize & portBYTE_ALIGNMENT_MASK ) );
+		}
+
+		/* The classes must be listed smallest block first. */
+		configASSERT( ( xClass == 0 ) || ( pxClass->xBlockSize > xClasses[ xClass - 1 ].xBlockSize ) );
+
+		/* configTOTAL_HEAP_SIZE must hold every block of every class. */
+		configASSERT( ( size_t ) ( &ucHeap[ configTOTAL_HEAP_SIZE ] - pucNextBlock ) >= ( pxClass->xBlockSize * xClassBlockCounts[ xClass ] ) );
+
+		pxClass->pucStart = pucNextBlock;
+		pxClass->pxFreeBlocks = NULL;
+
+		/* Link the blocks so the lowest addressed is handed out first. */
+		for( xBlock = xClassBlockCounts[ xClass ]; xBlock > 0; xBlock-- )
+		{
+			pxBlock = ( void * ) ( pucNextBlock + ( ( xBlock - 1 ) * pxClass->xBlockSize ) );
+			pxBlock->pxNextFreeBlock = pxClass->pxFreeBlocks;
+			pxClass->pxFreeBlocks = pxBlock;
+		}
+
+		pucNextBlock += pxClass->xBlockSize * xClassBlockCounts[ xClass ];
+		pxClass->pucEnd = pucNextBlock;
+		pxClass->xFreeBlocks = xClassBlockCounts[ xClass ];
+		pxClass->xMinimumEverFreeBlocks = xClassBlockCounts[ xClass ];
+		xFreeBytesRemaining += pxClass->xBlockSize * xClassBlockCounts[ xClass ];
+	}
+
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,703 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() using two level
+ * segregated fit (TLSF): free blocks are kept on one list for each of a fixed
+ * set of size ranges, and two levels of bitmap record which lists are not
+ * empty, so a free block large enough for a request is found with two bit
+ * scans whatever the state of the heap.  Freed blocks are combined with free
+ * neighbours straight away.  pvPortMalloc() and vPortFree() therefore both
+ * take a bounded time, unlike heap_2.c, heap_4.c and heap_5.c whose free list
+ * walks grow with the number of free blocks.
+ *
+ * The first level splits sizes at powers of two, and the second level splits
+ * each power of two range into 2^tlsfSL_INDEX_COUNT_LOG2 equal parts.  A
+ * request is rounded up to the start of the next second level range, so any
+ * block on the list found is large enough.
+ *
+ * Usage notes:
+ *
+ * The heap can be made up of several non-contiguous regions, defined exactly
+ * as for heap_5.c by passing an array of HeapRegion_t structures, terminated
+ * by a zero sized region, to vPortDefineHeapRegions() before pvPortMalloc() is
+ * first called.  Unlike heap_5.c the regions can be in any address order.
+ *
+ * If vPortDefineHeapRegions() has not been called by then, the heap is a
+ * single configTOTAL_HEAP_SIZE byte array, as with heap_4.c.  Set
+ * configTLSF_DEFAULT_REGION to 0 in FreeRTOSConfig.h to leave that array out
+ * when the regions are always defined.
+ *
+ * No block can be larger than 2^configTLSF_MAX_BLOCK_SIZE_LOG2 bytes, which
+ * also sets the number of free lists, and so the RAM taken by the heap's own
+ * state.  The default of 16 (64 KB blocks) needs 352 bytes on a 32-bit
+ * processor.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configTLSF_DEFAULT_REGION
+	#define configTLSF_DEFAULT_REGION		1
+#endif
+
+#ifndef configTLSF_MAX_BLOCK_SIZE_LOG2
+	#define configTLSF_MAX_BLOCK_SIZE_LOG2	16
+#endif
+
+/* Each power of two range of sizes is split into 2^tlsfSL_INDEX_COUNT_LOG2
+lists. */
+#define tlsfSL_INDEX_COUNT_LOG2		3
+#define tlsfSL_INDEX_COUNT			( 1UL << tlsfSL_INDEX_COUNT_LOG2 )
+
+#if( portBYTE_ALIGNMENT == 16 )
+	#define tlsfALIGN_SIZE_LOG2		4
+#elif( portBYTE_ALIGNMENT == 8 )
+	#define tlsfALIGN_SIZE_LOG2		3
+#elif( portBYTE_ALIGNMENT == 4 )
+	#define tlsfALIGN_SIZE_LOG2		2
+#else
+	#error heap_tlsf.c supports a portBYTE_ALIGNMENT of 4, 8 or 16 only
+#endif
+
+/* Blocks smaller than tlsfSMALL_BLOCK_SIZE all go in first level list 0, split
+linearly into second level lists one alignment unit apart.  Every larger power
+of two range has a first level list of its own. */
+#define tlsfFL_INDEX_SHIFT			( tlsfSL_INDEX_COUNT_LOG2 + tlsfALIGN_SIZE_LOG2 )
+#define tlsfSMALL_BLOCK_SIZE		( ( size_t ) 1 << tlsfFL_INDEX_SHIFT )
+#define tlsfFL_INDEX_COUNT			( configTLSF_MAX_BLOCK_SIZE_LOG2 - tlsfFL_INDEX_SHIFT + 1 )
+#define tlsfMAX_BLOCK_SIZE			( ( size_t ) 1 << configTLSF_MAX_BLOCK_SIZE_LOG2 )
+
+#if( ( configTLSF_MAX_BLOCK_SIZE_LOG2 > 31 ) || ( tlsfFL_INDEX_COUNT < 2 ) )
+	#error configTLSF_MAX_BLOCK_SIZE_LOG2 is out of range
+#endif
+
+/* The low bit of xBlockSize marks a block as free.  Block sizes are multiples
+of portBYTE_ALIGNMENT so the bit is otherwise always clear. */
+#define tlsfBLOCK_FREE_BIT			( ( size_t ) 1 )
+#define tlsfBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~tlsfBLOCK_FREE_BIT )
+#define tlsfBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & tlsfBLOCK_FREE_BIT ) != 0 )
+
+/* The next block in memory.  The last block of every region is followed by a
+zero sized, permanently allocated end marker. */
+#define tlsfNEXT_PHYSICAL_BLOCK( pxBlock )	( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + tlsfBLOCK_SIZE( pxBlock ) ) )
+
+/* Every block, free or allocated, starts with the block in memory before it
+and its own size.  Free blocks also hold their free list links, in the space
+that is handed out when the block is allocated. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPreviousPhysicalBlock;	/*<< The block before this one in memory, or NULL for the first block of a region. */
+	size_t xBlockSize;								/*<< The size of the block, including this header, with tlsfBLOCK_FREE_BIT set while it is free. */
+	struct A_BLOCK_LINK *pxNextFreeBlock;			/*<< The next block on the same free list.  Valid only while free. */
+	struct A_BLOCK_LINK *pxPreviousFreeBlock;		/*<< The previous block on the same free list.  Valid only while free. */
+} BlockLink_t;
+
+/* The part of the header kept when a block is allocated, and the smallest
+block, which must be able to hold the whole header once it is freed. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add the memory in one region to the heap.
+ */
+static size_t prvAddRegion( uint8_t *pucStartAddress, size_t xSizeInBytes );
+
+/*
+ * Map a block size onto the first and second level indexes of the free list
+ * that holds blocks of that size.
+ */
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Map a requested size onto the first free list whose blocks are all at least
+ * that large, and return the first block on that list or a later one, or NULL
+ * if no free block is large enough.
+ */
+static BlockLink_t *prvFindSuitableBlock( size_t xSize );
+
+/*
+ * Add a block to, or remove it from, the free list for its size, keeping the
+ * bitmaps up to date.
+ */
+static void prvInsertFreeBlock( BlockLink_t *pxBlock );
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock );
+
+/*
+ * The index of the most or least significant bit set in a non zero value.
+ */
+static UBaseType_t prvHighestSetBit( uint32_t ulValue );
+static UBaseType_t prvLowestSetBit( uint32_t ulValue );
+
+/*-----------------------------------------------------------*/
+
+#if( configTLSF_DEFAULT_REGION == 1 )
+	/* Allocate the memory for the heap, used if no regions are defined. */
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configTLSF_DEFAULT_REGION */
+
+/* Bit n of ulFirstLevelBitmap is set when any list in pxFreeLists[ n ] is not
+empty, and bit m of ulSecondLevelBitmap[ n ] is set when pxFreeLists[ n ][ m ]
+is not empty. */
+static uint32_t ulFirstLevelBitmap = 0;
+static uint32_t ulSecondLevelBitmap[ tlsfFL_INDEX_COUNT ];
+static BlockLink_t *pxFreeLists[ tlsfFL_INDEX_COUNT ][ tlsfSL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/* Set once a region has been added. */
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Maps the top five bits of ( ( 2^(n+1) ) - 1 ) * 0x07C4ACDD onto n, which
+finds the most significant set bit without a CLZ instruction - see
+uxPortGetHighestSetBit() in the ARM7_LPC21xx port. */
+static const uint8_t ucHighestSetBitTable[ 32 ] =
+{
+	0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+	8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+};
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockLink_t *pxBlock = NULL, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If no regions were defined before the first call to malloc then
+		the heap is the default array. */
+		#if( configTLSF_DEFAULT_REGION == 1 )
+		{
+			if( xHeapHasBeenInitialised == pdFALSE )
+			{
+				( void ) prvAddRegion( ucHeap, configTOTAL_HEAP_SIZE );
+				xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configTLSF_DEFAULT_REGION */
+
+		configASSERT( xHeapHasBeenInitialised != pdFALSE );
+
+		/* The block has to hold the part of the header that is kept while it
+		is allocated, be aligned, and be large enough to hold the whole header
+		again once it is freed. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < tlsfMAX_BLOCK_SIZE ) )
+		{
+			xWantedSize += xHeapStructSize;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxBlock = prvFindSuitableBlock( xWantedSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxBlock != NULL )
+		{
+			prvRemoveFreeBlock( pxBlock );
+
+			/* If the block is larger than required it can be split into two,
+			and the remainder goes straight back on a free list. */
+			if( ( tlsfBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xMinimumBlockSize )
+			{
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+				pxNewBlockLink->xBlockSize = tlsfBLOCK_SIZE( pxBlock ) - xWantedSize;
+				pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+				tlsfNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+				pxBlock->xBlockSize = xWantedSize;
+
+				prvInsertFreeBlock( pxNewBlockLink );
+			}
+			else
+			{
+				/* The whole block is handed out.  Clear the free bit. */
+				pxBlock->xBlockSize = tlsfBLOCK_SIZE( pxBlock );
+			}
+
+			xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+			if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+			{
+				xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+			xNumberOfSuccessfulAllocations++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( !tlsfBLOCK_IS_FREE( pxBlock ) );
+		configASSERT( pxBlock->xBlockSize >= xMinimumBlockSize );
+
+		vTaskSuspendAll();
+		{
+			xFreeBytesRemaining += pxBlock->xBlockSize;
+			traceFREE( pv, pxBlock->xBlockSize );
+			xNumberOfSuccessfulFrees++;
+
+			/* Combine the block with the block before it, if that is free. */
+			pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+
+			if( ( pxNeighbour != NULL ) && tlsfBLOCK_IS_FREE( pxNeighbour ) )
+			{
+				prvRemoveFreeBlock( pxNeighbour );
+				pxNeighbour->xBlockSize = tlsfBLOCK_SIZE( pxNeighbour ) + pxBlock->xBlockSize;
+				pxBlock = pxNeighbour;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* And with the block after it.  The end marker of a region is
+			never free, so this cannot run past the region. */
+			pxNeighbour = tlsfNEXT_PHYSICAL_BLOCK( pxBlock );
+
+			if( tlsfBLOCK_IS_FREE( pxNeighbour ) )
+			{
+				prvRemoveFreeBlock( pxNeighbour );
+				pxBlock->xBlockSize = tlsfBLOCK_SIZE( pxBlock ) + tlsfBLOCK_SIZE( pxNeighbour );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			tlsfNEXT_PHYSICAL_BLOCK( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+			prvInsertFreeBlock( pxBlock );
+		}
+		( void ) xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+const HeapRegion_t *pxHeapRegion;
+size_t xTotalHeapSize = 0;
+
+	/* The regions must all be defined before the first allocation. */
+	configASSERT( xHeapHasBeenInitialised == pdFALSE );
+
+	for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+	{
+		xTotalHeapSize += prvAddRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+	}
+
+	/* Check something was actually defined before it is accessed. */
+	configASSERT( xTotalHeapSize );
+
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock;
+size_t xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	vTaskSuspendAll();
+	{
+		/* The largest free block is on the highest non empty list, and the
+		smallest on the lowest, so only those two lists are walked. */
+		if( ulFirstLevelBitmap != 0 )
+		{
+			uxFirstLevel = prvHighestSetBit( ulFirstLevelBitmap );
+			uxSecondLevel = prvHighestSetBit( ulSecondLevelBitmap[ uxFirstLevel ] );
+
+			for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( tlsfBLOCK_SIZE( pxBlock ) > xMaxSize )
+				{
+					xMaxSize = tlsfBLOCK_SIZE( pxBlock );
+				}
+			}
+
+			uxFirstLevel = prvLowestSetBit( ulFirstLevelBitmap );
+			uxSecondLevel = prvLowestSetBit( ulSecondLevelBitmap[ uxFirstLevel ] );
+
+			for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( tlsfBLOCK_SIZE( pxBlock ) < xMinSize )
+				{
+					xMinSize = tlsfBLOCK_SIZE( pxBlock );
+				}
+			}
+		}
+		else
+		{
+			xMinSize = 0;
+		}
+
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+		pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAddRegion( uint8_t *pucStartAddress, size_t xSizeInBytes )
+{
+size_t xAddress, xRegionEnd;
+BlockLink_t *pxFirstBlock, *pxEndMarker;
+
+	/* Ensure the region starts and ends on a correctly aligned boundary. */
+	xAddress = ( ( size_t ) pucStartAddress + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	xRegionEnd = ( ( size_t ) pucStartAddress + xSizeInBytes ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	/* The region must hold one block and the end marker, and no block can be
+	larger than tlsfMAX_BLOCK_SIZE. */
+	configASSERT( xRegionEnd > ( xAddress + xMinimumBlockSize + xHeapStructSize ) );
+	configASSERT( ( xRegionEnd - xAddress - xHeapStructSize ) < tlsfMAX_BLOCK_SIZE );
+
+	/* The end marker takes the last header's worth of the region.  It is
+	zero sized and never free, so freed blocks are never combined across it. */
+	pxEndMarker = ( BlockLink_t * ) ( xRegionEnd - xHeapStructSize );
+	pxEndMarker->xBlockSize = 0;
+
+	/* To start with there is a single free block in the region that takes up
+	the rest of it. */
+	pxFirstBlock = ( BlockLink_t * ) xAddress;
+	pxFirstBlock->xBlockSize = ( size_t ) pxEndMarker - xAddress;
+	pxFirstBlock->pxPreviousPhysicalBlock = NULL;
+	pxEndMarker->pxPreviousPhysicalBlock = pxFirstBlock;
+
+	xFreeBytesRemaining += pxFirstBlock->xBlockSize;
+	prvInsertFreeBlock( pxFirstBlock );
+	xHeapHasBeenInitialised = pdTRUE;
+
+	return pxFirstBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxHighestBit;
+
+	if( xSize < tlsfSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are spread linearly over the lists of first level 0. */
+		*puxFirstLevel = 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xSize >> tlsfALIGN_SIZE_LOG2 );
+	}
+	else
+	{
+		/* The second level is the tlsfSL_INDEX_COUNT_LOG2 bits below the most
+		significant set bit. */
+		uxHighestBit = prvHighestSetBit( ( uint32_t ) xSize );
+		*puxSecondLevel = ( UBaseType_t ) ( ( xSize >> ( uxHighestBit - tlsfSL_INDEX_COUNT_LOG2 ) ) ^ tlsfSL_INDEX_COUNT );
+		*puxFirstLevel = uxHighestBit - ( tlsfFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvFindSuitableBlock( size_t xSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+BlockLink_t *pxBlock = NULL;
+
+	/* Round the size up to the next list boundary, so every block on the list
+	it maps to is large enough. */
+	if( xSize >= tlsfSMALL_BLOCK_SIZE )
+	{
+		xSize += ( ( size_t ) 1 << ( prvHighestSetBit( ( uint32_t ) xSize ) - tlsfSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel < tlsfFL_INDEX_COUNT )
+	{
+		/* A list in the same power of two range, at or above the one the
+		size maps to... */
+		ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+		if( ulBitmap == 0 )
+		{
+			/* ...or else the smallest list of any larger range. */
+			ulBitmap = ulFirstLevelBitmap & ( ~0UL << ( uxFirstLevel + 1 ) );
+
+			if( ulBitmap != 0 )
+			{
+				uxFirstLevel = prvLowestSetBit( ulBitmap );
+				ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulBitmap != 0 )
+		{
+			uxSecondLevel = prvLowestSetBit( ulBitmap );
+			pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+BlockLink_t *pxHead;
+
+	prvMappingInsert( tlsfBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+	pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPreviousFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBitmap |= ( 1UL << uxFirstLevel );
+	ulSecondLevelBitmap[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+
+	pxBlock->xBlockSize |= tlsfBLOCK_FREE_BIT;
+	xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMappingInsert( tlsfBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of its list.  If the list is now empty
+		clear its bit, and the first level bit if that was the last list of
+		its range. */
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			ulSecondLevelBitmap[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+			if( ulSecondLevelBitmap[ uxFirstLevel ] == 0 )
+			{
+				ulFirstLevelBitmap &= ~( 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxBlock->xBlockSize &= ~tlsfBLOCK_FREE_BIT;
+	xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHighestSetBit( uint32_t ulValue )
+{
+	/* Set every bit below the most significant set bit, which leaves one of
+	only 32 possible values, then map that value onto its index. */
+	ulValue |= ulValue >> 1;
+	ulValue |= ulValue >> 2;
+	ulValue |= ulValue >> 4;
+	ulValue |= ulValue >> 8;
+	ulValue |= ulValue >> 16;
+
+	return ( UBaseType_t ) ucHighestSetBitTable[ ( uint32_t ) ( ulValue * 0x07C4ACDDUL ) >> 27 ];
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLowestSetBit( uint32_t ulValue )
+{
+	/* Isolate the least significant set bit. */
+	return prvHighestSetBit( ulValue & ( ( ~ulValue ) + 1UL ) );
+}
+/*-----------------------------------------------------------*/
@@ -54,6 +54,17 @@
 #define portTIMER_MATCH_ISR_BIT		( ( uint8_t ) 0x01 )
 #define portCLEAR_VIC_INTERRUPT		( ( uint32_t ) 0 )
 
+/* Constants required by the tickless idle implementation. */
+#define portDISABLE_TIMER			( ( uint8_t ) 0x00 )
+#define portPCON_IDLE_MODE			( ( uint8_t ) 0x01 )
+
+/* The number of timer counts lost while timer 0 is stopped to be corrected
+after a tickless idle period.  Found by measurement and only accurate to a few
+counts, as it depends on the compiler settings and memory wait states. */
+#ifndef configSTOPPED_TIMER_COMPENSATION
+	#define configSTOPPED_TIMER_COMPENSATION	( 45UL )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The code generated by the Keil compiler does not maintain separate
@@ -65,11 +76,41 @@ as part of the task context and must be initialised to a non zero value. */
 #define portNO_CRITICAL_NESTING		( ( uint32_t ) 0 )
 volatile uint32_t ulCriticalNesting = 9999UL;
 
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Maps the top five bits of ( ( 2^(n+1) ) - 1 ) * 0x07C4ACDD onto n - see
+	uxPortGetHighestSetBit() in portmacro.h. */
+	const uint8_t ucPortHighestSetBitTable[ 32 ] =
+	{
+		0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+		8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+	};
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+#if configUSE_TICKLESS_IDLE == 1
+
+	/* The number of timer 0 counts that make up one tick period, and the
+	largest number of tick periods the 32-bit timer can be left to count before
+	it must generate an interrupt. */
+	static uint32_t ulTimerCountsForOneTick = 0;
+	static uint32_t xMaximumPossibleSuppressedTicks = 0;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*-----------------------------------------------------------*/
 
 /* Setup the timer to generate the tick interrupts. */
 static void prvSetupTimerInterrupt( void );
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	/* Enter idle mode with the tick suppressed, then correct the tick count
+	and timer 0 once an interrupt ends the sleep. */
+	static void prvSleepAndStepTick( TickType_t xExpectedIdleTime );
+
+#endif
+
 /* 
  * The scheduler can only be started from ARM mode, so 
  * vPortStartFirstSTask() is defined in portISR.c. 
@@ -231,6 +272,13 @@ uint32_t ulCompareMatch;
 
 	T0MR0 = ulCompareMatch;
 
+	#if configUSE_TICKLESS_IDLE == 1
+	{
+		ulTimerCountsForOneTick = ulCompareMatch;
+		xMaximumPossibleSuppressedTicks = 0xffffffffUL / ulCompareMatch;
+	}
+	#endif
+
 	/* Generate tick with timer 0 compare match. */
 	T0MCR = portRESET_COUNT_ON_MATCH | portINTERRUPT_ON_MATCH;
 
@@ -288,4 +336,112 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		/* Make sure the match value does not overflow the counter. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
 
+		/* Interrupts are disabled, rather than a critical section entered, so
+		the processor can still be woken from idle mode by an interrupt that
+		is not then executed until the tick count has been corrected. */
+		__disable_irq();
+
+		/* If a context switch is pending or a task is waiting for the
+		scheduler to be unsuspended then abandon the low power entry. */
+		if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+		{
+			/* Re-enable interrupts - see comments above the __disable_irq()
+			call above. */
+			__enable_irq();
+		}
+		else
+		{
+			/* Timer 0 is left running, and the count within the current tick
+			period is kept, by moving the match forward rather than restarting
+			the timer.  The timer counts up from zero and is reset on the match,
+			so the match is now at the end of the last of the expected idle tick
+			periods. */
+			T0MR0 = ulTimerCountsForOneTick * ( uint32_t ) xExpectedIdleTime;
+
+			if( ( T0IR & portTIMER_MATCH_ISR_BIT ) != 0 )
+			{
+				/* The tick period ended before the match was moved.  The timer
+				has just restarted to count the next one, so put the match back
+				and let the pending tick interrupt execute instead of
+				sleeping. */
+				T0MR0 = ulTimerCountsForOneTick;
+				__enable_irq();
+			}
+			else
+			{
+				prvSleepAndStepTick( xExpectedIdleTime );
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSleepAndStepTick( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulCountsElapsed, ulCompleteTickPeriods;
+	TickType_t xModifiableIdleTime;
+
+		/* Sleep until something happens.  configPRE_SLEEP_PROCESSING() can set
+		its parameter to 0 to indicate that its implementation enters a low
+		power mode itself, and so PCON should not be written.  The processor
+		leaves idle mode on any interrupt enabled in the VIC, even though
+		interrupts are disabled in the CPSR. */
+		xModifiableIdleTime = xExpectedIdleTime;
+		configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+		if( xModifiableIdleTime > 0 )
+		{
+			PCON = portPCON_IDLE_MODE;
+		}
+		configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+		/* Stop timer 0 while the count within the tick period is corrected. */
+		T0TCR = portDISABLE_TIMER;
+		ulCountsElapsed = T0TC + configSTOPPED_TIMER_COMPENSATION;
+
+		if( ( T0IR & portTIMER_MATCH_ISR_BIT ) != 0 )
+		{
+			/* The tick interrupt is pending, and the timer has already been
+			reset to count the tick period that follows the expected idle time.
+			The tick interrupt increments the tick count by one once interrupts
+			are enabled, so step the tick count by one less than the expected
+			idle time. */
+			ulCompleteTickPeriods = ( uint32_t ) xExpectedIdleTime - 1UL;
+		}
+		else
+		{
+			/* Something other than the tick interrupt ended the sleep.  Work
+			out how many complete tick periods passed, and leave the timer part
+			way through the current one. */
+			ulCompleteTickPeriods = ulCountsElapsed / ulTimerCountsForOneTick;
+			ulCountsElapsed -= ulCompleteTickPeriods * ulTimerCountsForOneTick;
+		}
+
+		/* The compensation must not carry the count past the match, which
+		would otherwise not be seen for another 2^32 counts. */
+		if( ulCountsElapsed >= ulTimerCountsForOneTick )
+		{
+			ulCountsElapsed = ulTimerCountsForOneTick - 1UL;
+		}
+
+		T0TC = ulCountsElapsed;
+		T0MR0 = ulTimerCountsForOneTick;
+		T0TCR = portENABLE_TIMER;
+
+		vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+
+		/* Exit with interrupts enabled, so the interrupt that ended the sleep
+		executes. */
+		__enable_irq();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
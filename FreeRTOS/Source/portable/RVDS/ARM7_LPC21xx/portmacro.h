@@ -72,6 +72,55 @@ typedef unsigned long UBaseType_t;
 #define portBYTE_ALIGNMENT			8
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	/* The ARM7TDMI has no CLZ instruction.  Instead every bit below the most
+	significant set bit is set, which leaves one of only 32 possible values,
+	and a de Bruijn multiply maps that value onto a unique index into a 32
+	entry table.  The cost is the same whatever the priority. */
+	extern const uint8_t ucPortHighestSetBitTable[ 32 ];
+
+	static __inline UBaseType_t uxPortGetHighestSetBit( uint32_t ulBitmap )
+	{
+		ulBitmap |= ulBitmap >> 1;
+		ulBitmap |= ulBitmap >> 2;
+
+		#if( configMAX_PRIORITIES > 4 )
+			ulBitmap |= ulBitmap >> 4;
+		#endif
+
+		#if( configMAX_PRIORITIES > 8 )
+			ulBitmap |= ulBitmap >> 8;
+		#endif
+
+		#if( configMAX_PRIORITIES > 16 )
+			ulBitmap |= ulBitmap >> 16;
+		#endif
+
+		return ( UBaseType_t ) ucPortHighestSetBitTable[ ( ulBitmap * 0x07C4ACDDUL ) >> 27 ];
+	}
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = uxPortGetHighestSetBit( ( uxReadyPriorities ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 /* Task utilities. */
 
 /*-----------------------------------------------------------
@@ -96,6 +145,10 @@ extern void vTaskSwitchContext(void);						 \
 extern void vPortYield( void );
 #define portYIELD() vPortYield()
 
+/* Tickless idle - see vPortSuppressTicksAndSleep() in port.c. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
 
 /* Critical section management. */
 
@@ -132,6 +185,10 @@ extern void vPortExitCritical( void );
 #define inline
 #define register
 #define portNOP()	__asm{ NOP }
+
+/* Stops the compiler moving memory accesses across it.  The ARM7 has a single
+core that does not reorder accesses, so nothing more is needed. */
+#define portMEMORY_BARRIER()	__schedule_barrier()
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site. */
@@ -51,6 +51,7 @@ correct privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueLOCK_COUNT_MAX				( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -198,6 +199,35 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy uxItemCount items onto the back of, or off the front of, a queue in at
+ * most two memcpy() calls.  Must be called from a critical section, and the
+ * caller must already have checked that the queue has room for, or contains,
+ * that many items.
+ */
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue, const void *pvItems, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxMaxTasks tasks from an event list of a queue, one for each
+ * item that was posted to or removed from the queue.  Must be called from a
+ * critical section with the queue unlocked.
+ *
+ * @return pdTRUE if any of the unblocked tasks has a priority above that of the
+ * calling task, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockWaitingTasks( List_t * const pxEventList, UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Tell the tasks waiting to receive from a queue, or the queue set the queue is
+ * a member of, that uxItemCount items were just posted to it.  Must be called
+ * from a critical section with the queue unlocked.
+ *
+ * @return pdTRUE if a task with a priority above that of the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+static BaseType_t prvNotifyItemsPosted( Queue_t * const pxQueue, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -1274,6 +1304,220 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsSent;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+	/* Semaphores and mutexes have no items to copy, and giving a mutex has to
+	go through the priority disinheritance in prvCopyDataToQueue(). */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( uxItemCount == ( UBaseType_t ) 0U )
+	{
+		return ( UBaseType_t ) 0U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Is there room for at least one item on the queue now?  As many
+			items as fit are posted together, and the tasks waiting to receive
+			are woken once for the whole batch. */
+			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			{
+				uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+				if( uxItemsSent > uxItemCount )
+				{
+					uxItemsSent = uxItemCount;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceQUEUE_SEND( pxQueue );
+				prvCopyMultipleToQueue( pxQueue, pvItems, uxItemsSent );
+
+				if( prvNotifyItemsPosted( pxQueue, uxItemsSent ) != pdFALSE )
+				{
+					/* One of the unblocked tasks has a priority higher than our
+					own so yield - once, however many were unblocked. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxItemsSent;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was full and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return ( UBaseType_t ) 0U;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The queue was full and a block time was specified so
+					configure the timeout structure. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return ( UBaseType_t ) 0U;
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxItemsSent = 0;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( uxItemCount != ( UBaseType_t ) 0U ) )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+			if( uxItemsSent > uxItemCount )
+			{
+				uxItemsSent = uxItemCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyMultipleToQueue( pxQueue, pvItems, uxItemsSent );
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvNotifyItemsPosted( pxQueue, uxItemsSent ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Add the number of items posted to the lock count so the task
+				that unlocks the queue unblocks a task for each of them.  The
+				count saturates, which at worst leaves a task to time out
+				rather than overflowing into queueUNLOCKED. */
+				if( uxItemsSent > ( UBaseType_t ) ( queueLOCK_COUNT_MAX - cTxLock ) )
+				{
+					pxQueue->cTxLock = queueLOCK_COUNT_MAX;
+				}
+				else
+				{
+					pxQueue->cTxLock = ( int8_t ) ( cTxLock + ( int8_t ) uxItemsSent );
+				}
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
@@ -1873,6 +2117,217 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsReceived;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( ( pxQueue ) );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( uxMaxItems == ( UBaseType_t ) 0U )
+	{
+		return ( UBaseType_t ) 0U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+			/* Is there data in the queue now?  If so remove as much of it as
+			fits in the buffer in one go. */
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				uxItemsReceived = ( uxMessagesWaiting < uxMaxItems ) ? uxMessagesWaiting : uxMaxItems;
+
+				prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemsReceived );
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* There is now space for uxItemsReceived items in the queue, so
+				unblock up to that many of the tasks waiting to post to it. */
+				if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxItemsReceived;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( UBaseType_t ) 0U;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The queue was empty and a block time was specified so
+					configure the timeout structure. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			/* The timeout has not expired.  If the queue is still empty place
+			the task on the list of tasks waiting to receive from the queue. */
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return ( UBaseType_t ) 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxItemsReceived = 0;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+		/* Cannot block in an ISR, so check there is data available. */
+		if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( uxMaxItems != ( UBaseType_t ) 0U ) )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			uxItemsReceived = ( uxMessagesWaiting < uxMaxItems ) ? uxMessagesWaiting : uxMaxItems;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxItemsReceived );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead add to the lock count so the task that unlocks the queue
+			will know how many items an ISR removed while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxItemsReceived ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				if( uxItemsReceived > ( UBaseType_t ) ( queueLOCK_COUNT_MAX - cRxLock ) )
+				{
+					pxQueue->cRxLock = queueLOCK_COUNT_MAX;
+				}
+				else
+				{
+					pxQueue->cRxLock = ( int8_t ) ( cRxLock + ( int8_t ) uxItemsReceived );
+				}
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxItemsReceived;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
 {
 BaseType_t xReturn;
@@ -2168,6 +2623,149 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue, const void *pvItems, const UBaseType_t uxItemCount )
+{
+const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+size_t xFirstBytes;
+
+	/* This function is called from a critical section. */
+
+	/* The items either fit between the write position and the end of the
+	storage area, or wrap round to the start of it. */
+	xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+
+	if( xFirstBytes >= xBytes )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xBytes ); /*lint !e961 !e418 !e9087 Caller ensures pvItems is not NULL. */
+		pxQueue->pcWriteTo += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xFirstBytes ); /*lint !e961 !e418 !e9087 Caller ensures pvItems is not NULL. */
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( ( const int8_t * ) pvItems + xFirstBytes ), xBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 As above. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstBytes ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+
+	pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxItemCount )
+{
+const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+size_t xFirstBytes;
+int8_t *pcReadFrom;
+
+	/* This function is called from a critical section. */
+
+	/* pcReadFrom points to the last item read, so the first item to read is
+	the one after it. */
+	pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+
+	if( xFirstBytes >= xBytes )
+	{
+		( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xBytes ); /*lint !e961 !e418 !e9087 Caller ensures pvBuffer is not NULL. */
+		pcReadFrom += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+	else
+	{
+		( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xFirstBytes ); /*lint !e961 !e418 !e9087 Caller ensures pvBuffer is not NULL. */
+		( void ) memcpy( ( void * ) ( ( int8_t * ) pvBuffer + xFirstBytes ), ( void * ) pxQueue->pcHead, xBytes - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9016 As above. */
+		pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstBytes ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+
+	/* Leave pcReadFrom pointing to the last item read, as
+	prvCopyDataFromQueue() does. */
+	pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+	pxQueue->uxMessagesWaiting -= uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks( List_t * const pxEventList, UBaseType_t uxMaxTasks )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function is called from a critical section. */
+
+	while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxMaxTasks--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyItemsPosted( Queue_t * const pxQueue, const UBaseType_t uxItemCount )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* This function is called from a critical section. */
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+		UBaseType_t uxItem;
+
+			/* A queue set holds one handle for every item in its member
+			queues. */
+			for( uxItem = 0; uxItem < uxItemCount; uxItem++ )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			return xHigherPriorityTaskWoken;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	xHigherPriorityTaskWoken = prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxItemCount );
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -49,23 +49,40 @@ for the header files above, but not in this file, in order to generate the
 correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
 
+/* In the single producer, single consumer mode the writer only ever moves
+xHead, and the reader only ever moves xTail, each with a single word store made
+after the data it covers, so neither masks interrupts to move data.  A task that
+is going to block registers to be woken inside a critical section, after finding
+the data or space it needs is not there, so the other side only needs to lock
+to wake a task that has registered. */
+#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+	#define sbINDEX_BARRIER()					portMEMORY_BARRIER()
+	#define sbTASK_MAY_BE_WAITING( xTask )		prvTaskMayBeWaiting( &( xTask ) )
+#else
+	#define sbINDEX_BARRIER()
+	#define sbTASK_MAY_BE_WAITING( xTask )		( pdTRUE )
+#endif
+
 /* If the user has not provided application specific Rx notification macros,
 or #defined the notification macros away, them provide default implementations
 that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overidden. */
 #ifndef sbRECEIVE_COMPLETED
 	#define sbRECEIVE_COMPLETED( pxStreamBuffer )										\
-		vTaskSuspendAll();																\
+		if( sbTASK_MAY_BE_WAITING( ( pxStreamBuffer )->xTaskWaitingToSend ) )			\
 		{																				\
-			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
+			vTaskSuspendAll();															\
 			{																			\
-				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,			\
-									  ( uint32_t ) 0,									\
-									  eNoAction );										\
-				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
+				if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )					\
+				{																		\
+					( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,		\
+										  ( uint32_t ) 0,								\
+										  eNoAction );									\
+					( pxStreamBuffer )->xTaskWaitingToSend = NULL;						\
+				}																		\
 			}																			\
-		}																				\
-		( void ) xTaskResumeAll();
+			( void ) xTaskResumeAll();													\
+		}
 #endif /* sbRECEIVE_COMPLETED */
 
 #ifndef sbRECEIVE_COMPLETED_FROM_ISR
@@ -74,8 +91,9 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		if( sbTASK_MAY_BE_WAITING( ( pxStreamBuffer )->xTaskWaitingToSend ) )			\
 		{																				\
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();	\
 			if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )						\
 			{																			\
 				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,	\
@@ -84,8 +102,8 @@ that uses task notifications. */
 											 pxHigherPriorityTaskWoken );				\
 				( pxStreamBuffer )->xTaskWaitingToSend = NULL;							\
 			}																			\
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );				\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
 	}
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -94,17 +112,20 @@ or #defined the notification macro away, them provide a default implementation
 that uses task notifications. */
 #ifndef sbSEND_COMPLETED
 	#define sbSEND_COMPLETED( pxStreamBuffer )											\
-		vTaskSuspendAll();																\
+		if( sbTASK_MAY_BE_WAITING( ( pxStreamBuffer )->xTaskWaitingToReceive ) )		\
 		{																				\
-			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
+			vTaskSuspendAll();															\
 			{																			\
-				( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,		\
-									  ( uint32_t ) 0,									\
-									  eNoAction );										\
-				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
+				if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )					\
+				{																		\
+					( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,	\
+										  ( uint32_t ) 0,								\
+										  eNoAction );									\
+					( pxStreamBuffer )->xTaskWaitingToReceive = NULL;					\
+				}																		\
 			}																			\
-		}																				\
-		( void ) xTaskResumeAll();
+			( void ) xTaskResumeAll();													\
+		}
 #endif /* sbSEND_COMPLETED */
 
 #ifndef sbSEND_COMPLETE_FROM_ISR
@@ -112,8 +133,9 @@ that uses task notifications. */
 	{																					\
 	UBaseType_t uxSavedInterruptStatus;													\
 																						\
-		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();		\
+		if( sbTASK_MAY_BE_WAITING( ( pxStreamBuffer )->xTaskWaitingToReceive ) )		\
 		{																				\
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();	\
 			if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )						\
 			{																			\
 				( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,	\
@@ -122,8 +144,8 @@ that uses task notifications. */
 											 pxHigherPriorityTaskWoken );				\
 				( pxStreamBuffer )->xTaskWaitingToReceive = NULL;						\
 			}																			\
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );				\
 		}																				\
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );					\
 	}
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
@@ -135,6 +157,12 @@ that uses task notifications. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
 
+/* With the zero copy API every message is held contiguously, so it can be
+read in place.  A message that would wrap is instead written at the start of
+the buffer, and the bytes left at the end are marked by a length of
+sbMESSAGE_PADDING, which the receive functions skip. */
+#define sbMESSAGE_PADDING	( ( configMESSAGE_BUFFER_LENGTH_TYPE ) ~( ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0 ) )
+
 /*-----------------------------------------------------------*/
 
 /* Structure that hold state information on the buffer. */
@@ -152,6 +180,11 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		size_t xReservedBytes;			/* The bytes last returned by xStreamBufferReserve(), which can be committed. */
+		size_t xReservedPadding;		/* The padding to be written before the reserved message, for message buffers. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -202,6 +235,72 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy xCount bytes starting at xTail to pucData without removing them from
+ * the buffer, and return the index following them.  Data is only ever peeked
+ * this way, never by moving the tail and moving it back, as the writer could
+ * see the space in between.
+ */
+static size_t prvCopyBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer,
+									  uint8_t *pucData,
+									  size_t xCount,
+									  size_t xTail ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	/*
+	 * The number of bytes that must be skipped at the end of the buffer so a
+	 * message of xDataLengthBytes written at the head does not wrap - 0 if it
+	 * does not wrap anyway.
+	 */
+	static size_t prvMessagePadding( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Write the padding, if any, and the length of the next message at the
+	 * head, leaving the head at the start of the message itself.
+	 */
+	static void prvWriteMessageHeader( StreamBuffer_t * const pxStreamBuffer, size_t xPadding, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the padding at the tail, if there is any, and return the bytes
+	 * then left in the buffer.
+	 */
+	static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The work of the zero copy functions, shared by their task and interrupt
+	 * versions.
+	 */
+	static size_t prvReserve( StreamBuffer_t * const pxStreamBuffer, void **ppvData, size_t xWantedBytes, size_t xSpace, size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+	static size_t prvCommit( StreamBuffer_t * const pxStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+	static size_t prvPeekContiguous( StreamBuffer_t * const pxStreamBuffer, const void **ppvData, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+	static size_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The space xStreamBufferSend() or xStreamBufferReserve() wait for.
+	 */
+	static size_t prvRequiredSpace( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+
+	/*
+	 * Whether a task has registered to be woken, read after the index that
+	 * was just moved is stored.
+	 */
+	static BaseType_t prvTaskMayBeWaiting( TaskHandle_t const volatile * pxTask ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Register the calling task to be woken, before it looks again for the
+	 * data or space it is going to wait for.  The other side reads the
+	 * registration only after it has moved its index, so one of the two sees
+	 * the other without either locking.
+	 */
+	static void prvRegisterToWait( TaskHandle_t volatile * pxTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_SPSC */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -526,12 +625,36 @@ TimeOut_t xTimeOut;
 
 		/* Overflow? */
 		configASSERT( xRequiredSpace > xDataLengthBytes );
+
+		#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		{
+			/* The message may have to start at the beginning of the buffer. */
+			xRequiredSpace = prvRequiredSpace( pxStreamBuffer, xDataLengthBytes );
+		}
+		#endif
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+	{
+		/* Only the reader can free space, so if the space is already there
+		it will still be there - there is no need to lock to check it. */
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+		if( xSpace >= xRequiredSpace )
+		{
+			xTicksToWait = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	if( xTicksToWait != ( TickType_t ) 0 )
 	{
 		vTaskSetTimeOutState( &xTimeOut );
@@ -540,26 +663,41 @@ TimeOut_t xTimeOut;
 		{
 			/* Wait until the required number of bytes are free in the message
 			buffer. */
-			taskENTER_CRITICAL();
+			#if( configUSE_STREAM_BUFFER_SPSC == 1 )
 			{
+				prvRegisterToWait( &( pxStreamBuffer->xTaskWaitingToSend ) );
 				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-				if( xSpace < xRequiredSpace )
+				if( xSpace >= xRequiredSpace )
 				{
-					/* Clear notification state as going to wait for space. */
-					( void ) xTaskNotifyStateClear( NULL );
-
-					/* Should only be one writer. */
-					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					pxStreamBuffer->xTaskWaitingToSend = NULL;
+					break;
 				}
-				else
+			}
+			#else
+			{
+				taskENTER_CRITICAL();
 				{
-					taskEXIT_CRITICAL();
-					break;
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
 				}
+				taskEXIT_CRITICAL();
 			}
-			taskEXIT_CRITICAL();
+			#endif
 
 			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
 			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
@@ -626,6 +764,12 @@ size_t xRequiredSpace = xDataLengthBytes;
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 	{
 		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		{
+			xRequiredSpace = prvRequiredSpace( pxStreamBuffer, xDataLengthBytes );
+		}
+		#endif
 	}
 	else
 	{
@@ -688,7 +832,17 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 		into the buffer.  Start by writing the length of the data, the data
 		itself will be written later in this function. */
 		xShouldWrite = pdTRUE;
-		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+		#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		{
+			/* Keep the message contiguous. */
+			prvWriteMessageHeader( pxStreamBuffer, prvMessagePadding( pxStreamBuffer, xDataLengthBytes ), xDataLengthBytes );
+		}
+		#else
+		{
+			( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		#endif
 	}
 	else
 	{
@@ -735,34 +889,79 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesToStoreMessageLength = 0;
 	}
 
+	#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+	{
+		/* Only the writer can add data, so if there is data already there is
+		no need to lock to check it. */
+		if( prvBytesInBuffer( pxStreamBuffer ) > xBytesToStoreMessageLength )
+		{
+			xTicksToWait = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	if( xTicksToWait != ( TickType_t ) 0 )
 	{
-		/* Checking if there is data and clearing the notification state must be
-		performed atomically. */
-		taskENTER_CRITICAL();
+		#if( configUSE_STREAM_BUFFER_SPSC == 1 )
 		{
+			prvRegisterToWait( &( pxStreamBuffer->xTaskWaitingToReceive ) );
 			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
-			/* If this function was invoked by a message buffer read then
-			xBytesToStoreMessageLength holds the number of bytes used to hold
-			the length of the next discrete message.  If this function was
-			invoked by a stream buffer read then xBytesToStoreMessageLength will
-			be 0. */
-			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 			{
-				/* Clear notification state as going to wait for data. */
-				( void ) xTaskNotifyStateClear( NULL );
+				xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+			}
+			#endif
 
-				/* Should only be one reader. */
-				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			if( xBytesAvailable > xBytesToStoreMessageLength )
+			{
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		taskEXIT_CRITICAL();
+		#else
+		{
+			/* Checking if there is data and clearing the notification state
+			must be performed atomically. */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+				{
+					xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+				}
+				#endif
+
+				/* If this function was invoked by a message buffer read then
+				xBytesToStoreMessageLength holds the number of bytes used to
+				hold the length of the next discrete message.  If this function
+				was invoked by a stream buffer read then
+				xBytesToStoreMessageLength will be 0. */
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					/* Clear notification state as going to wait for data. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		#endif
 
 		if( xBytesAvailable <= xBytesToStoreMessageLength )
 		{
@@ -784,6 +983,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 	}
 
+	#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+	{
+		xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+	}
+	#endif
+
 	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
 	holds the number of bytes used to store the message length) or a stream of
 	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
@@ -817,7 +1022,7 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
 {
 StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-size_t xReturn, xBytesAvailable, xOriginalTail;
+size_t xReturn, xBytesAvailable;
 configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 
 	configASSERT( pxStreamBuffer );
@@ -826,18 +1031,21 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
 	{
 		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+		#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+		{
+			xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+		}
+		#endif
+
 		if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
 		{
 			/* The number of bytes available is greater than the number of bytes
 			required to hold the length of the next message, so another message
 			is available.  Return its length without removing the length bytes
-			from the buffer.  A copy of the tail is stored so the buffer can be
-			returned to its prior state as the message is not actually being
-			removed from the buffer. */
-			xOriginalTail = pxStreamBuffer->xTail;
-			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+			from the buffer. */
+			( void ) prvCopyBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
 			xReturn = ( size_t ) xTempReturn;
-			pxStreamBuffer->xTail = xOriginalTail;
 		}
 		else
 		{
@@ -885,6 +1093,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
 	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
+	#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+	{
+		xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+	}
+	#endif
+
 	/* Whether receiving a discrete message (where xBytesToStoreMessageLength
 	holds the number of bytes used to store the message length) or a stream of
 	bytes (where xBytesToStoreMessageLength is zero), the number of bytes
@@ -921,17 +1135,15 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
 										size_t xBytesAvailable,
 										size_t xBytesToStoreMessageLength )
 {
-size_t xOriginalTail, xReceivedLength, xNextMessageLength;
+size_t xNextTail, xReceivedLength, xNextMessageLength;
 configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 
 	if( xBytesToStoreMessageLength != ( size_t ) 0 )
 	{
-		/* A discrete message is being received.  First receive the length
-		of the message.  A copy of the tail is stored so the buffer can be
-		returned to its prior state if the length of the message is too
-		large for the provided buffer. */
-		xOriginalTail = pxStreamBuffer->xTail;
-		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xBytesAvailable );
+		/* A discrete message is being received.  First peek the length of
+		the message.  It is only removed with the message, so stays in the
+		buffer if the message is too large for the provided buffer. */
+		xNextTail = prvCopyBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, pxStreamBuffer->xTail );
 		xNextMessageLength = ( size_t ) xTempNextMessageLength;
 
 		/* Reduce the number of bytes available by the number of bytes just
@@ -943,14 +1155,14 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 		if( xNextMessageLength > xBufferLengthBytes )
 		{
 			/* The user has provided insufficient space to read the message
-			so return the buffer to its previous state (so the length of
-			the message is in the buffer again). */
-			pxStreamBuffer->xTail = xOriginalTail;
+			so leave the buffer as it is. */
 			xNextMessageLength = 0;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			/* Remove the length. */
+			sbINDEX_BARRIER();
+			pxStreamBuffer->xTail = xNextTail;
 		}
 	}
 	else
@@ -1085,6 +1297,649 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvData,
+								 size_t xWantedBytes,
+								 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xSpace = 0, xRequiredSpace;
+	TimeOut_t xTimeOut;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xWantedBytes > ( size_t ) 0 );
+
+		xRequiredSpace = prvRequiredSpace( pxStreamBuffer, xWantedBytes );
+
+		#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+		{
+			/* As xStreamBufferSend(), only lock if there is not the space. */
+			xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+			if( xSpace >= xRequiredSpace )
+			{
+				xTicksToWait = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+
+			/* Wait for space as xStreamBufferSend() does. */
+			do
+			{
+				#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+				{
+					prvRegisterToWait( &( pxStreamBuffer->xTaskWaitingToSend ) );
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace >= xRequiredSpace )
+					{
+						pxStreamBuffer->xTaskWaitingToSend = NULL;
+						break;
+					}
+				}
+				#else
+				{
+					taskENTER_CRITICAL();
+					{
+						xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+						if( xSpace < xRequiredSpace )
+						{
+							( void ) xTaskNotifyStateClear( NULL );
+
+							/* Should only be one writer. */
+							configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+							pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+						}
+						else
+						{
+							taskEXIT_CRITICAL();
+							break;
+						}
+					}
+					taskEXIT_CRITICAL();
+				}
+				#endif
+
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xSpace == ( size_t ) 0 )
+		{
+			xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return prvReserve( pxStreamBuffer, ppvData, xWantedBytes, xSpace, xRequiredSpace );
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvData,
+										size_t xWantedBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+		configASSERT( xWantedBytes > ( size_t ) 0 );
+
+		return prvReserve( pxStreamBuffer, ppvData, xWantedBytes, xStreamBufferSpacesAvailable( pxStreamBuffer ), prvRequiredSpace( pxStreamBuffer, xWantedBytes ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvCommit( pxStreamBuffer, xBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvCommit( pxStreamBuffer, xBytes );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+										const void **ppvData,
+										TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+		{
+			/* As xStreamBufferReceive(), only lock if there is no data. */
+			if( prvBytesInBuffer( pxStreamBuffer ) > xBytesToStoreMessageLength )
+			{
+				xTicksToWait = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			/* Wait for data as xStreamBufferReceive() does. */
+			#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+			{
+				prvRegisterToWait( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+				xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, prvBytesInBuffer( pxStreamBuffer ) );
+
+				if( xBytesAvailable > xBytesToStoreMessageLength )
+				{
+					pxStreamBuffer->xTaskWaitingToReceive = NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+				taskENTER_CRITICAL();
+				{
+					xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, prvBytesInBuffer( pxStreamBuffer ) );
+
+					if( xBytesAvailable <= xBytesToStoreMessageLength )
+					{
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one reader. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+						pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		return prvPeekContiguous( pxStreamBuffer, ppvData, xBytesAvailable );
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferPeekContiguousFromISR( StreamBufferHandle_t xStreamBuffer,
+											   const void **ppvData )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( ppvData );
+		configASSERT( pxStreamBuffer );
+
+		return prvPeekContiguous( pxStreamBuffer, ppvData, prvBytesInBuffer( pxStreamBuffer ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytes )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsume( pxStreamBuffer, xBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn != ( size_t ) 0 )
+		{
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xBytes,
+										BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+
+		configASSERT( pxStreamBuffer );
+
+		xReturn = prvConsume( pxStreamBuffer, xBytes );
+
+		/* Was a task waiting for space in the buffer? */
+		if( xReturn != ( size_t ) 0 )
+		{
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvRequiredSpace( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+	{
+	size_t xRequiredSpace = xDataLengthBytes;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* A message must fit contiguously wherever the head is, so can be
+			at most half the buffer, and its length must not be mistaken for
+			padding. */
+			configASSERT( ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= ( ( pxStreamBuffer->xLength - ( size_t ) 1 ) / ( size_t ) 2 ) );
+			configASSERT( xDataLengthBytes < ( size_t ) sbMESSAGE_PADDING );
+
+			/* The head is only moved by the writer, so the padding needed
+			cannot change while the writer waits for space. */
+			xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH + prvMessagePadding( pxStreamBuffer, xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xRequiredSpace;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvMessagePadding( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+	{
+	size_t xStart, xPadding = 0;
+
+		/* Where the message would start, after its length. */
+		xStart = pxStreamBuffer->xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		/* If the length itself wraps the message starts near the beginning of
+		the buffer, so cannot wrap too.  Otherwise a message that would run
+		off the end is moved to the beginning. */
+		if( ( xStart < pxStreamBuffer->xLength ) && ( ( xStart + xDataLengthBytes ) > pxStreamBuffer->xLength ) )
+		{
+			xPadding = pxStreamBuffer->xLength - pxStreamBuffer->xHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xPadding;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvWriteMessageHeader( StreamBuffer_t * const pxStreamBuffer, size_t xPadding, size_t xDataLengthBytes )
+	{
+	configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+
+		if( xPadding != ( size_t ) 0 )
+		{
+			/* The padding is more than a length long, so the length marking
+			it does not wrap.  The reader ignores the length alone until the
+			head moves on, then sees the padding up to the end. */
+			xLength = sbMESSAGE_PADDING;
+			( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			pxStreamBuffer->xHead = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable )
+	{
+	configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+	size_t xTail;
+
+		if( ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+		{
+			xTail = pxStreamBuffer->xTail;
+
+			/* Padding always runs to the end of the buffer, and is longer than
+			a length, so a length that wraps is never padding. */
+			if( ( pxStreamBuffer->xLength - xTail ) > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+			{
+				( void ) memcpy( ( void * ) &xLength, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), sbBYTES_TO_STORE_MESSAGE_LENGTH ); /*lint !e9087 memcpy() requires void *. */
+
+				if( xLength == sbMESSAGE_PADDING )
+				{
+					xBytesAvailable -= pxStreamBuffer->xLength - xTail;
+					pxStreamBuffer->xTail = 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xBytesAvailable;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvReserve( StreamBuffer_t * const pxStreamBuffer, void **ppvData, size_t xWantedBytes, size_t xSpace, size_t xRequiredSpace )
+	{
+	size_t xReturn = 0, xPadding, xStart;
+
+		*ppvData = NULL;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			/* As much as fits before the end of the buffer - the rest can be
+			reserved at the start once this is committed. */
+			xReturn = configMIN( xWantedBytes, xSpace );
+			xReturn = configMIN( xReturn, pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+			xPadding = 0;
+			xStart = pxStreamBuffer->xHead;
+		}
+		else if( xSpace >= xRequiredSpace )
+		{
+			/* The whole message, which is contiguous. */
+			xReturn = xWantedBytes;
+			xPadding = prvMessagePadding( pxStreamBuffer, xWantedBytes );
+
+			if( xPadding != ( size_t ) 0 )
+			{
+				xStart = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			}
+			else
+			{
+				xStart = pxStreamBuffer->xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+				if( xStart >= pxStreamBuffer->xLength )
+				{
+					xStart -= pxStreamBuffer->xLength;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			/* Not enough space for the message. */
+			xPadding = 0;
+			xStart = 0;
+		}
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			*ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xReservedBytes = xReturn;
+		pxStreamBuffer->xReservedPadding = xPadding;
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvCommit( StreamBuffer_t * const pxStreamBuffer, size_t xBytes )
+	{
+	size_t xNextHead;
+
+		/* Only what was reserved can be committed. */
+		configASSERT( xBytes <= pxStreamBuffer->xReservedBytes );
+		xBytes = configMIN( xBytes, pxStreamBuffer->xReservedBytes );
+
+		if( xBytes > ( size_t ) 0 )
+		{
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				/* A shorter message than was reserved still starts where the
+				reserved one did. */
+				prvWriteMessageHeader( pxStreamBuffer, pxStreamBuffer->xReservedPadding, xBytes );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Moving the head makes the data visible to the reader. */
+			sbINDEX_BARRIER();
+			xNextHead = pxStreamBuffer->xHead + xBytes;
+
+			if( xNextHead >= pxStreamBuffer->xLength )
+			{
+				xNextHead -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxStreamBuffer->xHead = xNextHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xReservedBytes = 0;
+
+		return xBytes;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvPeekContiguous( StreamBuffer_t * const pxStreamBuffer, const void **ppvData, size_t xBytesAvailable )
+	{
+	size_t xReturn = 0, xStart = 0;
+	configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+
+		*ppvData = NULL;
+		xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			/* As much as there is before the end of the buffer - the rest is
+			at the start, and can be peeked once this is consumed. */
+			xStart = pxStreamBuffer->xTail;
+			xReturn = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xStart );
+		}
+		else if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			/* The next message, which is contiguous.  Its length is read
+			without removing it. */
+			xStart = prvCopyBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+			xReturn = ( size_t ) xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			*ppvData = ( const void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xBytes )
+	{
+	size_t xBytesAvailable, xNextTail;
+	configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+
+		xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, prvBytesInBuffer( pxStreamBuffer ) );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+		{
+			configASSERT( xBytes <= xBytesAvailable );
+			xBytes = configMIN( xBytes, xBytesAvailable );
+			xNextTail = pxStreamBuffer->xTail + xBytes;
+		}
+		else if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			/* The whole of the next message is removed, so xBytes must be the
+			length xStreamBufferPeekContiguous() returned. */
+			xNextTail = prvCopyBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+			configASSERT( xBytes == ( size_t ) xLength );
+			xBytes = ( size_t ) xLength;
+			xNextTail += xBytes;
+		}
+		else
+		{
+			xBytes = 0;
+			xNextTail = pxStreamBuffer->xTail;
+		}
+
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Moving the tail frees the space for the writer. */
+		sbINDEX_BARRIER();
+		pxStreamBuffer->xTail = xNextTail;
+
+		return xBytes;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
 {
 size_t xNextHead, xFirstLength;
@@ -1125,6 +1980,8 @@ size_t xNextHead, xFirstLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	/* The data must be in the buffer before the reader can see it. */
+	sbINDEX_BARRIER();
 	pxStreamBuffer->xHead = xNextHead;
 
 	return xCount;
@@ -1133,56 +1990,71 @@ size_t xNextHead, xFirstLength;
 
 static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
 {
-size_t xCount, xFirstLength, xNextTail;
+size_t xCount, xNextTail;
 
 	/* Use the minimum of the wanted bytes and the available bytes. */
 	xCount = configMIN( xBytesAvailable, xMaxCount );
 
 	if( xCount > ( size_t ) 0 )
 	{
-		xNextTail = pxStreamBuffer->xTail;
+		xNextTail = prvCopyBytesFromBuffer( pxStreamBuffer, pucData, xCount, pxStreamBuffer->xTail );
+
+		/* Move the tail pointer to effectively remove the data read from
+		the buffer - only once it has been read, as the writer can then
+		overwrite it. */
+		sbINDEX_BARRIER();
+		pxStreamBuffer->xTail = xNextTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
-		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+	return xCount;
+}
+/*-----------------------------------------------------------*/
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+static size_t prvCopyBytesFromBuffer( const StreamBuffer_t * const pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xTail )
+{
+size_t xFirstLength;
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
-		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+	/* The data is read after the head that showed it was there. */
+	sbINDEX_BARRIER();
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
+	/* Calculate the number of bytes that can be read - which may be less
+	than the number wanted if the data wraps around to the start of the
+	buffer. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
 
-		if( xNextTail >= pxStreamBuffer->xLength )
-		{
-			xNextTail -= pxStreamBuffer->xLength;
-		}
+	/* Obtain the number of bytes it is possible to obtain in the first read.
+	Asserts check bounds of read and write. */
+	configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
+	( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
-		pxStreamBuffer->xTail = xNextTail;
+	/* If the total number of wanted bytes is greater than the number that
+	could be read in the first read... */
+	if( xCount > xFirstLength )
+	{
+		/*...then read the remaining bytes from the start of the buffer. */
+		( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	return xCount;
+	xTail += xCount;
+
+	if( xTail >= pxStreamBuffer->xLength )
+	{
+		xTail -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xTail;
 }
 /*-----------------------------------------------------------*/
 
@@ -1206,6 +2078,47 @@ size_t xCount;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_STREAM_BUFFER_SPSC == 1 )
+
+	static BaseType_t prvTaskMayBeWaiting( TaskHandle_t const volatile * pxTask )
+	{
+	BaseType_t xReturn;
+
+		/* The index is stored before the waiting task is read.  A task that
+		registers after this sees the moved index instead. */
+		sbINDEX_BARRIER();
+
+		if( *pxTask != NULL )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRegisterToWait( TaskHandle_t volatile * pxTask )
+	{
+		/* A notification left from an earlier wait is cleared first.  None
+		can be sent between this and the registration, as the other side
+		only notifies a registered task. */
+		( void ) xTaskNotifyStateClear( NULL );
+
+		/* Should only be one reader and one writer. */
+		configASSERT( *pxTask == NULL );
+		*pxTask = xTaskGetCurrentTaskHandle();
+
+		/* The registration is stored before the index is read again. */
+		sbINDEX_BARRIER();
+	}
+
+#endif /* configUSE_STREAM_BUFFER_SPSC */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  uint8_t * const pucBuffer,
 										  size_t xBufferSizeBytes,
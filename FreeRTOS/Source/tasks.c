@@ -112,6 +112,52 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Tasks that have a period are kept at the front of their ready list, in
+	order of absolute deadline, so the task with the earliest deadline is
+	selected.  Tasks without a period follow, and share the processor as
+	usual when none of those with a period is ready. */
+	#define taskGET_OWNER_OF_READY_ENTRY( pxTCB, pxList )												\
+	{																									\
+		if( ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) )->xPeriod != ( TickType_t ) 0 )		\
+		{																								\
+			( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxList );											\
+		}																								\
+		else																							\
+		{																								\
+			listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), ( pxList ) );										\
+		}																								\
+	}
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB )	prvInsertTaskIntoReadyList( pxTCB )
+
+	/* Deadlines are compared by their difference, so the order is correct
+	across a tick count overflow as long as the deadlines of the ready tasks
+	are within half the range of TickType_t of each other. */
+	#define taskDEADLINE_IS_EARLIER( xDeadline, xOtherDeadline )	( ( TickType_t ) ( ( xDeadline ) - ( xOtherDeadline ) ) > ( portMAX_DELAY >> 1 ) )
+
+	/* A task made ready by an event preempts the running task if it has a
+	higher priority, or the same priority and would be selected ahead of it -
+	it has a period, and the running task either has none or has a later
+	deadline.  Otherwise it would wait for the next tick to be selected. */
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB )																			\
+		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||														\
+		  ( ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) &&													\
+			( ( pxTCB )->xPeriod != ( TickType_t ) 0U ) &&																\
+			( ( pxCurrentTCB->xPeriod == ( TickType_t ) 0U ) ||														\
+			  taskDEADLINE_IS_EARLIER( ( pxTCB )->xAbsoluteDeadline, pxCurrentTCB->xAbsoluteDeadline ) ) ) )
+
+#else
+
+	#define taskGET_OWNER_OF_READY_ENTRY( pxTCB, pxList )	listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), ( pxList ) )
+	#define taskINSERT_INTO_READY_LIST( pxTCB )	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+	#define taskPREEMPTS_CURRENT_TASK( pxTCB )	( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -143,7 +189,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskGET_OWNER_OF_READY_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -173,7 +219,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskGET_OWNER_OF_READY_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -213,12 +259,13 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if
+ * it is scheduled by deadline.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -291,6 +338,15 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		uint32_t		ulSwitchInCount;	/*< Stores the number of times the task has been switched in from another task. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xPeriod;			/*< The time between the releases of the task's jobs.  0 if the task is not scheduled by deadline. */
+		TickType_t		xRelativeDeadline;	/*< The time after its release by which each job must complete. */
+		TickType_t		xReleaseTime;		/*< The tick at which the current job was released. */
+		TickType_t		xAbsoluteDeadline;	/*< The tick by which the current job must complete - orders the ready list. */
+		uint32_t		ulDeadlineMisses;	/*< Stores the number of jobs that completed after their deadline. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -360,6 +416,15 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 #endif
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* Tasks that are due to wake within the reach of the wheel are held in the
+	wheel instead of the delayed lists, so they are added and removed in
+	constant time.  The delayed lists hold the remainder. */
+	PRIVILEGED_DATA static ListWheel_t xDelayedTaskWheel;					/*< Delayed tasks that wake within 32^configLIST_WHEEL_LEVELS ticks. */
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
 the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -534,6 +599,44 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert a task into its ready list: by absolute deadline, ahead of the
+	 * tasks without a period, if it has a period, otherwise at the end.
+	 */
+	static void prvInsertTaskIntoReadyList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/*
+	 * Place the calling task in the delayed task wheel.  Returns pdFALSE,
+	 * without changing anything, if its wake time is beyond the reach of the
+	 * wheel.
+	 */
+	static BaseType_t prvAddCurrentTaskToDelayedTaskWheel( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the tasks whose wake time has been reached from the delayed task
+	 * wheel to the ready lists.  Returns pdTRUE if a context switch is
+	 * required.
+	 */
+	static BaseType_t prvUnblockDelayedTaskWheel( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Bring xNextTaskUnblockTime forward if the delayed task wheel needs to be
+	 * serviced before then.
+	 */
+	static void prvLimitNextTaskUnblockTimeToWheel( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#else
+
+	#define prvAddCurrentTaskToDelayedTaskWheel( xConstTickCount ) pdFALSE
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -964,9 +1067,20 @@ UBaseType_t x;
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
+		pxNewTCB->ulSwitchInCount = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xReleaseTime = ( TickType_t ) 0U;
+		pxNewTCB->xAbsoluteDeadline = ( TickType_t ) 0U;
+		pxNewTCB->ulDeadlineMisses = 0UL;
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1381,6 +1495,148 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+
+		/* A deadline of 0 means the deadline is the end of the period. */
+		if( xRelativeDeadline == ( TickType_t ) 0U )
+		{
+			xRelativeDeadline = xPeriod;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		configASSERT( xRelativeDeadline <= xPeriod );
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the calling task that is
+			being changed. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The first job is released now. */
+			pxTCB->xPeriod = xPeriod;
+			pxTCB->xRelativeDeadline = xRelativeDeadline;
+			pxTCB->xReleaseTime = xTickCount;
+			pxTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+
+			/* A ready task is moved to its new place in the ready list, which
+			may put it ahead of the running task. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( xSchedulerRunning != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskWaitForNextPeriod( void )
+	{
+	TickType_t xSinceRelease;
+	BaseType_t xAlreadyYielded;
+
+		configASSERT( pxCurrentTCB->xPeriod > ( TickType_t ) 0U );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		vTaskSuspendAll();
+		{
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			/* The time since the job that has just completed was released.
+			Measuring from the release keeps the calculation correct when the
+			tick count overflows. */
+			xSinceRelease = xConstTickCount - pxCurrentTCB->xReleaseTime;
+
+			if( xSinceRelease > pxCurrentTCB->xRelativeDeadline )
+			{
+				( pxCurrentTCB->ulDeadlineMisses )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The next job is released one period after the last, as with
+			vTaskDelayUntil(), so the releases do not drift. */
+			pxCurrentTCB->xReleaseTime += pxCurrentTCB->xPeriod;
+			pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xRelativeDeadline;
+
+			if( xSinceRelease < pxCurrentTCB->xPeriod )
+			{
+				traceTASK_DELAY_UNTIL( pxCurrentTCB->xReleaseTime );
+
+				/* prvAddCurrentTaskToDelayedList() needs the block time, not
+				the time to wake, so subtract the current tick count. */
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xReleaseTime - xConstTickCount, pdFALSE );
+			}
+			else
+			{
+				/* The next job has already been released.  The task stays
+				ready, but its place in the ready list follows the new
+				deadline. */
+				( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxCurrentTCB );
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, we may
+		have put ourselves to sleep. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	uint32_t ulTaskGetDeadlineMisses( TaskHandle_t xTask )
+	{
+	TCB_t const *pxTCB;
+
+		/* If null is passed in here then it is the calling task that is
+		being queried. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		return pxTCB->ulDeadlineMisses;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
 	eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -1413,6 +1669,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				eReturn = eBlocked;
 			}
 
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+				else if( listWHEEL_OWNS_LIST( &xDelayedTaskWheel, pxStateList ) )
+				{
+					/* The task being queried is referenced from a slot of the
+					delayed task wheel. */
+					eReturn = eBlocked;
+				}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 				else if( pxStateList == &xSuspendedTaskList )
 				{
@@ -2472,6 +2737,21 @@ TCB_t *pxTCB;
 				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
 			}
 
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				/* Search the slots of the delayed task wheel. */
+				for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+				{
+					for( uxSlot = 0; ( uxSlot < ( UBaseType_t ) listWHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+					{
+						pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel.xSlots[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+					}
+				}
+			}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
 				if( pxTCB == NULL )
@@ -2525,6 +2805,20 @@ TCB_t *pxTCB;
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+				#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+				{
+				UBaseType_t uxLevel, uxSlot;
+
+					for( uxLevel = 0; uxLevel < ( UBaseType_t ) configLIST_WHEEL_LEVELS; uxLevel++ )
+					{
+						for( uxSlot = 0; uxSlot < ( UBaseType_t ) listWHEEL_SLOTS; uxSlot++ )
+						{
+							uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel.xSlots[ uxLevel ][ uxSlot ] ), eBlocked );
+						}
+					}
+				}
+				#endif
+
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
 					/* Fill in an TaskStatus_t structure with information on
@@ -2678,7 +2972,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2813,6 +3107,23 @@ BaseType_t xSwitchRequired = pdFALSE;
 					#endif /* configUSE_PREEMPTION */
 				}
 			}
+
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+				/* The loop above set xNextTaskUnblockTime for the delayed
+				lists alone. */
+				if( prvUnblockDelayedTaskWheel( xConstTickCount ) != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvLimitNextTaskUnblockTimeToWheel( xConstTickCount );
+			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 		}
 
 		/* Tasks of equal priority to the currently running task will share
@@ -2988,6 +3299,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	TCB_t * const pxPreviousTCB = pxCurrentTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -3041,6 +3356,20 @@ void vTaskSwitchContext( void )
 		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		traceTASK_SWITCHED_IN();
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* Only count the selections that change the running task. */
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				pxCurrentTCB->ulSwitchInCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
 		/* After the new task is switched in, update the global errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
@@ -3095,7 +3424,8 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 	list.  It is safe to access the event list here because it is part of an
 	event group implementation - and interrupts don't access event groups
 	directly (instead they access them indirectly by pending function calls to
-	the task level). */
+	the task level), unless configUSE_EVENT_GROUP_DIRECT_ISR_SET is 1, in which
+	case the event group calls this with interrupts disabled. */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3183,7 +3513,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3240,7 +3570,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3251,6 +3581,61 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_DIRECT_ISR_SET == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* Called from an interrupt with interrupts masked.  The event group
+		functions only access their list of waiting tasks with interrupts
+		disabled when this is used, so the event list can be accessed here. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+
+			#if( configUSE_TICKLESS_IDLE != 0 )
+			{
+				/* See xTaskRemoveFromEventList(). */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed.  The item value set above
+			is kept, so the task still knows it was unblocked by its bits. */
+			vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+		}
+
+		if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+
+			/* Mark that a yield is pending in case the caller does not use
+			the "xHigherPriorityTaskWoken" parameter. */
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR_SET */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3629,6 +4014,12 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		vListWheelInitialise( &xDelayedTaskWheel, ( TickType_t ) configINITIAL_TICK_COUNT );
+	}
+	#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
 	using list2. */
 	pxDelayedTaskList = &xDelayedTaskList1;
@@ -3693,10 +4084,22 @@ static void prvCheckTasksWaitingTermination( void )
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
 			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			pxTaskStatus->ulSwitchInCount = pxTCB->ulSwitchInCount;
 		}
 		#else
 		{
 			pxTaskStatus->ulRunTimeCounter = 0;
+			pxTaskStatus->ulSwitchInCount = 0;
+		}
+		#endif
+
+		#if ( configUSE_EDF_SCHEDULING == 1 )
+		{
+			pxTaskStatus->ulDeadlineMisses = pxTCB->ulDeadlineMisses;
+		}
+		#else
+		{
+			pxTaskStatus->ulDeadlineMisses = 0;
 		}
 		#endif
 
@@ -3940,6 +4343,45 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertTaskIntoReadyList( TCB_t * const pxTCB )
+	{
+	List_t * const pxReadyList = &( pxReadyTasksLists[ pxTCB->uxPriority ] );
+	ListItem_t * const pxEnd = ( ListItem_t * ) listGET_END_MARKER( pxReadyList ); /*lint !e9087 The end marker is only used as the position to insert before. */
+	ListItem_t *pxPosition = pxEnd;
+	TCB_t *pxOtherTCB;
+
+		if( pxTCB->xPeriod != ( TickType_t ) 0U )
+		{
+			/* Place the task after the tasks with the same or an earlier
+			deadline, so tasks with equal deadlines are selected in the order
+			they became ready. */
+			for( pxPosition = listGET_HEAD_ENTRY( pxReadyList ); pxPosition != pxEnd; pxPosition = listGET_NEXT( pxPosition ) )
+			{
+				pxOtherTCB = listGET_LIST_ITEM_OWNER( pxPosition ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( ( pxOtherTCB->xPeriod == ( TickType_t ) 0U ) ||
+					( taskDEADLINE_IS_EARLIER( pxTCB->xAbsoluteDeadline, pxOtherTCB->xAbsoluteDeadline ) != pdFALSE ) )
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			/* Tasks without a period go at the very end, never between tasks
+			with a period, so the ordered part of the list stays at the
+			front. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vListInsertBefore( pxReadyList, pxPosition, &( pxTCB->xStateListItem ) );
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -3961,9 +4403,124 @@ TCB_t *pxTCB;
 		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
+
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		prvLimitNextTaskUnblockTimeToWheel( xTickCount );
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static BaseType_t prvAddCurrentTaskToDelayedTaskWheel( const TickType_t xConstTickCount )
+	{
+	BaseType_t xReturn;
+
+		/* The wake time has already been stored in the state list item. */
+		xReturn = xListWheelInsert( &xDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+
+		if( xReturn != pdFALSE )
+		{
+			prvLimitNextTaskUnblockTimeToWheel( xConstTickCount );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static BaseType_t prvUnblockDelayedTaskWheel( const TickType_t xConstTickCount )
+	{
+	List_t *pxExpiredList;
+	TCB_t *pxTCB;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* Every task in an expired slot is due, so the slot is emptied without
+		looking at the wake times of the tasks it holds. */
+		while( ( pxExpiredList = pxListWheelAdvance( &xDelayedTaskWheel, xConstTickCount ) ) != NULL )
+		{
+			while( listLIST_IS_EMPTY( pxExpiredList ) == pdFALSE )
+			{
+				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxExpiredList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from
+				the event list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxTCB );
+
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static void prvLimitNextTaskUnblockTimeToWheel( const TickType_t xConstTickCount )
+	{
+	TickType_t xTicksToNextEvent, xNextEventTime;
+
+		xTicksToNextEvent = xListWheelTicksToNextEvent( &xDelayedTaskWheel, xConstTickCount );
+
+		if( xTicksToNextEvent != portMAX_DELAY )
+		{
+			xNextEventTime = xConstTickCount + xTicksToNextEvent;
+
+			/* An event that falls after the tick count overflows is left until
+			the delayed lists are switched, as xNextTaskUnblockTime is
+			recalculated then. */
+			if( ( xNextEventTime >= xConstTickCount ) && ( xNextEventTime < xNextTaskUnblockTime ) )
+			{
+				xNextTaskUnblockTime = xNextEventTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -4868,7 +5425,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4993,7 +5550,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5081,7 +5638,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5220,7 +5777,13 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-			if( xTimeToWake < xConstTickCount )
+			if( prvAddCurrentTaskToDelayedTaskWheel( xConstTickCount ) != pdFALSE )
+			{
+				/* The wake time is close enough for the task to be held in
+				the delayed task wheel. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
 				list. */
@@ -5256,7 +5819,13 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-		if( xTimeToWake < xConstTickCount )
+		if( prvAddCurrentTaskToDelayedTaskWheel( xConstTickCount ) != pdFALSE )
+		{
+			/* The wake time is close enough for the task to be held in the
+			delayed task wheel. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+		else if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
 			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
@@ -81,6 +81,12 @@ typedef struct tmrTimerControl /* The old naming convention is used to prevent b
 		UBaseType_t			uxTimerNumber;		/*<< An ID assigned by trace tools such as FreeRTOS+Trace */
 	#endif
 	uint8_t 				ucStatus;			/*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+	#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		UBaseType_t			uxLastCommandSent;		/*<< The sequence number of the last command queued for the timer, never 0. */
+		UBaseType_t			uxLastCommandReceived;	/*<< The sequence number of the last command the daemon took for the timer. */
+		UBaseType_t			uxCoalescedCommand;		/*<< The sequence number of the queued start or reset later ones are folded into, or 0. */
+		TickType_t			xCoalescedTime;			/*<< The command time of the last start or reset folded into it. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -96,6 +102,9 @@ typedef struct tmrTimerParameters
 {
 	TickType_t			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
 	Timer_t *			pxTimer;			/*<< The timer to which the command will be applied. */
+	#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		UBaseType_t		uxSequence;			/*<< Matched against the timer's uxCoalescedCommand. */
+	#endif
 } TimerParameter_t;
 
 
@@ -137,10 +146,31 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
+#if( configUSE_TIMER_WHEEL == 1 )
+	/* Active timers that expire within 32^configLIST_WHEEL_LEVELS ticks are
+	held in a timing wheel, which starts, stops and expires them in constant
+	time however many are active.  Only timers that expire further ahead are
+	kept in the two lists above. */
+	PRIVILEGED_DATA static ListWheel_t xTimerWheel;
+#endif
+
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	/* The daemon takes commands from xTimerQueue up to
+	configTIMER_COMMAND_BATCH_SIZE at a time, and works through them from
+	here.  Only the timer service task accesses these. */
+	PRIVILEGED_DATA static DaemonTaskMessage_t xCommandBatch[ configTIMER_COMMAND_BATCH_SIZE ];
+	PRIVILEGED_DATA static UBaseType_t uxCommandBatchNext = 0;
+	PRIVILEGED_DATA static UBaseType_t uxCommandBatchLength = 0;
+
+	/* Returned by vTimerGetCommandQueueStats().  Updated with interrupts
+	masked, as commands are sent from any task or interrupt. */
+	PRIVILEGED_DATA static TimerCommandQueueStats_t xCommandQueueStats = { 0U };
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -174,17 +204,71 @@ static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION
  */
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	/*
+	 * Take the next command from the batch, taking the next batch from
+	 * xTimerQueue when the last one has been worked through.  Returns pdFAIL
+	 * once both are empty.
+	 */
+	static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Fold a start or reset into the one already queued for the same timer, if
+	 * nothing else has been queued for the timer since, and return pdTRUE.
+	 * Otherwise give the command its sequence number and return pdFALSE.
+	 */
+	static BaseType_t prvCoalesceCommand( DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Count a command that has been queued, or that the queue was too full to
+	 * take.  A start or reset that was queued becomes the one later starts and
+	 * resets of the timer are folded into.
+	 */
+	static void prvCommandSent( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xSent, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the daemon for each timer command it processes.  Returns the
+	 * command time of the last start or reset folded into the command, or
+	 * the command's own value.
+	 */
+	static TickType_t prvCommandReceived( const TimerParameter_t * const pxParameters ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_COMMAND_COALESCING */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Add an active timer, whose expiry time has already been set, to the timer
+ * wheel if configUSE_TIMER_WHEEL is 1 and it expires within the wheel's
+ * reach, otherwise to pxList.
+ */
+static void prvAddTimerToActiveList( List_t * const pxList, Timer_t * const pxTimer, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * The timer at the head of the current timer list has reached its expire time,
+ * and so has any timer in the timer wheel that is due by xTimeNow.  Expire them.
+ */
+static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Expire every timer in the timer wheel that is due by xTimeNow.
+	 */
+	static void prvProcessTimerWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
@@ -369,6 +453,14 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		{
+			pxNewTimer->uxLastCommandSent = 0U;
+			pxNewTimer->uxLastCommandReceived = 0U;
+			pxNewTimer->uxCoalescedCommand = 0U;
+			pxNewTimer->xCoalescedTime = 0U;
+		}
+		#endif
 		if( uxAutoReload != pdFALSE )
 		{
 			pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -394,6 +486,18 @@ DaemonTaskMessage_t xMessage;
 		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
 		xMessage.u.xTimerParameters.pxTimer = xTimer;
 
+		#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		{
+			/* A start or reset that finds one still queued for the timer
+			only has to update its command time. */
+			if( prvCoalesceCommand( &xMessage, ( BaseType_t ) ( xCommandID >= tmrFIRST_FROM_ISR_COMMAND ) ) != pdFALSE )
+			{
+				traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, pdPASS );
+				return pdPASS;
+			}
+		}
+		#endif /* configUSE_TIMER_COMMAND_COALESCING */
+
 		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 		{
 			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
@@ -410,6 +514,12 @@ DaemonTaskMessage_t xMessage;
 			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 		}
 
+		#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		{
+			prvCommandSent( &xMessage, xReturn, ( BaseType_t ) ( xCommandID >= tmrFIRST_FROM_ISR_COMMAND ) );
+		}
+		#endif /* configUSE_TIMER_COMMAND_COALESCING */
+
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
 	else
@@ -505,12 +615,72 @@ Timer_t *pxTimer = xTimer;
 /*-----------------------------------------------------------*/
 
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+		/* xNextExpireTime may have come from the wheel or from the list, so
+		both are checked. */
+		( void ) xNextExpireTime;
+
+		prvProcessTimerWheel( xTimeNow );
+
+		if( ( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList ) <= xTimeNow ) )
+		{
+			prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList ), xTimeNow ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* A check has already been performed to ensure the list is not
+		empty. */
+		prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), xNextExpireTime, xTimeNow ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	static void prvProcessTimerWheel( const TickType_t xTimeNow )
+	{
+	List_t xExpiredTimers;
+	List_t *pxSlot;
+	Timer_t *pxTimer;
+
+		vListInitialise( &xExpiredTimers );
+
+		while( ( pxSlot = pxListWheelAdvance( &xTimerWheel, xTimeNow ) ) != NULL )
+		{
+			/* Every timer in an expired slot is due.  They are moved out of the
+			slot before any is expired, as an auto-reload timer can be put back
+			into the same slot if the daemon is running late. */
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				vListInsertEnd( &xExpiredTimers, &( pxTimer->xTimerListItem ) );
+			}
+
+			while( listLIST_IS_EMPTY( &xExpiredTimers ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimers ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				prvExpireTimer( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ), xTimeNow );
+			}
+		}
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
+	/* Remove the timer from the list of active timers. */
 	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
@@ -521,11 +691,11 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 		/* The timer is inserted into a list using a time relative to anything
 		other than the current time.  It will therefore be inserted into the
 		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+		if( prvInsertTimerInActiveList( pxTimer, ( xExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpireTime ) != pdFALSE )
 		{
 			/* The timer expired before it was added to the active timer
 			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xExpireTime, NULL, tmrNO_DELAY );
 			configASSERT( xResult );
 			( void ) xResult;
 		}
@@ -615,6 +785,21 @@ BaseType_t xTimerListsWereSwitched;
 					/* The current timer list is empty - is the overflow list
 					also empty? */
 					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+
+					#if( configUSE_TIMER_WHEEL == 1 )
+					{
+						/* The wheel may hold a timer that expires after the
+						tick count overflows. */
+						if( xListWheelTicksToNextEvent( &xTimerWheel, xTimeNow ) != portMAX_DELAY )
+						{
+							xListWasEmpty = pdFALSE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_TIMER_WHEEL */
 				}
 
 				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
@@ -663,6 +848,35 @@ TickType_t xNextExpireTime;
 		xNextExpireTime = ( TickType_t ) 0U;
 	}
 
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+	TickType_t xTimeNow, xTicksToEvent;
+
+		/* The wheel is next due when it next has to expire or cascade a slot.
+		A time after the tick count overflows is left until the overflow, when
+		it is found again. */
+		xTimeNow = xTaskGetTickCount();
+		xTicksToEvent = xListWheelTicksToNextEvent( &xTimerWheel, xTimeNow );
+
+		if( ( xTicksToEvent != portMAX_DELAY ) && ( ( TickType_t ) ( xTimeNow + xTicksToEvent ) >= xTimeNow ) )
+		{
+			if( ( *pxListWasEmpty != pdFALSE ) || ( ( TickType_t ) ( xTimeNow + xTicksToEvent ) < xNextExpireTime ) )
+			{
+				xNextExpireTime = xTimeNow + xTicksToEvent;
+				*pxListWasEmpty = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+
 	return xNextExpireTime;
 }
 /*-----------------------------------------------------------*/
@@ -709,7 +923,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			prvAddTimerToActiveList( pxOverflowTimerList, pxTimer, xTimeNow );
 		}
 	}
 	else
@@ -723,7 +937,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			prvAddTimerToActiveList( pxCurrentTimerList, pxTimer, xTimeNow );
 		}
 	}
 
@@ -731,6 +945,30 @@ BaseType_t xProcessTimerNow = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+static void prvAddTimerToActiveList( List_t * const pxList, Timer_t * const pxTimer, const TickType_t xTimeNow )
+{
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+		/* The wheel works on the difference between the expiry time and the
+		time now, so it holds timers either side of a tick count overflow. */
+		if( xListWheelInsert( &xTimerWheel, &( pxTimer->xTimerListItem ), xTimeNow ) == pdFALSE )
+		{
+			vListInsert( pxList, &( pxTimer->xTimerListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		( void ) xTimeNow;
+		vListInsert( pxList, &( pxTimer->xTimerListItem ) );
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
@@ -738,7 +976,11 @@ Timer_t *pxTimer;
 BaseType_t xTimerListsWereSwitched, xResult;
 TickType_t xTimeNow;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		while( prvReceiveCommand( &xMessage ) != pdFAIL )
+	#else
+		while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	#endif
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
@@ -780,6 +1022,14 @@ TickType_t xTimeNow;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+			{
+				/* Use the time of the last start or reset folded into this
+				one. */
+				xMessage.u.xTimerParameters.xMessageValue = prvCommandReceived( &( xMessage.u.xTimerParameters ) );
+			}
+			#endif /* configUSE_TIMER_COMMAND_COALESCING */
+
 			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
 
 			/* In this case the xTimerListsWereSwitched parameter is not used, but
@@ -879,6 +1129,211 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage )
+	{
+	BaseType_t xReturn = pdFAIL;
+
+		if( uxCommandBatchNext == uxCommandBatchLength )
+		{
+			/* One call for up to a whole batch, rather than one per command. */
+			uxCommandBatchNext = 0U;
+			uxCommandBatchLength = xQueueReceiveMultiple( xTimerQueue, xCommandBatch, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE, tmrNO_DELAY );
+
+			if( uxCommandBatchLength > 0U )
+			{
+				taskENTER_CRITICAL();
+				{
+					xCommandQueueStats.uxBatches++;
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCommandBatchNext < uxCommandBatchLength )
+		{
+			*pxMessage = xCommandBatch[ uxCommandBatchNext ];
+			uxCommandBatchNext++;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCoalesceCommand( DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR )
+	{
+	Timer_t * const pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+	const BaseType_t xCommandID = pxMessage->xMessageID;
+	BaseType_t xCoalesced = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus = 0U;
+
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+		}
+		{
+			/* Only a start or reset can be folded, and only into the last
+			command queued for the timer, which the daemon has not taken yet
+			(it clears uxCoalescedCommand when it does).  The command times of
+			a start and of a reset are used in the same way. */
+			if( ( ( xCommandID == tmrCOMMAND_START ) || ( xCommandID == tmrCOMMAND_RESET ) ||
+				  ( xCommandID == tmrCOMMAND_START_FROM_ISR ) || ( xCommandID == tmrCOMMAND_RESET_FROM_ISR ) ) &&
+				( pxTimer->uxCoalescedCommand != 0U ) &&
+				( pxTimer->uxCoalescedCommand == pxTimer->uxLastCommandSent ) )
+			{
+				pxTimer->xCoalescedTime = pxMessage->u.xTimerParameters.xMessageValue;
+				xCommandQueueStats.uxCommandsCoalesced++;
+				xCoalesced = pdTRUE;
+			}
+			else
+			{
+				/* The sequence number is taken before the command is queued,
+				so the daemon can never see a command with a later number than
+				uxLastCommandSent.  0 is never used. */
+				pxTimer->uxLastCommandSent++;
+
+				if( pxTimer->uxLastCommandSent == 0U )
+				{
+					pxTimer->uxLastCommandSent = 1U;
+				}
+
+				pxMessage->u.xTimerParameters.uxSequence = pxTimer->uxLastCommandSent;
+			}
+		}
+		if( xFromISR != pdFALSE )
+		{
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskEXIT_CRITICAL();
+		}
+
+		return xCoalesced;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCommandSent( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xSent, const BaseType_t xFromISR )
+	{
+	Timer_t * const pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+	const BaseType_t xCommandID = pxMessage->xMessageID;
+	const UBaseType_t uxSequence = pxMessage->u.xTimerParameters.uxSequence;
+	UBaseType_t uxSavedInterruptStatus = 0U, uxDepth;
+
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			uxDepth = uxQueueMessagesWaitingFromISR( xTimerQueue );
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			uxDepth = uxQueueMessagesWaiting( xTimerQueue );
+		}
+		{
+			if( xSent != pdFAIL )
+			{
+				xCommandQueueStats.uxCommandsSent++;
+
+				if( uxDepth > xCommandQueueStats.uxQueueHighWaterMark )
+				{
+					xCommandQueueStats.uxQueueHighWaterMark = uxDepth;
+				}
+
+				/* The timer is only accessed again for a start or reset - any
+				other command may have been a delete the daemon has already
+				processed.  Later starts and resets can be folded into this one
+				if it is still the last command queued for the timer, and the
+				daemon has not taken it yet. */
+				if( ( ( xCommandID == tmrCOMMAND_START ) || ( xCommandID == tmrCOMMAND_RESET ) ||
+					  ( xCommandID == tmrCOMMAND_START_FROM_ISR ) || ( xCommandID == tmrCOMMAND_RESET_FROM_ISR ) ) &&
+					( pxTimer->uxLastCommandSent == uxSequence ) &&
+					( pxTimer->uxLastCommandReceived != uxSequence ) )
+				{
+					pxTimer->uxCoalescedCommand = uxSequence;
+					pxTimer->xCoalescedTime = pxMessage->u.xTimerParameters.xMessageValue;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xCommandQueueStats.uxCommandsDropped++;
+			}
+		}
+		if( xFromISR != pdFALSE )
+		{
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskEXIT_CRITICAL();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvCommandReceived( const TimerParameter_t * const pxParameters )
+	{
+	Timer_t * const pxTimer = pxParameters->pxTimer;
+	TickType_t xCommandTime = pxParameters->xMessageValue;
+
+		taskENTER_CRITICAL();
+		{
+			pxTimer->uxLastCommandReceived = pxParameters->uxSequence;
+
+			if( pxTimer->uxCoalescedCommand == pxParameters->uxSequence )
+			{
+				/* Nothing more can be folded into this command. */
+				xCommandTime = pxTimer->xCoalescedTime;
+				pxTimer->uxCoalescedCommand = 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xCommandTime;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTimerGetCommandQueueStats( TimerCommandQueueStats_t *pxStats )
+	{
+		configASSERT( pxStats );
+		configASSERT( xTimerQueue );
+
+		taskENTER_CRITICAL();
+		{
+			*pxStats = xCommandQueueStats;
+			pxStats->uxQueueDepth = uxQueueMessagesWaiting( xTimerQueue );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_COMMAND_COALESCING */
+/*-----------------------------------------------------------*/
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -952,6 +1407,12 @@ static void prvCheckForValidListAndQueue( void )
 			pxCurrentTimerList = &xActiveTimerList1;
 			pxOverflowTimerList = &xActiveTimerList2;
 
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				vListWheelInitialise( &xTimerWheel, xTaskGetTickCount() );
+			}
+			#endif
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* The timer queue is allocated statically in case
@@ -0,0 +1,234 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+	BINARY TRACE RECORDER.
+
+	Include this file at the end of FreeRTOSConfig.h to define the kernel trace
+	hooks.  Each hook writes one eight byte record, stamped with the timer 1
+	count, into a RAM ring buffer.  vTraceRecorderStart() creates a task that
+	drains the ring buffer over UART1 in frames, and Tools/trace_decode.c turns
+	a capture of those frames into a Chrome trace (chrome://tracing or
+	https://ui.perfetto.dev).
+
+	A record is written, and made visible to the drain task, without a
+	critical section, so the hooks can be called from tasks and interrupts
+	alike.  When the drain task falls behind the oldest records are
+	overwritten, and the number lost is reported in the next frame.
+
+	The part of this file above traceRECORDER_HOST_DECODER describes the
+	format on the wire and is shared with the host decoder.
+*/
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+/*-----------------------------------------------------------
+ * Wire format.  All fields are little endian.
+ *----------------------------------------------------------*/
+
+/* Every frame starts with this header, then usRecords records. */
+#define traceFRAME_SYNC					( 0x31435254UL )	/* "TRC1". */
+#define traceFRAME_HEADER_BYTES			( 12 )
+#define traceRECORD_BYTES				( 8 )
+
+typedef struct TRACE_FRAME_HEADER
+{
+	uint32_t ulSync;			/* traceFRAME_SYNC. */
+	uint32_t ulTimestampHz;		/* The rate at which the timestamps count. */
+	uint16_t usRecords;			/* The number of records that follow. */
+	uint16_t usDropped;			/* The number of records overwritten before they could be sent, since the last frame. */
+} TraceFrameHeader_t;
+
+typedef struct TRACE_RECORD
+{
+	uint32_t ulTimestamp;		/* T1TC when the event occurred.  Four characters of the name for traceEVENT_TASK_NAME. */
+	uint8_t ucEvent;			/* One of the traceEVENT_ values below.  Zero until the record is complete. */
+	uint8_t ucObject;			/* The number of the task or queue the event relates to. */
+	uint16_t usParam;			/* Event specific, see below. */
+} TraceRecord_t;
+
+/* Event codes.  Tasks are identified by the kernel's TCB number and queues by
+a number the recorder assigns when the queue is created.  The events written
+from an interrupt have FROM_ISR in their name. */
+#define traceEVENT_NONE							( 0x00 )
+#define traceEVENT_TASK_SWITCHED_IN				( 0x01 )	/* Param: priority.  Only when the running task changes. */
+#define traceEVENT_TASK_CREATE					( 0x02 )	/* Param: priority. */
+#define traceEVENT_TASK_NAME					( 0x03 )	/* Param: offset of the four characters in the name. */
+#define traceEVENT_TASK_DELETE					( 0x04 )
+#define traceEVENT_TASK_DELAY					( 0x05 )	/* Param: ticks to delay. */
+#define traceEVENT_TASK_DELAY_UNTIL				( 0x06 )	/* Param: low 16 bits of the wake time. */
+#define traceEVENT_TASK_SUSPEND					( 0x07 )
+#define traceEVENT_TASK_RESUME					( 0x08 )
+#define traceEVENT_TASK_RESUME_FROM_ISR			( 0x09 )
+#define traceEVENT_TASK_READY					( 0x0a )
+#define traceEVENT_TASK_PRIORITY_SET			( 0x0b )	/* Param: new priority. */
+#define traceEVENT_TASK_NOTIFY					( 0x0c )	/* Param: eNotifyAction. */
+#define traceEVENT_TASK_NOTIFY_FROM_ISR			( 0x0d )	/* Param: eNotifyAction. */
+#define traceEVENT_TASK_NOTIFY_GIVE_FROM_ISR	( 0x0e )
+#define traceEVENT_TASK_NOTIFY_TAKE				( 0x0f )
+#define traceEVENT_TASK_NOTIFY_TAKE_BLOCK		( 0x10 )
+#define traceEVENT_TASK_NOTIFY_WAIT				( 0x11 )
+#define traceEVENT_TASK_NOTIFY_WAIT_BLOCK		( 0x12 )
+#define traceEVENT_TASK_INCREMENT_TICK			( 0x13 )	/* Param: low 16 bits of the tick count. */
+#define traceEVENT_QUEUE_CREATE					( 0x20 )	/* Param: queue type. */
+#define traceEVENT_QUEUE_DELETE					( 0x21 )
+#define traceEVENT_QUEUE_SEND					( 0x22 )	/* Param, for all queue events: messages waiting. */
+#define traceEVENT_QUEUE_SEND_FAILED			( 0x23 )
+#define traceEVENT_QUEUE_SEND_FROM_ISR			( 0x24 )
+#define traceEVENT_QUEUE_SEND_FROM_ISR_FAILED	( 0x25 )
+#define traceEVENT_QUEUE_RECEIVE				( 0x26 )
+#define traceEVENT_QUEUE_RECEIVE_FAILED			( 0x27 )
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR		( 0x28 )
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED	( 0x29 )
+#define traceEVENT_QUEUE_PEEK					( 0x2a )
+#define traceEVENT_BLOCKING_ON_QUEUE_SEND		( 0x2b )
+#define traceEVENT_BLOCKING_ON_QUEUE_RECEIVE	( 0x2c )
+#define traceEVENT_BLOCKING_ON_QUEUE_PEEK		( 0x2d )
+#define traceEVENT_LOW_POWER_IDLE_BEGIN			( 0x30 )
+#define traceEVENT_LOW_POWER_IDLE_END			( 0x31 )
+
+#ifndef traceRECORDER_HOST_DECODER
+
+/*-----------------------------------------------------------
+ * Recorder configuration.  Each can be set in FreeRTOSConfig.h before this
+ * file is included.
+ *----------------------------------------------------------*/
+
+#if( configUSE_TRACE_FACILITY != 1 )
+	#error The trace recorder needs configUSE_TRACE_FACILITY to be set to 1 in FreeRTOSConfig.h, for the task and queue numbers.
+#endif
+
+/* The number of records the ring buffer holds.  Must be a power of two. */
+#ifndef traceRECORDER_BUFFER_RECORDS
+	#define traceRECORDER_BUFFER_RECORDS	( 128UL )
+#endif
+
+#if( ( traceRECORDER_BUFFER_RECORDS & ( traceRECORDER_BUFFER_RECORDS - 1UL ) ) != 0 )
+	#error traceRECORDER_BUFFER_RECORDS must be a power of two.
+#endif
+
+/* The timestamp source and its rate.  The default is timer 1 as set up by
+configTimer1() in main.c. */
+#ifndef traceRECORDER_TIMESTAMP
+	#define traceRECORDER_TIMESTAMP()		( ( uint32_t ) T1TC )
+	#define traceRECORDER_TIMESTAMP_HZ		( 1000000UL )
+#endif
+
+/* The baud rate of UART1, used to pace the drain task. */
+#ifndef traceRECORDER_BAUD_RATE
+	#define traceRECORDER_BAUD_RATE			( 115200UL )
+#endif
+
+/* Set to 1 to record every tick interrupt, which at 1kHz uses most of the
+bandwidth of the UART. */
+#ifndef traceRECORDER_RECORD_TICKS
+	#define traceRECORDER_RECORD_TICKS		0
+#endif
+
+/* Set to 0 to leave out the tickless idle hooks.  A port without tickless
+idle support calls them in a busy loop from the idle task. */
+#ifndef traceRECORDER_RECORD_LOW_POWER
+	#define traceRECORDER_RECORD_LOW_POWER	1
+#endif
+
+/*-----------------------------------------------------------
+ * API.
+ *----------------------------------------------------------*/
+
+/*
+ * Creates the task that drains the ring buffer over UART1.  The hooks record
+ * from the start, so nothing is lost if this is called just before the
+ * scheduler is started.  UART1 must not be used for anything else.
+ */
+void vTraceRecorderStart( unsigned long ulPriority );
+
+/*
+ * Write a record.  Called by the hooks below, and can be called by the
+ * application to mark events of its own with codes from 0x80 up.
+ */
+void vTraceRecord( uint8_t ucEvent, uint8_t ucObject, uint16_t usParam );
+
+/*
+ * Used by the context switch, task creation and queue creation hooks.
+ */
+void vTraceRecordTaskSwitchedIn( uint8_t ucTask, uint16_t usPriority );
+void vTraceRecordTaskCreate( uint8_t ucTask, uint16_t usPriority, const char *pcName );
+uint8_t ucTraceRecordQueueCreate( uint8_t ucQueueType );
+
+/*-----------------------------------------------------------
+ * Kernel trace hooks.
+ *----------------------------------------------------------*/
+
+#define traceRECORD( ucEvent, uxObject, uxParam ) vTraceRecord( ( uint8_t ) ( ucEvent ), ( uint8_t ) ( uxObject ), ( uint16_t ) ( uxParam ) )
+
+#define traceTASK_SWITCHED_IN()						vTraceRecordTaskSwitchedIn( ( uint8_t ) pxCurrentTCB->uxTCBNumber, ( uint16_t ) pxCurrentTCB->uxPriority )
+#define traceTASK_CREATE( pxNewTCB )				vTraceRecordTaskCreate( ( uint8_t ) ( pxNewTCB )->uxTCBNumber, ( uint16_t ) ( pxNewTCB )->uxPriority, ( pxNewTCB )->pcTaskName )
+#define traceTASK_DELETE( pxTCB )					traceRECORD( traceEVENT_TASK_DELETE, ( pxTCB )->uxTCBNumber, 0 )
+#define traceTASK_DELAY()							traceRECORD( traceEVENT_TASK_DELAY, pxCurrentTCB->uxTCBNumber, xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )		traceRECORD( traceEVENT_TASK_DELAY_UNTIL, pxCurrentTCB->uxTCBNumber, ( xTimeToWake ) )
+#define traceTASK_SUSPEND( pxTCB )					traceRECORD( traceEVENT_TASK_SUSPEND, ( pxTCB )->uxTCBNumber, 0 )
+#define traceTASK_RESUME( pxTCB )					traceRECORD( traceEVENT_TASK_RESUME, ( pxTCB )->uxTCBNumber, 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTCB )			traceRECORD( traceEVENT_TASK_RESUME_FROM_ISR, ( pxTCB )->uxTCBNumber, 0 )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )		traceRECORD( traceEVENT_TASK_READY, ( pxTCB )->uxTCBNumber, ( pxTCB )->uxPriority )
+#define traceTASK_PRIORITY_SET( pxTCB, uxNewPriority )	traceRECORD( traceEVENT_TASK_PRIORITY_SET, ( pxTCB )->uxTCBNumber, ( uxNewPriority ) )
+#define traceTASK_NOTIFY()							traceRECORD( traceEVENT_TASK_NOTIFY, pxTCB->uxTCBNumber, eAction )
+#define traceTASK_NOTIFY_FROM_ISR()					traceRECORD( traceEVENT_TASK_NOTIFY_FROM_ISR, pxTCB->uxTCBNumber, eAction )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()			traceRECORD( traceEVENT_TASK_NOTIFY_GIVE_FROM_ISR, pxTCB->uxTCBNumber, 0 )
+#define traceTASK_NOTIFY_TAKE()						traceRECORD( traceEVENT_TASK_NOTIFY_TAKE, pxCurrentTCB->uxTCBNumber, 0 )
+#define traceTASK_NOTIFY_TAKE_BLOCK()				traceRECORD( traceEVENT_TASK_NOTIFY_TAKE_BLOCK, pxCurrentTCB->uxTCBNumber, 0 )
+#define traceTASK_NOTIFY_WAIT()						traceRECORD( traceEVENT_TASK_NOTIFY_WAIT, pxCurrentTCB->uxTCBNumber, 0 )
+#define traceTASK_NOTIFY_WAIT_BLOCK()				traceRECORD( traceEVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB->uxTCBNumber, 0 )
+
+#if( traceRECORDER_RECORD_TICKS == 1 )
+	#define traceTASK_INCREMENT_TICK( xTickCount )	traceRECORD( traceEVENT_TASK_INCREMENT_TICK, 0, ( xTickCount ) )
+#endif
+
+#define traceQUEUE_CREATE( pxNewQueue )				( pxNewQueue )->uxQueueNumber = ( UBaseType_t ) ucTraceRecordQueueCreate( ( pxNewQueue )->ucQueueType )
+#define traceQUEUE_DELETE( pxQueue )				traceRECORD( traceEVENT_QUEUE_DELETE, ( pxQueue )->uxQueueNumber, 0 )
+#define traceQUEUE_SEND( pxQueue )					traceRECORD( traceEVENT_QUEUE_SEND, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )			traceRECORD( traceEVENT_QUEUE_SEND_FAILED, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )			traceRECORD( traceEVENT_QUEUE_SEND_FROM_ISR, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )	traceRECORD( traceEVENT_QUEUE_SEND_FROM_ISR_FAILED, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )				traceRECORD( traceEVENT_QUEUE_RECEIVE, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )		traceRECORD( traceEVENT_QUEUE_RECEIVE_FAILED, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )		traceRECORD( traceEVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )	traceRECORD( traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_PEEK( pxQueue )					traceRECORD( traceEVENT_QUEUE_PEEK, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )		traceRECORD( traceEVENT_BLOCKING_ON_QUEUE_SEND, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	traceRECORD( traceEVENT_BLOCKING_ON_QUEUE_RECEIVE, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )		traceRECORD( traceEVENT_BLOCKING_ON_QUEUE_PEEK, ( pxQueue )->uxQueueNumber, ( pxQueue )->uxMessagesWaiting )
+
+#if( traceRECORDER_RECORD_LOW_POWER == 1 )
+	#define traceLOW_POWER_IDLE_BEGIN()				traceRECORD( traceEVENT_LOW_POWER_IDLE_BEGIN, 0, 0 )
+	#define traceLOW_POWER_IDLE_END()				traceRECORD( traceEVENT_LOW_POWER_IDLE_END, 0, 0 )
+#endif
+
+#endif /* traceRECORDER_HOST_DECODER */
+
+#endif /* TRACE_RECORDER_H */
+
@@ -0,0 +1,321 @@
+/*
+ * Host (Linux) stand-in for the Keil LPC21xx.H register header.
+ *
+ * The application sources include "lpc21xx.h" and access the on-chip
+ * peripherals by register name.  On the host those names map onto a software
+ * model of the LPC2129 (see lpc21xx_sim.c):
+ *
+ *  - registers without side effects are plain variables;
+ *  - registers whose access has a side effect in hardware (UART data and
+ *    status, GPIO set/clear, timer counters, ...) go through an accessor that
+ *    brings the model up to date and returns the storage the access should
+ *    use.  Every access evaluates the register name exactly once, so read,
+ *    write and read-modify-write statements all behave as on the target.
+ *
+ * Only the peripherals used by the applications are modelled: the VIC, pin
+ * select, GPIO ports 0 and 1, UART0/UART1, Timer0/Timer1 and the system
+ * control registers.
+ */
+
+#ifndef __LPC21xx_H
+#define __LPC21xx_H
+
+/*-----------------------------------------------------------*/
+/* Peripheral models. */
+
+typedef struct
+{
+	volatile unsigned long ulIRQStatus;
+	volatile unsigned long ulFIQStatus;
+	volatile unsigned long ulRawIntr;
+	volatile unsigned long ulIntSelect;
+	volatile unsigned long ulIntEnable;
+	volatile unsigned long ulIntEnClr;
+	volatile unsigned long ulSoftInt;
+	volatile unsigned long ulSoftIntClr;
+	volatile unsigned long ulProtection;
+	volatile unsigned long ulVectAddr;
+	volatile unsigned long ulDefVectAddr;
+	volatile unsigned long ulVectAddrN[ 16 ];
+	volatile unsigned long ulVectCntlN[ 16 ];
+} SimVic_t;
+
+typedef struct
+{
+	volatile unsigned long ulPIN;
+	volatile unsigned long ulSET;
+	volatile unsigned long ulDIR;
+	volatile unsigned long ulCLR;
+
+	/* Model state. */
+	unsigned long ulOutput;
+	unsigned long ulInput;
+	unsigned long ulLastPIN;
+} SimGpio_t;
+
+#define simUART_FIFO_DEPTH		16
+
+typedef struct
+{
+	volatile unsigned long ulRBR;
+	volatile unsigned long ulTHR[ simUART_FIFO_DEPTH ];
+	volatile unsigned long ulIER;
+	volatile unsigned long ulIIR;
+	volatile unsigned long ulFCR;
+	volatile unsigned long ulLCR;
+	volatile unsigned long ulMCR;
+	volatile unsigned long ulLSR;
+	volatile unsigned long ulMSR;
+	volatile unsigned long ulSCR;
+	volatile unsigned long ulDLL;
+	volatile unsigned long ulDLM;
+	volatile unsigned long ulOverrun;
+
+	/* Model state. */
+	unsigned long ulTxHead;
+	unsigned long ulTxCount;
+	unsigned char ucRxFifo[ simUART_FIFO_DEPTH ];
+	unsigned long ulRxHead;
+	unsigned long ulRxCount;
+	unsigned long ulRxTriggerLevel;
+	unsigned long ulBitBudget;
+	long lThreInterruptPending;
+	long lRxTimeoutPending;
+	unsigned long ulVicChannel;
+	int iTxFd;
+	int iRxFd;
+} SimUart_t;
+
+typedef struct
+{
+	volatile unsigned long ulIR;
+	volatile unsigned long ulTCR;
+	volatile unsigned long ulTC;
+	volatile unsigned long ulPR;
+	volatile unsigned long ulPC;
+	volatile unsigned long ulMCR;
+	volatile unsigned long ulMR[ 4 ];
+	volatile unsigned long ulCCR;
+	volatile unsigned long ulCR[ 4 ];
+	volatile unsigned long ulEMR;
+
+	/* Model state. */
+	unsigned long long ullLastNs;
+	unsigned long long ullNsRemainder;
+	unsigned long ulLastTC;
+	unsigned long ulMatchedTC;
+	unsigned long ulVicChannel;
+} SimTimer_t;
+
+typedef struct
+{
+	volatile unsigned long ulPINSEL0;
+	volatile unsigned long ulPINSEL1;
+	volatile unsigned long ulPINSEL2;
+	volatile unsigned long ulMAMCR;
+	volatile unsigned long ulMAMTIM;
+	volatile unsigned long ulPLLCON;
+	volatile unsigned long ulPLLCFG;
+	volatile unsigned long ulPLLSTAT;
+	volatile unsigned long ulPLLFEED;
+	volatile unsigned long ulPCON;
+	volatile unsigned long ulPCONP;
+	volatile unsigned long ulVPBDIV;
+	volatile unsigned long ulEXTINT;
+	volatile unsigned long ulEXTWAKE;
+	volatile unsigned long ulEXTMODE;
+	volatile unsigned long ulEXTPOLAR;
+} SimSystem_t;
+
+extern SimVic_t xSimVic;
+extern SimGpio_t xSimGpio[ 2 ];
+extern SimUart_t xSimUart[ 2 ];
+extern SimTimer_t xSimTimer[ 2 ];
+extern SimSystem_t xSimSystem;
+
+/* Accessors for the registers that have side effects. */
+extern volatile unsigned long *pulSimVicIntEnClr( void );
+extern volatile unsigned long *pulSimGpioPIN( unsigned long ulPort );
+extern volatile unsigned long *pulSimGpioSET( unsigned long ulPort );
+extern volatile unsigned long *pulSimGpioCLR( unsigned long ulPort );
+extern volatile unsigned long *pulSimUartRBR( unsigned long ulUart );
+extern volatile unsigned long *pulSimUartTHR( unsigned long ulUart );
+extern volatile unsigned long *pulSimUartIIR( unsigned long ulUart );
+extern volatile unsigned long *pulSimUartFCR( unsigned long ulUart );
+extern volatile unsigned long *pulSimUartLSR( unsigned long ulUart );
+extern volatile unsigned long *pulSimTimerTCR( unsigned long ulTimer );
+extern volatile unsigned long *pulSimTimerTC( unsigned long ulTimer );
+extern volatile unsigned long *pulSimTimerPC( unsigned long ulTimer );
+
+/*
+ * Drive the level of an input pin, as an external circuit (a push button for
+ * example) would.  ulPin is the bit number within the port.
+ */
+extern void vSimSetPinInput( unsigned long ulPort, unsigned long ulPin, unsigned long ulLevel );
+
+/*
+ * Read back the level the chip is driving onto an output pin.
+ */
+extern unsigned long ulSimGetPinOutput( unsigned long ulPort, unsigned long ulPin );
+
+/*
+ * Connect the transmitter and receiver of a UART to host file descriptors.
+ * Pass -1 to leave either side disconnected.  UART1 defaults to stdout/stdin,
+ * UART0 is disconnected.
+ */
+extern void vSimConnectUart( unsigned long ulUart, int iTxFd, int iRxFd );
+
+/*-----------------------------------------------------------*/
+/* Vectored Interrupt Controller (VIC). */
+
+#define VICIRQStatus   (xSimVic.ulIRQStatus)
+#define VICFIQStatus   (xSimVic.ulFIQStatus)
+#define VICRawIntr     (xSimVic.ulRawIntr)
+#define VICIntSelect   (xSimVic.ulIntSelect)
+#define VICIntEnable   (xSimVic.ulIntEnable)
+#define VICIntEnClr    (*pulSimVicIntEnClr())
+#define VICSoftInt     (xSimVic.ulSoftInt)
+#define VICSoftIntClr  (xSimVic.ulSoftIntClr)
+#define VICProtection  (xSimVic.ulProtection)
+#define VICVectAddr    (xSimVic.ulVectAddr)
+#define VICDefVectAddr (xSimVic.ulDefVectAddr)
+#define VICVectAddr0   (xSimVic.ulVectAddrN[ 0 ])
+#define VICVectAddr1   (xSimVic.ulVectAddrN[ 1 ])
+#define VICVectAddr2   (xSimVic.ulVectAddrN[ 2 ])
+#define VICVectAddr3   (xSimVic.ulVectAddrN[ 3 ])
+#define VICVectAddr4   (xSimVic.ulVectAddrN[ 4 ])
+#define VICVectAddr5   (xSimVic.ulVectAddrN[ 5 ])
+#define VICVectAddr6   (xSimVic.ulVectAddrN[ 6 ])
+#define VICVectAddr7   (xSimVic.ulVectAddrN[ 7 ])
+#define VICVectAddr8   (xSimVic.ulVectAddrN[ 8 ])
+#define VICVectAddr9   (xSimVic.ulVectAddrN[ 9 ])
+#define VICVectAddr10  (xSimVic.ulVectAddrN[ 10 ])
+#define VICVectAddr11  (xSimVic.ulVectAddrN[ 11 ])
+#define VICVectAddr12  (xSimVic.ulVectAddrN[ 12 ])
+#define VICVectAddr13  (xSimVic.ulVectAddrN[ 13 ])
+#define VICVectAddr14  (xSimVic.ulVectAddrN[ 14 ])
+#define VICVectAddr15  (xSimVic.ulVectAddrN[ 15 ])
+#define VICVectCntl0   (xSimVic.ulVectCntlN[ 0 ])
+#define VICVectCntl1   (xSimVic.ulVectCntlN[ 1 ])
+#define VICVectCntl2   (xSimVic.ulVectCntlN[ 2 ])
+#define VICVectCntl3   (xSimVic.ulVectCntlN[ 3 ])
+#define VICVectCntl4   (xSimVic.ulVectCntlN[ 4 ])
+#define VICVectCntl5   (xSimVic.ulVectCntlN[ 5 ])
+#define VICVectCntl6   (xSimVic.ulVectCntlN[ 6 ])
+#define VICVectCntl7   (xSimVic.ulVectCntlN[ 7 ])
+#define VICVectCntl8   (xSimVic.ulVectCntlN[ 8 ])
+#define VICVectCntl9   (xSimVic.ulVectCntlN[ 9 ])
+#define VICVectCntl10  (xSimVic.ulVectCntlN[ 10 ])
+#define VICVectCntl11  (xSimVic.ulVectCntlN[ 11 ])
+#define VICVectCntl12  (xSimVic.ulVectCntlN[ 12 ])
+#define VICVectCntl13  (xSimVic.ulVectCntlN[ 13 ])
+#define VICVectCntl14  (xSimVic.ulVectCntlN[ 14 ])
+#define VICVectCntl15  (xSimVic.ulVectCntlN[ 15 ])
+
+/*-----------------------------------------------------------*/
+/* Pin Connect Block. */
+
+#define PINSEL0        (xSimSystem.ulPINSEL0)
+#define PINSEL1        (xSimSystem.ulPINSEL1)
+#define PINSEL2        (xSimSystem.ulPINSEL2)
+
+/*-----------------------------------------------------------*/
+/* General Purpose Input/Output (GPIO). */
+
+#define IOPIN0         (*pulSimGpioPIN( 0 ))
+#define IOSET0         (*pulSimGpioSET( 0 ))
+#define IODIR0         (xSimGpio[ 0 ].ulDIR)
+#define IOCLR0         (*pulSimGpioCLR( 0 ))
+#define IOPIN1         (*pulSimGpioPIN( 1 ))
+#define IOSET1         (*pulSimGpioSET( 1 ))
+#define IODIR1         (xSimGpio[ 1 ].ulDIR)
+#define IOCLR1         (*pulSimGpioCLR( 1 ))
+
+/*-----------------------------------------------------------*/
+/* Memory Accelerator Module (MAM), PLL, power and VPB control. */
+
+#define MAMCR          (xSimSystem.ulMAMCR)
+#define MAMTIM         (xSimSystem.ulMAMTIM)
+#define PLLCON         (xSimSystem.ulPLLCON)
+#define PLLCFG         (xSimSystem.ulPLLCFG)
+#define PLLSTAT        (xSimSystem.ulPLLSTAT)
+#define PLLFEED        (xSimSystem.ulPLLFEED)
+#define PCON           (xSimSystem.ulPCON)
+#define PCONP          (xSimSystem.ulPCONP)
+#define VPBDIV         (xSimSystem.ulVPBDIV)
+#define EXTINT         (xSimSystem.ulEXTINT)
+#define EXTWAKE        (xSimSystem.ulEXTWAKE)
+#define EXTMODE        (xSimSystem.ulEXTMODE)
+#define EXTPOLAR       (xSimSystem.ulEXTPOLAR)
+
+/*-----------------------------------------------------------*/
+/* Timer 0. */
+
+#define T0IR           (xSimTimer[ 0 ].ulIR)
+#define T0TCR          (*pulSimTimerTCR( 0 ))
+#define T0TC           (*pulSimTimerTC( 0 ))
+#define T0PR           (xSimTimer[ 0 ].ulPR)
+#define T0PC           (*pulSimTimerPC( 0 ))
+#define T0MCR          (xSimTimer[ 0 ].ulMCR)
+#define T0MR0          (xSimTimer[ 0 ].ulMR[ 0 ])
+#define T0MR1          (xSimTimer[ 0 ].ulMR[ 1 ])
+#define T0MR2          (xSimTimer[ 0 ].ulMR[ 2 ])
+#define T0MR3          (xSimTimer[ 0 ].ulMR[ 3 ])
+#define T0CCR          (xSimTimer[ 0 ].ulCCR)
+#define T0CR0          (xSimTimer[ 0 ].ulCR[ 0 ])
+#define T0CR1          (xSimTimer[ 0 ].ulCR[ 1 ])
+#define T0CR2          (xSimTimer[ 0 ].ulCR[ 2 ])
+#define T0CR3          (xSimTimer[ 0 ].ulCR[ 3 ])
+#define T0EMR          (xSimTimer[ 0 ].ulEMR)
+
+/*-----------------------------------------------------------*/
+/* Timer 1. */
+
+#define T1IR           (xSimTimer[ 1 ].ulIR)
+#define T1TCR          (*pulSimTimerTCR( 1 ))
+#define T1TC           (*pulSimTimerTC( 1 ))
+#define T1PR           (xSimTimer[ 1 ].ulPR)
+#define T1PC           (*pulSimTimerPC( 1 ))
+#define T1MCR          (xSimTimer[ 1 ].ulMCR)
+#define T1MR0          (xSimTimer[ 1 ].ulMR[ 0 ])
+#define T1MR1          (xSimTimer[ 1 ].ulMR[ 1 ])
+#define T1MR2          (xSimTimer[ 1 ].ulMR[ 2 ])
+#define T1MR3          (xSimTimer[ 1 ].ulMR[ 3 ])
+#define T1CCR          (xSimTimer[ 1 ].ulCCR)
+#define T1CR0          (xSimTimer[ 1 ].ulCR[ 0 ])
+#define T1CR1          (xSimTimer[ 1 ].ulCR[ 1 ])
+#define T1CR2          (xSimTimer[ 1 ].ulCR[ 2 ])
+#define T1CR3          (xSimTimer[ 1 ].ulCR[ 3 ])
+#define T1EMR          (xSimTimer[ 1 ].ulEMR)
+
+/*-----------------------------------------------------------*/
+/* Universal Asynchronous Receiver Transmitter 0 (UART0). */
+
+#define U0RBR          (*pulSimUartRBR( 0 ))
+#define U0THR          (*pulSimUartTHR( 0 ))
+#define U0IER          (xSimUart[ 0 ].ulIER)
+#define U0IIR          (*pulSimUartIIR( 0 ))
+#define U0FCR          (*pulSimUartFCR( 0 ))
+#define U0LCR          (xSimUart[ 0 ].ulLCR)
+#define U0LSR          (*pulSimUartLSR( 0 ))
+#define U0SCR          (xSimUart[ 0 ].ulSCR)
+#define U0DLL          (xSimUart[ 0 ].ulDLL)
+#define U0DLM          (xSimUart[ 0 ].ulDLM)
+
+/*-----------------------------------------------------------*/
+/* Universal Asynchronous Receiver Transmitter 1 (UART1). */
+
+#define U1RBR          (*pulSimUartRBR( 1 ))
+#define U1THR          (*pulSimUartTHR( 1 ))
+#define U1IER          (xSimUart[ 1 ].ulIER)
+#define U1IIR          (*pulSimUartIIR( 1 ))
+#define U1FCR          (*pulSimUartFCR( 1 ))
+#define U1LCR          (xSimUart[ 1 ].ulLCR)
+#define U1MCR          (xSimUart[ 1 ].ulMCR)
+#define U1LSR          (*pulSimUartLSR( 1 ))
+#define U1MSR          (xSimUart[ 1 ].ulMSR)
+#define U1SCR          (xSimUart[ 1 ].ulSCR)
+#define U1DLL          (xSimUart[ 1 ].ulDLL)
+#define U1DLM          (xSimUart[ 1 ].ulDLM)
+
+#endif  /* __LPC21xx_H */
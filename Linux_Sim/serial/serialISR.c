@@ -0,0 +1,29 @@
+/*
+ * Host (Linux) counterpart of serial/serialISR.s.
+ *
+ * On the target the UART interrupt entry points are assembly wrappers that
+ * save the context of the interrupted task, call vUART_ISRHandler() (UART1) or
+ * vUART0_ISRHandler() (UART0) and then restore the context of whichever task
+ * is selected to run next.  Under the Posix port the simulated interrupt
+ * already switches to the selected task when it returns, so the wrappers only
+ * have to call the C handlers.
+ */
+
+void vUART_ISRHandler( void );
+void vUART_ISREntry( void );
+
+/* Only defined by serial.c when serUSE_UART0 is 1, and only installed in the
+VIC then. */
+void vUART0_ISRHandler( void ) __attribute__( ( weak ) );
+void vUART0_ISREntry( void );
+
+void vUART_ISREntry( void )
+{
+	/* Call the C handler function - defined within serial.c. */
+	vUART_ISRHandler();
+}
+
+void vUART0_ISREntry( void )
+{
+	vUART0_ISRHandler();
+}
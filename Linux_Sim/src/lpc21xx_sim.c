@@ -0,0 +1,699 @@
+/*
+ * Software model of the LPC2129 peripherals used by the applications, for the
+ * Posix (Linux) host build.  See lpc21xx.h for how register accesses reach
+ * the model.
+ *
+ * The model is advanced from the simulated tick interrupt of the Posix port:
+ * every tick the UART transmitters shift out as many characters as the
+ * programmed baud rate allows in one tick period, received characters are
+ * moved into the receive FIFOs, and the handlers of any interrupt that became
+ * pending are called through the VIC exactly as on the target.
+ *
+ * Timer match interrupts are raised from the same tick, for every match
+ * register the counter passed since the last tick, so they are only accurate
+ * to one tick period.  Reset and stop on match, and the interrupt flags in IR,
+ * are not modelled.
+ *
+ * Environment variables:
+ *  LPC21XX_SIM_RUN_MS - exit the process after this many simulated
+ *                       milliseconds (ticks).  Useful for benchmark runs.
+ */
+
+/* Standard includes. */
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lpc21xx.h"
+
+/* Register values. */
+#define simUART_EMPTY_SLOT			( ( unsigned long ) 0xFFFFFFFFUL )
+#define simUART_NO_WRITE			( ( unsigned long ) 0xFFFFFFFFUL )
+#define simUART_BITS_PER_CHAR		( ( unsigned long ) 10 )
+
+#define simIIR_NO_INTERRUPT			( ( unsigned long ) 0x01 )
+#define simIIR_THRE					( ( unsigned long ) 0x02 )
+#define simIIR_RDA					( ( unsigned long ) 0x04 )
+#define simIIR_CTI					( ( unsigned long ) 0x0c )
+#define simIIR_FIFOS_ENABLED		( ( unsigned long ) 0xc0 )
+
+#define simIER_RBR					( ( unsigned long ) 0x01 )
+#define simIER_THRE					( ( unsigned long ) 0x02 )
+
+#define simFCR_FIFO_ENABLE			( ( unsigned long ) 0x01 )
+#define simFCR_RX_RESET				( ( unsigned long ) 0x02 )
+#define simFCR_TX_RESET				( ( unsigned long ) 0x04 )
+
+#define simLSR_RDR					( ( unsigned long ) 0x01 )
+#define simLSR_THRE					( ( unsigned long ) 0x20 )
+#define simLSR_TEMT					( ( unsigned long ) 0x40 )
+
+#define simTCR_ENABLE				( ( unsigned long ) 0x01 )
+#define simTCR_RESET				( ( unsigned long ) 0x02 )
+
+#define simMCR_BITS_PER_MATCH		( ( unsigned long ) 3 )
+#define simMCR_INTERRUPT			( ( unsigned long ) 0x01 )
+
+#define simVIC_SLOT_ENABLE			( ( unsigned long ) 0x20 )
+#define simVIC_CHANNEL_MASK			( ( unsigned long ) 0x1f )
+#define simVIC_TIMER0_CHANNEL		( ( unsigned long ) 4 )
+#define simVIC_TIMER1_CHANNEL		( ( unsigned long ) 5 )
+#define simVIC_UART0_CHANNEL		( ( unsigned long ) 6 )
+#define simVIC_UART1_CHANNEL		( ( unsigned long ) 7 )
+
+#define simNS_PER_SECOND			( 1000000000ULL )
+
+/*-----------------------------------------------------------*/
+
+SimVic_t xSimVic;
+SimGpio_t xSimGpio[ 2 ];
+SimUart_t xSimUart[ 2 ];
+SimTimer_t xSimTimer[ 2 ];
+SimSystem_t xSimSystem;
+
+/* Number of simulated ticks after which the process exits, 0 to run
+forever. */
+static unsigned long ulRunLimitTicks = 0;
+static unsigned long ulTicksElapsed = 0;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Advance the whole model by one tick period.  Installed as the simulated
+ * peripherals handler of the Posix port.
+ */
+static void prvSimTick( void );
+
+/*
+ * Mask/unmask the simulated interrupts around updates of the model, so a
+ * register accessed from task code is never seen half updated by the tick.
+ */
+static void prvSimLock( sigset_t *pxSaved );
+static void prvSimUnlock( const sigset_t *pxSaved );
+
+/*
+ * Call the handler the VIC has installed for a channel, if it is enabled.
+ */
+static void prvSimRaiseInterrupt( unsigned long ulChannel );
+
+static void prvSimGpioSync( SimGpio_t *pxGpio );
+static void prvSimUartSync( SimUart_t *pxUart );
+static void prvSimUartTick( SimUart_t *pxUart );
+static void prvSimTimerSync( SimTimer_t *pxTimer );
+static void prvSimTimerMatch( SimTimer_t *pxTimer );
+
+/*-----------------------------------------------------------*/
+
+static void __attribute__( ( constructor ) ) prvSimInit( void )
+{
+const char *pcRunMs;
+unsigned long ulUart;
+
+	memset( &xSimVic, 0, sizeof( xSimVic ) );
+	memset( xSimGpio, 0, sizeof( xSimGpio ) );
+	memset( xSimUart, 0, sizeof( xSimUart ) );
+	memset( xSimTimer, 0, sizeof( xSimTimer ) );
+	memset( &xSimSystem, 0, sizeof( xSimSystem ) );
+
+	/* Reset values. */
+	xSimSystem.ulPCONP = 0x000003be;
+	xSimSystem.ulVPBDIV = 0;
+
+	for( ulUart = 0; ulUart < 2; ulUart++ )
+	{
+		xSimUart[ ulUart ].ulLCR = 0x03;
+		xSimUart[ ulUart ].ulFCR = simUART_NO_WRITE;
+		xSimUart[ ulUart ].ulRxTriggerLevel = 1;
+		xSimUart[ ulUart ].iTxFd = -1;
+		xSimUart[ ulUart ].iRxFd = -1;
+	}
+
+	xSimTimer[ 0 ].ulVicChannel = simVIC_TIMER0_CHANNEL;
+	xSimTimer[ 1 ].ulVicChannel = simVIC_TIMER1_CHANNEL;
+
+	xSimUart[ 0 ].ulVicChannel = simVIC_UART0_CHANNEL;
+	xSimUart[ 1 ].ulVicChannel = simVIC_UART1_CHANNEL;
+	vSimConnectUart( 1, STDOUT_FILENO, STDIN_FILENO );
+
+	pcRunMs = getenv( "LPC21XX_SIM_RUN_MS" );
+	if( pcRunMs != NULL )
+	{
+		ulRunLimitTicks = ( strtoul( pcRunMs, NULL, 10 ) * configTICK_RATE_HZ ) / 1000UL;
+	}
+
+	vPortSetSimulatedPeripheralsHandler( prvSimTick );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimLock( sigset_t *pxSaved )
+{
+sigset_t xSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGALRM );
+	pthread_sigmask( SIG_BLOCK, &xSignals, pxSaved );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimUnlock( const sigset_t *pxSaved )
+{
+	pthread_sigmask( SIG_SETMASK, pxSaved, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimTick( void )
+{
+unsigned long ulIndex;
+
+	for( ulIndex = 0; ulIndex < 2; ulIndex++ )
+	{
+		prvSimTimerSync( &( xSimTimer[ ulIndex ] ) );
+		prvSimTimerMatch( &( xSimTimer[ ulIndex ] ) );
+		prvSimUartTick( &( xSimUart[ ulIndex ] ) );
+	}
+
+	ulTicksElapsed++;
+
+	if( ( ulRunLimitTicks != 0 ) && ( ulTicksElapsed >= ulRunLimitTicks ) )
+	{
+		_exit( 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimRaiseInterrupt( unsigned long ulChannel )
+{
+unsigned long ulSlot, ulHandler;
+
+	/* Apply any pending write to VICIntEnClr. */
+	( void ) pulSimVicIntEnClr();
+
+	if( ( xSimVic.ulIntEnable & ( 1UL << ulChannel ) ) == 0 )
+	{
+		return;
+	}
+
+	ulHandler = xSimVic.ulDefVectAddr;
+
+	for( ulSlot = 0; ulSlot < 16; ulSlot++ )
+	{
+		if( xSimVic.ulVectCntlN[ ulSlot ] == ( simVIC_SLOT_ENABLE | ulChannel ) )
+		{
+			ulHandler = xSimVic.ulVectAddrN[ ulSlot ];
+			break;
+		}
+	}
+
+	if( ulHandler != 0 )
+	{
+		xSimVic.ulVectAddr = ulHandler;
+		( ( void ( * )( void ) ) ulHandler )();
+	}
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimVicIntEnClr( void )
+{
+	/* Write only - bits written as 1 disable the channel. */
+	xSimVic.ulIntEnable &= ~xSimVic.ulIntEnClr;
+	xSimVic.ulIntEnClr = 0;
+
+	return &( xSimVic.ulIntEnClr );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimGpioSync( SimGpio_t *pxGpio )
+{
+	/* Writes to IOPIN set the output latch directly. */
+	if( pxGpio->ulPIN != pxGpio->ulLastPIN )
+	{
+		pxGpio->ulOutput = pxGpio->ulPIN;
+	}
+
+	/* IOSET reads back the output latch, so anything written to it on top of
+	that sets output bits.  IOCLR is write only. */
+	pxGpio->ulOutput |= pxGpio->ulSET;
+	pxGpio->ulOutput &= ~( pxGpio->ulCLR );
+	pxGpio->ulCLR = 0;
+	pxGpio->ulSET = pxGpio->ulOutput;
+
+	pxGpio->ulPIN = ( pxGpio->ulOutput & pxGpio->ulDIR ) | ( pxGpio->ulInput & ~( pxGpio->ulDIR ) );
+	pxGpio->ulLastPIN = pxGpio->ulPIN;
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimGpioPIN( unsigned long ulPort )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimGpioSync( &( xSimGpio[ ulPort ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimGpio[ ulPort ].ulPIN );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimGpioSET( unsigned long ulPort )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimGpioSync( &( xSimGpio[ ulPort ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimGpio[ ulPort ].ulSET );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimGpioCLR( unsigned long ulPort )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimGpioSync( &( xSimGpio[ ulPort ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimGpio[ ulPort ].ulCLR );
+}
+/*-----------------------------------------------------------*/
+
+void vSimSetPinInput( unsigned long ulPort, unsigned long ulPin, unsigned long ulLevel )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	{
+		if( ulLevel != 0 )
+		{
+			xSimGpio[ ulPort ].ulInput |= ( 1UL << ulPin );
+		}
+		else
+		{
+			xSimGpio[ ulPort ].ulInput &= ~( 1UL << ulPin );
+		}
+
+		prvSimGpioSync( &( xSimGpio[ ulPort ] ) );
+	}
+	prvSimUnlock( &xSaved );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimGetPinOutput( unsigned long ulPort, unsigned long ulPin )
+{
+	return ( *pulSimGpioPIN( ulPort ) >> ulPin ) & 0x01UL;
+}
+/*-----------------------------------------------------------*/
+
+void vSimConnectUart( unsigned long ulUart, int iTxFd, int iRxFd )
+{
+	xSimUart[ ulUart ].iTxFd = iTxFd;
+	xSimUart[ ulUart ].iRxFd = iRxFd;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimUartSync( SimUart_t *pxUart )
+{
+static const unsigned long ulTriggerLevels[ 4 ] = { 1, 4, 8, 14 };
+unsigned long ulFCR = pxUart->ulFCR;
+
+	/* Apply the last write to the (write only) FIFO control register. */
+	if( ulFCR != simUART_NO_WRITE )
+	{
+		if( ( ulFCR & simFCR_RX_RESET ) != 0 )
+		{
+			pxUart->ulRxHead = 0;
+			pxUart->ulRxCount = 0;
+			pxUart->lRxTimeoutPending = pdFALSE;
+		}
+
+		if( ( ulFCR & simFCR_TX_RESET ) != 0 )
+		{
+			pxUart->ulTxHead = 0;
+			pxUart->ulTxCount = 0;
+		}
+
+		pxUart->ulRxTriggerLevel = ulTriggerLevels[ ( ulFCR >> 6 ) & 0x03 ];
+		pxUart->ulFCR = simUART_NO_WRITE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimUartFCR( unsigned long ulUart )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimUartSync( &( xSimUart[ ulUart ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimUart[ ulUart ].ulFCR );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimUartTHR( unsigned long ulUart )
+{
+SimUart_t *pxUart = &( xSimUart[ ulUart ] );
+volatile unsigned long *pulSlot;
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	{
+		prvSimUartSync( pxUart );
+
+		/* Each write to THR lands in its own FIFO slot.  The slot is marked
+		empty until the caller's store completes, and the transmitter never
+		passes an empty slot. */
+		if( pxUart->ulTxCount < simUART_FIFO_DEPTH )
+		{
+			pulSlot = &( pxUart->ulTHR[ ( pxUart->ulTxHead + pxUart->ulTxCount ) % simUART_FIFO_DEPTH ] );
+			*pulSlot = simUART_EMPTY_SLOT;
+			pxUart->ulTxCount++;
+		}
+		else
+		{
+			/* The FIFO is full - the character is lost, as on the target. */
+			pulSlot = &( pxUart->ulOverrun );
+		}
+
+		/* Writing THR clears the THRE interrupt. */
+		pxUart->lThreInterruptPending = pdFALSE;
+	}
+	prvSimUnlock( &xSaved );
+
+	return pulSlot;
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimUartRBR( unsigned long ulUart )
+{
+SimUart_t *pxUart = &( xSimUart[ ulUart ] );
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	{
+		prvSimUartSync( pxUart );
+
+		if( pxUart->ulRxCount > 0 )
+		{
+			pxUart->ulRBR = pxUart->ucRxFifo[ pxUart->ulRxHead ];
+			pxUart->ulRxHead = ( pxUart->ulRxHead + 1 ) % simUART_FIFO_DEPTH;
+			pxUart->ulRxCount--;
+		}
+
+		/* Reading RBR clears the character time-out interrupt. */
+		pxUart->lRxTimeoutPending = pdFALSE;
+	}
+	prvSimUnlock( &xSaved );
+
+	return &( pxUart->ulRBR );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimUartIIR( unsigned long ulUart )
+{
+SimUart_t *pxUart = &( xSimUart[ ulUart ] );
+unsigned long ulIIR = simIIR_NO_INTERRUPT;
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	{
+		prvSimUartSync( pxUart );
+
+		/* Report the highest priority pending source. */
+		if( ( pxUart->ulIER & simIER_RBR ) != 0 )
+		{
+			if( pxUart->ulRxCount >= pxUart->ulRxTriggerLevel )
+			{
+				ulIIR = simIIR_RDA;
+			}
+			else if( ( pxUart->lRxTimeoutPending != pdFALSE ) && ( pxUart->ulRxCount > 0 ) )
+			{
+				ulIIR = simIIR_CTI;
+			}
+		}
+
+		if( ( ulIIR == simIIR_NO_INTERRUPT ) && ( ( pxUart->ulIER & simIER_THRE ) != 0 ) && ( pxUart->lThreInterruptPending != pdFALSE ) )
+		{
+			/* Reading IIR clears the THRE interrupt when it is the source. */
+			ulIIR = simIIR_THRE;
+			pxUart->lThreInterruptPending = pdFALSE;
+		}
+
+		pxUart->ulIIR = ulIIR | simIIR_FIFOS_ENABLED;
+	}
+	prvSimUnlock( &xSaved );
+
+	return &( pxUart->ulIIR );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimUartLSR( unsigned long ulUart )
+{
+SimUart_t *pxUart = &( xSimUart[ ulUart ] );
+unsigned long ulLSR = 0;
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	{
+		prvSimUartSync( pxUart );
+
+		if( pxUart->ulRxCount > 0 )
+		{
+			ulLSR |= simLSR_RDR;
+		}
+
+		if( pxUart->ulTxCount == 0 )
+		{
+			ulLSR |= ( simLSR_THRE | simLSR_TEMT );
+		}
+
+		pxUart->ulLSR = ulLSR;
+	}
+	prvSimUnlock( &xSaved );
+
+	return &( pxUart->ulLSR );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimUartTick( SimUart_t *pxUart )
+{
+unsigned char ucTxBytes[ 256 ];
+unsigned long ulTxBytes = 0, ulDivisor, ulCharsThisTick, ulSlot;
+unsigned char ucRxByte;
+struct pollfd xPoll;
+BaseType_t xReceived = pdFALSE;
+
+	prvSimUartSync( pxUart );
+
+	ulDivisor = ( pxUart->ulDLM << 8 ) | pxUart->ulDLL;
+	if( ulDivisor == 0 )
+	{
+		/* Not configured yet. */
+		return;
+	}
+
+	/* Number of characters that fit into one tick at the programmed baud
+	rate, carrying the remainder to the next tick. */
+	pxUart->ulBitBudget += ( unsigned long ) ( configCPU_CLOCK_HZ / ( 16UL * ulDivisor * configTICK_RATE_HZ ) );
+	ulCharsThisTick = pxUart->ulBitBudget / simUART_BITS_PER_CHAR;
+	pxUart->ulBitBudget %= simUART_BITS_PER_CHAR;
+
+	/* Transmit. */
+	while( ulCharsThisTick > 0 )
+	{
+		if( pxUart->ulTxCount == 0 )
+		{
+			break;
+		}
+
+		ulSlot = pxUart->ulTHR[ pxUart->ulTxHead ];
+		if( ulSlot == simUART_EMPTY_SLOT )
+		{
+			/* The write to this slot has not completed yet. */
+			break;
+		}
+
+		if( ulTxBytes < sizeof( ucTxBytes ) )
+		{
+			ucTxBytes[ ulTxBytes++ ] = ( unsigned char ) ulSlot;
+		}
+
+		pxUart->ulTxHead = ( pxUart->ulTxHead + 1 ) % simUART_FIFO_DEPTH;
+		pxUart->ulTxCount--;
+		ulCharsThisTick--;
+
+		if( pxUart->ulTxCount == 0 )
+		{
+			/* The FIFO has emptied - raise THRE, the handler may refill it. */
+			pxUart->lThreInterruptPending = pdTRUE;
+
+			if( ( pxUart->ulIER & simIER_THRE ) != 0 )
+			{
+				prvSimRaiseInterrupt( pxUart->ulVicChannel );
+			}
+		}
+	}
+
+	if( ( ulTxBytes > 0 ) && ( pxUart->iTxFd >= 0 ) )
+	{
+		( void ) write( pxUart->iTxFd, ucTxBytes, ulTxBytes );
+	}
+
+	/* Receive. */
+	while( ( pxUart->iRxFd >= 0 ) && ( pxUart->ulRxCount < simUART_FIFO_DEPTH ) )
+	{
+		xPoll.fd = pxUart->iRxFd;
+		xPoll.events = POLLIN;
+		xPoll.revents = 0;
+
+		if( poll( &xPoll, 1, 0 ) <= 0 )
+		{
+			break;
+		}
+
+		if( read( pxUart->iRxFd, &ucRxByte, 1 ) != 1 )
+		{
+			/* End of input - disconnect the receiver. */
+			pxUart->iRxFd = -1;
+			break;
+		}
+
+		pxUart->ucRxFifo[ ( pxUart->ulRxHead + pxUart->ulRxCount ) % simUART_FIFO_DEPTH ] = ucRxByte;
+		pxUart->ulRxCount++;
+		xReceived = pdTRUE;
+	}
+
+	if( pxUart->ulRxCount > 0 )
+	{
+		/* Characters left below the trigger level for a whole tick with no
+		new arrivals raise the character time-out interrupt. */
+		if( xReceived == pdFALSE )
+		{
+			pxUart->lRxTimeoutPending = pdTRUE;
+		}
+
+		if( ( ( pxUart->ulIER & simIER_RBR ) != 0 ) &&
+			( ( pxUart->ulRxCount >= pxUart->ulRxTriggerLevel ) || ( pxUart->lRxTimeoutPending != pdFALSE ) ) )
+		{
+			prvSimRaiseInterrupt( pxUart->ulVicChannel );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimTimerSync( SimTimer_t *pxTimer )
+{
+struct timespec xNow;
+unsigned long long ullNowNs, ullPclk, ullCounts, ullVpbDivider;
+static const unsigned long long ullVpbDividers[ 4 ] = { 4, 1, 2, 4 };
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	ullNowNs = ( ( unsigned long long ) xNow.tv_sec * simNS_PER_SECOND ) + ( unsigned long long ) xNow.tv_nsec;
+
+	/* Accept a value written to TC by software. */
+	if( pxTimer->ulTC != pxTimer->ulLastTC )
+	{
+		pxTimer->ullNsRemainder = 0;
+		pxTimer->ulMatchedTC = pxTimer->ulTC;
+	}
+
+	if( ( pxTimer->ulTCR & simTCR_RESET ) != 0 )
+	{
+		/* Held in reset. */
+		pxTimer->ulTC = 0;
+		pxTimer->ulPC = 0;
+		pxTimer->ullNsRemainder = 0;
+		pxTimer->ulMatchedTC = 0;
+	}
+	else if( ( ( pxTimer->ulTCR & simTCR_ENABLE ) != 0 ) && ( pxTimer->ullLastNs != 0 ) )
+	{
+		/* Count peripheral clock cycles since the last update. */
+		ullVpbDivider = ullVpbDividers[ xSimSystem.ulVPBDIV & 0x03 ];
+		ullPclk = ( unsigned long long ) configCPU_CLOCK_HZ / ullVpbDivider;
+
+		pxTimer->ullNsRemainder += ( ullNowNs - pxTimer->ullLastNs ) * ullPclk;
+		ullCounts = pxTimer->ullNsRemainder / simNS_PER_SECOND;
+		pxTimer->ullNsRemainder %= simNS_PER_SECOND;
+
+		/* Run the prescaler. */
+		ullCounts += pxTimer->ulPC;
+		pxTimer->ulTC += ( unsigned long ) ( ullCounts / ( ( unsigned long long ) pxTimer->ulPR + 1ULL ) );
+		pxTimer->ulPC = ( unsigned long ) ( ullCounts % ( ( unsigned long long ) pxTimer->ulPR + 1ULL ) );
+		pxTimer->ulTC &= 0xFFFFFFFFUL;
+	}
+
+	pxTimer->ullLastNs = ullNowNs;
+	pxTimer->ulLastTC = pxTimer->ulTC;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSimTimerMatch( SimTimer_t *pxTimer )
+{
+unsigned long ulMatch, ulPassed, ulMatchControl, ulTC;
+
+	/* Counts passed since the last tick.  The handlers may read the counter,
+	so moving it on, before all the match registers have been checked. */
+	ulTC = pxTimer->ulTC;
+	ulPassed = ulTC - pxTimer->ulMatchedTC;
+
+	for( ulMatch = 0; ulMatch < 4; ulMatch++ )
+	{
+		ulMatchControl = pxTimer->ulMCR >> ( ulMatch * simMCR_BITS_PER_MATCH );
+
+		/* The match register was passed if it lies in ( ulMatchedTC, ulTC ]. */
+		if( ( ( ulMatchControl & simMCR_INTERRUPT ) != 0 ) &&
+			( ulPassed != 0 ) &&
+			( ( pxTimer->ulMR[ ulMatch ] - pxTimer->ulMatchedTC - 1UL ) < ulPassed ) )
+		{
+			prvSimRaiseInterrupt( pxTimer->ulVicChannel );
+		}
+	}
+
+	pxTimer->ulMatchedTC = ulTC;
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimTimerTCR( unsigned long ulTimer )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimTimerSync( &( xSimTimer[ ulTimer ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimTimer[ ulTimer ].ulTCR );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimTimerTC( unsigned long ulTimer )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimTimerSync( &( xSimTimer[ ulTimer ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimTimer[ ulTimer ].ulTC );
+}
+/*-----------------------------------------------------------*/
+
+volatile unsigned long *pulSimTimerPC( unsigned long ulTimer )
+{
+sigset_t xSaved;
+
+	prvSimLock( &xSaved );
+	prvSimTimerSync( &( xSimTimer[ ulTimer ] ) );
+	prvSimUnlock( &xSaved );
+
+	return &( xSimTimer[ ulTimer ].ulPC );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,87 @@
+/*
+ * Host side decoder for the frames of frame.h.
+ *
+ * Reads a serial stream - a capture, or a live port - and writes every good
+ * frame as one line:
+ *
+ *   <sequence> <type> <payload length> <payload in hex>
+ *
+ * so it can be fed to another program.  It decodes as the bytes arrive, so
+ * it can sit on the end of a pipe from the port.  The counts of good frames,
+ * errors and frames missing from the sequence numbers go to stderr at the
+ * end.  Give -4 for frames sent with frameCRC_BYTES set to frameCRC32_BYTES.
+ *
+ * The decoding itself is in the frame_codec library, which another host
+ * program can link to in the same way.
+ *
+ *   ./build/frame_decode [-4] [capture]
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "frame_codec.h"
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxInput = stdin;
+FrameDecoder_t xDecoder;
+size_t xCrcBytes = frameCRC16_BYTES, x;
+int iArg = 1, iByte;
+
+	if( ( argc > iArg ) && ( strcmp( argv[ iArg ], "-4" ) == 0 ) )
+	{
+		xCrcBytes = frameCRC32_BYTES;
+		iArg++;
+	}
+
+	if( argc > ( iArg + 1 ) )
+	{
+		fprintf( stderr, "usage: %s [-4] [capture]\n", argv[ 0 ] );
+		return 2;
+	}
+
+	if( argc == ( iArg + 1 ) )
+	{
+		pxInput = fopen( argv[ iArg ], "rb" );
+
+		if( pxInput == NULL )
+		{
+			perror( argv[ iArg ] );
+			return 1;
+		}
+	}
+
+	vFrameDecoderInit( &xDecoder, xCrcBytes );
+
+	while( ( iByte = getc( pxInput ) ) != EOF )
+	{
+		if( eFrameDecoderPush( &xDecoder, ( uint8_t ) iByte ) == eFrameReceived )
+		{
+			printf( "%u %u %u ", ( unsigned ) xDecoder.usSequence, ( unsigned ) xDecoder.ucType, ( unsigned ) xDecoder.xPayloadLength );
+
+			for( x = 0; x < xDecoder.xPayloadLength; x++ )
+			{
+				printf( "%02x", ( unsigned ) xDecoder.pucPayload[ x ] );
+			}
+
+			printf( "\n" );
+		}
+	}
+
+	fprintf( stderr, "%lu frames, %lu crc errors, %lu framing errors, %lu lost\n",
+			 ( unsigned long ) xDecoder.ulFrames, ( unsigned long ) xDecoder.ulCrcErrors,
+			 ( unsigned long ) xDecoder.ulFramingErrors, ( unsigned long ) xDecoder.ulLostFrames );
+
+	if( pxInput != stdin )
+	{
+		fclose( pxInput );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,187 @@
+/*
+ * Host side decoder for the binary frames of the logger (logger.h).
+ *
+ * Reads a capture of UART1 - the frames sent by the logger's drain task with
+ * loggerBINARY set to 1 - and writes the records as the lines the drain task
+ * would have written with loggerBINARY set to 0.
+ *
+ * The format strings are taken from the same log_formats.h the application
+ * was built with, so build the decoder against it: this build uses the one of
+ * the logger benchmark, and another list is chosen with
+ * -DloggerFORMATS_HEADER='"file.h"'.
+ *
+ * Anything in the capture that is not a frame is skipped, so a capture may
+ * start part way through a frame, or mix frames with text.
+ *
+ *   ./build/bench_logger_1 > log.bin
+ *   ./build/log_decode log.bin
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The wire format only. */
+#define loggerHOST_DECODER
+#include "logger.h"
+
+/*-----------------------------------------------------------*/
+
+#define decodeMAX_PRODUCERS			( 256 )
+#define decodeNAME_LEN				( 4 * loggerMAX_ARGS )
+
+/*-----------------------------------------------------------*/
+
+/* The format strings, in the order of the names in LogFormat_t. */
+#define loggerFORMAT( xName, pcFormat )	pcFormat,
+
+static const char * const pcFormats[ loggerFORMAT_COUNT + 1 ] =
+{
+	#include loggerFORMATS_HEADER
+	NULL
+};
+
+#undef loggerFORMAT
+
+static const char cLevels[] = "DIWE";
+
+static char cProducerNames[ decodeMAX_PRODUCERS ][ decodeNAME_LEN + 1 ];
+
+static unsigned long ulFrames = 0, ulRecords = 0, ulDropped = 0;
+
+/*-----------------------------------------------------------*/
+
+static uint16_t prvGet16( const unsigned char *pucBytes )
+{
+	return ( uint16_t ) ( pucBytes[ 0 ] | ( pucBytes[ 1 ] << 8 ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvGet32( const unsigned char *pucBytes )
+{
+	return ( uint32_t ) prvGet16( pucBytes ) | ( ( uint32_t ) prvGet16( pucBytes + 2 ) << 16 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( const unsigned char *pucRecord )
+{
+uint32_t ulTimestamp = prvGet32( pucRecord );
+uint16_t usFormat = prvGet16( pucRecord + 4 );
+uint8_t ucLevel = pucRecord[ 6 ], ucProducer = pucRecord[ 7 ];
+unsigned long ulArgs[ loggerMAX_ARGS ];
+unsigned int x;
+
+	for( x = 0; x < loggerMAX_ARGS; x++ )
+	{
+		ulArgs[ x ] = ( unsigned long ) prvGet32( pucRecord + 8 + ( 4 * x ) );
+	}
+
+	if( usFormat == loggerRECORD_PRODUCER_NAME )
+	{
+		memcpy( cProducerNames[ ucProducer ], pucRecord + 8, decodeNAME_LEN );
+		cProducerNames[ ucProducer ][ decodeNAME_LEN ] = '\0';
+		return;
+	}
+
+	printf( "%8lu %c %-8s ", ( unsigned long ) ulTimestamp, cLevels[ ucLevel & 0x03U ],
+			( cProducerNames[ ucProducer ][ 0 ] != '\0' ) ? cProducerNames[ ucProducer ] : "?" );
+
+	if( usFormat == loggerRECORD_DROPPED )
+	{
+		printf( "dropped %lu records, %lu in total", ulArgs[ 0 ], ulArgs[ 1 ] );
+		ulDropped += ulArgs[ 0 ];
+	}
+	else if( usFormat < ( uint16_t ) loggerFORMAT_COUNT )
+	{
+		printf( pcFormats[ usFormat ], ulArgs[ 0 ], ulArgs[ 1 ], ulArgs[ 2 ] );
+	}
+	else
+	{
+		printf( "unknown format %u", ( unsigned ) usFormat );
+	}
+
+	printf( "\n" );
+	ulRecords++;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxInput = stdin;
+unsigned char *pucCapture = NULL;
+size_t xLength = 0, xSize = 0, xRead, xOffset = 0, xRecord, xFrameBytes;
+uint16_t usRecords;
+
+	if( argc > 2 )
+	{
+		fprintf( stderr, "usage: %s [capture]\n", argv[ 0 ] );
+		return 2;
+	}
+
+	if( argc == 2 )
+	{
+		pxInput = fopen( argv[ 1 ], "rb" );
+
+		if( pxInput == NULL )
+		{
+			perror( argv[ 1 ] );
+			return 1;
+		}
+	}
+
+	/* The whole capture is read first, so a frame split across reads needs
+	no special handling. */
+	do
+	{
+		if( xLength == xSize )
+		{
+			xSize = ( xSize == 0 ) ? 65536U : ( xSize * 2U );
+			pucCapture = realloc( pucCapture, xSize );
+
+			if( pucCapture == NULL )
+			{
+				fprintf( stderr, "out of memory\n" );
+				return 1;
+			}
+		}
+
+		xRead = fread( &( pucCapture[ xLength ] ), 1, xSize - xLength, pxInput );
+		xLength += xRead;
+	} while( xRead != 0 );
+
+	while( ( xOffset + loggerFRAME_HEADER_BYTES ) <= xLength )
+	{
+		usRecords = prvGet16( &( pucCapture[ xOffset + 8 ] ) );
+		xFrameBytes = loggerFRAME_HEADER_BYTES + ( ( size_t ) usRecords * loggerRECORD_BYTES );
+
+		if( ( prvGet32( &( pucCapture[ xOffset ] ) ) != loggerFRAME_SYNC ) || ( ( xOffset + xFrameBytes ) > xLength ) )
+		{
+			/* Not the start of a complete frame. */
+			xOffset++;
+		}
+		else
+		{
+			for( xRecord = 0; xRecord < usRecords; xRecord++ )
+			{
+				prvRecord( &( pucCapture[ xOffset + loggerFRAME_HEADER_BYTES + ( xRecord * loggerRECORD_BYTES ) ] ) );
+			}
+
+			ulFrames++;
+			xOffset += xFrameBytes;
+		}
+	}
+
+	fprintf( stderr, "%lu frames, %lu records, %lu dropped\n", ulFrames, ulRecords, ulDropped );
+
+	free( pucCapture );
+
+	if( pxInput != stdin )
+	{
+		fclose( pxInput );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,355 @@
+/*
+ * Host side decoder for the binary trace recorder (trace_recorder.h).
+ *
+ * Reads a capture of UART1 - the frames sent by the recorder's drain task -
+ * and writes a Chrome trace (JSON) that chrome://tracing or
+ * https://ui.perfetto.dev can show as a timeline:
+ *
+ *  - one track per task, with a slice for every period the task was running;
+ *  - the kernel events each task caused, as instants on its track;
+ *  - the events written from interrupts, on a track of their own;
+ *  - a global marker wherever records were lost.
+ *
+ * Anything in the capture that is not a frame is skipped, so a capture may
+ * start part way through a frame.
+ *
+ *   LPC21XX_SIM_RUN_MS=5000 ./build/A2_Task1_trace > trace.bin
+ *   ./build/trace_decode trace.bin > trace.json
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The wire format only. */
+#define traceRECORDER_HOST_DECODER
+#include "trace_recorder.h"
+
+/*-----------------------------------------------------------*/
+
+#define decodeMAX_OBJECTS			( 256 )
+#define decodeMAX_NAME_LEN			( 64 )
+
+/* The track the events written from interrupts are shown on.  Task numbers
+start at 1. */
+#define decodeISR_TRACK				( 0 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct DECODE_EVENT_NAME
+{
+	uint8_t ucEvent;
+	const char *pcName;
+	int iFromISR;
+} DecodeEventName_t;
+
+static const DecodeEventName_t xEventNames[] =
+{
+	{ traceEVENT_TASK_CREATE,						"task create",				0 },
+	{ traceEVENT_TASK_DELETE,						"task delete",				0 },
+	{ traceEVENT_TASK_DELAY,						"delay",					0 },
+	{ traceEVENT_TASK_DELAY_UNTIL,					"delay until",				0 },
+	{ traceEVENT_TASK_SUSPEND,						"suspend",					0 },
+	{ traceEVENT_TASK_RESUME,						"resume",					0 },
+	{ traceEVENT_TASK_RESUME_FROM_ISR,				"resume from ISR",			1 },
+	{ traceEVENT_TASK_READY,						"ready",					0 },
+	{ traceEVENT_TASK_PRIORITY_SET,					"priority set",				0 },
+	{ traceEVENT_TASK_NOTIFY,						"notify",					0 },
+	{ traceEVENT_TASK_NOTIFY_FROM_ISR,				"notify from ISR",			1 },
+	{ traceEVENT_TASK_NOTIFY_GIVE_FROM_ISR,			"notify give from ISR",		1 },
+	{ traceEVENT_TASK_NOTIFY_TAKE,					"notify take",				0 },
+	{ traceEVENT_TASK_NOTIFY_TAKE_BLOCK,			"notify take (block)",		0 },
+	{ traceEVENT_TASK_NOTIFY_WAIT,					"notify wait",				0 },
+	{ traceEVENT_TASK_NOTIFY_WAIT_BLOCK,			"notify wait (block)",		0 },
+	{ traceEVENT_TASK_INCREMENT_TICK,				"tick",						1 },
+	{ traceEVENT_QUEUE_CREATE,						"queue create",				0 },
+	{ traceEVENT_QUEUE_DELETE,						"queue delete",				0 },
+	{ traceEVENT_QUEUE_SEND,						"queue send",				0 },
+	{ traceEVENT_QUEUE_SEND_FAILED,					"queue send failed",		0 },
+	{ traceEVENT_QUEUE_SEND_FROM_ISR,				"queue send from ISR",		1 },
+	{ traceEVENT_QUEUE_SEND_FROM_ISR_FAILED,		"queue send from ISR failed",	1 },
+	{ traceEVENT_QUEUE_RECEIVE,						"queue receive",			0 },
+	{ traceEVENT_QUEUE_RECEIVE_FAILED,				"queue receive failed",		0 },
+	{ traceEVENT_QUEUE_RECEIVE_FROM_ISR,			"queue receive from ISR",	1 },
+	{ traceEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED,		"queue receive from ISR failed",	1 },
+	{ traceEVENT_QUEUE_PEEK,						"queue peek",				0 },
+	{ traceEVENT_BLOCKING_ON_QUEUE_SEND,			"block on queue send",		0 },
+	{ traceEVENT_BLOCKING_ON_QUEUE_RECEIVE,			"block on queue receive",	0 },
+	{ traceEVENT_BLOCKING_ON_QUEUE_PEEK,			"block on queue peek",		0 },
+	{ traceEVENT_LOW_POWER_IDLE_BEGIN,				"low power idle begin",		0 },
+	{ traceEVENT_LOW_POWER_IDLE_END,				"low power idle end",		0 }
+};
+
+/*-----------------------------------------------------------*/
+
+static char cTaskNames[ decodeMAX_OBJECTS ][ decodeMAX_NAME_LEN + 1 ];
+static int iTaskSeen[ decodeMAX_OBJECTS ];
+
+/* The task running, and since when, or 0 before the first switch. */
+static uint8_t ucRunningTask = 0;
+static double dRunningSince = 0.0;
+
+/* The timestamps are 32 bits wide and wrap, so they are extended to 64 bits
+as the records are read. */
+static uint64_t ullTime = 0;
+static uint32_t ulLastTimestamp = 0;
+static int iTimeValid = 0;
+static uint32_t ulTimestampHz = 1000000UL;
+
+static unsigned long ulFrames = 0, ulRecords = 0, ulDropped = 0;
+static int iFirstEvent = 1;
+
+/*-----------------------------------------------------------*/
+
+static uint16_t prvGet16( const unsigned char *pucBytes )
+{
+	return ( uint16_t ) ( pucBytes[ 0 ] | ( pucBytes[ 1 ] << 8 ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvGet32( const unsigned char *pucBytes )
+{
+	return ( uint32_t ) prvGet16( pucBytes ) | ( ( uint32_t ) prvGet16( pucBytes + 2 ) << 16 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * The time of a record in microseconds since the first record.  A record can
+ * be stamped slightly before the one ahead of it in the ring buffer, when an
+ * interrupt writes one between the writer claiming its record and reading
+ * the timer, so the difference is taken as signed.
+ */
+static double prvMicroseconds( uint32_t ulTimestamp )
+{
+	if( iTimeValid == 0 )
+	{
+		iTimeValid = 1;
+	}
+	else
+	{
+		ullTime += ( uint64_t ) ( int64_t ) ( int32_t ) ( ulTimestamp - ulLastTimestamp );
+	}
+
+	ulLastTimestamp = ulTimestamp;
+
+	return ( ( double ) ullTime * 1000000.0 ) / ( double ) ulTimestampHz;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartEvent( void )
+{
+	if( iFirstEvent == 0 )
+	{
+		fputs( ",\n", stdout );
+	}
+
+	iFirstEvent = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndRunningSlice( double dNow )
+{
+	if( ucRunningTask != 0 )
+	{
+		prvStartEvent();
+		printf( "{\"name\":\"running\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				( unsigned ) ucRunningTask, dRunningSince, dNow - dRunningSince );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( const unsigned char *pucRecord )
+{
+uint32_t ulTimestamp = prvGet32( pucRecord );
+uint8_t ucEvent = pucRecord[ 4 ], ucObject = pucRecord[ 5 ];
+uint16_t usParam = prvGet16( pucRecord + 6 );
+const char *pcName = NULL;
+int iFromISR = 0;
+size_t xEvent;
+unsigned uTrack;
+double dNow;
+
+	if( ucEvent == traceEVENT_TASK_NAME )
+	{
+		/* Four characters of a name in place of the timestamp. */
+		if( ( size_t ) usParam + 4U <= decodeMAX_NAME_LEN )
+		{
+			memcpy( &( cTaskNames[ ucObject ][ usParam ] ), pucRecord, 4 );
+		}
+	}
+	else
+	{
+		dNow = prvMicroseconds( ulTimestamp );
+
+		if( ucEvent == traceEVENT_TASK_SWITCHED_IN )
+		{
+			if( ucObject != ucRunningTask )
+			{
+				prvEndRunningSlice( dNow );
+				ucRunningTask = ucObject;
+				dRunningSince = dNow;
+			}
+
+			iTaskSeen[ ucObject ] = 1;
+		}
+		else
+		{
+			for( xEvent = 0; xEvent < sizeof( xEventNames ) / sizeof( xEventNames[ 0 ] ); xEvent++ )
+			{
+				if( xEventNames[ xEvent ].ucEvent == ucEvent )
+				{
+					pcName = xEventNames[ xEvent ].pcName;
+					iFromISR = xEventNames[ xEvent ].iFromISR;
+				}
+			}
+
+			if( ucEvent == traceEVENT_TASK_CREATE )
+			{
+				iTaskSeen[ ucObject ] = 1;
+			}
+
+			uTrack = ( iFromISR != 0 ) ? decodeISR_TRACK : ( unsigned ) ucRunningTask;
+
+			prvStartEvent();
+
+			if( pcName != NULL )
+			{
+				printf( "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"object\":%u,\"param\":%u}}",
+						pcName, uTrack, dNow, ( unsigned ) ucObject, ( unsigned ) usParam );
+			}
+			else
+			{
+				/* Application events, from 0x80 up. */
+				printf( "{\"name\":\"event 0x%02x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"object\":%u,\"param\":%u}}",
+						( unsigned ) ucEvent, uTrack, dNow, ( unsigned ) ucObject, ( unsigned ) usParam );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDropped( unsigned uDropped )
+{
+	prvStartEvent();
+	printf( "{\"name\":\"%u records dropped\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+			uDropped, ( unsigned ) decodeISR_TRACK, ( ( double ) ullTime * 1000000.0 ) / ( double ) ulTimestampHz );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTrackNames( void )
+{
+unsigned uTask;
+
+	prvStartEvent();
+	printf( "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"FreeRTOS\"}},\n" );
+	printf( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"ISR\"}}", ( unsigned ) decodeISR_TRACK );
+
+	for( uTask = 1; uTask < decodeMAX_OBJECTS; uTask++ )
+	{
+		if( iTaskSeen[ uTask ] != 0 )
+		{
+			printf( ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%u %s\"}}",
+					uTask, uTask, cTaskNames[ uTask ] );
+			printf( ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}",
+					uTask, uTask );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxInput = stdin;
+unsigned char *pucCapture = NULL;
+size_t xLength = 0, xSize = 0, xRead, xOffset = 0, xRecord, xFrameBytes;
+uint16_t usRecords, usDropped;
+
+	if( argc > 2 )
+	{
+		fprintf( stderr, "usage: %s [capture]\n", argv[ 0 ] );
+		return 2;
+	}
+
+	if( argc == 2 )
+	{
+		pxInput = fopen( argv[ 1 ], "rb" );
+
+		if( pxInput == NULL )
+		{
+			perror( argv[ 1 ] );
+			return 1;
+		}
+	}
+
+	/* The whole capture is read first, so a frame split across reads needs
+	no special handling. */
+	do
+	{
+		if( xLength == xSize )
+		{
+			xSize = ( xSize == 0 ) ? 65536U : ( xSize * 2U );
+			pucCapture = realloc( pucCapture, xSize );
+
+			if( pucCapture == NULL )
+			{
+				fprintf( stderr, "out of memory\n" );
+				return 1;
+			}
+		}
+
+		xRead = fread( &( pucCapture[ xLength ] ), 1, xSize - xLength, pxInput );
+		xLength += xRead;
+	} while( xRead != 0 );
+
+	printf( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+
+	while( ( xOffset + traceFRAME_HEADER_BYTES ) <= xLength )
+	{
+		usRecords = prvGet16( &( pucCapture[ xOffset + 8 ] ) );
+		usDropped = prvGet16( &( pucCapture[ xOffset + 10 ] ) );
+		xFrameBytes = traceFRAME_HEADER_BYTES + ( ( size_t ) usRecords * traceRECORD_BYTES );
+
+		if( ( prvGet32( &( pucCapture[ xOffset ] ) ) != traceFRAME_SYNC ) || ( ( xOffset + xFrameBytes ) > xLength ) )
+		{
+			/* Not the start of a complete frame. */
+			xOffset++;
+		}
+		else
+		{
+			ulTimestampHz = prvGet32( &( pucCapture[ xOffset + 4 ] ) );
+
+			if( usDropped != 0U )
+			{
+				prvDropped( usDropped );
+			}
+
+			for( xRecord = 0; xRecord < usRecords; xRecord++ )
+			{
+				prvRecord( &( pucCapture[ xOffset + traceFRAME_HEADER_BYTES + ( xRecord * traceRECORD_BYTES ) ] ) );
+			}
+
+			ulFrames++;
+			ulRecords += usRecords;
+			ulDropped += usDropped;
+			xOffset += xFrameBytes;
+		}
+	}
+
+	prvEndRunningSlice( ( ( double ) ullTime * 1000000.0 ) / ( double ) ulTimestampHz );
+	prvTrackNames();
+	printf( "\n]}\n" );
+
+	fprintf( stderr, "%lu frames, %lu records, %lu dropped\n", ulFrames, ulRecords, ulDropped );
+
+	free( pucCapture );
+
+	if( pxInput != stdin )
+	{
+		fclose( pxInput );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/